@@ -0,0 +1,15 @@
+/**
+ * @file
+ * @brief Function prototypes for the emitter functions.
+ * @note  DO NOT EDIT THIS FILE, your changes will be lost.
+ *         Edit ir/be/amd64/amd64_spec.pl instead.
+ *         created by: ./ir/be/scripts/generate_emitter.pl ir/be/amd64/amd64_spec.pl build/gen/ir/be/amd64
+ * @date  Mon Oct 19 18:08:17 2026
+ */
+#ifndef FIRM_BE_AMD64_GEN_AMD64_EMITTER_H
+#define FIRM_BE_AMD64_GEN_AMD64_EMITTER_H
+
+void amd64_register_spec_emitters(void);
+void amd64_register_spec_binary_emitters(void);
+
+#endif
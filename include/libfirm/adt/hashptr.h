@@ -26,8 +26,14 @@
 #define _FIRM_FNV_OFFSET_BASIS 2166136261U
 #define _FIRM_FNV_FNV_PRIME    16777619U
 
+#define _FIRM_FNV64_OFFSET_BASIS 14695981039346656037ULL
+#define _FIRM_FNV64_PRIME        1099511628211ULL
+
 /** @endcond */
 
+/** The 64 bit hash of no data, to start hash_data64() with. */
+#define HASH64_START _FIRM_FNV64_OFFSET_BASIS
+
 /**
  * Returns a hash value for a block of data.
  */
@@ -42,6 +48,23 @@ static inline unsigned hash_data(unsigned char const *data, size_t bytes)
 	return hash;
 }
 
+/**
+ * Continues the 64 bit hash value @p hash over a block of data.
+ * Unlike hash_data(), the result does not depend on the host, so it may be
+ * stored, e.g. as a fingerprint.
+ */
+static inline unsigned long long hash_data64(unsigned long long hash,
+                                             void const *data, size_t size)
+{
+	unsigned char const *const bytes = (unsigned char const*)data;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= _FIRM_FNV64_PRIME;
+	}
+
+	return hash;
+}
+
 /**
  * Returns a hash value for a string.
  * @param str The string (can be const).
@@ -114,6 +114,26 @@ typedef void callgraph_walk_func(ir_graph *g, void *env);
 FIRM_API void callgraph_walk(callgraph_walk_func *pre,
                              callgraph_walk_func *post, void *env);
 
+/**
+ * Runs a pipeline of passes on all graphs, callees before their callers.
+ *
+ * The graphs are grouped into the strongly connected components of the
+ * callgraph. Each component gets a level one above the highest level of the
+ * components it calls and the graphs are processed level by level, running
+ * all passes on one graph before the next. So information a pass computes
+ * for a graph, e.g. its purity, is available when its callers are processed.
+ * Components of the same level do not call each other.
+ *
+ * Expects a consistent callgraph, see compute_callgraph(). The order is
+ * determined before the first pass runs, so passes may change calls.
+ *
+ * @param passes    the passes to run on each graph
+ * @param n_passes  the number of passes
+ * @param env       environment, passed to each pass
+ */
+FIRM_API void callgraph_run_bottom_up(callgraph_walk_func *const *passes,
+                                      size_t n_passes, void *env);
+
 /**
  * Compute the backedges that represent recursions and a looptree.
  */
@@ -22,6 +22,15 @@
  * @{
  */
 
+/**
+ * An out edge: input @c pos of node @c src uses the node the edge belongs
+ * to.
+ */
+struct ir_edge_t {
+	ir_node *src; /**< The source node of the edge. */
+	int      pos; /**< The position of the edge at @c src. */
+};
+
 /**
  * Returns the first edge pointing to some node.
  * @note There is no order on out edges. First in this context only
@@ -53,6 +62,9 @@ FIRM_API const ir_edge_t *get_block_succ_first(const ir_node *block);
 
 /**
  * Returns the next edge in the out list of some node.
+ * @note The returned edges point into the out array of @p irn, which is
+ * reallocated when edges are added. Use the foreach macros if the graph is
+ * changed while iterating.
  * @param irn The node.
  * @param last The last out edge you have seen.
  * @param kind the kind of edge that are iterated
@@ -62,27 +74,46 @@ FIRM_API const ir_edge_t *get_irn_out_edge_next(const ir_node *irn,
                                                 const ir_edge_t *last,
                                                 ir_edge_kind_t kind);
 
+/**
+ * Helper for the iteration macros: Copies the out edge of @p irn in front of
+ * index @p idx into @p edge and returns its index, or -1 if there is none.
+ * @p idx is first limited to the number of out edges, so edges may be
+ * removed while iterating.
+ */
+FIRM_API int get_irn_out_edge_before(const ir_node *irn, int idx,
+                                     ir_edge_kind_t kind, ir_edge_t *edge);
+
 /**
  * A convenience iteration macro over all out edges of a node.
+ *
+ * The edges are visited from the last to the first one in the out array of
+ * the node and @p edge points to a copy of the current edge. Therefore the
+ * current edge may be changed or removed in the loop body and edges added
+ * while iterating are not visited.
+ *
  * @param irn  The node.
  * @param kind The edge's kind.
  * @param edge An ir_edge_t pointer which shall be set to the current
  * edge.
  */
 #define foreach_out_edge_kind(irn, edge, kind) \
-	for (ir_edge_t const *edge = get_irn_out_edge_first_kind(irn, kind); edge; edge = get_irn_out_edge_next(irn, edge, kind))
+	for (int edge##__b = 1; edge##__b;) \
+		for (ir_node const *const edge##__irn = (irn); edge##__b; edge##__b = 0) \
+			for (ir_edge_t edge##__copy; edge##__b; edge##__b = 0) \
+				for (int edge##__i = get_irn_n_edges_kind(edge##__irn, (kind)); edge##__b && (edge##__i = get_irn_out_edge_before(edge##__irn, edge##__i, (kind), &edge##__copy)) >= 0;) \
+					for (ir_edge_t const *const edge = (edge##__b = 0, &edge##__copy); !edge##__b; (void)edge, edge##__b = 1)
 
 /**
  * A convenience iteration macro over all out edges of a node, which is safe
- * against alteration of the current edge.
+ * against alteration of the current edge. As foreach_out_edge_kind() works
+ * on a copy of the current edge, this is the same.
  *
  * @param irn  The node.
  * @param edge An ir_edge_t pointer which shall be set to the current edge.
  * @param kind The kind of the edge.
  */
 #define foreach_out_edge_kind_safe(irn, edge, kind) \
-	for (ir_edge_t const *edge = get_irn_out_edge_first_kind((irn), (kind)), *edge##__next; edge; edge = edge##__next) \
-		if (edge##__next = get_irn_out_edge_next((irn), edge, (kind)), 0) {} else
+	foreach_out_edge_kind(irn, edge, kind)
 
 /**
  * Convenience macro for normal out edges.
@@ -64,6 +64,22 @@ FIRM_API void irg_walk_core(ir_node *node, irg_walk_func *pre,
 FIRM_API void irg_walk_graph(ir_graph *irg, irg_walk_func *pre,
                              irg_walk_func *post, void *env);
 
+/**
+ * Calls a function for every node of the ir graph in the order of the node
+ * indices.
+ *
+ * This is faster than irg_walk_graph() as it simply runs over the index map
+ * of the graph, but the order is not topological and nodes which are no
+ * longer reachable are visited as well. Nodes created by @p func are not
+ * visited. Does not use the visited flags or the link field.
+ *
+ * @param irg   the irg graph
+ * @param func  walker function
+ * @param env   environment, passed to func
+ */
+FIRM_API void irg_walk_graph_by_idx(ir_graph *irg, irg_walk_func *func,
+                                    void *env);
+
 /**
  * Walks over the ir graph.
  *
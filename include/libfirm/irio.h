@@ -38,9 +38,40 @@ FIRM_API int ir_export(const char *filename);
  */
 FIRM_API void ir_export_file(FILE *output);
 
+/**
+ * Exports the whole irp to the given file in a compact binary form.
+ * The file contains an index of the ir graphs, so ir_import() can defer
+ * reading each graph until it is accessed.
+ *
+ * @param filename  the name of the resulting file
+ * @return  0 if no errors occured, other values in case of errors
+ */
+FIRM_API int ir_export_binary(const char *filename);
+
+/**
+ * same as ir_export_binary but writes to a FILE*
+ * @note As with any FILE* errors are indicated by ferror(output)
+ */
+FIRM_API void ir_export_binary_file(FILE *output);
+
+/**
+ * Computes a fingerprint of the given graph.
+ * The fingerprint covers the nodes with their modes and attributes as well as
+ * the names and layout of referenced entities and types, but not node
+ * numbers, so identical graphs built at different times have the same
+ * fingerprint.
+ *
+ * @param irg  the graph
+ * @return  a 64 bit hash of the exported form of the graph
+ */
+FIRM_API unsigned long long ir_graph_fingerprint(ir_graph *irg);
+
 /**
  * Imports the data stored in the given file.
  * Imports any type graphs and ir graphs contained in the file.
+ * Files written by ir_export_binary() are detected automatically. For them
+ * types and entities are imported right away, but each ir graph is only read
+ * when it is first accessed, e.g. by get_entity_irg() or get_irp_n_irgs().
  *
  * @param filename  the name of the file
  * @returns 0 if no errors occured, other values in case of errors
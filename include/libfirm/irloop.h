@@ -52,7 +52,7 @@ FIRM_API void set_irg_loop(ir_graph *irg, ir_loop *l);
 /** Returns the root loop info (if exists) for an irg. */
 FIRM_API ir_loop *get_irg_loop(const ir_graph *irg);
 
-/** Returns the loop n is contained in.  NULL if node is in no loop. */
+/** Returns the loop block n is contained in.  NULL if it is in no loop. */
 FIRM_API ir_loop *get_irn_loop(const ir_node *n);
 
 /** Returns outer loop, itself if outermost. */
@@ -299,6 +299,24 @@ FIRM_API void remove_phi_cycles(ir_graph *irg);
  */
 FIRM_API void proc_cloning(float threshold);
 
+/** A default threshold for opt_ipcp(). */
+#define DEFAULT_IPCP_THRESHOLD 4
+
+/**
+ * Interprocedural constant and range propagation.
+ *
+ * Propagates the constants, known bits and value ranges of the arguments into
+ * the parameters of functions whose call sites are all known, and the results
+ * of functions back into their callers. Ranges are attached as Confirm
+ * nodes, so remove_confirms() must be run before code generation.
+ * Call sites passing the same constants to a function get a specialized copy
+ * of it, if the summed weights of the constant parameters times the number of
+ * these calls times @p threshold reach the number of nodes of the function.
+ *
+ * @param threshold  the threshold for specializing, 0.0 disables it
+ */
+FIRM_API void opt_ipcp(float threshold);
+
 /**
  * Reassociation.
  *
@@ -368,6 +386,17 @@ FIRM_API void normalize_n_returns(ir_graph *irg);
  */
 FIRM_API void scalar_replacement_opt(ir_graph *irg);
 
+/**
+ * Promotes memory locations accessed in innermost loops to values.
+ * A location with a loop invariant address is loaded once in front of the
+ * loop and stored once behind it, if the memory disambiguator proves that no
+ * other memory operation in the loop accesses it.  Loops containing calls are
+ * not changed.
+ *
+ * @param irg  the graph which should be optimized
+ */
+FIRM_API void opt_scalar_promotion(ir_graph *irg);
+
 /**
  * Optimizes tail-recursion calls by converting them into loops.
  * Depends on the flag opt_tail_recursion.
@@ -438,6 +467,75 @@ FIRM_API void do_loop_unrolling(ir_graph *irg);
  */
 FIRM_API void do_loop_peeling(ir_graph *irg);
 
+/**
+ * Perform loop unswitching on a given graph.
+ * A condition, which does not change inside of a loop, is tested in front of
+ * the loop instead. The loop is duplicated for both outcomes of the condition,
+ * which is removed from both copies. More frequently executed loops are
+ * unswitched first, until a code size budget is exhausted.
+ */
+FIRM_API void do_loop_unswitching(ir_graph *irg);
+
+/**
+ * Optimizes perfectly nested loops for cache locality.
+ * The loops of a nest are interchanged if the inner loop then touches fewer
+ * cache lines per iteration, and the inner loop is tiled if the outer loop
+ * reuses its data but one sweep over it does not fit into the cache.  Only
+ * nests of two counted loops without dependences preventing the reordering
+ * and with affine addresses are changed.
+ *
+ * @param irg              the graph which should be optimized
+ * @param cache_size       the size of the cache in bytes
+ * @param cache_line_size  the size of a cache line in bytes
+ */
+FIRM_API void do_loop_nest_optimization(ir_graph *irg, unsigned cache_size,
+                                        unsigned cache_line_size);
+
+/**
+ * Removes range checks, whose outcome is known.
+ * A compare-and-branch is decided by the conditions of dominating branches,
+ * Confirm nodes, the lower bounds of loop induction variables and value range
+ * propagation, also chaining two known relations over a common value.  A
+ * check of a counted loop's induction variable against a loop invariant value
+ * gets a loop invariant guard implying it, which is moved in front of the
+ * loop by do_loop_unswitching(), so one copy of the loop runs without the
+ * check.  Decided checks keep a constant selector for control flow
+ * optimization to remove.
+ *
+ * @param irg  the graph which should be optimized
+ */
+FIRM_API void opt_range_checks(ir_graph *irg);
+
+/**
+ * Inserts software prefetches for Loads in loops, whose address advances by
+ * a constant stride per iteration.  The prefetched address is the one the
+ * Load accesses @p distance iterations later.  Loads sharing a cache line
+ * share a prefetch.  Backends without prefetch instructions drop the
+ * prefetches again.
+ *
+ * @param irg              the graph which should be optimized
+ * @param distance         the number of iterations to prefetch ahead
+ * @param cache_line_size  the size of a cache line in bytes
+ */
+FIRM_API void opt_prefetch(ir_graph *irg, unsigned distance,
+                           unsigned cache_line_size);
+
+/**
+ * Forms superblocks along frequently executed paths by tail duplication.
+ * Blocks are grouped into traces along their most frequent control flow
+ * edges.  A block in a trace, which is also entered from outside of the
+ * trace, is duplicated for the trace, so the trace is only entered at its
+ * head.  Traces stay within their loop and enter loop headers only at their
+ * head.  The execution frequencies of the blocks must be available, either
+ * from ir_estimate_execfreq() or from a profile.  Run optimize_cf()
+ * afterwards to merge the blocks of the superblocks.
+ *
+ * @param irg         the graph which should be optimized
+ * @param max_growth  the maximal number of duplicated nodes in percent of
+ *                    the nodes of the graph
+ */
+FIRM_API void opt_tail_duplication(ir_graph *irg, unsigned max_growth);
+
 /**
  * Removes all entities which are unused.
  *
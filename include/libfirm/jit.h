@@ -34,6 +34,11 @@ typedef struct ir_jit_segment_t ir_jit_segment_t;
  */
 typedef struct ir_jit_function_t ir_jit_function_t;
 
+/**
+ * Graph compiled in the background, see be_jit_compile_async().
+ */
+typedef struct ir_jit_task_t ir_jit_task_t;
+
 /**
  * Create a new jit segment.
  */
@@ -72,6 +77,121 @@ FIRM_API unsigned be_get_function_size(ir_jit_function_t const *function);
  */
 FIRM_API void be_emit_function(char *buffer, ir_jit_function_t *function);
 
+/**
+ * Compile graph \p irg into executable memory owned by \p segment.
+ *
+ * The address of the entity of \p irg is set to the code, so functions
+ * compiled later can call it. Small functions of a segment share pages.
+ * The code is written through a second mapping of its memory, so no page is
+ * writable and executable at the same time and other functions of
+ * \p segment may run meanwhile.
+ *
+ * @return the address of the code or NULL if the target does not support
+ *         jit compilation
+ */
+FIRM_API void *be_jit_compile_executable(ir_jit_segment_t *segment,
+                                         ir_graph *irg);
+
+/**
+ * Free the executable memory of a function compiled with
+ * be_jit_compile_executable(). The memory is reused for later functions of
+ * \p segment. Destroying the segment frees the memory of all its functions.
+ * Freeing a stub cancels its pending recompilation. Takes be_jit_lock()
+ * itself.
+ */
+FIRM_API void be_jit_free_executable(ir_jit_segment_t *segment, void *code);
+
+/**
+ * Callback of tiered compilation, which runs the optimizations of the final
+ * tier on the graph \p irg of a hot function. The graph has already been
+ * lowered for the target.
+ */
+typedef void (*ir_jit_optimize_func)(ir_graph *irg);
+
+/**
+ * Create a call-through stub for graph \p irg in \p segment and set the
+ * address of the entity of \p irg to it.
+ *
+ * The graph is compiled on the first call of the stub, which then jumps to the
+ * code directly. Calls from code compiled later always go through the stub,
+ * so functions do not need to be compiled in call order. The graph must not
+ * be used until it is compiled. Freeing the stub with
+ * be_jit_free_executable() frees the code of the function, too.
+ *
+ * Stubs compile in the thread that calls them. The stub is only written on
+ * creation, so other functions of \p segment may run meanwhile.
+ *
+ * @return the address of the stub or NULL if the target does not support
+ *         stubs
+ */
+FIRM_API void *be_jit_create_stub(ir_jit_segment_t *segment, ir_graph *irg);
+
+/**
+ * Enable tiered compilation of functions behind stubs of \p segment.
+ *
+ * With a \p threshold greater than 0, the first call of a stub compiles a copy
+ * of the graph with a fast register allocator and scheduler. After
+ * \p threshold further calls, the stub calls \p optimize, if it is not NULL,
+ * compiles the graph again and switches to the new code. The code of the
+ * first tier stays allocated until the stub is freed, because it may still be
+ * running. A \p threshold of 0 compiles the final code on the first call.
+ */
+FIRM_API void be_jit_set_tiering(ir_jit_segment_t *segment, unsigned threshold,
+                                 ir_jit_optimize_func optimize);
+
+/**
+ * Start worker threads for \p segment until it has \p n_workers of them.
+ *
+ * Workers compile graphs queued with be_jit_compile_async() and recompile
+ * hot functions behind stubs of \p segment, so the threads calling them do
+ * not wait for the compiler.
+ *
+ * The IR of libFirm is global state, so only one thread compiles at a time:
+ * While workers run, other threads must hold be_jit_lock() when they call
+ * libFirm functions, including the jit functions other than the ones for
+ * tasks and be_jit_free_executable(). Destroying the segment waits for the
+ * queued tasks.
+ */
+FIRM_API void be_jit_set_workers(ir_jit_segment_t *segment, unsigned n_workers);
+
+/**
+ * Queue graph \p irg for compilation by a worker of \p segment. Starts a
+ * worker if the segment has none. When the code is ready, the address of the
+ * entity of \p irg is set to it. The graph must not have a stub and must not
+ * be used until the task is done.
+ *
+ * @return a handle, which has to be released with be_jit_wait()
+ */
+FIRM_API ir_jit_task_t *be_jit_compile_async(ir_jit_segment_t *segment,
+                                             ir_graph *irg);
+
+/**
+ * Return whether the code of \p task is ready, so be_jit_wait() does not
+ * block.
+ */
+FIRM_API int be_jit_task_done(ir_jit_task_t const *task);
+
+/**
+ * Wait until \p task is done and release it.
+ *
+ * @return the address of the code or NULL if the target does not support jit
+ *         compilation
+ */
+FIRM_API void *be_jit_wait(ir_jit_task_t *task);
+
+/**
+ * Acquire the lock, which the compiling thread holds. The first call of a
+ * stub waits for it, so a thread holding it must not call functions behind
+ * stubs, which are not compiled yet. Hot stubs never wait: While the lock is
+ * taken, they keep running the tier-0 code and try again later.
+ */
+FIRM_API void be_jit_lock(void);
+
+/**
+ * Release the lock acquired with be_jit_lock().
+ */
+FIRM_API void be_jit_unlock(void);
+
 /** @} */
 
 #include "end.h"
@@ -80,7 +80,10 @@ FIRM_API void lower_CopyB(ir_graph *irg, unsigned max_small_size,
 
 /**
  * Lowers all Switches (Cond nodes with non-boolean mode) depending on spare_size.
- * They will either remain the same or be converted into if-cascades.
+ * They will either remain the same or be converted into a binary decision
+ * tree over clusters of cases. A cluster is a single case, a dense island
+ * lowered to a smaller table switch or a small range tested with bit masks.
+ * If execution frequencies are available, frequent cases are tested first.
  *
  * @param irg        The ir graph to be lowered.
  * @param small_switch  If switch has <= cases then change it to an if-cascade.
@@ -45,12 +45,18 @@
  */
 #define ENUMBF(type)  __extension__ type
 
+/**
+ * Hint to the processor that the memory at addr is going to be read soon.
+ */
+#define PREFETCH(addr) __builtin_prefetch(addr)
+
 #else
 #define LIKELY(x)   x
 #define UNLIKELY(x) x
 #define PURE
 #define UNUSED
 #define ENUMBF(type)  unsigned
+#define PREFETCH(addr) ((void)(addr))
 #endif
 
 /**
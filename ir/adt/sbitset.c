@@ -0,0 +1,398 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   sparse bitsets for large universes
+ */
+#include "sbitset.h"
+
+#include <string.h>
+#include "util.h"
+#include "xmalloc.h"
+
+void sbitset_init(sbitset_t *set, size_t size)
+{
+	set->size     = size;
+	set->dense    = NULL;
+	set->chunks   = NULL;
+	set->n_chunks = 0;
+	set->capacity = 0;
+}
+
+void sbitset_free(sbitset_t *set)
+{
+	free(set->dense);
+	free(set->chunks);
+	set->dense    = NULL;
+	set->chunks   = NULL;
+	set->n_chunks = 0;
+	set->capacity = 0;
+}
+
+/** Returns the index of the first chunk whose number is >= index. */
+static size_t lower_bound(const sbitset_t *set, size_t index)
+{
+	size_t lo = 0;
+	size_t hi = set->n_chunks;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (set->chunks[mid].index < index)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+static bool chunk_is_empty(const sbitset_chunk_t *chunk)
+{
+	for (size_t i = 0; i < SBITSET_CHUNK_ELEMS; ++i) {
+		if (chunk->bits[i] != 0)
+			return false;
+	}
+	return true;
+}
+
+static void ensure_capacity(sbitset_t *set, size_t n)
+{
+	if (n <= set->capacity)
+		return;
+	size_t new_capacity = set->capacity < 4 ? 4 : set->capacity * 2;
+	if (new_capacity < n)
+		new_capacity = n;
+	set->chunks   = XREALLOC(set->chunks, sbitset_chunk_t, new_capacity);
+	set->capacity = new_capacity;
+}
+
+/** Copy the words of chunk number index out of a dense raw bitset. */
+static void dense_get_chunk(const sbitset_t *set, size_t index,
+                            unsigned *bits)
+{
+	size_t n_elems = BITSET_SIZE_ELEMS(set->size);
+	size_t first   = index * SBITSET_CHUNK_ELEMS;
+	for (size_t i = 0; i < SBITSET_CHUNK_ELEMS; ++i) {
+		size_t elem = first + i;
+		bits[i] = elem < n_elems ? set->dense[elem] : 0;
+	}
+}
+
+/** Copy the words of chunk number index out of any set representation. */
+static void get_chunk(const sbitset_t *set, size_t index, unsigned *bits)
+{
+	if (set->dense != NULL) {
+		dense_get_chunk(set, index, bits);
+		return;
+	}
+	size_t i = lower_bound(set, index);
+	if (i < set->n_chunks && set->chunks[i].index == index) {
+		memcpy(bits, set->chunks[i].bits, sizeof(set->chunks[i].bits));
+	} else {
+		memset(bits, 0, SBITSET_CHUNK_ELEMS * sizeof(unsigned));
+	}
+}
+
+static void make_dense(sbitset_t *set)
+{
+	if (set->dense != NULL)
+		return;
+	size_t    n_elems = BITSET_SIZE_ELEMS(set->size);
+	unsigned *dense   = rbitset_malloc(set->size);
+	for (size_t c = 0; c < set->n_chunks; ++c) {
+		const sbitset_chunk_t *chunk = &set->chunks[c];
+		size_t first = chunk->index * SBITSET_CHUNK_ELEMS;
+		for (size_t i = 0; i < SBITSET_CHUNK_ELEMS && first + i < n_elems; ++i)
+			dense[first + i] = chunk->bits[i];
+	}
+	free(set->chunks);
+	set->chunks   = NULL;
+	set->n_chunks = 0;
+	set->capacity = 0;
+	set->dense    = dense;
+}
+
+/** Switch to dense mode if the chunk array got bigger than a raw bitset. */
+static void maybe_make_dense(sbitset_t *set)
+{
+	if (set->n_chunks * sizeof(sbitset_chunk_t) > BITSET_SIZE_BYTES(set->size))
+		make_dense(set);
+}
+
+/** Remove all empty chunks from a sparse set. */
+static void compact_chunks(sbitset_t *set)
+{
+	size_t n = 0;
+	for (size_t c = 0; c < set->n_chunks; ++c) {
+		if (chunk_is_empty(&set->chunks[c]))
+			continue;
+		if (n != c)
+			set->chunks[n] = set->chunks[c];
+		++n;
+	}
+	set->n_chunks = n;
+}
+
+void sbitset_set(sbitset_t *set, size_t pos)
+{
+	assert(pos < set->size);
+	if (set->dense != NULL) {
+		rbitset_set(set->dense, pos);
+		return;
+	}
+
+	size_t index = pos / SBITSET_CHUNK_BITS;
+	size_t i     = lower_bound(set, index);
+	if (i == set->n_chunks || set->chunks[i].index != index) {
+		ensure_capacity(set, set->n_chunks + 1);
+		memmove(&set->chunks[i + 1], &set->chunks[i],
+		        (set->n_chunks - i) * sizeof(set->chunks[0]));
+		++set->n_chunks;
+		sbitset_chunk_t *chunk = &set->chunks[i];
+		chunk->index = index;
+		memset(chunk->bits, 0, sizeof(chunk->bits));
+	}
+	rbitset_set(set->chunks[i].bits, pos % SBITSET_CHUNK_BITS);
+	maybe_make_dense(set);
+}
+
+void sbitset_clear(sbitset_t *set, size_t pos)
+{
+	assert(pos < set->size);
+	if (set->dense != NULL) {
+		rbitset_clear(set->dense, pos);
+		return;
+	}
+
+	size_t index = pos / SBITSET_CHUNK_BITS;
+	size_t i     = lower_bound(set, index);
+	if (i == set->n_chunks || set->chunks[i].index != index)
+		return;
+	sbitset_chunk_t *chunk = &set->chunks[i];
+	rbitset_clear(chunk->bits, pos % SBITSET_CHUNK_BITS);
+	if (chunk_is_empty(chunk)) {
+		--set->n_chunks;
+		memmove(&set->chunks[i], &set->chunks[i + 1],
+		        (set->n_chunks - i) * sizeof(set->chunks[0]));
+	}
+}
+
+void sbitset_set_all(sbitset_t *set)
+{
+	make_dense(set);
+	rbitset_set_all(set->dense, set->size);
+}
+
+void sbitset_clear_all(sbitset_t *set)
+{
+	free(set->dense);
+	set->dense    = NULL;
+	set->n_chunks = 0;
+}
+
+bool sbitset_is_set(const sbitset_t *set, size_t pos)
+{
+	assert(pos < set->size);
+	if (set->dense != NULL)
+		return rbitset_is_set(set->dense, pos);
+
+	size_t index = pos / SBITSET_CHUNK_BITS;
+	size_t i     = lower_bound(set, index);
+	if (i == set->n_chunks || set->chunks[i].index != index)
+		return false;
+	return rbitset_is_set(set->chunks[i].bits, pos % SBITSET_CHUNK_BITS);
+}
+
+size_t sbitset_next(const sbitset_t *set, size_t pos)
+{
+	if (pos >= set->size)
+		return (size_t)-1;
+	if (set->dense != NULL)
+		return rbitset_next_max(set->dense, pos, set->size, true);
+
+	size_t index = pos / SBITSET_CHUNK_BITS;
+	for (size_t c = lower_bound(set, index); c < set->n_chunks; ++c) {
+		const sbitset_chunk_t *chunk = &set->chunks[c];
+		size_t first = chunk->index == index ? pos % SBITSET_CHUNK_BITS : 0;
+		size_t p     = rbitset_next_max(chunk->bits, first,
+		                                SBITSET_CHUNK_BITS, true);
+		if (p != (size_t)-1)
+			return chunk->index * SBITSET_CHUNK_BITS + p;
+	}
+	return (size_t)-1;
+}
+
+bool sbitset_is_empty(const sbitset_t *set)
+{
+	if (set->dense != NULL)
+		return rbitset_is_empty(set->dense, set->size);
+	/* sparse sets never contain empty chunks */
+	return set->n_chunks == 0;
+}
+
+size_t sbitset_popcount(const sbitset_t *set)
+{
+	if (set->dense != NULL)
+		return rbitset_popcount(set->dense, set->size);
+
+	size_t res = 0;
+	for (size_t c = 0; c < set->n_chunks; ++c) {
+		res += rbitset_popcount(set->chunks[c].bits, SBITSET_CHUNK_BITS);
+	}
+	return res;
+}
+
+void sbitset_copy(sbitset_t *dst, const sbitset_t *src)
+{
+	assert(dst->size == src->size);
+	if (dst == src)
+		return;
+	if (src->dense != NULL) {
+		make_dense(dst);
+		rbitset_copy(dst->dense, src->dense, src->size);
+		return;
+	}
+	sbitset_clear_all(dst);
+	ensure_capacity(dst, src->n_chunks);
+	MEMCPY(dst->chunks, src->chunks, src->n_chunks);
+	dst->n_chunks = src->n_chunks;
+}
+
+void sbitset_and(sbitset_t *dst, const sbitset_t *src)
+{
+	assert(dst->size == src->size);
+	if (dst->dense != NULL && src->dense != NULL) {
+		rbitset_and(dst->dense, src->dense, dst->size);
+		return;
+	}
+
+	if (dst->dense != NULL) {
+		/* the result is a subset of the sparse src, so become sparse */
+		unsigned *dense = dst->dense;
+		dst->dense = NULL;
+		ensure_capacity(dst, src->n_chunks);
+		for (size_t c = 0; c < src->n_chunks; ++c) {
+			const sbitset_chunk_t *chunk = &src->chunks[c];
+			sbitset_chunk_t       *res   = &dst->chunks[c];
+			res->index = chunk->index;
+			size_t first   = chunk->index * SBITSET_CHUNK_ELEMS;
+			size_t n_elems = BITSET_SIZE_ELEMS(dst->size);
+			for (size_t i = 0; i < SBITSET_CHUNK_ELEMS; ++i) {
+				unsigned word = first + i < n_elems ? dense[first + i] : 0;
+				res->bits[i] = word & chunk->bits[i];
+			}
+		}
+		dst->n_chunks = src->n_chunks;
+		free(dense);
+		compact_chunks(dst);
+		return;
+	}
+
+	for (size_t c = 0; c < dst->n_chunks; ++c) {
+		sbitset_chunk_t *chunk = &dst->chunks[c];
+		unsigned         bits[SBITSET_CHUNK_ELEMS];
+		get_chunk(src, chunk->index, bits);
+		rbitset_and(chunk->bits, bits, SBITSET_CHUNK_BITS);
+	}
+	compact_chunks(dst);
+}
+
+void sbitset_or(sbitset_t *dst, const sbitset_t *src)
+{
+	assert(dst->size == src->size);
+	if (src->dense != NULL) {
+		make_dense(dst);
+		rbitset_or(dst->dense, src->dense, dst->size);
+		return;
+	}
+
+	if (dst->dense != NULL) {
+		size_t n_elems = BITSET_SIZE_ELEMS(dst->size);
+		for (size_t c = 0; c < src->n_chunks; ++c) {
+			const sbitset_chunk_t *chunk = &src->chunks[c];
+			size_t first = chunk->index * SBITSET_CHUNK_ELEMS;
+			for (size_t i = 0; i < SBITSET_CHUNK_ELEMS && first + i < n_elems; ++i)
+				dst->dense[first + i] |= chunk->bits[i];
+		}
+		return;
+	}
+
+	/* merge both sorted chunk arrays */
+	size_t           n1     = dst->n_chunks;
+	size_t           n2     = src->n_chunks;
+	sbitset_chunk_t *merged = XMALLOCN(sbitset_chunk_t, n1 + n2 > 0 ? n1 + n2 : 1);
+	size_t           i1     = 0;
+	size_t           i2     = 0;
+	size_t           n      = 0;
+	while (i1 < n1 || i2 < n2) {
+		if (i2 == n2 || (i1 < n1 && dst->chunks[i1].index < src->chunks[i2].index)) {
+			merged[n++] = dst->chunks[i1++];
+		} else if (i1 == n1 || src->chunks[i2].index < dst->chunks[i1].index) {
+			merged[n++] = src->chunks[i2++];
+		} else {
+			merged[n] = dst->chunks[i1++];
+			rbitset_or(merged[n].bits, src->chunks[i2++].bits,
+			           SBITSET_CHUNK_BITS);
+			++n;
+		}
+	}
+	free(dst->chunks);
+	dst->chunks   = merged;
+	dst->n_chunks = n;
+	dst->capacity = n1 + n2 > 0 ? n1 + n2 : 1;
+	maybe_make_dense(dst);
+}
+
+void sbitset_andnot(sbitset_t *dst, const sbitset_t *src)
+{
+	assert(dst->size == src->size);
+	if (dst->dense != NULL) {
+		if (src->dense != NULL) {
+			rbitset_andnot(dst->dense, src->dense, dst->size);
+			return;
+		}
+		size_t n_elems = BITSET_SIZE_ELEMS(dst->size);
+		for (size_t c = 0; c < src->n_chunks; ++c) {
+			const sbitset_chunk_t *chunk = &src->chunks[c];
+			size_t first = chunk->index * SBITSET_CHUNK_ELEMS;
+			for (size_t i = 0; i < SBITSET_CHUNK_ELEMS && first + i < n_elems; ++i)
+				dst->dense[first + i] &= ~chunk->bits[i];
+		}
+		return;
+	}
+
+	for (size_t c = 0; c < dst->n_chunks; ++c) {
+		sbitset_chunk_t *chunk = &dst->chunks[c];
+		unsigned         bits[SBITSET_CHUNK_ELEMS];
+		get_chunk(src, chunk->index, bits);
+		rbitset_andnot(chunk->bits, bits, SBITSET_CHUNK_BITS);
+	}
+	compact_chunks(dst);
+}
+
+bool sbitsets_equal(const sbitset_t *set1, const sbitset_t *set2)
+{
+	assert(set1->size == set2->size);
+	if (set1->dense != NULL && set2->dense != NULL)
+		return rbitsets_equal(set1->dense, set2->dense, set1->size);
+	if (set1->dense == NULL && set2->dense == NULL) {
+		if (set1->n_chunks != set2->n_chunks)
+			return false;
+		return memcmp(set1->chunks, set2->chunks,
+		              set1->n_chunks * sizeof(set1->chunks[0])) == 0;
+	}
+
+	/* mixed representation: every sparse chunk must match the dense words
+	 * and the dense set must not have any other bits */
+	const sbitset_t *sparse = set1->dense == NULL ? set1 : set2;
+	const sbitset_t *dense  = set1->dense == NULL ? set2 : set1;
+	for (size_t c = 0; c < sparse->n_chunks; ++c) {
+		const sbitset_chunk_t *chunk = &sparse->chunks[c];
+		unsigned               bits[SBITSET_CHUNK_ELEMS];
+		dense_get_chunk(dense, chunk->index, bits);
+		if (!rbitsets_equal(chunk->bits, bits, SBITSET_CHUNK_BITS))
+			return false;
+	}
+	return sbitset_popcount(sparse) == sbitset_popcount(dense);
+}
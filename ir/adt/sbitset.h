@@ -0,0 +1,150 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   sparse bitsets for large universes
+ *
+ *     A sparse bitset stores only the chunks of SBITSET_CHUNK_BITS bits which
+ *     contain at least one set bit. The chunks are kept in an array sorted by
+ *     their chunk number, so lookups are a binary search and iteration is a
+ *     linear scan.
+ *
+ *     The representation is picked adaptively: once the chunk array would
+ *     need more memory than a raw bitset of the same universe, the set
+ *     switches to a dense raw bitset. Clearing the set returns it to the
+ *     sparse representation. Users do not need to care about the current
+ *     representation, all operations work on both.
+ *
+ *     Use these sets instead of raw bitsets when there are many sets over a
+ *     universe that is large compared to the number of set elements (typical
+ *     for per-block dataflow sets).
+ */
+#ifndef FIRM_ADT_SBITSET_H
+#define FIRM_ADT_SBITSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "raw_bitset.h"
+
+#define SBITSET_CHUNK_ELEMS 4
+#define SBITSET_CHUNK_BITS  (SBITSET_CHUNK_ELEMS * BITS_PER_ELEM)
+
+typedef struct sbitset_chunk_t {
+	size_t   index;                     /**< chunk number: pos / SBITSET_CHUNK_BITS */
+	unsigned bits[SBITSET_CHUNK_ELEMS]; /**< the bits of this chunk */
+} sbitset_chunk_t;
+
+typedef struct sbitset_t {
+	size_t           size;     /**< number of bits in the universe */
+	unsigned        *dense;    /**< raw bitset in dense mode, else NULL */
+	sbitset_chunk_t *chunks;   /**< sorted chunks in sparse mode */
+	size_t           n_chunks; /**< number of used chunks */
+	size_t           capacity; /**< number of allocated chunks */
+} sbitset_t;
+
+/**
+ * Initialize an empty sparse bitset.
+ *
+ * @param set   the bitset
+ * @param size  number of bits in the universe
+ */
+void sbitset_init(sbitset_t *set, size_t size);
+
+/**
+ * Free all memory held by a sparse bitset.
+ */
+void sbitset_free(sbitset_t *set);
+
+/**
+ * Set the bit at position pos.
+ */
+void sbitset_set(sbitset_t *set, size_t pos);
+
+/**
+ * Clear the bit at position pos.
+ */
+void sbitset_clear(sbitset_t *set, size_t pos);
+
+/**
+ * Set all bits of the universe. This switches the set to dense mode.
+ */
+void sbitset_set_all(sbitset_t *set);
+
+/**
+ * Clear all bits. This switches the set back to sparse mode.
+ */
+void sbitset_clear_all(sbitset_t *set);
+
+/**
+ * Check if the bit at position pos is set.
+ */
+bool sbitset_is_set(const sbitset_t *set, size_t pos);
+
+/**
+ * Returns the position of the next set bit starting from (and including)
+ * a given position.
+ *
+ * @param set  the bitset
+ * @param pos  the first position to check
+ *
+ * @return the first position where a set bit was found.
+ *         (size_t)-1 if no bit was found.
+ */
+size_t sbitset_next(const sbitset_t *set, size_t pos);
+
+/**
+ * Check if a bitset is empty, ie all bits cleared.
+ */
+bool sbitset_is_empty(const sbitset_t *set);
+
+/**
+ * Calculate the number of set bits (number of elements).
+ */
+size_t sbitset_popcount(const sbitset_t *set);
+
+/**
+ * Copy src into dst. Both sets must have the same size.
+ */
+void sbitset_copy(sbitset_t *dst, const sbitset_t *src);
+
+/**
+ * Inplace intersection of two sets.
+ */
+void sbitset_and(sbitset_t *dst, const sbitset_t *src);
+
+/**
+ * Inplace union of two sets.
+ */
+void sbitset_or(sbitset_t *dst, const sbitset_t *src);
+
+/**
+ * Remove all bits in src from dst.
+ */
+void sbitset_andnot(sbitset_t *dst, const sbitset_t *src);
+
+/**
+ * Returns true if two sets contain the same elements.
+ */
+bool sbitsets_equal(const sbitset_t *set1, const sbitset_t *set2);
+
+/**
+ * Returns true if the set currently uses the dense representation.
+ */
+static inline bool sbitset_is_dense(const sbitset_t *set)
+{
+	return set->dense != NULL;
+}
+
+/**
+ * Convenience macro for sparse bitset iteration.
+ * @param set  The bitset.
+ * @param elm  A size_t variable.
+ */
+#define sbitset_foreach(set, elm) \
+	for (size_t elm = 0; (elm = sbitset_next((set), elm)) != (size_t)-1; ++elm)
+
+#endif
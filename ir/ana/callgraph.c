@@ -25,6 +25,7 @@
 #include "pmap.h"
 #include "hashptr.h"
 #include "raw_bitset.h"
+#include "xmalloc.h"
 #include "panic.h"
 
 #include "irgwalk.h"
@@ -324,6 +325,115 @@ void callgraph_walk(callgraph_walk_func *pre, callgraph_walk_func *post, void *e
 	}
 }
 
+/** State of the component search of callgraph_run_bottom_up(). */
+typedef struct level_env_t {
+	size_t    *dfn;      /**< depth first number per graph index, 0 if new */
+	size_t    *low;      /**< smallest dfn reachable per graph index */
+	size_t    *level;    /**< level per graph index */
+	bool      *on_stack; /**< whether a graph is on the stack */
+	ir_graph **stack;    /**< graphs of unfinished components */
+	size_t     next_dfn;
+	size_t     max_level;
+} level_env_t;
+
+/**
+ * Tarjan's algorithm. When a component is finished, all components it calls
+ * are finished before, so its level can be computed right away.
+ */
+static void compute_level(level_env_t *env, ir_graph *irg)
+{
+	size_t const idx = get_irg_idx(irg);
+	env->dfn[idx] = env->low[idx] = ++env->next_dfn;
+	ARR_APP1(ir_graph*, env->stack, irg);
+	env->on_stack[idx] = true;
+
+	for (size_t i = 0, n = get_irg_n_callees(irg); i < n; ++i) {
+		ir_graph *const callee = get_irg_callee(irg, i);
+		size_t    const c_idx  = get_irg_idx(callee);
+		if (env->dfn[c_idx] == 0) {
+			compute_level(env, callee);
+			env->low[idx] = MIN(env->low[idx], env->low[c_idx]);
+		} else if (env->on_stack[c_idx]) {
+			env->low[idx] = MIN(env->low[idx], env->dfn[c_idx]);
+		}
+	}
+	if (env->low[idx] != env->dfn[idx])
+		return;
+
+	/* irg is the root of a component, which consists of irg and the graphs
+	 * above it on the stack. Callees still on the stack are in the component,
+	 * all others are finished. */
+	size_t start = ARR_LEN(env->stack);
+	do {
+		--start;
+	} while (env->stack[start] != irg);
+
+	size_t level = 0;
+	for (size_t m = start, n_stack = ARR_LEN(env->stack); m < n_stack; ++m) {
+		ir_graph *const member = env->stack[m];
+		for (size_t i = 0, n = get_irg_n_callees(member); i < n; ++i) {
+			size_t const c_idx = get_irg_idx(get_irg_callee(member, i));
+			if (!env->on_stack[c_idx])
+				level = MAX(level, env->level[c_idx] + 1);
+		}
+	}
+	for (size_t m = start, n_stack = ARR_LEN(env->stack); m < n_stack; ++m) {
+		size_t const m_idx = get_irg_idx(env->stack[m]);
+		env->level[m_idx]    = level;
+		env->on_stack[m_idx] = false;
+	}
+	ARR_SHRINKLEN(env->stack, start);
+	env->max_level = MAX(env->max_level, level);
+}
+
+void callgraph_run_bottom_up(callgraph_walk_func *const *const passes,
+                             size_t const n_passes, void *const env)
+{
+	assert(get_irp_callgraph_state() == irp_callgraph_consistent
+	    || get_irp_callgraph_state() == irp_callgraph_and_calltree_consistent);
+
+	size_t      const n_idx = get_irp_last_idx();
+	level_env_t       lenv;
+	lenv.dfn       = XMALLOCNZ(size_t, n_idx);
+	lenv.low       = XMALLOCNZ(size_t, n_idx);
+	lenv.level     = XMALLOCNZ(size_t, n_idx);
+	lenv.on_stack  = XMALLOCNZ(bool, n_idx);
+	lenv.stack     = NEW_ARR_F(ir_graph*, 0);
+	lenv.next_dfn  = 0;
+	lenv.max_level = 0;
+	foreach_irp_irg(i, irg) {
+		if (lenv.dfn[get_irg_idx(irg)] == 0)
+			compute_level(&lenv, irg);
+	}
+
+	/* Sort the graphs by level. Within a level keep the program order, so the
+	 * schedule does not depend on the order of the callee sets. */
+	size_t     const n_irgs = get_irp_n_irgs();
+	size_t    *const start  = XMALLOCNZ(size_t, lenv.max_level + 2);
+	ir_graph **const order  = XMALLOCN(ir_graph*, n_irgs);
+	foreach_irp_irg(i, irg) {
+		++start[lenv.level[get_irg_idx(irg)] + 1];
+	}
+	for (size_t l = 1; l <= lenv.max_level + 1; ++l)
+		start[l] += start[l - 1];
+	foreach_irp_irg(i, irg) {
+		order[start[lenv.level[get_irg_idx(irg)]]++] = irg;
+	}
+
+	for (size_t i = 0; i < n_irgs; ++i) {
+		for (size_t p = 0; p < n_passes; ++p)
+			passes[p](order[i], env);
+	}
+
+	free(order);
+	free(start);
+	DEL_ARR_F(lenv.stack);
+	free(lenv.on_stack);
+	free(lenv.level);
+	free(lenv.low);
+	free(lenv.dfn);
+}
+
 static ir_graph *outermost_ir_graph;   /**< The outermost graph the scc is computed
                                             for */
 static ir_loop *current_loop;      /**< Current cfloop construction is working
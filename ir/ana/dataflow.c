@@ -0,0 +1,117 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Worklist driven solver for block level dataflow problems.
+ */
+#include "dataflow.h"
+
+#include <string.h>
+
+#include "debug.h"
+#include "set.h"
+#include "dfs_t.h"
+#include "iredges_t.h"
+#include "irgraph_t.h"
+#include "irnode_t.h"
+#include "pqueue.h"
+#include "raw_bitset.h"
+#include "xmalloc.h"
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+typedef struct dataflow_env_t {
+	dataflow_problem_t const *problem;
+	dfs_t                    *dfs;
+	int                       n_blocks;
+	pqueue_t                 *worklist;
+	unsigned                 *queued;  /**< blocks currently in the worklist */
+	unsigned                 *visits;  /**< number of times a block was processed */
+} dataflow_env_t;
+
+/**
+ * Returns the position of a block in the processing order or -1 if the
+ * block was not reached by the depth first search.
+ */
+static int get_order(dataflow_env_t const *env, ir_node *block)
+{
+	dfs_node_t const *node = _dfs_get_node(env->dfs, block);
+	if (!node->visited)
+		return -1;
+	if (env->problem->direction == DATAFLOW_FORWARD)
+		return env->n_blocks - 1 - node->post_num;
+	return node->post_num;
+}
+
+static void enqueue(dataflow_env_t *env, ir_node *block)
+{
+	int order = get_order(env, block);
+	if (order < 0 || rbitset_is_set(env->queued, order))
+		return;
+	rbitset_set(env->queued, order);
+	/* the queue pops the highest priority first */
+	pqueue_put(env->worklist, block, -order);
+}
+
+static void enqueue_dependents(dataflow_env_t *env, ir_node *block)
+{
+	if (env->problem->direction == DATAFLOW_FORWARD) {
+		foreach_block_succ(block, edge) {
+			enqueue(env, get_edge_src_irn(edge));
+		}
+	} else {
+		for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+			ir_node *pred = get_Block_cfgpred_block(block, i);
+			if (pred != NULL && !is_Bad(pred))
+				enqueue(env, pred);
+		}
+	}
+}
+
+unsigned dataflow_solve(ir_graph *irg, dataflow_problem_t const *problem)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.ana.dataflow");
+
+	dataflow_env_t env;
+	env.problem  = problem;
+	env.dfs      = dfs_new(irg);
+	env.n_blocks = dfs_get_n_nodes(env.dfs);
+	env.worklist = new_pqueue();
+	env.queued   = rbitset_malloc(env.n_blocks);
+	env.visits   = XMALLOCNZ(unsigned, env.n_blocks);
+
+	for (int i = 0; i < env.n_blocks; ++i) {
+		enqueue(&env, dfs_get_post_num_node(env.dfs, i));
+	}
+
+	unsigned n_processed = 0;
+	while (!pqueue_empty(env.worklist)) {
+		ir_node *block = (ir_node*)pqueue_pop_front(env.worklist);
+		int      order = get_order(&env, block);
+		rbitset_clear(env.queued, order);
+
+		if (problem->max_visits != 0 && env.visits[order] >= problem->max_visits)
+			continue;
+		++env.visits[order];
+		++n_processed;
+
+		if (problem->meet != NULL)
+			problem->meet(block, problem->data);
+		if (problem->transfer(block, problem->data)) {
+			DB((dbg, LEVEL_2, "%+F changed\n", block));
+			enqueue_dependents(&env, block);
+		}
+	}
+
+	DB((dbg, LEVEL_1, "%+F: processed %u blocks for %d blocks\n", irg,
+	    n_processed, env.n_blocks));
+
+	free(env.visits);
+	free(env.queued);
+	del_pqueue(env.worklist);
+	dfs_free(env.dfs);
+	return n_processed;
+}
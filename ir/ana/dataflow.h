@@ -0,0 +1,73 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Worklist driven solver for block level dataflow problems.
+ *
+ * The solver does not know about the lattice itself: the client keeps the
+ * lattice values for each block and supplies a meet function (combining the
+ * values of the predecessors resp. successors into the block) and a transfer
+ * function (computing the value on the other side of the block and reporting
+ * whether it changed).
+ *
+ * Blocks are processed in reverse postorder (postorder for backward
+ * problems) of a depth first search of the CFG. A block is only
+ * re-processed if the value of one of its inputs changed. As the worklist
+ * always continues with the block that comes first in this order, a loop
+ * is iterated until it is stable before the blocks after it are visited
+ * again, so the work is proportional to the loop nesting instead of the
+ * number of blocks times the number of global iterations.
+ *
+ * The graph must have consistent block out edges.
+ */
+#ifndef FIRM_ANA_DATAFLOW_H
+#define FIRM_ANA_DATAFLOW_H
+
+#include <stdbool.h>
+#include "firm_types.h"
+
+typedef enum dataflow_direction_t {
+	DATAFLOW_FORWARD,  /**< information flows from predecessors to successors */
+	DATAFLOW_BACKWARD, /**< information flows from successors to predecessors */
+} dataflow_direction_t;
+
+/**
+ * Combine the values flowing into a block. For forward problems these are
+ * the values at the end of the predecessors, for backward problems the
+ * values at the begin of the successors.
+ */
+typedef void (*dataflow_meet_func)(ir_node *block, void *data);
+
+/**
+ * Apply the transfer function of a block.
+ *
+ * @return true if the value flowing out of the block changed, so the
+ *         dependent blocks have to be re-processed.
+ */
+typedef bool (*dataflow_transfer_func)(ir_node *block, void *data);
+
+typedef struct dataflow_problem_t {
+	dataflow_direction_t   direction;
+	dataflow_meet_func     meet;       /**< meet function, may be NULL if the
+	                                        transfer function does the meet */
+	dataflow_transfer_func transfer;   /**< transfer function */
+	unsigned               max_visits; /**< maximum number of times a block is
+	                                        processed, 0 for no limit */
+	void                  *data;       /**< passed to meet and transfer */
+} dataflow_problem_t;
+
+/**
+ * Solve a dataflow problem. Every block reachable from the start block
+ * (and the end block) is processed at least once.
+ *
+ * @param irg      the graph
+ * @param problem  the problem description
+ *
+ * @return the number of processed blocks
+ */
+unsigned dataflow_solve(ir_graph *irg, dataflow_problem_t const *problem);
+
+#endif
@@ -14,6 +14,8 @@
 #ifndef FIRM_ANA_DFS_H
 #define FIRM_ANA_DFS_H
 
+#include <stdio.h>
+
 #include "firm_types.h"
 
 typedef struct dfs_t      dfs_t;
@@ -17,6 +17,7 @@
 #include <stdbool.h>
 #include "hashptr.h"
 #include "dfs.h"
+#include "set.h"
 
 #define dfs_get_n_nodes(dfs)            ((dfs)->pre_num)
 #define dfs_get_pre_num(dfs, node)      (_dfs_get_node((dfs), (node))->pre_num)
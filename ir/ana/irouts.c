@@ -16,23 +16,25 @@
 #include "irprog_t.h"
 #include "irgwalk.h"
 #include "ircons.h"
+#include "util.h"
 
 unsigned get_irn_n_outs(const ir_node *node)
 {
-	return node->o.out->n_edges;
+	return get_irn_def_use_edges(node)->n_edges;
 }
 
 ir_node *get_irn_out(const ir_node *def, unsigned pos)
 {
 	assert(pos < get_irn_n_outs(def));
-	return def->o.out->edges[pos].use;
+	return get_irn_def_use_edges(def)->edges[pos].use;
 }
 
 ir_node *get_irn_out_ex(const ir_node *def, unsigned pos, int *in_pos)
 {
 	assert(pos < get_irn_n_outs(def));
-	*in_pos = def->o.out->edges[pos].pos;
-	return def->o.out->edges[pos].use;
+	ir_def_use_edges const *const outs = get_irn_def_use_edges(def);
+	*in_pos = outs->edges[pos].pos;
+	return outs->edges[pos].use;
 }
 
 unsigned get_Block_n_cfg_outs(const ir_node *bl)
@@ -226,46 +228,39 @@ void irg_out_block_walk(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
 /*--------------------------------------------------------------------*/
 
 
-/** Returns the amount of out edges for not yet visited successors. */
-static void count_outs_node(ir_node *n)
+/** Counts the out edges of not yet visited nodes in @p n_outs. */
+static void count_outs_node(ir_node *n, unsigned *n_outs)
 {
 	if (irn_visited_else_mark(n))
 		return;
 
-	/* initialize our counter */
-	n->o.n_outs = 0;
-
 	int start = is_Block(n) ? 0 : -1;
 	for (int i = start, irn_arity = get_irn_arity(n); i < irn_arity; ++i) {
 		ir_node *def = get_irn_n(n, i);
-		count_outs_node(def);
-		++def->o.n_outs;
+		count_outs_node(def, n_outs);
+		++n_outs[get_irn_idx(def)];
 	}
 }
 
 
-/** Returns the amount of out edges for not yet visited successors.
- *  This version handles some special nodes like irg_frame, irg_args etc. */
-static void count_outs(ir_graph *irg)
+/** Counts the out edges of all nodes in @p n_outs. Unreachable anchors like
+ *  irg_frame, irg_args etc. keep a count of zero. */
+static void count_outs(ir_graph *irg, unsigned *n_outs)
 {
 	inc_irg_visited(irg);
-	count_outs_node(get_irg_end(irg));
-	foreach_irn_in(get_irg_anchor(irg), i, n) {
-		if (irn_visited_else_mark(n))
-			continue;
-		n->o.n_outs = 0;
-	}
+	count_outs_node(get_irg_end(irg), n_outs);
 }
 
-static void set_out_edges_node(ir_node *node, struct obstack *obst)
+static void set_out_edges_node(ir_node *node, ir_def_use_edges **outs,
+                               unsigned const *n_outs, struct obstack *obst)
 {
 	if (irn_visited_else_mark(node))
 		return;
 
 	/* Allocate my array */
-	unsigned n_outs = node->o.n_outs;
-	node->o.out          = OALLOCF(obst, ir_def_use_edges, edges, n_outs);
-	node->o.out->n_edges = 0;
+	unsigned const idx = get_irn_idx(node);
+	outs[idx]          = OALLOCF(obst, ir_def_use_edges, edges, n_outs[idx]);
+	outs[idx]->n_edges = 0;
 
 	/* add def->use edges from my predecessors to me */
 	int start = is_Block(node) ? 0 : -1;
@@ -273,42 +268,67 @@ static void set_out_edges_node(ir_node *node, struct obstack *obst)
 		ir_node *def = get_irn_n(node, i);
 
 		/* recurse, ensures that out array of pred is already allocated */
-		set_out_edges_node(def, obst);
+		set_out_edges_node(def, outs, n_outs, obst);
 
 		/* Remember this Def-Use edge */
-		unsigned pos = def->o.out->n_edges++;
-		def->o.out->edges[pos].use = node;
-		def->o.out->edges[pos].pos = i;
+		ir_def_use_edges *const def_outs = outs[get_irn_idx(def)];
+		unsigned          const pos      = def_outs->n_edges++;
+		def_outs->edges[pos].use = node;
+		def_outs->edges[pos].pos = i;
 	}
 }
 
-static void set_out_edges(ir_graph *irg)
+static void set_out_edges(ir_graph *irg, unsigned const *n_outs)
 {
 	struct obstack *obst = &irg->out_obst;
 	obstack_init(obst);
 	irg->out_obst_allocated = true;
 
+	unsigned           const n_nodes = get_irg_last_idx(irg);
+	ir_def_use_edges **const outs    = OALLOCNZ(obst, ir_def_use_edges*, n_nodes);
+	irg->outs         = outs;
+	irg->n_outs_nodes = n_nodes;
+
 	inc_irg_visited(irg);
-	set_out_edges_node(get_irg_end(irg), obst);
+	set_out_edges_node(get_irg_end(irg), outs, n_outs, obst);
 	foreach_irn_in(get_irg_anchor(irg), i, n) {
 		if (irn_visited_else_mark(n))
 			continue;
-		n->o.out          = OALLOCF(obst, ir_def_use_edges, edges, 0);
-		n->o.out->n_edges = 0;
+		unsigned const idx = get_irn_idx(n);
+		outs[idx]          = OALLOCF(obst, ir_def_use_edges, edges, 0);
+		outs[idx]->n_edges = 0;
 	}
 }
 
+void set_irn_def_use_edges(ir_node *node, ir_def_use_edges *outs)
+{
+	ir_graph *const irg = get_irn_irg(node);
+	unsigned  const idx = get_irn_idx(node);
+	assert(irg->out_obst_allocated);
+	if (idx >= irg->n_outs_nodes) {
+		unsigned           const n_nodes = get_irg_last_idx(irg);
+		ir_def_use_edges **const table
+			= OALLOCNZ(&irg->out_obst, ir_def_use_edges*, n_nodes);
+		MEMCPY(table, irg->outs, irg->n_outs_nodes);
+		irg->outs         = table;
+		irg->n_outs_nodes = n_nodes;
+	}
+	irg->outs[idx] = outs;
+}
+
 void compute_irg_outs(ir_graph *irg)
 {
 	free_irg_outs(irg);
 
 	/* This first iteration counts the overall number of out edges and the
 	   number of out edges for each node. */
-	count_outs(irg);
+	unsigned *const n_outs = XMALLOCNZ(unsigned, get_irg_last_idx(irg));
+	count_outs(irg, n_outs);
 
 	/* The second iteration splits the irg->outs array into smaller arrays
 	   for each node and writes the back edges into this array. */
-	set_out_edges(irg);
+	set_out_edges(irg, n_outs);
+	free(n_outs);
 
 	add_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUTS);
 }
@@ -319,25 +339,12 @@ void assure_irg_outs(ir_graph *irg)
 		compute_irg_outs(irg);
 }
 
-#ifdef DEBUG_libfirm
-/** Clear the outs of a node */
-static void reset_outs(ir_node *node, void *unused)
-{
-	(void)unused;
-	node->o.out = NULL;
-}
-#endif
-
 void free_irg_outs(ir_graph *irg)
 {
 	if (irg->out_obst_allocated) {
 		obstack_free(&irg->out_obst, NULL);
 		irg->out_obst_allocated = false;
 	}
-
-#ifdef DEBUG_libfirm
-	/* when debugging, *always* reset all nodes' outs!  irg->outs might
-	   have been lying to us */
-	irg_walk_graph(irg, reset_outs, NULL, NULL);
-#endif
+	irg->outs         = NULL;
+	irg->n_outs_nodes = 0;
 }
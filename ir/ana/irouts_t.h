@@ -6,8 +6,28 @@
 #ifndef FIRM_ANA_IROUTS_T_H
 #define FIRM_ANA_IROUTS_T_H
 
+#include "irgraph_t.h"
+#include "irnode_t.h"
 #include "irouts.h"
 
+/**
+ * Returns the Def-Use array of a node. The arrays are kept in a table of the
+ * graph indexed by node index.
+ */
+static inline ir_def_use_edges *get_irn_def_use_edges(const ir_node *node)
+{
+	ir_graph const *const irg = get_irn_irg(node);
+	unsigned        const idx = get_irn_idx(node);
+	assert(idx < irg->n_outs_nodes && irg->outs[idx] != NULL);
+	return irg->outs[idx];
+}
+
+/**
+ * Sets the Def-Use array of a node, which may have been created after the
+ * outs were computed.
+ */
+void set_irn_def_use_edges(ir_node *node, ir_def_use_edges *outs);
+
 #define foreach_irn_out(irn, idx, succ) \
 	for (bool succ##__b = true; succ##__b;) \
 		for (ir_node const *const succ##__irn = (irn); succ##__b; succ##__b = false) \
@@ -287,6 +287,19 @@ my $x87store = {
 	mode      => "mode_M",
 };
 
+my $prefetchop = {
+	op_flags  => [ "uses_memory" ],
+	state     => "exc_pinned",
+	in_reqs   => "...",
+	out_reqs  => [ "mem" ],
+	outs      => [ "M" ],
+	attr_type => "amd64_addr_attr_t",
+	attr      => "x86_addr_t addr",
+	fixed     => "amd64_op_mode_t op_mode = AMD64_OP_ADDR;\n"
+	            ."x86_insn_size_t size    = X86_SIZE_8;\n",
+	emit      => "{name} %A",
+};
+
 %nodes = (
 push_am => {
 	op_flags  => [ "uses_memory" ],
@@ -526,6 +539,14 @@ mov_store => {
 	emit      => "mov%M %AM",
 },
 
+prefetcht0 => { template => $prefetchop },
+
+prefetcht1 => { template => $prefetchop },
+
+prefetcht2 => { template => $prefetchop },
+
+prefetchnta => { template => $prefetchop },
+
 jmp_switch => {
 	op_flags  => [ "cfopcode", "forking" ],
 	state     => "pinned",
@@ -3054,6 +3054,44 @@ static ir_node *gen_saturating_increment(ir_node *const node)
 	return sbb;
 }
 
+static ir_node *gen_prefetch(ir_node *const node)
+{
+	dbg_info *const dbgi     = get_irn_dbg_info(node);
+	ir_node  *const block    = be_transform_nodes_block(node);
+	ir_node  *const ptr      = get_Builtin_param(node, 0);
+	ir_node  *const hint     = get_Builtin_param(node, 2);
+	/* without a constant hint, assume high locality like GCC does */
+	long      const locality = is_Const(hint) ? get_Const_long(hint) : 3;
+	ir_node  *const mem      = get_Builtin_mem(node);
+	ir_node  *const new_mem  = be_transform_node(mem);
+
+	ir_node *in[3];
+	int arity = 0;
+	x86_addr_t addr;
+	perform_address_matching(ptr, &arity, in, &addr);
+	arch_register_req_t const **const reqs = gp_am_reqs[arity];
+	in[arity++] = new_mem;
+
+	/* the write hint is ignored, prefetchw is not available everywhere */
+	ir_node *new_node;
+	switch (locality) {
+	case 0:
+		new_node = new_bd_amd64_prefetchnta(dbgi, block, arity, in, reqs, addr);
+		break;
+	case 1:
+		new_node = new_bd_amd64_prefetcht2(dbgi, block, arity, in, reqs, addr);
+		break;
+	case 2:
+		new_node = new_bd_amd64_prefetcht1(dbgi, block, arity, in, reqs, addr);
+		break;
+	default:
+		new_node = new_bd_amd64_prefetcht0(dbgi, block, arity, in, reqs, addr);
+		break;
+	}
+	set_irn_pinned(new_node, get_irn_pinned(node));
+	return new_node;
+}
+
 static ir_node *gen_va_start(ir_node *const node)
 {
 	ir_graph *const irg   = get_irn_irg(node);
@@ -3080,6 +3118,8 @@ static ir_node *gen_Builtin(ir_node *const node)
 		return gen_compare_swap(node);
 	case ir_bk_saturating_increment:
 		return gen_saturating_increment(node);
+	case ir_bk_prefetch:
+		return gen_prefetch(node);
 	case ir_bk_va_start:
 		return gen_va_start(node);
 	default:
@@ -3110,6 +3150,7 @@ static ir_node *gen_Proj_Builtin(ir_node *const proj)
 		}
 	case ir_bk_saturating_increment:
 		return be_new_Proj(new_node, pn_amd64_sbb_res);
+	case ir_bk_prefetch:
 	case ir_bk_va_start:
 		assert(get_Proj_num(proj) == pn_Builtin_M);
 		return new_node;
@@ -231,13 +231,14 @@ static void arm_lower_for_target(void)
 		be_after_transform(irg, "lower-copyb");
 	}
 	if (arm_cg_config.fpu == ARM_FPU_SOFTFLOAT) {
-		lower_floating_point();
+		lower_floating_point(arm_cg_config.inline_softfloat);
 		be_after_irp_transform("lower-fp");
 	}
 
-	ir_builtin_kind supported[1];
+	ir_builtin_kind supported[2];
 	size_t s = 0;
 	supported[s++] = ir_bk_clz;
+	supported[s++] = ir_bk_prefetch;
 	assert(s <= ARRAY_SIZE(supported));
 	lower_builtins(s, supported);
 	be_after_irp_transform("lower-builtins");
@@ -352,6 +353,7 @@ static lc_opt_enum_int_var_t arch_var = {
 static const lc_opt_table_entry_t arm_options[] = {
 	LC_OPT_ENT_ENUM_INT("fpu", "select the floating point unit", &arch_fpu_var),
 	LC_OPT_ENT_ENUM_INT("arch", "select architecture variant", &arch_var),
+	LC_OPT_ENT_BOOL("inline-softfloat", "expand common soft float cases inline", &arm_cg_config.inline_softfloat),
 	LC_OPT_LAST
 };
 
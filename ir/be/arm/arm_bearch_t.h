@@ -45,6 +45,7 @@ typedef struct arm_codegen_config_t {
 	arm_variant_t     variant;
 	arm_fpu_variant_t fpu;
 	bool              big_endian;
+	bool              inline_softfloat;
 } arm_codegen_config_t;
 
 extern arm_codegen_config_t arm_cg_config;
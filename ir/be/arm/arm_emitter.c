@@ -223,7 +223,8 @@ static unsigned get_unique_label(void)
 
 static void emit_constant_name(const ent_or_tv_t *entry)
 {
-	be_emit_irprintf("%sC%u", be_gas_get_private_prefix(), entry->label);
+	be_emit_irprintf("%sC%u%s", be_gas_get_private_prefix(), entry->label,
+	                 be_gas_get_label_scope());
 }
 
 void arm_emitf(const ir_node *node, const char *format, ...)
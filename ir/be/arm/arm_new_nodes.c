@@ -37,7 +37,7 @@ static bool arm_has_address_attr(const ir_node *node)
 static bool has_load_store_attr(const ir_node *node)
 {
 	return is_arm_Ldr(node) || is_arm_Str(node) || is_arm_LinkLdrPC(node)
-		|| is_arm_Ldf(node) || is_arm_Stf(node);
+		|| is_arm_Ldf(node) || is_arm_Stf(node) || is_arm_Pld(node);
 }
 
 static bool has_shifter_operand(const ir_node *node)
@@ -1381,6 +1381,28 @@ static ir_node *gen_clz(ir_node *node)
 	return new_bd_arm_Clz(dbg, block, new_op);
 }
 
+static ir_node *gen_prefetch(ir_node *node)
+{
+	ir_node *mem     = get_Builtin_mem(node);
+	ir_node *new_mem = be_transform_node(mem);
+	/* pld needs ARMv5TE, which has no variant of its own, so it is only used
+	 * from ARMv6 on */
+	if (arm_cg_config.variant < ARM_VARIANT_6)
+		return new_mem;
+
+	ir_node  *block = be_transform_nodes_block(node);
+	ir_node  *ptr   = get_Builtin_param(node, 0);
+	arm_am_t  am    = transform_am(ptr, arm_mode_gp, false);
+	/* the frame is cached anyway and its offsets are not final yet */
+	if (am.is_frame_entity)
+		return new_mem;
+
+	dbg_info *dbgi = get_irn_dbg_info(node);
+	ir_node  *pld  = new_bd_arm_Pld(dbgi, block, am.base, new_mem, arm_mode_gp, NULL, 0, am.offset, false);
+	set_irn_pinned(pld, get_irn_pinned(node));
+	return pld;
+}
+
 /**
  * Transform Builtin node.
  */
@@ -1392,9 +1414,10 @@ static ir_node *gen_Builtin(ir_node *node)
 	case ir_bk_debugbreak:
 	case ir_bk_return_address:
 	case ir_bk_frame_address:
-	case ir_bk_prefetch:
 	case ir_bk_ffs:
 		break;
+	case ir_bk_prefetch:
+		return gen_prefetch(node);
 	case ir_bk_clz:
 		return gen_clz(node);
 	case ir_bk_ctz:
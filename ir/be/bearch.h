@@ -290,7 +290,22 @@ struct arch_isa_if_t {
 
 	ir_jit_function_t* (*jit_compile)(ir_jit_segment_t *segment, ir_graph *irg);
 
-	void (*emit_function)(char *buffer, ir_jit_function_t *function);
+	/**
+	 * Emits @p function into @p buffer, which is executed at @p address.
+	 */
+	void (*emit_function)(char *buffer, char const *address,
+	                      ir_jit_function_t *function);
+
+	/** size of a call-through stub for jit compiled code, see be_jit_emit_stub() */
+	unsigned jit_stub_size;
+
+	/**
+	 * Writes a call-through stub for jit compiled code into @p buffer. See
+	 * be_jit_emit_stub() for details.
+	 */
+	void (*emit_jit_stub)(char *buffer, char const *address,
+	                      void const *const *target, int32_t *counter,
+	                      void (*resolve)(void *data), void *data);
 
 	/**
 	 * lowers current program for target. See the documentation for
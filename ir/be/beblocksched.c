@@ -18,10 +18,18 @@
  * to change as many edges to fallthroughs as possible, this is done by setting
  * a next and prev pointers on blocks. The greedy algorithm sorts the edges by
  * execution frequencies and tries to transform them to fallthroughs in this order
+ *
+ * The ext-tsp layout additionally rewards short forward and backward jumps,
+ * which stay within the same cache lines: Chains of blocks are merged greedily
+ * by the gain in the extended TSP score of Newell and Pupyrev, "Improved Basic
+ * Block Reordering", 2020.
  */
 #include "beblocksched.h"
 
+#include <string.h>
+
 #include "bearch.h"
+#include "begnuas.h"
 #include "beirg.h"
 #include "bemodule.h"
 #include "besched.h"
@@ -31,11 +39,38 @@
 #include "irgmod.h"
 #include "irgwalk.h"
 #include "irnode_t.h"
+#include "irtools.h"
+#include "lc_opts.h"
+#include "lc_opts_enum.h"
 #include "pdeq.h"
 #include "util.h"
 
 DEBUG_ONLY(static firm_dbg_module_t *dbg = NULL;)
 
+typedef enum blocksched_algo_t {
+	BLOCKSCHED_GREEDY,
+	BLOCKSCHED_EXTTSP,
+} blocksched_algo_t;
+
+static double cold_freq = 0.0;
+static int    algo      = BLOCKSCHED_GREEDY;
+
+static const lc_opt_enum_int_items_t algo_items[] = {
+	{ "greedy", BLOCKSCHED_GREEDY },
+	{ "exttsp", BLOCKSCHED_EXTTSP },
+	{ NULL,     0 }
+};
+
+static lc_opt_enum_int_var_t algo_var = {
+	&algo, algo_items
+};
+
+static const lc_opt_table_entry_t be_blocksched_options[] = {
+	LC_OPT_ENT_ENUM_INT("algo", "block layout algorithm", &algo_var),
+	LC_OPT_ENT_DBL("coldfreq", "emit blocks executed less often than this per function call into a separate section (0 disables)", &cold_freq),
+	LC_OPT_LAST
+};
+
 static bool blocks_removed;
 
 /**
@@ -137,11 +172,19 @@ static void remove_empty_blocks(ir_graph *irg)
 		clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE);
 }
 
+typedef struct chain_t chain_t;
+typedef struct jump_t  jump_t;
+
 typedef struct blocksched_entry_t blocksched_entry_t;
 struct blocksched_entry_t {
 	ir_node            *block;
 	blocksched_entry_t *next;
 	blocksched_entry_t *prev;
+	/* only used by the ext-tsp layout */
+	chain_t            *chain; /**< chain containing the block */
+	jump_t             *jumps; /**< outgoing control flow edges */
+	unsigned            size;  /**< estimated code size in bytes */
+	unsigned            addr;  /**< address in the layout being evaluated */
 };
 
 typedef struct edge_t edge_t;
@@ -164,6 +207,7 @@ struct blocksched_env_t {
 	edge_t         *edges;
 	deq_t           worklist;
 	unsigned        blockcount;
+	blocksched_entry_t **layout; /**< blocks for the ext-tsp layout */
 };
 
 static blocksched_entry_t* get_blocksched_entry(const ir_node *block)
@@ -407,6 +451,396 @@ static void coalesce_blocks(blocksched_env_t *env)
 	}
 }
 
+/* Parameters of the ext-tsp score, see Newell and Pupyrev. */
+#define FALLTHROUGH_WEIGHT   1.0
+#define FORWARD_WEIGHT       0.1
+#define BACKWARD_WEIGHT      0.1
+#define FORWARD_DISTANCE     1024
+#define BACKWARD_DISTANCE    640
+/** chains up to this length are tried to be split when merging */
+#define CHAIN_SPLIT_THRESHOLD 128
+/** assumed size of an instruction in bytes */
+#define INSN_SIZE            4
+
+struct jump_t {
+	blocksched_entry_t *target;
+	double              freq;
+};
+
+typedef struct chain_edge_t chain_edge_t;
+
+struct chain_t {
+	blocksched_entry_t **blocks; /**< blocks in layout order */
+	chain_edge_t       **edges;  /**< chains connected by jumps */
+	unsigned             id;     /**< for deterministic tie breaking */
+	unsigned             size;   /**< code size of all blocks */
+	double               freq;   /**< sum of the block frequencies */
+	double               score;  /**< ext-tsp score of the jumps inside */
+	bool                 entry;  /**< contains the start block */
+};
+
+typedef enum merge_kind_t {
+	MERGE_X1_Y_X2,
+	MERGE_Y_X2_X1,
+	MERGE_X2_X1_Y,
+	MERGE_X2_Y_X1,
+} merge_kind_t;
+
+/** Connects two chains and caches the best way to merge them. */
+struct chain_edge_t {
+	chain_t      *chains[2];
+	bool          valid;  /**< the cached merge below is up to date */
+	double        gain;
+	chain_t      *x;      /**< the chain which is split */
+	size_t        split;  /**< number of blocks in X1 */
+	merge_kind_t  kind;
+};
+
+typedef struct segment_t {
+	blocksched_entry_t **blocks;
+	size_t               n;
+} segment_t;
+
+static double jump_score(blocksched_entry_t const *const src,
+                         jump_t const *const jump)
+{
+	unsigned const src_end  = src->addr + src->size;
+	unsigned const dst_addr = jump->target->addr;
+	if (dst_addr == src_end)
+		return jump->freq * FALLTHROUGH_WEIGHT;
+	if (dst_addr > src_end) {
+		unsigned const dist = dst_addr - src_end;
+		if (dist < FORWARD_DISTANCE)
+			return jump->freq * FORWARD_WEIGHT
+			     * (1.0 - (double)dist / FORWARD_DISTANCE);
+	} else {
+		unsigned const dist = src_end - dst_addr;
+		if (dist < BACKWARD_DISTANCE)
+			return jump->freq * BACKWARD_WEIGHT
+			     * (1.0 - (double)dist / BACKWARD_DISTANCE);
+	}
+	return 0.0;
+}
+
+/**
+ * Computes the score of the jumps inside the chains x and y when laying them
+ * out in the order given by the segments.
+ */
+static double score_segments(segment_t const *const segs, size_t const n_segs,
+                             chain_t const *const x, chain_t const *const y)
+{
+	unsigned addr = 0;
+	for (size_t s = 0; s < n_segs; ++s) {
+		for (size_t i = 0; i < segs[s].n; ++i) {
+			blocksched_entry_t *const entry = segs[s].blocks[i];
+			entry->addr = addr;
+			addr       += entry->size;
+		}
+	}
+
+	double score = 0.0;
+	for (size_t s = 0; s < n_segs; ++s) {
+		for (size_t i = 0; i < segs[s].n; ++i) {
+			blocksched_entry_t const *const entry = segs[s].blocks[i];
+			for (size_t j = 0, n = ARR_LEN(entry->jumps); j < n; ++j) {
+				jump_t const *const jump  = &entry->jumps[j];
+				chain_t const      *chain = jump->target->chain;
+				if (chain == x || chain == y)
+					score += jump_score(entry, jump);
+			}
+		}
+	}
+	return score;
+}
+
+/** Arranges the parts of x, split after the first split blocks, and y. */
+static size_t get_merge_segments(segment_t *const segs, chain_t const *const x,
+                                 chain_t const *const y, size_t const split,
+                                 merge_kind_t const kind)
+{
+	segment_t const x1 = { x->blocks, split };
+	segment_t const x2 = { x->blocks + split, ARR_LEN(x->blocks) - split };
+	segment_t const yy = { y->blocks, ARR_LEN(y->blocks) };
+	switch (kind) {
+	case MERGE_X1_Y_X2: segs[0] = x1; segs[1] = yy; segs[2] = x2; break;
+	case MERGE_Y_X2_X1: segs[0] = yy; segs[1] = x2; segs[2] = x1; break;
+	case MERGE_X2_X1_Y: segs[0] = x2; segs[1] = x1; segs[2] = yy; break;
+	case MERGE_X2_Y_X1: segs[0] = x2; segs[1] = yy; segs[2] = x1; break;
+	}
+	/* the start block has to stay in front */
+	if (x->entry || y->entry) {
+		blocksched_entry_t const *const first
+			= segs[0].n > 0 ? segs[0].blocks[0] : segs[1].blocks[0];
+		if (first->block != get_irg_start_block(get_irn_irg(first->block)))
+			return 0;
+	}
+	return 3;
+}
+
+static void try_merges(chain_edge_t *const edge, chain_t *const x,
+                       chain_t *const y)
+{
+	size_t const n     = ARR_LEN(x->blocks);
+	size_t const first = n <= CHAIN_SPLIT_THRESHOLD ? 1 : n;
+	for (size_t split = first; split <= n; ++split) {
+		for (merge_kind_t kind = MERGE_X1_Y_X2; kind <= MERGE_X2_Y_X1; ++kind) {
+			segment_t    segs[3];
+			size_t const n_segs = get_merge_segments(segs, x, y, split, kind);
+			if (n_segs == 0)
+				continue;
+			double const gain = score_segments(segs, n_segs, x, y)
+			                  - x->score - y->score;
+			if (gain > edge->gain) {
+				edge->gain  = gain;
+				edge->x     = x;
+				edge->split = split;
+				edge->kind  = kind;
+			}
+		}
+	}
+}
+
+static void compute_merge_gain(chain_edge_t *const edge)
+{
+	edge->gain  = 0.0;
+	edge->x     = NULL;
+	edge->valid = true;
+	try_merges(edge, edge->chains[0], edge->chains[1]);
+	try_merges(edge, edge->chains[1], edge->chains[0]);
+}
+
+static chain_t *get_other_chain(chain_edge_t const *const edge,
+                                chain_t const *const chain)
+{
+	return edge->chains[0] == chain ? edge->chains[1] : edge->chains[0];
+}
+
+static chain_edge_t *find_chain_edge(chain_t const *const chain,
+                                     chain_t const *const other)
+{
+	for (size_t i = 0, n = ARR_LEN(chain->edges); i < n; ++i) {
+		chain_edge_t *const edge = chain->edges[i];
+		if (get_other_chain(edge, chain) == other)
+			return edge;
+	}
+	return NULL;
+}
+
+static void remove_chain_edge(chain_t *const chain,
+                              chain_edge_t const *const edge)
+{
+	size_t const n = ARR_LEN(chain->edges);
+	for (size_t i = 0; i < n; ++i) {
+		if (chain->edges[i] == edge) {
+			chain->edges[i] = chain->edges[n - 1];
+			ARR_SHRINKLEN(chain->edges, n - 1);
+			return;
+		}
+	}
+	panic("chain edge not found");
+}
+
+/** Merges the chain y into the chain x of the edge as described by it. */
+static void merge_chains(chain_edge_t *const edge)
+{
+	chain_t *const x = edge->x;
+	chain_t *const y = get_other_chain(edge, x);
+	DB((dbg, LEVEL_2, "Merge chains %+F and %+F (gain %.3g)\n",
+	    x->blocks[0]->block, y->blocks[0]->block, edge->gain));
+
+	segment_t segs[3];
+	get_merge_segments(segs, x, y, edge->split, edge->kind);
+	blocksched_entry_t **const blocks
+		= NEW_ARR_F(blocksched_entry_t*, ARR_LEN(x->blocks) + ARR_LEN(y->blocks));
+	size_t n = 0;
+	for (size_t s = 0; s < ARRAY_SIZE(segs); ++s) {
+		memcpy(&blocks[n], segs[s].blocks, segs[s].n * sizeof(*blocks));
+		n += segs[s].n;
+	}
+	for (size_t i = 0, n_y = ARR_LEN(y->blocks); i < n_y; ++i)
+		y->blocks[i]->chain = x;
+
+	x->score += y->score + edge->gain;
+	x->size  += y->size;
+	x->freq  += y->freq;
+	x->entry |= y->entry;
+	x->id     = MIN(x->id, y->id);
+	DEL_ARR_F(x->blocks);
+	x->blocks = blocks;
+
+	/* move the edges of y over to x */
+	remove_chain_edge(x, edge);
+	for (size_t i = 0, n_edges = ARR_LEN(y->edges); i < n_edges; ++i) {
+		chain_edge_t *const y_edge = y->edges[i];
+		if (y_edge == edge)
+			continue;
+		chain_t *const other = get_other_chain(y_edge, y);
+		if (find_chain_edge(x, other) != NULL) {
+			remove_chain_edge(other, y_edge);
+		} else {
+			y_edge->chains[y_edge->chains[0] == y ? 0 : 1] = x;
+			ARR_APP1(chain_edge_t*, x->edges, y_edge);
+		}
+	}
+	DEL_ARR_F(y->blocks);
+	DEL_ARR_F(y->edges);
+	y->blocks = NULL;
+	y->edges  = NULL;
+
+	for (size_t i = 0, n_edges = ARR_LEN(x->edges); i < n_edges; ++i)
+		x->edges[i]->valid = false;
+}
+
+static void collect_layout_block(ir_node *block, void *data)
+{
+	blocksched_env_t *const env = (blocksched_env_t*)data;
+	if (block == get_irg_end_block(env->irg))
+		return;
+
+	unsigned n_insns = 0;
+	sched_foreach(block, node) {
+		if (!is_Phi(node))
+			++n_insns;
+	}
+
+	blocksched_entry_t *const entry = get_blocksched_entry(block);
+	entry->size  = MAX(n_insns, 1) * INSN_SIZE;
+	entry->jumps = NEW_ARR_F(jump_t, 0);
+	ARR_APP1(blocksched_entry_t*, env->layout, entry);
+}
+
+/**
+ * Estimates the frequency of the control flow edge from the pos-th
+ * predecessor into block. Critical edges are split at this point, so either
+ * the predecessor has a single successor or the block a single predecessor.
+ */
+static double get_edge_freq(ir_node const *const block, int const pos)
+{
+	ir_node *const pred_block = get_Block_cfgpred_block(block, pos);
+	double   const freq       = get_block_execfreq(block);
+	if (get_Block_n_cfgpreds(block) == 1)
+		return freq;
+	double const pred_freq = get_block_execfreq(pred_block);
+	if (get_block_succ_next(pred_block, get_block_succ_first(pred_block)) == NULL)
+		return pred_freq;
+	return MIN(freq, pred_freq);
+}
+
+static int cmp_chains(const void *d1, const void *d2)
+{
+	chain_t const *const c1 = *(chain_t const**)d1;
+	chain_t const *const c2 = *(chain_t const**)d2;
+	if (c1->entry != c2->entry)
+		return c1->entry ? -1 : 1;
+	double const density1 = c1->freq / c1->size;
+	double const density2 = c2->freq / c2->size;
+	if (density1 != density2)
+		return density1 > density2 ? -1 : 1;
+	return c1->id < c2->id ? -1 : c1->id > c2->id ? 1 : 0;
+}
+
+/**
+ * Lays out the blocks by merging chains of blocks, which maximizes the number
+ * of fallthroughs and short jumps weighted by their execution frequencies.
+ * The resulting order is stored in the next and prev links of the entries.
+ */
+static void ext_tsp_layout(blocksched_env_t *const env)
+{
+	ir_graph *const irg = env->irg;
+	env->layout = NEW_ARR_F(blocksched_entry_t*, 0);
+	irg_block_walk_graph(irg, collect_layout_block, NULL, env);
+
+	size_t   const n_blocks = ARR_LEN(env->layout);
+	chain_t *const chains   = OALLOCNZ(&env->obst, chain_t, n_blocks);
+	for (size_t i = 0; i < n_blocks; ++i) {
+		blocksched_entry_t *const entry = env->layout[i];
+		chain_t            *const chain = &chains[i];
+		chain->blocks = NEW_ARR_F(blocksched_entry_t*, 1);
+		chain->blocks[0] = entry;
+		chain->edges  = NEW_ARR_F(chain_edge_t*, 0);
+		chain->id     = i;
+		chain->size   = entry->size;
+		chain->freq   = get_block_execfreq(entry->block);
+		chain->entry  = entry->block == get_irg_start_block(irg);
+		entry->chain  = chain;
+	}
+
+	/* collect the jumps and connect the chains of their blocks */
+	for (size_t i = 0; i < n_blocks; ++i) {
+		blocksched_entry_t *const entry = env->layout[i];
+		ir_node            *const block = entry->block;
+		for (int p = 0, arity = get_Block_n_cfgpreds(block); p < arity; ++p) {
+			if (is_Bad(get_Block_cfgpred(block, p)))
+				continue;
+			ir_node *const pred_block = get_Block_cfgpred_block(block, p);
+			if (pred_block == block)
+				continue;
+			blocksched_entry_t *const pred_entry = get_blocksched_entry(pred_block);
+			jump_t const jump = { entry, get_edge_freq(block, p) };
+			ARR_APP1(jump_t, pred_entry->jumps, jump);
+
+			chain_t *const chain      = entry->chain;
+			chain_t *const pred_chain = pred_entry->chain;
+			if (find_chain_edge(chain, pred_chain) != NULL)
+				continue;
+			chain_edge_t *const edge = OALLOCZ(&env->obst, chain_edge_t);
+			edge->chains[0] = pred_chain;
+			edge->chains[1] = chain;
+			ARR_APP1(chain_edge_t*, pred_chain->edges, edge);
+			ARR_APP1(chain_edge_t*, chain->edges, edge);
+		}
+	}
+
+	/* merge the pair of chains with the highest gain until nothing improves */
+	for (;;) {
+		chain_edge_t *best = NULL;
+		for (size_t i = 0; i < n_blocks; ++i) {
+			chain_t *const chain = &chains[i];
+			if (chain->blocks == NULL)
+				continue;
+			for (size_t e = 0, n = ARR_LEN(chain->edges); e < n; ++e) {
+				chain_edge_t *const edge = chain->edges[e];
+				if (get_other_chain(edge, chain) < chain)
+					continue;
+				if (!edge->valid)
+					compute_merge_gain(edge);
+				if (edge->x != NULL && (best == NULL || edge->gain > best->gain))
+					best = edge;
+			}
+		}
+		if (best == NULL)
+			break;
+		merge_chains(best);
+	}
+
+	/* concatenate the chains, the entry first and dense chains early */
+	chain_t **order = NEW_ARR_F(chain_t*, 0);
+	for (size_t i = 0; i < n_blocks; ++i) {
+		if (chains[i].blocks != NULL)
+			ARR_APP1(chain_t*, order, &chains[i]);
+	}
+	QSORT_ARR(order, cmp_chains);
+
+	blocksched_entry_t *prev = NULL;
+	for (size_t c = 0, n_chains = ARR_LEN(order); c < n_chains; ++c) {
+		chain_t *const chain = order[c];
+		for (size_t i = 0, n = ARR_LEN(chain->blocks); i < n; ++i) {
+			blocksched_entry_t *const entry = chain->blocks[i];
+			entry->prev = prev;
+			if (prev != NULL)
+				prev->next = entry;
+			prev = entry;
+		}
+		DEL_ARR_F(chain->blocks);
+		DEL_ARR_F(chain->edges);
+	}
+	DEL_ARR_F(order);
+
+	for (size_t i = 0; i < n_blocks; ++i)
+		DEL_ARR_F(env->layout[i]->jumps);
+	DEL_ARR_F(env->layout);
+}
+
 static void pick_block_successor(blocksched_entry_t *entry, blocksched_env_t *env)
 {
 	ir_node *const block = entry->block;
@@ -531,6 +965,52 @@ static ir_node **create_blocksched_array(blocksched_env_t *const env)
 	return block_list;
 }
 
+static bool is_cold_block(ir_node const *const block)
+{
+	if (get_block_execfreq(block) >= cold_freq
+	 || block == get_irg_start_block(get_irn_irg(block)))
+		return false;
+
+	/* jump tables may address their targets relative to the table */
+	for (int i = get_Block_n_cfgpreds(block); i-- > 0;) {
+		ir_node *const pred = get_Block_cfgpred(block, i);
+		if (is_Proj(pred) && arch_get_irn_n_outs(get_Proj_pred(pred)) > 2)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Moves the rarely executed blocks to the end of the block schedule, so they
+ * can be emitted into a separate section and do not dilute the hot code.
+ */
+static void split_cold_blocks(ir_graph *const irg, ir_node **const block_list)
+{
+	be_irg_t *const birg = be_birg_from_irg(irg);
+	birg->first_cold_block = NULL;
+	if (cold_freq <= 0.0 || !be_gas_can_split_function(get_irg_entity(irg)))
+		return;
+
+	ir_node **cold_list = NEW_ARR_F(ir_node*, 0);
+	size_t    n_hot     = 0;
+	for (size_t i = 0, n = ARR_LEN(block_list); i < n; ++i) {
+		ir_node *const block = block_list[i];
+		if (is_cold_block(block))
+			ARR_APP1(ir_node*, cold_list, block);
+		else
+			block_list[n_hot++] = block;
+	}
+
+	size_t const n_cold = ARR_LEN(cold_list);
+	if (n_cold > 0) {
+		memcpy(&block_list[n_hot], cold_list, n_cold * sizeof(*cold_list));
+		birg->first_cold_block = cold_list[0];
+		DB((dbg, LEVEL_1, "%zu cold blocks starting at %+F\n", n_cold,
+		    cold_list[0]));
+	}
+	DEL_ARR_F(cold_list);
+}
+
 ir_node **be_create_block_schedule(ir_graph *irg)
 {
 	blocksched_env_t env = {
@@ -548,10 +1028,14 @@ ir_node **be_create_block_schedule(ir_graph *irg)
 
 	remove_empty_blocks(irg);
 
-	coalesce_blocks(&env);
+	if (algo == BLOCKSCHED_EXTTSP)
+		ext_tsp_layout(&env);
+	else
+		coalesce_blocks(&env);
 
 	ir_node **const block_list = create_blocksched_array(&env);
 	ir_free_resources(irg, IR_RESOURCE_IRN_LINK);
+	split_cold_blocks(irg, block_list);
 
 	DEL_ARR_F(env.edges);
 	obstack_free(&env.obst, NULL);
@@ -562,5 +1046,9 @@ ir_node **be_create_block_schedule(ir_graph *irg)
 BE_REGISTER_MODULE_CONSTRUCTOR(be_init_blocksched)
 void be_init_blocksched(void)
 {
+	lc_opt_entry_t *be_grp         = lc_opt_get_grp(firm_opt_get_root(), "be");
+	lc_opt_entry_t *blocksched_grp = lc_opt_get_grp(be_grp, "blocksched");
+	lc_opt_add_table(blocksched_grp, be_blocksched_options);
+
 	FIRM_DBG_REGISTER(dbg, "firm.be.blocksched");
 }
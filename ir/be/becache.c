@@ -0,0 +1,185 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   On-disk cache for the assembler code of unchanged functions.
+ *
+ * The key of a function combines the fingerprint of its graph, the execution
+ * frequencies of its blocks, whether it is hot and the values of all options,
+ * so a hit replays exactly the code the backend would emit. Local labels get
+ * the function name appended while the cache is active, so the code of a
+ * function does not depend on the functions emitted before it. Functions
+ * referencing entities created by the backend, e.g. float constants or jump
+ * tables, are not cached because a replay would not create these entities
+ * again.
+ */
+#include "becache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "be_t.h"
+#include "bediagnostic.h"
+#include "beemitter.h"
+#include "befuncorder.h"
+#include "begnuas.h"
+#include "entity_t.h"
+#include "execfreq.h"
+#include "firm_common.h"
+#include "hashptr.h"
+#include "irflag_t.h"
+#include "irgwalk.h"
+#include "irio.h"
+#include "irprog_t.h"
+#include "irtools.h"
+#include "lc_opts.h"
+#include "obst.h"
+
+static bool               active;
+static bool               cacheable;
+static bool               warned;
+/** number of the first entity created by the backend */
+static long               first_backend_nr;
+static unsigned long long options_hash;
+static char               path[sizeof(be_options.cache_dir) + 32];
+static struct obstack     obst;
+
+void be_cache_init(void)
+{
+	active = be_options.cache_dir[0] != '\0';
+	if (!active)
+		return;
+
+	obstack_init(&obst);
+	obstack_printf(&obst, "libfirm %u.%u.%u %s\nopt %x\n",
+	               ir_get_version_major(), ir_get_version_minor(),
+	               ir_get_version_micro(), ir_get_version_revision(),
+	               libFIRM_opt);
+	lc_opt_append_values(firm_opt_get_root(), &obst);
+	size_t const size    = obstack_object_size(&obst);
+	char  *const options = (char*)obstack_finish(&obst);
+	options_hash = hash_data64(HASH64_START, options, size);
+	obstack_free(&obst, options);
+
+	first_backend_nr = irp->max_node_nr;
+}
+
+void be_cache_finish(void)
+{
+	if (!active)
+		return;
+	obstack_free(&obst, NULL);
+	active = false;
+}
+
+static void hash_block_execfreq(ir_node *block, void *data)
+{
+	unsigned long long *const hash = (unsigned long long*)data;
+	double              const freq = get_block_execfreq(block);
+	*hash = hash_data64(*hash, &freq, sizeof(freq));
+}
+
+static bool read_fragment(void)
+{
+	FILE *const file = fopen(path, "rb");
+	if (file == NULL)
+		return false;
+
+	char   buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), file)) > 0)
+		obstack_grow(&obst, buf, n);
+	bool   const ok   = !ferror(file);
+	size_t const size = obstack_object_size(&obst);
+	char  *const text = (char*)obstack_finish(&obst);
+	fclose(file);
+
+	if (ok) {
+		be_emit_string_len(text, size);
+		be_emit_write_line();
+	}
+	obstack_free(&obst, text);
+	return ok;
+}
+
+bool be_cache_replay(ir_graph *const irg)
+{
+	if (!active)
+		return false;
+
+	unsigned long long const fingerprint = ir_graph_fingerprint(irg);
+	unsigned long long       key
+		= hash_data64(options_hash, &fingerprint, sizeof(fingerprint));
+	irg_block_walk_graph(irg, hash_block_execfreq, NULL, &key);
+	bool const hot = be_is_hot_function(get_irg_entity(irg));
+	key = hash_data64(key, &hot, sizeof(hot));
+	snprintf(path, sizeof(path), "%s/%016llx.s", be_options.cache_dir, key);
+
+	/* cached code starts with its section and may end in any section */
+	be_gas_forget_section();
+	if (read_fragment()) {
+		be_gas_forget_section();
+		return true;
+	}
+
+	cacheable = true;
+	be_gas_set_label_scope(get_irg_entity(irg));
+	be_emit_capture(&obst);
+	return false;
+}
+
+static void write_fragment(char const *const text, size_t const size)
+{
+	/* write to a temporary file first and rename it, so concurrent compilers
+	 * never read a partial fragment. The name of the temporary file is unique
+	 * to this process, so compilers writing the same fragment at once do not
+	 * write into the same file. */
+	static unsigned n_tmp_files;
+	char tmp_path[sizeof(path) + 32];
+	snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.%u.tmp", path,
+	         (long)getpid(), n_tmp_files++);
+	FILE *const file = fopen(tmp_path, "wb");
+	bool        ok   = false;
+	if (file != NULL) {
+		fwrite(text, 1, size, file);
+		bool const written = !ferror(file);
+		ok = fclose(file) == 0 && written && rename(tmp_path, path) == 0;
+		if (!ok)
+			remove(tmp_path);
+	}
+	if (!ok && !warned) {
+		be_warningf(NULL, "could not write code cache file '%s'", path);
+		warned = true;
+	}
+}
+
+void be_cache_store(void)
+{
+	if (!active)
+		return;
+
+	be_emit_capture(NULL);
+	be_gas_set_label_scope(NULL);
+
+	size_t const size = obstack_object_size(&obst);
+	char  *const text = (char*)obstack_finish(&obst);
+	if (cacheable)
+		write_fragment(text, size);
+	obstack_free(&obst, text);
+}
+
+void be_cache_disable_function(void)
+{
+	cacheable = false;
+}
+
+void be_cache_check_entity(ir_entity const *const entity)
+{
+	if (entity->kind == IR_ENTITY_LABEL
+	 || get_entity_nr(entity) >= first_backend_nr)
+		cacheable = false;
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   On-disk cache for the assembler code of unchanged functions.
+ */
+#ifndef FIRM_BE_BECACHE_H
+#define FIRM_BE_BECACHE_H
+
+#include <stdbool.h>
+
+#include "firm_types.h"
+
+/**
+ * Activates the cache if a cache directory is set. Entities created after
+ * this call are considered to be created by the backend.
+ */
+void be_cache_init(void);
+
+/**
+ * Deactivates the cache.
+ */
+void be_cache_finish(void);
+
+/**
+ * Emits the cached code of @p irg if there is any. Otherwise starts to
+ * capture the code emitted for it.
+ *
+ * @return true if the cached code was emitted
+ */
+bool be_cache_replay(ir_graph *irg);
+
+/**
+ * Stops capturing and stores the captured code unless the function was marked
+ * as not cacheable.
+ */
+void be_cache_store(void);
+
+/**
+ * Marks the function currently being emitted as not cacheable.
+ */
+void be_cache_disable_function(void);
+
+/**
+ * Checks whether code referencing @p entity can be cached.
+ */
+void be_cache_check_entity(ir_entity const *entity);
+
+#endif
@@ -13,6 +13,7 @@
 #include <assert.h>
 
 #include "bearch.h"
+#include "becache.h"
 #include "bedwarf_t.h"
 #include "panic.h"
 #include "obst.h"
@@ -71,6 +72,12 @@ typedef enum custom_abbrevs {
 	abbrev_void_subroutine_type,
 } custom_abbrevs;
 
+/** A register saved in the callframe. */
+typedef struct callframe_spill_t {
+	const arch_register_t *reg;
+	int                    offset;
+} callframe_spill_t;
+
 /**
  * The dwarf handle.
  */
@@ -86,6 +93,12 @@ typedef struct dwarf_t {
 	const char       *curr_file;    /**< name of the current source file */
 	unsigned          label_num;
 	unsigned          last_line;
+	/* callframe state of the current function, restated for its cold part */
+	const arch_register_t *cfa_reg;
+	int                    cfa_offset;
+	bool                   has_cfa_offset;
+	callframe_spill_t     *spills;
+	bool                   split;  /**< the cold part has been started */
 } dwarf_t;
 
 static dwarf_t               env;
@@ -322,6 +335,7 @@ void be_dwarf_callframe_register(const arch_register_t *reg)
 	be_emit_cstring("\t.cfi_def_cfa_register ");
 	be_emit_irprintf("%d\n", reg->dwarf_number);
 	be_emit_write_line();
+	env.cfa_reg = reg;
 }
 
 void be_dwarf_callframe_offset(int offset)
@@ -331,6 +345,8 @@ void be_dwarf_callframe_offset(int offset)
 	be_emit_cstring("\t.cfi_def_cfa_offset ");
 	be_emit_irprintf("%d\n", offset);
 	be_emit_write_line();
+	env.cfa_offset     = offset;
+	env.has_cfa_offset = true;
 }
 
 void be_dwarf_callframe_spilloffset(const arch_register_t *reg, int offset)
@@ -340,6 +356,8 @@ void be_dwarf_callframe_spilloffset(const arch_register_t *reg, int offset)
 	be_emit_cstring("\t.cfi_offset ");
 	be_emit_irprintf("%d, %d\n", reg->dwarf_number, offset);
 	be_emit_write_line();
+	callframe_spill_t const spill = { reg, offset };
+	ARR_APP1(callframe_spill_t, env.spills, spill);
 }
 
 static bool is_extern_entity(const ir_entity *entity)
@@ -461,6 +479,8 @@ void be_dwarf_function_before(const ir_entity *entity,
 	if (debug_level < LEVEL_BASIC)
 		return;
 
+	/* the debug info refers to files and types of the whole unit */
+	be_cache_disable_function();
 	be_gas_emit_switch_section(GAS_SECTION_DEBUG_INFO);
 
 	ir_type *type   = get_entity_type(entity);
@@ -506,15 +526,23 @@ void be_dwarf_function_begin(void)
 		return;
 	be_emit_cstring("\t.cfi_startproc\n");
 	be_emit_write_line();
+	env.cfa_reg        = NULL;
+	env.has_cfa_offset = false;
+	ARR_SHRINKLEN(env.spills, 0);
 }
 
 void be_dwarf_function_end(void)
 {
 	if (debug_level < LEVEL_BASIC)
 		return;
-	const ir_entity *entity = env.cur_ent;
-	be_emit_irprintf("%sfunction_end_%s:\n", be_gas_get_private_prefix(),
-	                 get_entity_ld_name(entity));
+	/* the subprogram only covers the hot part of a split function */
+	if (env.split) {
+		env.split = false;
+	} else {
+		const ir_entity *entity = env.cur_ent;
+		be_emit_irprintf("%sfunction_end_%s:\n", be_gas_get_private_prefix(),
+		                 get_entity_ld_name(entity));
+	}
 
 	if (debug_level >= LEVEL_FRAMEINFO) {
 		be_emit_cstring("\t.cfi_endproc\n");
@@ -522,6 +550,42 @@ void be_dwarf_function_end(void)
 	}
 }
 
+void be_dwarf_function_hot_end(void)
+{
+	if (debug_level < LEVEL_BASIC)
+		return;
+	be_dwarf_function_end();
+	env.split = true;
+}
+
+void be_dwarf_function_cold_begin(void)
+{
+	if (debug_level < LEVEL_FRAMEINFO)
+		return;
+	/* the cold part is a separate frame description entry, which starts with
+	 * the state of the hot part */
+	be_emit_cstring("\t.cfi_startproc\n");
+	be_emit_write_line();
+	if (env.cfa_reg != NULL && env.has_cfa_offset) {
+		be_emit_irprintf("\t.cfi_def_cfa %d, %d\n", env.cfa_reg->dwarf_number,
+		                 env.cfa_offset);
+		be_emit_write_line();
+	} else if (env.cfa_reg != NULL) {
+		be_emit_irprintf("\t.cfi_def_cfa_register %d\n",
+		                 env.cfa_reg->dwarf_number);
+		be_emit_write_line();
+	} else if (env.has_cfa_offset) {
+		be_emit_irprintf("\t.cfi_def_cfa_offset %d\n", env.cfa_offset);
+		be_emit_write_line();
+	}
+	for (size_t i = 0, n = ARR_LEN(env.spills); i < n; ++i) {
+		callframe_spill_t const *const spill = &env.spills[i];
+		be_emit_irprintf("\t.cfi_offset %d, %d\n", spill->reg->dwarf_number,
+		                 spill->offset);
+		be_emit_write_line();
+	}
+}
+
 static void emit_base_type_abbrev(void)
 {
 	begin_abbrev(abbrev_base_type, DW_TAG_base_type, DW_CHILDREN_no);
@@ -929,6 +993,7 @@ void be_dwarf_close(void)
 	pmap_destroy(env.file_map);
 	DEL_ARR_F(env.file_list);
 	DEL_ARR_F(env.pubnames_list);
+	DEL_ARR_F(env.spills);
 	pset_new_destroy(&env.emitted_types);
 }
 
@@ -940,6 +1005,7 @@ void be_dwarf_open(void)
 	env.file_map      = pmap_create();
 	env.file_list     = NEW_ARR_F(const char*, 0);
 	env.pubnames_list = NEW_ARR_F(const ir_entity*, 0);
+	env.spills        = NEW_ARR_F(callframe_spill_t, 0);
 	pset_new_init(&env.emitted_types);
 }
 
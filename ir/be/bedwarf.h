@@ -39,6 +39,11 @@ void be_dwarf_function_begin(void);
 
 /** debug for a function end */
 void be_dwarf_function_end(void);
+/** debug info at the end of the hot part of a function split into two
+ * sections */
+void be_dwarf_function_hot_end(void);
+/** debug info at the beginning of the cold part of a split function */
+void be_dwarf_function_cold_begin(void);
 
 /** dump a variable in the global type */
 void be_dwarf_variable(const ir_entity *ent);
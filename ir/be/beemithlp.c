@@ -14,6 +14,7 @@
 #include "beemitter.h"
 #include "be_t.h"
 #include "begnuas.h"
+#include "beirg.h"
 #include "benode.h"
 #include "dbginfo.h"
 #include "debug.h"
@@ -74,7 +75,10 @@ void be_emit_init_cf_links(ir_node **const block_schedule)
 			set_irn_link(pred, block);
 		}
 
-		/* initialize pred block links */
+		/* initialize pred block links, the cold part is emitted into another
+		 * section, so nothing falls through into it */
+		if (block == be_birg_from_irg(get_irn_irg(block))->first_cold_block)
+			prev = NULL;
 		set_irn_link(block, prev);
 		prev = block;
 	}
@@ -14,8 +14,9 @@
 #include "panic.h"
 #include "irprintf.h"
 
-static FILE    *emit_file;
-struct obstack  emit_obst;
+static FILE           *emit_file;
+static struct obstack *emit_capture;
+struct obstack         emit_obst;
 
 void be_emit_init(FILE *file)
 {
@@ -46,5 +47,12 @@ void be_emit_write_line(void)
 	size_t const len  = obstack_object_size(&emit_obst);
 	char  *const line = (char*)obstack_finish(&emit_obst);
 	fwrite(line, 1, len, emit_file);
+	if (emit_capture != NULL)
+		obstack_grow(emit_capture, line, len);
 	obstack_free(&emit_obst, line);
 }
+
+void be_emit_capture(struct obstack *obst)
+{
+	emit_capture = obst;
+}
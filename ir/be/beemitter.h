@@ -90,6 +90,12 @@ void be_emit_irvprintf(const char *fmt, va_list args);
  */
 void be_emit_write_line(void);
 
+/**
+ * Additionally appends all lines written from now on to @p obst. Pass NULL
+ * to stop capturing.
+ */
+void be_emit_capture(struct obstack *obst);
+
 /** Return column in current line. Counting starts at 0. */
 static inline size_t be_emit_get_column(void)
 {
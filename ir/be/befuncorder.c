@@ -0,0 +1,335 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Ordering of the emitted functions by their call relations.
+ *
+ * Implements the call-chain clustering of Ottoni and Maher, "Optimizing
+ * Function Placement for Large-Scale Data-Center Applications", 2017: The
+ * functions are visited by decreasing number of calls and the cluster of each
+ * function is appended to the cluster of its most frequent caller, as long as
+ * the result fits into a page. The clusters are emitted by decreasing density.
+ * The call counts come from the profile if there is one and are estimated from
+ * the execution frequencies of the calling blocks otherwise.
+ */
+#include "befuncorder.h"
+
+#include "bemodule.h"
+#include "debug.h"
+#include "entity_t.h"
+#include "execfreq.h"
+#include "irgwalk.h"
+#include "irnode_t.h"
+#include "irprofile.h"
+#include "irprog_t.h"
+#include "irtools.h"
+#include "lc_opts.h"
+#include "lc_opts_enum.h"
+#include "pmap.h"
+#include "pset.h"
+#include "util.h"
+
+/** merged clusters must not get larger than this many bytes */
+#define MAX_CLUSTER_SIZE       4096
+/** merging must not reduce the density of the caller cluster more */
+#define MAX_DENSITY_DEGRADATION 8.0
+/** the hot functions account for this fraction of all calls */
+#define HOT_CALL_FRACTION      0.99
+/** assumed size of an IR node in bytes */
+#define NODE_SIZE              4
+
+typedef enum funcorder_algo_t {
+	FUNCORDER_NONE,
+	FUNCORDER_C3,
+} funcorder_algo_t;
+
+typedef struct cluster_t cluster_t;
+
+typedef struct call_arc_t {
+	struct function_t *caller;
+	double             count;
+} call_arc_t;
+
+typedef struct function_t {
+	ir_graph   *irg;
+	cluster_t  *cluster;
+	call_arc_t *callers; /**< callers with their number of calls */
+	size_t      pos;     /**< position in the original order */
+	unsigned    size;    /**< estimated code size in bytes */
+	double      heat;    /**< number of calls */
+} function_t;
+
+struct cluster_t {
+	function_t **functions;
+	unsigned     size;
+	double       heat;
+};
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg = NULL;)
+
+static int   algo = FUNCORDER_NONE;
+static pset *hot_functions;
+
+static const lc_opt_enum_int_items_t algo_items[] = {
+	{ "none", FUNCORDER_NONE },
+	{ "c3",   FUNCORDER_C3   },
+	{ NULL,   0 }
+};
+
+static lc_opt_enum_int_var_t algo_var = {
+	&algo, algo_items
+};
+
+static const lc_opt_table_entry_t be_funcorder_options[] = {
+	LC_OPT_ENT_ENUM_INT("algo", "function ordering algorithm", &algo_var),
+	LC_OPT_LAST
+};
+
+typedef struct collect_env_t {
+	pmap       *functions; /**< maps entities to their function_t */
+	function_t *function;
+	bool        have_profile;
+	unsigned    n_nodes;
+} collect_env_t;
+
+static double get_block_count(ir_node const *const block,
+                              bool const have_profile)
+{
+	if (have_profile)
+		return ir_profile_get_block_execcount(block);
+	return get_block_execfreq(block);
+}
+
+static void collect_calls(ir_node *node, void *data)
+{
+	collect_env_t *const env = (collect_env_t*)data;
+	++env->n_nodes;
+	if (!is_Call(node))
+		return;
+
+	ir_entity *const callee = get_Call_callee(node);
+	if (callee == NULL)
+		return;
+	function_t *const function = pmap_get(function_t, env->functions, callee);
+	if (function == NULL || function == env->function)
+		return;
+
+	double const count = get_block_count(get_nodes_block(node),
+	                                     env->have_profile);
+	function->heat += count;
+	for (size_t i = 0, n = ARR_LEN(function->callers); i < n; ++i) {
+		if (function->callers[i].caller == env->function) {
+			function->callers[i].count += count;
+			return;
+		}
+	}
+	call_arc_t const arc = { env->function, count };
+	ARR_APP1(call_arc_t, function->callers, arc);
+}
+
+static double get_density(cluster_t const *const cluster)
+{
+	return cluster->heat / cluster->size;
+}
+
+static int cmp_functions_heat(const void *d1, const void *d2)
+{
+	function_t const *const f1 = *(function_t const**)d1;
+	function_t const *const f2 = *(function_t const**)d2;
+	if (f1->heat != f2->heat)
+		return f1->heat > f2->heat ? -1 : 1;
+	return f1->pos < f2->pos ? -1 : f1->pos > f2->pos ? 1 : 0;
+}
+
+static int cmp_clusters(const void *d1, const void *d2)
+{
+	cluster_t const *const c1 = *(cluster_t const**)d1;
+	cluster_t const *const c2 = *(cluster_t const**)d2;
+	double const density1 = get_density(c1);
+	double const density2 = get_density(c2);
+	if (density1 != density2)
+		return density1 > density2 ? -1 : 1;
+	size_t const pos1 = c1->functions[0]->pos;
+	size_t const pos2 = c2->functions[0]->pos;
+	return pos1 < pos2 ? -1 : pos1 > pos2 ? 1 : 0;
+}
+
+static function_t *get_hottest_caller(function_t const *const function)
+{
+	function_t *caller = NULL;
+	double      count  = 0.0;
+	for (size_t i = 0, n = ARR_LEN(function->callers); i < n; ++i) {
+		call_arc_t const *const arc = &function->callers[i];
+		if (arc->count > count) {
+			count  = arc->count;
+			caller = arc->caller;
+		}
+	}
+	return caller;
+}
+
+static void merge_clusters(cluster_t *const into, cluster_t *const cluster)
+{
+	for (size_t i = 0, n = ARR_LEN(cluster->functions); i < n; ++i) {
+		function_t *const function = cluster->functions[i];
+		function->cluster = into;
+		ARR_APP1(function_t*, into->functions, function);
+	}
+	into->size += cluster->size;
+	into->heat += cluster->heat;
+	DEL_ARR_F(cluster->functions);
+	cluster->functions = NULL;
+}
+
+/**
+ * Marks the functions receiving most of the calls as hot.
+ */
+static void mark_hot_functions(function_t **const by_heat, size_t const n)
+{
+	double total = 0.0;
+	for (size_t i = 0; i < n; ++i)
+		total += by_heat[i]->heat;
+
+	double sum = 0.0;
+	for (size_t i = 0; i < n && sum < total * HOT_CALL_FRACTION; ++i) {
+		function_t const *const function = by_heat[i];
+		if (function->heat <= 0.0)
+			break;
+		sum += function->heat;
+		pset_insert_ptr(hot_functions, get_irg_entity(function->irg));
+		DB((dbg, LEVEL_2, "hot function %+F (%.3g calls)\n", function->irg,
+		    function->heat));
+	}
+}
+
+void be_order_functions(bool const have_profile)
+{
+	be_free_function_order();
+	size_t const n_irgs = get_irp_n_irgs();
+	if (algo == FUNCORDER_NONE || n_irgs == 0)
+		return;
+	hot_functions = pset_new_ptr_default();
+
+	function_t *const functions = XMALLOCNZ(function_t, n_irgs);
+	cluster_t  *const clusters  = XMALLOCNZ(cluster_t, n_irgs);
+	collect_env_t     env       = {
+		.functions    = pmap_create(),
+		.have_profile = have_profile,
+	};
+	for (size_t i = 0; i < n_irgs; ++i) {
+		function_t *const function = &functions[i];
+		function->irg     = get_irp_irg(i);
+		function->cluster = &clusters[i];
+		function->callers = NEW_ARR_F(call_arc_t, 0);
+		function->pos     = i;
+		pmap_insert(env.functions, get_irg_entity(function->irg), function);
+	}
+
+	for (size_t i = 0; i < n_irgs; ++i) {
+		function_t *const function = &functions[i];
+		ir_graph   *const irg      = function->irg;
+		env.function = function;
+		env.n_nodes  = 0;
+		irg_walk_graph(irg, collect_calls, NULL, &env);
+		function->size = MAX(env.n_nodes, 1) * NODE_SIZE;
+
+		/* the profile also knows about calls from outside */
+		if (have_profile) {
+			double const entries = get_block_count(get_irg_start_block(irg),
+			                                       have_profile);
+			function->heat = MAX(function->heat, entries);
+		}
+	}
+
+	for (size_t i = 0; i < n_irgs; ++i) {
+		function_t *const function = &functions[i];
+		cluster_t  *const cluster  = &clusters[i];
+		cluster->functions    = NEW_ARR_F(function_t*, 1);
+		cluster->functions[0] = function;
+		cluster->size         = function->size;
+		cluster->heat         = function->heat;
+	}
+
+	function_t **const by_heat = NEW_ARR_F(function_t*, n_irgs);
+	for (size_t i = 0; i < n_irgs; ++i)
+		by_heat[i] = &functions[i];
+	QSORT_ARR(by_heat, cmp_functions_heat);
+
+	for (size_t i = 0; i < n_irgs; ++i) {
+		function_t *const function = by_heat[i];
+		function_t *const caller   = get_hottest_caller(function);
+		if (caller == NULL)
+			continue;
+
+		cluster_t *const cluster        = function->cluster;
+		cluster_t *const caller_cluster = caller->cluster;
+		if (cluster == caller_cluster
+		 || cluster->size + caller_cluster->size > MAX_CLUSTER_SIZE)
+			continue;
+		double const merged_density = (cluster->heat + caller_cluster->heat)
+		                            / (cluster->size + caller_cluster->size);
+		if (merged_density * MAX_DENSITY_DEGRADATION
+		    < get_density(caller_cluster))
+			continue;
+
+		DB((dbg, LEVEL_2, "append cluster of %+F to cluster of %+F\n",
+		    function->irg, caller->irg));
+		merge_clusters(caller_cluster, cluster);
+	}
+
+	mark_hot_functions(by_heat, n_irgs);
+
+	cluster_t **order = NEW_ARR_F(cluster_t*, 0);
+	for (size_t i = 0; i < n_irgs; ++i) {
+		if (clusters[i].functions != NULL)
+			ARR_APP1(cluster_t*, order, &clusters[i]);
+	}
+	QSORT_ARR(order, cmp_clusters);
+
+	size_t pos = 0;
+	for (size_t c = 0, n_clusters = ARR_LEN(order); c < n_clusters; ++c) {
+		cluster_t *const cluster = order[c];
+		for (size_t i = 0, n = ARR_LEN(cluster->functions); i < n; ++i) {
+			ir_graph *const irg = cluster->functions[i]->irg;
+			DB((dbg, LEVEL_1, "function %zu: %+F\n", pos, irg));
+			set_irp_irg(pos++, irg);
+		}
+		DEL_ARR_F(cluster->functions);
+	}
+	assert(pos == n_irgs);
+
+	DEL_ARR_F(order);
+	DEL_ARR_F(by_heat);
+	for (size_t i = 0; i < n_irgs; ++i)
+		DEL_ARR_F(functions[i].callers);
+	pmap_destroy(env.functions);
+	free(clusters);
+	free(functions);
+}
+
+void be_free_function_order(void)
+{
+	if (hot_functions != NULL) {
+		del_pset(hot_functions);
+		hot_functions = NULL;
+	}
+}
+
+bool be_is_hot_function(ir_entity const *const entity)
+{
+	return hot_functions != NULL
+	    && pset_find_ptr(hot_functions, entity) != NULL;
+}
+
+BE_REGISTER_MODULE_CONSTRUCTOR(be_init_funcorder)
+void be_init_funcorder(void)
+{
+	lc_opt_entry_t *be_grp        = lc_opt_get_grp(firm_opt_get_root(), "be");
+	lc_opt_entry_t *funcorder_grp = lc_opt_get_grp(be_grp, "funcorder");
+	lc_opt_add_table(funcorder_grp, be_funcorder_options);
+
+	FIRM_DBG_REGISTER(dbg, "firm.be.funcorder");
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Ordering of the emitted functions by their call relations.
+ */
+#ifndef FIRM_BE_BEFUNCORDER_H
+#define FIRM_BE_BEFUNCORDER_H
+
+#include <stdbool.h>
+
+#include "firm_types.h"
+
+/**
+ * Reorders the graphs of the program, so functions calling each other
+ * frequently are emitted next to each other, and determines the hot
+ * functions. Requires the execution frequencies of all graphs.
+ *
+ * @param have_profile  use the profiled execution counts of the blocks
+ */
+void be_order_functions(bool have_profile);
+
+/**
+ * Frees the information about the hot functions.
+ */
+void be_free_function_order(void);
+
+/**
+ * Checks whether @p entity was determined to be a hot function, which is
+ * emitted into a separate section.
+ */
+bool be_is_hot_function(ir_entity const *entity);
+
+#endif
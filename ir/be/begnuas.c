@@ -16,8 +16,11 @@
 
 #include "be_t.h"
 #include "bearch.h"
+#include "becache.h"
 #include "beemithlp.h"
 #include "beemitter.h"
+#include "befuncorder.h"
+#include "beirg.h"
 #include "bemodule.h"
 #include "betranshlp.h"
 #include "dbginfo.h"
@@ -44,8 +47,11 @@ bool                        be_gas_emit_types         = true;
 char                        be_gas_elf_type_char      = '@';
 
 static be_gas_section_t current_section = (be_gas_section_t) -1;
+static char const      *label_scope     = "";
 static pmap            *block_numbers;
 static unsigned         next_block_nr;
+static ir_entity const *cold_function; /**< function whose cold part started */
+static be_gas_section_t text_section = GAS_SECTION_TEXT; /**< section of the current function */
 
 static bool is_macho(void)
 {
@@ -145,6 +151,8 @@ static const elf_sectioninfo_t elf_sectioninfos[] = {
 	[GAS_SECTION_DEBUG_LINE]     = { "debug_line",        "progbits", ""   },
 	[GAS_SECTION_DEBUG_PUBNAMES] = { "debug_pubnames",    "progbits", ""   },
 	[GAS_SECTION_DEBUG_FRAME]    = { "debug_frame",       "progbits", ""   },
+	[GAS_SECTION_TEXT_UNLIKELY]  = { "text.unlikely",     "progbits", "ax" },
+	[GAS_SECTION_TEXT_HOT]       = { "text.hot",          "progbits", "ax" },
 };
 
 static void emit_section_sparc(be_gas_section_t section,
@@ -524,6 +532,21 @@ static be_gas_section_t determine_section(be_main_env_t const *const main_env, i
 	panic("couldn't determine section for %+F", entity);
 }
 
+/**
+ * Determines the section of a function, which is the hot text section for
+ * hot functions unless they are COMDAT.
+ */
+static be_gas_section_t determine_function_section(ir_entity const *const entity)
+{
+	be_gas_section_t const section = determine_section(NULL, entity);
+	if (section == GAS_SECTION_TEXT
+	 && be_gas_object_file_format == OBJECT_FILE_FORMAT_ELF
+	 && be_gas_elf_variant != ELF_VARIANT_SPARC
+	 && be_is_hot_function(entity))
+		return GAS_SECTION_TEXT_HOT;
+	return section;
+}
+
 static void emit_symbol_directive(const char *directive,
 								  const ir_entity *entity)
 {
@@ -605,8 +628,10 @@ void be_gas_emit_function_prolog(const ir_entity *entity, unsigned po2alignment,
 {
 	be_dwarf_function_before(entity, parameter_infos);
 
-	be_gas_section_t const section = determine_section(NULL, entity);
+	be_gas_section_t const section = determine_function_section(entity);
 	emit_section(section, entity);
+	if (section == GAS_SECTION_TEXT_HOT)
+		text_section = section;
 
 	/* write the begin line (makes the life easier for scripts parsing the
 	 * assembler) */
@@ -652,10 +677,51 @@ void be_gas_emit_function_prolog(const ir_entity *entity, unsigned po2alignment,
 	be_dwarf_function_begin();
 }
 
+bool be_gas_can_split_function(ir_entity const *const entity)
+{
+	return be_gas_object_file_format == OBJECT_FILE_FORMAT_ELF
+	    && be_gas_elf_variant != ELF_VARIANT_SPARC
+	    && determine_section(NULL, entity) == GAS_SECTION_TEXT;
+}
+
+/**
+ * Continues the current function in the section for rarely executed code.
+ * The cold part gets its own symbol and call frame information.
+ */
+static void emit_cold_part_begin(ir_entity const *const entity)
+{
+	be_dwarf_function_hot_end();
+	emit_section(GAS_SECTION_TEXT_UNLIKELY, entity);
+
+	be_emit_cstring("\t.type\t");
+	be_gas_emit_entity(entity);
+	be_emit_irprintf(".cold, %cfunction\n", be_gas_elf_type_char);
+	be_emit_write_line();
+	be_gas_emit_entity(entity);
+	be_emit_cstring(".cold:\n");
+	be_emit_write_line();
+
+	be_dwarf_function_cold_begin();
+	cold_function = entity;
+}
+
 void be_gas_emit_function_epilog(ir_entity const *const entity)
 {
 	be_dwarf_function_end();
 
+	if (cold_function == entity) {
+		be_emit_cstring("\t.size\t");
+		be_gas_emit_entity(entity);
+		be_emit_cstring(".cold, .-");
+		be_gas_emit_entity(entity);
+		be_emit_cstring(".cold\n");
+		be_emit_write_line();
+		/* the size of the hot part is computed in its own section */
+		emit_section(determine_function_section(entity), entity);
+		cold_function = NULL;
+	}
+	text_section = GAS_SECTION_TEXT;
+
 	if (be_gas_object_file_format == OBJECT_FILE_FORMAT_ELF) {
 		be_emit_cstring("\t.size\t");
 		be_gas_emit_entity(entity);
@@ -1290,6 +1356,22 @@ char const *be_gas_get_private_prefix(void)
 	return is_macho() ? "L" : ".L";
 }
 
+void be_gas_set_label_scope(ir_entity const *const function)
+{
+	label_scope = function != NULL
+		? get_id_str(new_id_fmt(".%s", get_entity_ld_name(function))) : "";
+}
+
+char const *be_gas_get_label_scope(void)
+{
+	return label_scope;
+}
+
+void be_gas_forget_section(void)
+{
+	current_section = (be_gas_section_t)-1;
+}
+
 static bool check_needs_quotes(char const *const s)
 {
 	if (is_macho()) {
@@ -1303,6 +1385,7 @@ static bool check_needs_quotes(char const *const s)
 
 void be_gas_emit_entity(const ir_entity *entity)
 {
+	be_cache_check_entity(entity);
 	if (entity->kind == IR_ENTITY_LABEL) {
 		ir_label_t label = get_entity_label(entity);
 		be_emit_irprintf("%s_%lu", be_gas_get_private_prefix(), label);
@@ -1334,12 +1417,17 @@ void be_gas_emit_block_name(const ir_node *block)
 		} else {
 			nr = PTR_TO_INT(nr_val) - 1;
 		}
-		be_emit_irprintf("%s%d", be_gas_get_private_prefix(), nr);
+		be_emit_irprintf("%s%d%s", be_gas_get_private_prefix(), nr,
+		                 label_scope);
 	}
 }
 
 void be_gas_begin_block(const ir_node *block, bool needs_label)
 {
+	ir_graph *const irg = get_irn_irg(block);
+	if (block == be_birg_from_irg(irg)->first_cold_block)
+		emit_cold_part_begin(get_irg_entity(irg));
+
 	if (needs_label || get_Block_entity(block)) {
 		be_gas_emit_block_name(block);
 		be_emit_char(':');
@@ -1609,8 +1697,10 @@ void be_emit_jump_table(ir_node const *const node, be_switch_attr_t const *const
 		be_emit_write_line();
 	}
 
-	if (entity && !is_macho())
-		be_gas_emit_switch_section(GAS_SECTION_TEXT);
+	if (entity && !is_macho()) {
+		be_gas_emit_switch_section(cold_function != NULL
+			? GAS_SECTION_TEXT_UNLIKELY : text_section);
+	}
 
 	free(labels);
 	free(targets);
@@ -35,6 +35,8 @@ typedef enum {
 	GAS_SECTION_DEBUG_LINE,      /**< dwarf debug line */
 	GAS_SECTION_DEBUG_PUBNAMES,  /**< dwarf pub names */
 	GAS_SECTION_DEBUG_FRAME,     /**< dwarf callframe infos */
+	GAS_SECTION_TEXT_UNLIKELY,   /**< rarely executed program code */
+	GAS_SECTION_TEXT_HOT,        /**< frequently executed program code */
 	GAS_SECTION_TYPE_MASK    = 0xFF,
 
 	GAS_SECTION_FLAG_TLS     = 1 << 8,  /**< thread local flag */
@@ -72,8 +74,32 @@ void be_gas_emit_function_prolog(const ir_entity *entity,
 
 void be_gas_emit_function_epilog(const ir_entity *entity);
 
+/**
+ * Checks whether the rarely executed blocks of a function may be emitted into
+ * a separate section, see be_irg_t.first_cold_block.
+ */
+bool be_gas_can_split_function(ir_entity const *entity);
+
 char const *be_gas_get_private_prefix(void);
 
+/**
+ * Sets the function whose name is appended to local labels, so the code of
+ * that function does not depend on the labels of the other functions. Pass
+ * NULL to stop appending.
+ */
+void be_gas_set_label_scope(ir_entity const *function);
+
+/**
+ * Returns the suffix for local labels, see be_gas_set_label_scope().
+ */
+char const *be_gas_get_label_scope(void);
+
+/**
+ * Forgets the current section, so the next section switch is emitted even if
+ * the section does not change.
+ */
+void be_gas_forget_section(void);
+
 /**
  * emit ld_ident of an entity and performs additional mangling if necessary.
  * (mangling is necessary for ir_visibility_private for example).
@@ -54,6 +54,9 @@ typedef struct be_irg_t {
 	struct obstack    obst;
 	/** Architecture specific per-graph data */
 	void             *isa_link;
+	/** first block of the cold part at the end of the block schedule, which
+	 * is emitted into a separate section. May be NULL. */
+	ir_node          *first_cold_block;
 } be_irg_t;
 
 static inline be_irg_t *be_birg_from_irg(const ir_graph *irg)
@@ -9,11 +9,18 @@
  * @author      Matthias Braun
  * @date        12.03.2007
  */
+/* for memfd_create */
+#define _GNU_SOURCE
+
 #include "bejit.h"
 
 #include <assert.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include "array.h"
 #include "beemitter.h"
@@ -21,8 +28,17 @@
 #include "bitfiddle.h"
 #include "compiler.h"
 #include "entity_t.h"
+#include "bera.h"
+#include "besched.h"
+#include "irgraph_t.h"
 #include "obst.h"
 #include "panic.h"
+#include "pmap.h"
+#include "util.h"
+
+/** the smallest block of executable memory has 2^MIN_CODE_P2 bytes */
+#define MIN_CODE_P2    4
+#define N_SIZE_CLASSES 16
 
 typedef enum reloc_dest_kind_t {
 	RELOC_DEST_CODE_FRAGMENT,
@@ -38,23 +54,87 @@ typedef struct relocation_t {
 		uint16_t   fragment_num;
 		ir_entity *entity;
 	} dest;
+	uint8_t                   len;       /**< reserved size of a branch */
+	uint8_t                   short_len; /**< size of the short form of a branch, 0 if this is no branch */
+	bool                      is_short;  /**< the branch uses the short form */
 } relocation_t;
 
 typedef struct fragment_info_t {
 	unsigned     address;  /**< Address from begin of code segment */
 	unsigned     len;      /**< size of the fragments data */
+	unsigned     size;     /**< size of the fragment after branch relaxation */
 	uint8_t      p2align;  /**< power 2 of two we should align */
 	uint8_t      max_skip; /**< Maximum number of bytes to skip for alignment */
 	uint16_t     n_relocations;
 	relocation_t relocations[];
 } fragment_info_t;
 
+/**
+ * Executable memory, which is mapped twice: The code runs at addr, but is
+ * written through the writable view, so no page is ever writable and
+ * executable.
+ */
+typedef struct code_mapping_t {
+	char   *addr;
+	char   *writable;
+	size_t  size;
+} code_mapping_t;
+
+/** Call-through stub of a function, which is compiled on its first call. */
+typedef struct jit_stub_t {
+	ir_jit_segment_t *segment;
+	ir_graph         *irg;     /**< graph compiled on the next resolution, NULL if the code is final, protected by the queue lock */
+	char             *stub;    /**< the stub in executable memory */
+	void const       *target;  /**< code the stub jumps to */
+	char            **code;    /**< code of the function for each tier */
+	int32_t           counter; /**< calls left until the function is recompiled */
+	ir_jit_task_t    *task;    /**< pending recompilation by a worker, if any, protected by the queue lock */
+} jit_stub_t;
+
+/** A graph compiled by a worker thread. */
+struct ir_jit_task_t {
+	ir_jit_segment_t *segment;
+	ir_graph         *irg;
+	jit_stub_t       *stub;     /**< stub switched to the code, if any */
+	void             *code;     /**< the compiled code, valid once done */
+	bool              done;
+	bool              detached; /**< nobody waits for the task, the worker frees it */
+	ir_jit_task_t    *next;     /**< next task in the queue */
+};
+
+/** A block of executable memory holding the code of a function. */
+typedef struct code_block_t {
+	size_t      size;     /**< allocated size */
+	char       *writable; /**< the block in the writable view */
+	ir_entity  *entity;   /**< the function placed into the block */
+	jit_stub_t *stub;     /**< the stub if the block holds one */
+} code_block_t;
+
 struct ir_jit_segment_t {
-	struct obstack code_obst;
-	struct obstack fragment_info_obst;
-	struct obstack fragment_info_arr_obst;
+	struct obstack        code_obst;
+	struct obstack        fragment_info_obst;
+	struct obstack        fragment_info_arr_obst;
+	pmap                 *code_blocks; /**< maps code addresses to code_block_t */
+	code_mapping_t       *mappings;    /**< executable memory of the segment */
+	char                **free_blocks[N_SIZE_CLASSES]; /**< unused blocks of each size class */
+	unsigned              tier_threshold; /**< calls before a stub recompiles its function, 0 without tiers */
+	ir_jit_optimize_func  optimize;       /**< optimizes hot functions before recompilation */
+	pthread_t            *workers;     /**< threads compiling queued tasks */
+	pthread_mutex_t       queue_lock;  /**< protects the workers, the queue, tasks and the graphs of stubs */
+	pthread_cond_t        queue_cond;  /**< signals new tasks and shutdown */
+	pthread_cond_t        done_cond;   /**< signals finished tasks */
+	ir_jit_task_t        *queue;       /**< first pending task */
+	ir_jit_task_t        *queue_last;  /**< last pending task */
+	bool                  shutdown;    /**< workers stop once the queue is empty */
 };
 
+/**
+ * The IR and the backend are global state, only one thread may compile. A
+ * thread holding it may take the queue lock of a segment, but not the other
+ * way round.
+ */
+static pthread_mutex_t compiler_lock = PTHREAD_MUTEX_INITIALIZER;
+
 struct ir_jit_function_t {
 	unsigned          size;
 	unsigned          n_fragments;
@@ -72,11 +152,56 @@ ir_jit_segment_t *be_new_jit_segment(void)
 	obstack_init(&segment->code_obst);
 	obstack_init(&segment->fragment_info_obst);
 	obstack_init(&segment->fragment_info_arr_obst);
+	segment->code_blocks = pmap_create();
+	segment->mappings    = NEW_ARR_F(code_mapping_t, 0);
+	for (unsigned i = 0; i < N_SIZE_CLASSES; ++i)
+		segment->free_blocks[i] = NEW_ARR_F(char*, 0);
+	segment->workers = NEW_ARR_F(pthread_t, 0);
+	pthread_mutex_init(&segment->queue_lock, NULL);
+	pthread_cond_init(&segment->queue_cond, NULL);
+	pthread_cond_init(&segment->done_cond, NULL);
 	return segment;
 }
 
+static void stop_workers(ir_jit_segment_t *const segment)
+{
+	pthread_mutex_lock(&segment->queue_lock);
+	segment->shutdown = true;
+	pthread_cond_broadcast(&segment->queue_cond);
+	pthread_mutex_unlock(&segment->queue_lock);
+	for (size_t i = 0, n = ARR_LEN(segment->workers); i < n; ++i)
+		pthread_join(segment->workers[i], NULL);
+	DEL_ARR_F(segment->workers);
+	pthread_cond_destroy(&segment->done_cond);
+	pthread_cond_destroy(&segment->queue_cond);
+	pthread_mutex_destroy(&segment->queue_lock);
+}
+
 void be_destroy_jit_segment(ir_jit_segment_t *segment)
 {
+	stop_workers(segment);
+	foreach_pmap(segment->code_blocks, entry) {
+		code_block_t *const block = (code_block_t*)entry->value;
+		if (block == NULL)
+			continue;
+		if (be_jit_get_entity_addr(block->entity) == entry->key)
+			be_jit_set_entity_addr(block->entity, (void const*)-1);
+		if (block->stub != NULL) {
+			DEL_ARR_F(block->stub->code);
+			free(block->stub);
+		}
+		free(block);
+	}
+	pmap_destroy(segment->code_blocks);
+	for (size_t i = 0, n = ARR_LEN(segment->mappings); i < n; ++i) {
+		code_mapping_t const *const mapping = &segment->mappings[i];
+		munmap(mapping->addr, mapping->size);
+		munmap(mapping->writable, mapping->size);
+	}
+	DEL_ARR_F(segment->mappings);
+	for (unsigned i = 0; i < N_SIZE_CLASSES; ++i)
+		DEL_ARR_F(segment->free_blocks[i]);
+
 	obstack_free(&segment->code_obst, NULL);
 	obstack_free(&segment->fragment_info_obst, NULL);
 	obstack_free(&segment->fragment_info_arr_obst, NULL);
@@ -105,20 +230,46 @@ void be_jit_begin_function(ir_jit_segment_t *const segment)
 	fragment_info_arr_obst = &segment->fragment_info_arr_obst;
 }
 
-static void layout_fragments(ir_jit_function_t *const function,
-                             unsigned const code_size)
+static bool is_branch(relocation_t const *const relocation)
 {
-	unsigned          const n_fragments    = function->n_fragments;
-	fragment_info_t **const fragment_infos = function->fragment_infos;
+	return relocation->short_len != 0;
+}
 
-	unsigned address      = 0;
-#ifndef NDEBUG
-	unsigned orig_address = 0;
-#endif
-	for (unsigned i = 0; i < n_fragments; ++i) {
-		fragment_info_t *const fragment = fragment_infos[i];
-		assert(fragment->address == ~0u);
-		assert(fragment->len != ~0u);
+/** Returns the number of bytes the branch saves by using the short form. */
+static unsigned get_branch_shrink(relocation_t const *const relocation)
+{
+	return relocation->is_short ? relocation->len - relocation->short_len : 0;
+}
+
+static unsigned get_fragment_address(ir_jit_function_t const *const function,
+                                     relocation_t const *const relocation)
+{
+	unsigned const fragment_num = relocation->dest.fragment_num;
+	assert(fragment_num < function->n_fragments);
+	fragment_info_t const *const fragment
+		= function->fragment_infos[fragment_num];
+	return fragment->address + relocation->dest_offset;
+}
+
+/**
+ * Returns the displacement of a branch at @p address, which is relative to
+ * the end of the branch.
+ */
+static int32_t get_branch_displacement(ir_jit_function_t const *const function,
+                                       relocation_t const *const relocation,
+                                       unsigned const address)
+{
+	unsigned const len = relocation->is_short ? relocation->short_len
+	                                          : relocation->len;
+	return (int32_t)get_fragment_address(function, relocation)
+	     - (int32_t)(address + len);
+}
+
+static void assign_addresses(ir_jit_function_t *const function)
+{
+	unsigned address = 0;
+	for (unsigned i = 0, n = function->n_fragments; i < n; ++i) {
+		fragment_info_t *const fragment = function->fragment_infos[i];
 
 		unsigned const align   = 1 << fragment->p2align;
 		unsigned const aligned = round_up2(address, align);
@@ -126,15 +277,69 @@ static void layout_fragments(ir_jit_function_t *const function,
 			address = aligned;
 
 		fragment->address = address;
+		fragment->size    = fragment->len;
+		for (unsigned r = 0; r < fragment->n_relocations; ++r)
+			fragment->size -= get_branch_shrink(&fragment->relocations[r]);
 
-		address      += fragment->len;
-#ifndef NDEBUG
-		orig_address += fragment->len;
-#endif
+		address += fragment->size;
 	}
 	function->size = address;
-	assert(code_size == orig_address);
+}
+
+/**
+ * Switches short branches, whose destination is out of reach, to the long
+ * form.
+ *
+ * @return true if a branch was changed
+ */
+static bool grow_branches(ir_jit_function_t *const function)
+{
+	bool changed = false;
+	for (unsigned i = 0, n = function->n_fragments; i < n; ++i) {
+		fragment_info_t *const fragment = function->fragment_infos[i];
+		unsigned               shrink   = 0;
+		for (unsigned r = 0; r < fragment->n_relocations; ++r) {
+			relocation_t *const relocation = &fragment->relocations[r];
+			if (!relocation->is_short)
+				continue;
+			unsigned const address = fragment->address + relocation->offset
+			                       - shrink;
+			int32_t  const displacement
+				= get_branch_displacement(function, relocation, address);
+			if (displacement < INT8_MIN || displacement > INT8_MAX) {
+				relocation->is_short = false;
+				changed              = true;
+			} else {
+				shrink += get_branch_shrink(relocation);
+			}
+		}
+	}
+	return changed;
+}
+
+/**
+ * Assigns the addresses of the fragments. Branches start out in their short
+ * form and are switched to the long form until all destinations are in reach.
+ * Branches only grow, so this terminates.
+ */
+static void layout_fragments(ir_jit_function_t *const function,
+                             unsigned const code_size)
+{
+#ifndef NDEBUG
+	unsigned orig_size = 0;
+	for (unsigned i = 0; i < function->n_fragments; ++i) {
+		fragment_info_t const *const fragment = function->fragment_infos[i];
+		assert(fragment->address == ~0u);
+		assert(fragment->len != ~0u);
+		orig_size += fragment->len;
+	}
+	assert(code_size == orig_size);
+#endif
 	(void)code_size;
+
+	do {
+		assign_addresses(function);
+	} while (grow_branches(function));
 }
 
 ir_jit_function_t *be_jit_finish_function(void)
@@ -242,33 +447,49 @@ void be_emit_reloc_entity(unsigned const len, uint8_t be_kind,
 	be_emit_relocation(len, &relocation);
 }
 
-static int32_t resolve_relocation_code(ir_jit_function_t const *const function,
-                                       relocation_t const *const relocation,
-                                       unsigned const relocation_address)
+void be_emit_reloc_branch(unsigned const len, unsigned const short_len,
+                          uint8_t const be_kind, unsigned const fragment_num)
 {
-	unsigned const fragment_num = relocation->dest.fragment_num;
-	assert(fragment_num < function->n_fragments);
-	fragment_info_t const *const fragment
-		= function->fragment_infos[fragment_num];
-	unsigned const dest_address = fragment->address + relocation->dest_offset;
-	return (int32_t)dest_address - relocation_address;
+	assert(0 < short_len && short_len < len && len <= UINT8_MAX);
+	relocation_t relocation = {
+		.be_kind           = be_kind,
+		.dest_kind         = RELOC_DEST_CODE_FRAGMENT,
+		.dest.fragment_num = fragment_num,
+		.len               = len,
+		.short_len         = short_len,
+		.is_short          = true,
+	};
+	be_emit_relocation(len, &relocation);
 }
 
 static unsigned emit_relocation(ir_jit_function_t const *const function,
                                 relocation_t const *const relocation,
                                 unsigned const relocation_address,
                                 char *const relocation_abs,
-                                emit_relocation_func const emit)
+                                char const *const relocation_exec,
+                                be_jit_emit_interface_t const *const emitter)
 {
 	switch (relocation->dest_kind) {
 	case RELOC_DEST_CODE_FRAGMENT: {
-		int32_t const dest = resolve_relocation_code(function, relocation,
-		                                             relocation_address);
-		return emit(relocation_abs, relocation->be_kind, NULL, dest);
+		if (is_branch(relocation)) {
+			int32_t const displacement = get_branch_displacement(
+				function, relocation, relocation_address);
+			unsigned const size = emitter->branch(relocation_abs,
+				relocation->be_kind, relocation->is_short, displacement);
+			assert(size == (relocation->is_short ? relocation->short_len
+			                                     : relocation->len));
+			return size;
+		}
+		int32_t const dest = (int32_t)get_fragment_address(function, relocation)
+		                   - (int32_t)relocation_address;
+		return emitter->relocation(relocation_abs, relocation_exec,
+		                           relocation->be_kind, NULL, dest);
 	}
 	case RELOC_DEST_ENTITY:
-		return emit(relocation_abs, relocation->be_kind,
-		            relocation->dest.entity, relocation->dest_offset);
+		return emitter->relocation(relocation_abs, relocation_exec,
+		                           relocation->be_kind,
+		                           relocation->dest.entity,
+		                           relocation->dest_offset);
 	}
 	panic("Invalid relocation");
 }
@@ -282,28 +503,50 @@ static void emit_bytes_as_asm(char const *const begin, char const *const end)
 	}
 }
 
+/**
+ * Returns the reserved size of a relocation in the code of its fragment and
+ * the size it got after relaxation.
+ */
+static unsigned get_reloc_reserved_size(relocation_t const *const relocation,
+                                        unsigned const emitted_size)
+{
+	return is_branch(relocation) ? relocation->len : emitted_size;
+}
+
 static void emit_fragment_as_asm(ir_jit_function_t const *const function,
                                  fragment_info_t const *const fragment,
                                  char const *const fragment_code,
-                                 emit_relocation_func const emit)
+                                 be_jit_emit_interface_t const *const emitter)
 {
 	unsigned        const fragment_address = fragment->address;
 	char     const *      b                = fragment_code;
+	unsigned              shrink           = 0;
 	for (unsigned r = 0, n = fragment->n_relocations; r < n; ++r) {
 		relocation_t const *const relocation = &fragment->relocations[r];
 		unsigned            const offset     = relocation->offset;
 		emit_bytes_as_asm(b, fragment_code + offset);
-		unsigned const reloc_address = fragment_address + offset;
-		unsigned const reloc_size
-			= emit_relocation(function, relocation, reloc_address, NULL, emit);
-		b = fragment_code + relocation->offset + reloc_size;
+		unsigned const reloc_address = fragment_address + offset - shrink;
+		unsigned       reloc_size;
+		if (is_branch(relocation)) {
+			/* branches are fully resolved, so emit their bytes */
+			char buffer[UINT8_MAX];
+			reloc_size = emit_relocation(function, relocation, reloc_address,
+			                             buffer, NULL, emitter);
+			emit_bytes_as_asm(buffer, buffer + reloc_size);
+		} else {
+			reloc_size = emit_relocation(function, relocation, reloc_address,
+			                             NULL, NULL, emitter);
+		}
+		b       = fragment_code + offset
+		        + get_reloc_reserved_size(relocation, reloc_size);
+		shrink += get_branch_shrink(relocation);
 	}
 	char const *const end = fragment_code + fragment->len;
 	emit_bytes_as_asm(b, end);
 }
 
 void be_jit_emit_as_asm(ir_jit_function_t *const function,
-                        emit_relocation_func const emit)
+                        be_jit_emit_interface_t const *const emitter)
 {
 	/* Move fragments to their final addresses */
 	char const *const code         = function->code;
@@ -316,43 +559,43 @@ void be_jit_emit_as_asm(ir_jit_function_t *const function,
 			be_emit_irprintf("\t.p2align %u,,%u\n", fragment->p2align,
 			                 fragment->max_skip);
 
-		emit_fragment_as_asm(function, fragment, code + orig_address, emit);
+		emit_fragment_as_asm(function, fragment, code + orig_address, emitter);
 
 		orig_address += fragment->len;
-		last_address = address + fragment->len;
+		last_address = address + fragment->size;
 	}
 }
 
 static void emit_fragment(ir_jit_function_t const *const function,
-						  fragment_info_t const *const fragment,
+                          fragment_info_t const *const fragment,
                           char const *const fragment_code, char *const buffer,
-                          emit_relocation_func const emit)
+                          char const *const address,
+                          be_jit_emit_interface_t const *const emitter)
 {
 	unsigned        const fragment_address = fragment->address;
 	char     const *      b                = fragment_code;
 	char           *      d                = buffer;
-	unsigned              last_offset      = 0;
 	for (unsigned r = 0, n = fragment->n_relocations; r < n; ++r) {
 		relocation_t const *const relocation = &fragment->relocations[r];
-		unsigned            const offset     = relocation->offset;
-		unsigned            const len        = offset - last_offset;
-		assert(last_offset <= offset);
+		char         const *const reloc_code = fragment_code + relocation->offset;
+		assert(b <= reloc_code);
+		size_t const len = reloc_code - b;
 		memcpy(d, b, len);
 		d += len;
-		b += len;
-		unsigned const reloc_address = fragment_address + offset;
-		unsigned const reloc_size
-			= emit_relocation(function, relocation, reloc_address, d, emit);
+		unsigned const reloc_address = fragment_address + (d - buffer);
+		unsigned const reloc_size    = emit_relocation(function, relocation,
+			reloc_address, d, address + (d - buffer), emitter);
 		d += reloc_size;
-		b += reloc_size;
-		last_offset = offset + reloc_size;
+		b  = reloc_code + get_reloc_reserved_size(relocation, reloc_size);
 	}
 	char const *const end = fragment_code + fragment->len;
 	assert(b <= end);
 	memcpy(d, b, end-b);
+	assert((unsigned)(d + (end - b) - buffer) == fragment->size);
 }
 
-void be_jit_emit_memory(char *const buffer, ir_jit_function_t *const function,
+void be_jit_emit_memory(char *const buffer, char const *const exec_address,
+                        ir_jit_function_t *const function,
                         be_jit_emit_interface_t const *const emitter)
 {
 	/* Copy fragments and resolve relocations. */
@@ -362,15 +605,618 @@ void be_jit_emit_memory(char *const buffer, ir_jit_function_t *const function,
 	for (size_t i = 0, n = function->n_fragments; i < n; ++i) {
 		fragment_info_t const *const fragment  = function->fragment_infos[i];
 		unsigned               const address   = fragment->address;
-		unsigned               const nop_bytes = last_address - address;
 		assert(address >= last_address);
+		unsigned               const nop_bytes = address - last_address;
 		if (nop_bytes > 0)
 			emitter->nops(buffer + last_address, nop_bytes);
 
 		emit_fragment(function, fragment, code+orig_address, buffer+address,
-		              emitter->relocation);
+		              exec_address + address, emitter);
 
 		orig_address += fragment->len;
-		last_address = address + fragment->len;
+		last_address = address + fragment->size;
+	}
+}
+
+static size_t get_page_size(void)
+{
+	static size_t page_size;
+	if (page_size == 0)
+		page_size = (size_t)sysconf(_SC_PAGESIZE);
+	return page_size;
+}
+
+/** Returns a file descriptor of anonymous shared memory. */
+static int create_shared_memory(void)
+{
+#ifdef __linux__
+	return memfd_create("firm-jit", MFD_CLOEXEC);
+#else
+	char name[32];
+	snprintf(name, sizeof(name), "/firm-jit-%ld", (long)getpid());
+	int const fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0700);
+	if (fd >= 0)
+		shm_unlink(name);
+	return fd;
+#endif
+}
+
+static char *map_code(ir_jit_segment_t *const segment, size_t const size)
+{
+	int const fd = create_shared_memory();
+	if (fd < 0 || ftruncate(fd, (off_t)size) != 0)
+		panic("could not create executable memory");
+	void *const addr     = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_SHARED,
+	                            fd, 0);
+	void *const writable = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED || writable == MAP_FAILED)
+		panic("could not map executable memory");
+	code_mapping_t const mapping = { (char*)addr, (char*)writable, size };
+	ARR_APP1(code_mapping_t, segment->mappings, mapping);
+	return (char*)addr;
+}
+
+static void unmap_code(ir_jit_segment_t *const segment, char *const addr)
+{
+	size_t const n = ARR_LEN(segment->mappings);
+	for (size_t i = 0; i < n; ++i) {
+		code_mapping_t const mapping = segment->mappings[i];
+		if (mapping.addr == addr) {
+			munmap(mapping.addr, mapping.size);
+			munmap(mapping.writable, mapping.size);
+			segment->mappings[i] = segment->mappings[n - 1];
+			ARR_SHRINKLEN(segment->mappings, n - 1);
+			return;
+		}
+	}
+	panic("no mapping at %p", (void*)addr);
+}
+
+/** Returns the address of @p code in the writable view. */
+static char *get_writable(ir_jit_segment_t const *const segment,
+                          char const *const code)
+{
+	for (size_t i = 0, n = ARR_LEN(segment->mappings); i < n; ++i) {
+		code_mapping_t const *const mapping = &segment->mappings[i];
+		if (code >= mapping->addr && code < mapping->addr + mapping->size)
+			return mapping->writable + (code - mapping->addr);
+	}
+	panic("no mapping at %p", (void const*)code);
+}
+
+/**
+ * Returns the size class for blocks of @p size bytes, or N_SIZE_CLASSES if
+ * the block gets its own mapping.
+ */
+static unsigned get_size_class(size_t const size)
+{
+	if (size > get_page_size() / 2)
+		return N_SIZE_CLASSES;
+	unsigned const p2 = log2_ceil((uint32_t)MAX(size, 1u << MIN_CODE_P2));
+	return MIN(p2 - MIN_CODE_P2, (unsigned)N_SIZE_CLASSES);
+}
+
+/**
+ * Allocates executable memory. Small blocks of the same size class share
+ * pages, which only contain code of this segment.
+ */
+static char *alloc_code(ir_jit_segment_t *const segment, size_t const size,
+                        ir_entity *const entity)
+{
+	unsigned const size_class = get_size_class(size);
+	char          *code;
+	size_t         block_size;
+	if (size_class < N_SIZE_CLASSES) {
+		block_size = (size_t)1 << (size_class + MIN_CODE_P2);
+		char **const free_blocks = segment->free_blocks[size_class];
+		if (ARR_LEN(free_blocks) == 0) {
+			size_t const page_size = get_page_size();
+			char  *const page      = map_code(segment, page_size);
+			for (size_t offset = page_size; offset > 0; offset -= block_size)
+				ARR_APP1(char*, segment->free_blocks[size_class],
+				         page + offset - block_size);
+		}
+		char **const blocks = segment->free_blocks[size_class];
+		size_t const n      = ARR_LEN(blocks);
+		code = blocks[n - 1];
+		ARR_SHRINKLEN(blocks, n - 1);
+	} else {
+		block_size = round_up2(size, get_page_size());
+		code       = map_code(segment, block_size);
+	}
+
+	code_block_t *const block = XMALLOCZ(code_block_t);
+	block->size     = block_size;
+	block->writable = get_writable(segment, code);
+	block->entity   = entity;
+	pmap_insert(segment->code_blocks, code, block);
+	return code;
+}
+
+static void set_protection(char *const code, size_t const size, int const prot)
+{
+	size_t    const page_size = get_page_size();
+	uintptr_t const begin     = (uintptr_t)code & ~(uintptr_t)(page_size - 1);
+	uintptr_t const end       = (uintptr_t)code + size;
+	if (mprotect((void*)begin, end - begin, prot) != 0)
+		panic("could not change protection of code memory");
+}
+
+static void flush_icache(char *const code, size_t const size)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	/* only generates code on targets with incoherent caches, e.g. ARM */
+	__builtin___clear_cache(code, code + size);
+#else
+	(void)code;
+	(void)size;
+#endif
+}
+
+/** Frees the data of @p function, which has to be the last one created. */
+static void free_jit_function(ir_jit_segment_t *const segment,
+                              ir_jit_function_t *const function)
+{
+	obstack_free(&segment->code_obst, (void*)function->code);
+	if (function->n_fragments > 0)
+		obstack_free(&segment->fragment_info_obst, function->fragment_infos[0]);
+	obstack_free(&segment->fragment_info_arr_obst, function->fragment_infos);
+}
+
+/**
+ * Returns the writable view of the block at @p code. Its pages are writable
+ * until end_write(), the executable view never is, so code of the segment may
+ * run meanwhile.
+ */
+static char *begin_write(ir_jit_segment_t const *const segment,
+                         char *const code, size_t const size)
+{
+	char *const writable
+		= pmap_get(code_block_t, segment->code_blocks, code)->writable;
+	set_protection(writable, size, PROT_READ | PROT_WRITE);
+	return writable;
+}
+
+static void end_write(char *const code, char *const writable,
+                      size_t const size)
+{
+	set_protection(writable, size, PROT_READ);
+	flush_icache(code, size);
+}
+
+/** Emits @p function into @p code. */
+static void write_function(ir_jit_segment_t *const segment, char *const code,
+                           ir_jit_function_t *const function)
+{
+	unsigned const size     = be_get_function_size(function);
+	char    *const writable = begin_write(segment, code, size);
+	be_jit_emit_function(writable, code, function);
+	end_write(code, writable, size);
+	free_jit_function(segment, function);
+}
+
+void *be_jit_compile_executable(ir_jit_segment_t *const segment,
+                                ir_graph *const irg)
+{
+	ir_jit_function_t *const function = be_jit_compile(segment, irg);
+	if (function == NULL)
+		return NULL;
+
+	ir_entity *const entity = get_irg_entity(irg);
+	char      *const code   = alloc_code(segment,
+		be_get_function_size(function), entity);
+	/* set the address first, so recursive calls can be resolved */
+	be_jit_set_entity_addr(entity, code);
+	write_function(segment, code, function);
+	return code;
+}
+
+void be_jit_lock(void)
+{
+	pthread_mutex_lock(&compiler_lock);
+}
+
+void be_jit_unlock(void)
+{
+	pthread_mutex_unlock(&compiler_lock);
+}
+
+static void resolve_stub(void *data);
+
+/**
+ * Switches @p stub to @p code. Running stubs load the target, so this is
+ * atomic for other threads.
+ */
+static void publish_code(jit_stub_t *const stub, char *const code)
+{
+	ARR_APP1(char*, stub->code, code);
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_store_n(&stub->target, code, __ATOMIC_RELEASE);
+#else
+	stub->target = code;
+#endif
+}
+
+/** Reads the target of @p stub, which is NULL until its first code runs. */
+static void const *get_target(jit_stub_t const *const stub)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __atomic_load_n(&stub->target, __ATOMIC_ACQUIRE);
+#else
+	return stub->target;
+#endif
+}
+
+/** Reads the counter of @p stub, which running stubs decrement. */
+static int32_t get_counter(jit_stub_t const *const stub)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __atomic_load_n(&stub->counter, __ATOMIC_ACQUIRE);
+#else
+	return stub->counter;
+#endif
+}
+
+static void set_counter(jit_stub_t *const stub, int32_t const counter)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__atomic_store_n(&stub->counter, counter, __ATOMIC_RELEASE);
+#else
+	stub->counter = counter;
+#endif
+}
+
+/**
+ * Compiles a copy of @p irg with the fast register allocator and scheduler,
+ * so @p irg can be compiled again later.
+ */
+static ir_jit_function_t *compile_quickly(ir_jit_segment_t *const segment,
+                                          ir_graph *const irg)
+{
+	ir_entity *const entity = get_irg_entity(irg);
+	ir_graph  *const copy   = new_ir_graph_copy(entity, irg);
+	add_irg_constraints(copy, irg->constraints);
+
+	allocate_func const allocator
+		= be_select_register_allocator(be_find_register_allocator("pref"));
+	schedule_func const scheduler
+		= be_select_scheduler(be_find_scheduler("trivial"));
+	ir_jit_function_t *const function = be_jit_compile(segment, copy);
+	be_select_scheduler(scheduler);
+	be_select_register_allocator(allocator);
+
+	free_ir_graph(copy);
+	set_entity_irg(entity, irg);
+	return function;
+}
+
+static void push_task(ir_jit_task_t *task);
+
+/**
+ * Takes the graph of @p stub for its final compilation. Returns NULL if the
+ * final code is installed or compiled already.
+ */
+static ir_graph *take_graph(jit_stub_t *const stub)
+{
+	ir_jit_segment_t *const segment = stub->segment;
+	pthread_mutex_lock(&segment->queue_lock);
+	ir_graph *const irg = stub->irg;
+	stub->irg = NULL;
+	pthread_mutex_unlock(&segment->queue_lock);
+	return irg;
+}
+
+/**
+ * Compiles @p irg for @p stub and switches the stub to the code. The caller
+ * holds the compiler lock.
+ */
+static void compile_stub(jit_stub_t *const stub, ir_graph *const irg,
+                         bool const tier_0)
+{
+	ir_jit_segment_t *const segment = stub->segment;
+	ir_jit_function_t      *function;
+	if (tier_0) {
+		function = compile_quickly(segment, irg);
+	} else {
+		if (ARR_LEN(stub->code) > 0 && segment->optimize != NULL)
+			segment->optimize(irg);
+		function = be_jit_compile(segment, irg);
+	}
+	if (function == NULL)
+		panic("could not compile %+F", irg);
+
+	/* the entity keeps the address of the stub, so recursive calls are
+	 * counted and get the recompiled code, too */
+	char *const code = alloc_code(segment, be_get_function_size(function),
+	                              get_irg_entity(irg));
+	write_function(segment, code, function);
+	publish_code(stub, code);
+}
+
+/**
+ * Recompiles the hot function of @p stub, whose tier-0 code runs already, or
+ * queues it for a worker. Never waits for the compiler lock, which the calling
+ * thread may hold: If another thread compiles, the tier-0 code keeps running
+ * for another round of calls.
+ */
+static void recompile_stub(jit_stub_t *const stub)
+{
+	ir_jit_segment_t *const segment = stub->segment;
+	pthread_mutex_lock(&segment->queue_lock);
+	ir_graph *const irg = stub->irg;
+	if (irg == NULL) {
+		/* the final code is installed or a worker compiles it, keep
+		 * counting */
+		set_counter(stub, INT32_MAX);
+		pthread_mutex_unlock(&segment->queue_lock);
+		return;
 	}
+	if (ARR_LEN(segment->workers) > 0) {
+		stub->irg = NULL;
+		ir_jit_task_t *const task = XMALLOCZ(ir_jit_task_t);
+		task->segment  = segment;
+		task->irg      = irg;
+		task->stub     = stub;
+		task->detached = true;
+		stub->task     = task;
+		push_task(task);
+		set_counter(stub, INT32_MAX);
+		pthread_mutex_unlock(&segment->queue_lock);
+		return;
+	}
+	pthread_mutex_unlock(&segment->queue_lock);
+
+	if (pthread_mutex_trylock(&compiler_lock) != 0) {
+		set_counter(stub, (int32_t)MIN(segment->tier_threshold,
+		                               (unsigned)INT32_MAX));
+		return;
+	}
+	ir_graph *const final_irg = take_graph(stub);
+	if (final_irg != NULL)
+		compile_stub(stub, final_irg, false);
+	set_counter(stub, INT32_MAX);
+	be_jit_unlock();
+}
+
+/**
+ * Called by a stub when its counter runs out: on the first call of its
+ * function, when the tier-0 code got hot and after INT32_MAX calls of the
+ * final code. The stub itself is never rewritten, the resolver only switches
+ * its target and resets its counter.
+ */
+static void resolve_stub(void *const data)
+{
+	jit_stub_t *const stub = (jit_stub_t*)data;
+	if (get_target(stub) != NULL) {
+		recompile_stub(stub);
+		return;
+	}
+
+	/* the first call has to wait for code */
+	be_jit_lock();
+	/* calls racing with the one which installed code meanwhile find the
+	 * counter reset */
+	if (get_counter(stub) <= 0) {
+		ir_jit_segment_t *const segment = stub->segment;
+		if (segment->tier_threshold > 0) {
+			compile_stub(stub, stub->irg, true);
+			set_counter(stub, (int32_t)MIN(segment->tier_threshold,
+			                               (unsigned)INT32_MAX));
+		} else {
+			compile_stub(stub, take_graph(stub), false);
+			set_counter(stub, INT32_MAX);
+		}
+	}
+	be_jit_unlock();
+}
+
+void const *be_jit_call_stub(ir_jit_segment_t *const segment,
+                             void const *const code)
+{
+	code_block_t const *const block
+		= pmap_get(code_block_t, segment->code_blocks, code);
+	jit_stub_t *const stub = block->stub;
+	assert(stub != NULL);
+#if defined(__GNUC__) || defined(__clang__)
+	while (__atomic_sub_fetch(&stub->counter, 1, __ATOMIC_ACQ_REL) <= 0)
+#else
+	while (--stub->counter <= 0)
+#endif
+		resolve_stub(stub);
+	return get_target(stub);
+}
+
+void *be_jit_create_stub(ir_jit_segment_t *const segment, ir_graph *const irg)
+{
+	unsigned const size = be_jit_get_stub_size();
+	if (size == 0)
+		return NULL;
+
+	ir_entity  *const entity = get_irg_entity(irg);
+	jit_stub_t *const stub   = XMALLOCZ(jit_stub_t);
+	stub->segment = segment;
+	stub->irg     = irg;
+	stub->code    = NEW_ARR_F(char*, 0);
+	stub->stub    = alloc_code(segment, size, entity);
+	pmap_get(code_block_t, segment->code_blocks, stub->stub)->stub = stub;
+
+	/* the counter starts at 0, so the first call resolves the stub before it
+	 * jumps to its target */
+	char *const writable = begin_write(segment, stub->stub, size);
+	be_jit_emit_stub(writable, stub->stub, &stub->target, &stub->counter,
+	                 resolve_stub, stub);
+	end_write(stub->stub, writable, size);
+
+	be_jit_set_entity_addr(entity, stub->stub);
+	return stub->stub;
+}
+
+/** Compiles the graph of @p task. Freeing the stub of the task cancels it. */
+static void run_task(ir_jit_task_t *const task)
+{
+	ir_jit_segment_t *const segment = task->segment;
+	be_jit_lock();
+
+	pthread_mutex_lock(&segment->queue_lock);
+	ir_graph   *const irg  = task->irg;
+	jit_stub_t *const stub = task->stub;
+	if (stub != NULL)
+		stub->task = NULL;
+	pthread_mutex_unlock(&segment->queue_lock);
+	if (irg == NULL) {
+		be_jit_unlock();
+		return;
+	}
+
+	if (stub != NULL && segment->optimize != NULL)
+		segment->optimize(irg);
+	ir_jit_function_t *const function = be_jit_compile(segment, irg);
+	char                    *code     = NULL;
+	if (function != NULL) {
+		ir_entity *const entity = get_irg_entity(irg);
+		code = alloc_code(segment, be_get_function_size(function), entity);
+		if (stub == NULL)
+			be_jit_set_entity_addr(entity, code);
+		write_function(segment, code, function);
+		if (stub != NULL)
+			publish_code(stub, code);
+	}
+
+	be_jit_unlock();
+	task->code = code;
+}
+
+static void *work(void *const data)
+{
+	ir_jit_segment_t *const segment = (ir_jit_segment_t*)data;
+	pthread_mutex_lock(&segment->queue_lock);
+	for (;;) {
+		while (segment->queue == NULL && !segment->shutdown)
+			pthread_cond_wait(&segment->queue_cond, &segment->queue_lock);
+		ir_jit_task_t *const task = segment->queue;
+		if (task == NULL)
+			break;
+		segment->queue = task->next;
+		pthread_mutex_unlock(&segment->queue_lock);
+
+		run_task(task);
+
+		pthread_mutex_lock(&segment->queue_lock);
+		task->done = true;
+		if (task->detached)
+			free(task);
+		pthread_cond_broadcast(&segment->done_cond);
+	}
+	pthread_mutex_unlock(&segment->queue_lock);
+	return NULL;
+}
+
+void be_jit_set_workers(ir_jit_segment_t *const segment,
+                        unsigned const n_workers)
+{
+	pthread_mutex_lock(&segment->queue_lock);
+	while (ARR_LEN(segment->workers) < n_workers) {
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, work, segment) != 0)
+			panic("could not create jit worker thread");
+		ARR_APP1(pthread_t, segment->workers, worker);
+	}
+	pthread_mutex_unlock(&segment->queue_lock);
+}
+
+/** Appends @p task to the queue. The caller holds the queue lock. */
+static void push_task(ir_jit_task_t *const task)
+{
+	ir_jit_segment_t *const segment = task->segment;
+	if (segment->queue == NULL)
+		segment->queue = task;
+	else
+		segment->queue_last->next = task;
+	segment->queue_last = task;
+	pthread_cond_signal(&segment->queue_cond);
+}
+
+ir_jit_task_t *be_jit_compile_async(ir_jit_segment_t *const segment,
+                                    ir_graph *const irg)
+{
+	be_jit_set_workers(segment, 1);
+
+	ir_jit_task_t *const task = XMALLOCZ(ir_jit_task_t);
+	task->segment = segment;
+	task->irg     = irg;
+	pthread_mutex_lock(&segment->queue_lock);
+	push_task(task);
+	pthread_mutex_unlock(&segment->queue_lock);
+	return task;
+}
+
+int be_jit_task_done(ir_jit_task_t const *const task)
+{
+	ir_jit_segment_t *const segment = task->segment;
+	pthread_mutex_lock(&segment->queue_lock);
+	bool const done = task->done;
+	pthread_mutex_unlock(&segment->queue_lock);
+	return done;
+}
+
+void *be_jit_wait(ir_jit_task_t *const task)
+{
+	ir_jit_segment_t *const segment = task->segment;
+	pthread_mutex_lock(&segment->queue_lock);
+	while (!task->done)
+		pthread_cond_wait(&segment->done_cond, &segment->queue_lock);
+	pthread_mutex_unlock(&segment->queue_lock);
+	void *const code = task->code;
+	free(task);
+	return code;
+}
+
+void be_jit_set_tiering(ir_jit_segment_t *const segment,
+                        unsigned const threshold,
+                        ir_jit_optimize_func const optimize)
+{
+	segment->tier_threshold = threshold;
+	segment->optimize       = optimize;
+}
+
+static void free_code(ir_jit_segment_t *const segment, char *const code)
+{
+	code_block_t *const block
+		= pmap_get(code_block_t, segment->code_blocks, code);
+	if (block == NULL)
+		panic("%p is not code of the segment", (void*)code);
+	/* pmap has no removal, addresses of freed blocks map to NULL */
+	pmap_insert(segment->code_blocks, code, NULL);
+
+	if (be_jit_get_entity_addr(block->entity) == code)
+		be_jit_set_entity_addr(block->entity, (void const*)-1);
+
+	jit_stub_t *const stub = block->stub;
+	if (stub != NULL) {
+		pthread_mutex_lock(&segment->queue_lock);
+		if (stub->task != NULL) {
+			stub->task->irg  = NULL;
+			stub->task->stub = NULL;
+		}
+		pthread_mutex_unlock(&segment->queue_lock);
+		for (size_t i = 0, n = ARR_LEN(stub->code); i < n; ++i)
+			free_code(segment, stub->code[i]);
+		DEL_ARR_F(stub->code);
+		free(stub);
+	}
+
+	unsigned const size_class = get_size_class(block->size);
+	if (size_class < N_SIZE_CLASSES)
+		ARR_APP1(char*, segment->free_blocks[size_class], code);
+	else
+		unmap_code(segment, code);
+	free(block);
+}
+
+void be_jit_free_executable(ir_jit_segment_t *const segment, void *const code)
+{
+	be_jit_lock();
+	free_code(segment, (char*)code);
+	be_jit_unlock();
 }
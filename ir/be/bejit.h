@@ -12,14 +12,22 @@
 #ifndef FIRM_BE_BEEMITTER_BINARY_H
 #define FIRM_BE_BEEMITTER_BINARY_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "firm_types.h"
 #include "jit.h"
 #include "obst.h"
 
-typedef unsigned (*emit_relocation_func) (char *buffer, uint8_t be_kind,
-                                          ir_entity *entity, int32_t offset);
+/**
+ * Encodes a relocation into @p buffer, which is executed at @p address.
+ */
+typedef unsigned (*emit_relocation_func) (char *buffer, char const *address,
+                                          uint8_t be_kind, ir_entity *entity,
+                                          int32_t offset);
+
+typedef unsigned (*emit_branch_func) (char *buffer, uint8_t be_kind,
+                                      bool is_short, int32_t displacement);
 
 typedef struct be_jit_emit_interface_t {
 	/** create @p size of NOP instructions for alignment */
@@ -28,12 +36,57 @@ typedef struct be_jit_emit_interface_t {
 	/** dest is an absolute address for RELOC_DEST_ENTITY and a relative
 	 * offset for RELOC_DEST_CODE_FRAGMENT (cast to int64_t in this case) */
 	emit_relocation_func relocation;
+
+	/** encode a complete branch in its short or long form, the displacement
+	 * is relative to the end of the branch */
+	emit_branch_func branch;
 } be_jit_emit_interface_t;
 
-void be_jit_emit_memory(char *buffer, ir_jit_function_t *function,
+/**
+ * Emits @p function into @p buffer, which is executed at @p address.
+ */
+void be_jit_emit_memory(char *buffer, char const *address,
+                        ir_jit_function_t *function,
                         be_jit_emit_interface_t const *emitter);
 
-void be_jit_emit_as_asm(ir_jit_function_t *function, emit_relocation_func emit);
+void be_jit_emit_as_asm(ir_jit_function_t *function,
+                        be_jit_emit_interface_t const *emitter);
+
+/**
+ * Returns the size of a call-through stub of the target or 0 if the target
+ * does not support them.
+ */
+unsigned be_jit_get_stub_size(void);
+
+/**
+ * Like be_emit_function(), but @p buffer is executed at @p address, e.g.
+ * because it is a writable view of executable memory.
+ */
+void be_jit_emit_function(char *buffer, char const *address,
+                          ir_jit_function_t *function);
+
+/**
+ * Writes a call-through stub into @p buffer, which is executed at
+ * @p address.
+ *
+ * Without a @p target, the stub calls @p resolve with @p data and then starts
+ * over, so @p resolve has to rewrite the stub. With a @p counter the stub
+ * atomically decrements it on each call and calls @p resolve and starts over
+ * while it is not positive, so @p resolve only has to reset the counter.
+ * Otherwise the stub jumps to the address stored in @p target, which can be
+ * replaced atomically without writing to the stub. The arguments of the call
+ * are preserved.
+ */
+void be_jit_emit_stub(char *buffer, char const *address,
+                      void const *const *target, int32_t *counter,
+                      void (*resolve)(void *data), void *data);
+
+/**
+ * Does what a call of the stub at @p code of @p segment does before it jumps
+ * to its target and returns the target, so stubs can be tested on targets
+ * which cannot run.
+ */
+void const *be_jit_call_stub(ir_jit_segment_t *segment, void const *code);
 
 void be_jit_begin_function(ir_jit_segment_t *segment);
 ir_jit_function_t *be_jit_finish_function(void);
@@ -67,4 +120,12 @@ void be_emit_reloc_fragment(unsigned len, uint8_t be_kind,
 void be_emit_reloc_entity(unsigned len, uint8_t be_kind, ir_entity *entity,
                           int32_t offset);
 
+/**
+ * Reserves @p len bytes for a branch to the fragment @p fragment_num. The
+ * branch is encoded by the emit interface when the fragments are laid out,
+ * using the short form of @p short_len bytes if the destination is in reach.
+ */
+void be_emit_reloc_branch(unsigned len, unsigned short_len, uint8_t be_kind,
+                          unsigned fragment_num);
+
 #endif
@@ -18,6 +18,7 @@
 #include "irprintf.h"
 #include "irdump_t.h"
 #include "irnodeset.h"
+#include "sbitset.h"
 
 #include "statev_t.h"
 #include "be_t.h"
@@ -248,14 +249,14 @@ static void liveness_for_node(ir_node *irn)
 }
 
 /**
- * Walker, collect all nodes for which we want calculate liveness info
- * on an obstack.
+ * Walker, collect the indices of all nodes for which we want calculate
+ * liveness info in a sparse bitset.
  */
 static void collect_liveness_nodes(ir_node *irn, void *data)
 {
-	ir_node **nodes = (ir_node**)data;
+	sbitset_t *nodes = (sbitset_t*)data;
 	if (is_liveness_node(irn))
-		nodes[get_irn_idx(irn)] = irn;
+		sbitset_set(nodes, get_irn_idx(irn));
 }
 
 void be_liveness_compute_sets(be_lv_t *lv)
@@ -268,22 +269,21 @@ void be_liveness_compute_sets(be_lv_t *lv)
 	obstack_init(&lv->obst);
 
 	ir_graph *irg = lv->irg;
-	unsigned n = get_irg_last_idx(irg);
-	ir_node **const nodes = NEW_ARR_FZ(ir_node*, n);
+	sbitset_t nodes;
+	sbitset_init(&nodes, get_irg_last_idx(irg));
 
 	/* inserting the variables sorted by their ID is probably
 	 * more efficient since the binary sorted set insertion
 	 * will not need to move around the data. */
-	irg_walk_graph(irg, NULL, collect_liveness_nodes, nodes);
+	irg_walk_graph(irg, NULL, collect_liveness_nodes, &nodes);
 
 	re.lv = lv;
 
-	for (unsigned i = 0; i < n; ++i) {
-		if (nodes[i] != NULL)
-			liveness_for_node(nodes[i]);
+	sbitset_foreach(&nodes, idx) {
+		liveness_for_node(get_idx_irn(irg, idx));
 	}
 
-	DEL_ARR_F(nodes);
+	sbitset_free(&nodes);
 	lv->sets_valid = true;
 	be_timer_pop(T_LIVE);
 }
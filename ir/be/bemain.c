@@ -33,8 +33,11 @@
 #include "util.h"
 
 #include "be_t.h"
+#include "becache.h"
 #include "bediagnostic.h"
+#include "befuncorder.h"
 #include "begnuas.h"
+#include "bejit.h"
 #include "bemodule.h"
 #include "beutil.h"
 #include "benode.h"
@@ -66,6 +69,7 @@ be_options_t be_options = {
 	.do_verify            = true,
 	.ilp_solver           = "",
 	.verbose_asm          = true,
+	.cache_dir            = "",
 	.pic_style            = BE_PIC_NONE,
 };
 
@@ -111,6 +115,7 @@ static const lc_opt_table_entry_t be_main_options[] = {
 	LC_OPT_ENT_BOOL     ("verboseasm", "enable verbose assembler output",                        &be_options.verbose_asm),
 
 	LC_OPT_ENT_STR("ilp.solver", "the ilp solver name", &be_options.ilp_solver),
+	LC_OPT_ENT_STR("cache",      "directory to cache the code of unchanged functions in", &be_options.cache_dir),
 	LC_OPT_LAST
 };
 
@@ -334,7 +339,6 @@ static ir_graph *be_prepare_profile(const char *const cup_name)
 			be_warningf(NULL, "could not read profile data '%s'", prof_filename);
 		} else {
 			ir_create_execfreqs_from_profile();
-			ir_profile_free();
 			have_profile = true;
 		}
 	}
@@ -350,6 +354,10 @@ static ir_graph *be_prepare_profile(const char *const cup_name)
 		}
 		be_timer_pop(T_EXECFREQ);
 	}
+
+	be_order_functions(have_profile);
+	if (have_profile)
+		ir_profile_free();
 	return prof_init_irg;
 }
 
@@ -422,6 +430,7 @@ void be_begin(FILE *file_handle, const char *cup_name)
 	if (prof_init_irg != NULL)
 		initialize_birg(&birgs[num_birgs++], prof_init_irg, &env);
 
+	be_cache_init();
 	be_gas_begin_compilation_unit(&env);
 }
 
@@ -537,6 +546,10 @@ bool be_step_first(ir_graph *irg)
 	ir_entity *const entity = get_irg_entity(irg);
 	if (get_entity_linkage(entity) & IR_LINKAGE_NO_CODEGEN)
 		return false;
+	if (be_cache_replay(irg)) {
+		be_free_birg(irg);
+		return false;
+	}
 
 	be_timer_push(T_OTHER);
 	if (stat_ev_enabled) {
@@ -616,6 +629,7 @@ void be_step_last(ir_graph *irg)
 		}
 	}
 
+	be_cache_store();
 	be_free_birg(irg);
 	stat_ev_ctx_pop("bemain_irg");
 
@@ -625,6 +639,8 @@ void be_step_last(ir_graph *irg)
 void be_finish(void)
 {
 	be_gas_end_compilation_unit(&env);
+	be_cache_finish();
+	be_free_function_order();
 
 	if (be_options.timing) {
 		ir_timer_stop(bemain_timer);
@@ -663,8 +679,6 @@ ir_jit_function_t *be_jit_compile(ir_jit_segment_t *const segment,
 	if (isa_if->jit_compile == NULL)
 		return NULL;
 
-	obstack_init(&obst);
-
 	ir_entity *entity = get_irg_entity(irg);
 	if (get_entity_linkage(entity) & IR_LINKAGE_NO_CODEGEN)
 		return NULL;
@@ -674,10 +688,32 @@ ir_jit_function_t *be_jit_compile(ir_jit_segment_t *const segment,
 		isa_if->handle_intrinsics(irg);
 	be_dump(DUMP_INITIAL, irg, "prepared");
 
-	return isa_if->jit_compile(segment, irg);
+	ir_jit_function_t *const res = isa_if->jit_compile(segment, irg);
+	/* the obstack lives as long as the isa, so do not leak a birg per call */
+	obstack_free(&obst, birg);
+	return res;
 }
 
 void be_emit_function(char *const buffer, ir_jit_function_t *const function)
 {
-	isa_if->emit_function(buffer, function);
+	isa_if->emit_function(buffer, buffer, function);
+}
+
+void be_jit_emit_function(char *const buffer, char const *const address,
+                          ir_jit_function_t *const function)
+{
+	isa_if->emit_function(buffer, address, function);
+}
+
+unsigned be_jit_get_stub_size(void)
+{
+	initialize_isa();
+	return isa_if->emit_jit_stub != NULL ? isa_if->jit_stub_size : 0;
+}
+
+void be_jit_emit_stub(char *const buffer, char const *const address,
+                      void const *const *const target, int32_t *const counter,
+                      void (*const resolve)(void *data), void *const data)
+{
+	isa_if->emit_jit_stub(buffer, address, target, counter, resolve, data);
 }
@@ -43,6 +43,7 @@ void be_init_copynone(void);
 void be_init_copyopt(void);
 void be_init_daemelspill(void);
 void be_init_dwarf(void);
+void be_init_funcorder(void);
 void be_init_gas(void);
 void be_init_listsched(void);
 void be_init_live(void);
@@ -82,6 +83,7 @@ void be_init_modules(void)
 	be_init_chordal_common();
 	be_init_copyopt();
 	be_init_dwarf();
+	be_init_funcorder();
 	be_init_gas();
 	be_init_live();
 	be_init_loopana();
@@ -149,17 +151,11 @@ static bool set_opt_module(void *const data, size_t const length, char const *co
 	(void)length;
 
 	const module_opt_data_t *moddata = (module_opt_data_t*)data;
-	bool                     res     = false;
-	for (const be_module_list_entry_t *module = *(moddata->list_head);
-	     module != NULL; module = module->next) {
-		if (streq(module->name, opt)) {
-			*(moddata->var) = module->data;
-			res = true;
-			break;
-		}
-	}
-
-	return res;
+	void                    *module  = be_find_module(*moddata->list_head, opt);
+	if (module == NULL)
+		return false;
+	*(moddata->var) = module;
+	return true;
 }
 
 /**
@@ -219,6 +215,17 @@ void be_add_module_to_list(be_module_list_entry_t **list_head, const char *name,
 	*list_head  = entry;
 }
 
+void *be_find_module(be_module_list_entry_t const *const list_head,
+                     char const *const name)
+{
+	for (be_module_list_entry_t const *module = list_head; module != NULL;
+	     module = module->next) {
+		if (streq(module->name, name))
+			return module->data;
+	}
+	return NULL;
+}
+
 /**
  * Add an option for a module.
  */
@@ -1741,7 +1741,7 @@ static void be_pref_alloc_cls(void)
 
 	DB((dbg, LEVEL_2, "=== Allocating registers of %s ===\n", cls->name));
 
-	irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+	irg_walk_graph_by_idx(irg, firm_clear_link, NULL);
 
 	irg_block_walk_graph(irg, NULL, analyze_block, NULL);
 	combine_congruence_classes();
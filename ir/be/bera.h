@@ -58,4 +58,15 @@ typedef void (*allocate_func)(ir_graph *irg, const regalloc_if_t *regif);
 
 void be_register_allocator(const char *name, allocate_func allocator);
 
+/**
+ * Returns the register allocator registered as @p name or NULL.
+ */
+allocate_func be_find_register_allocator(char const *name);
+
+/**
+ * Selects @p allocator for the following graphs and returns the previously
+ * selected one.
+ */
+allocate_func be_select_register_allocator(allocate_func allocator);
+
 #endif
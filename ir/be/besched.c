@@ -153,6 +153,18 @@ void be_register_scheduler(const char *name, schedule_func func)
 	be_add_module_to_list(&schedulers, name, (void*)func);
 }
 
+schedule_func be_find_scheduler(char const *const name)
+{
+	return (schedule_func)be_find_module(schedulers, name);
+}
+
+schedule_func be_select_scheduler(schedule_func const func)
+{
+	schedule_func const prev = scheduler;
+	scheduler = func;
+	return prev;
+}
+
 void be_schedule_graph(ir_graph *irg)
 {
 	scheduler(irg);
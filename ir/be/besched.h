@@ -241,6 +241,17 @@ typedef void (*schedule_func) (ir_graph *irg);
  */
 void be_register_scheduler(const char *name, schedule_func func);
 
+/**
+ * Returns the scheduler registered as @p name or NULL.
+ */
+schedule_func be_find_scheduler(char const *name);
+
+/**
+ * Selects @p func for the following graphs and returns the previously
+ * selected scheduler.
+ */
+schedule_func be_select_scheduler(schedule_func func);
+
 /**
  * schedule a graph with the currently selected scheduler.
  */
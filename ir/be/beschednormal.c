@@ -314,7 +314,7 @@ static void sched_normal(ir_graph *irg)
 
 	obstack_init(&obst);
 
-	irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+	irg_walk_graph_by_idx(irg, firm_clear_link, NULL);
 	irg_walk_graph(irg, normal_cost_walker,  NULL, NULL);
 	irg_walk_graph(irg, collect_roots, NULL, NULL);
 	ir_heights_t *heights = heights_new(irg);
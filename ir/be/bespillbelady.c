@@ -842,7 +842,7 @@ static void be_spill_belady(ir_graph *irg, const arch_register_class_t *rcls,
 
 	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK);
 	stat_ev_tim_push();
-	irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+	irg_walk_graph_by_idx(irg, firm_clear_link, NULL);
 	stat_ev_tim_pop("belady_time_clear_links");
 
 	/* init belady env */
@@ -14,6 +14,7 @@
 #include "debug.h"
 #include "util.h"
 #include "set.h"
+#include "sbitset.h"
 #include "array.h"
 #include "irgwalk.h"
 #include "ircons.h"
@@ -62,7 +63,7 @@ struct be_fec_env_t {
 	struct obstack         obst;
 	ir_graph              *irg;
 	spill_t              **spills;
-	unsigned              *spills_set;
+	sbitset_t              spills_set;
 	ir_node              **reloads;
 	affinity_edge_t      **affinity_edges;
 	set                   *memperms;
@@ -103,7 +104,7 @@ static int cmp_affinity(const void *d1, const void *d2)
 static spill_t *get_spill(be_fec_env_t *env, ir_node *node)
 {
 	(void)env;
-	assert(rbitset_is_set(env->spills_set, get_irn_idx(node)));
+	assert(sbitset_is_set(&env->spills_set, get_irn_idx(node)));
 	return (spill_t*)get_irn_link(node);
 }
 
@@ -154,7 +155,7 @@ static spill_t *collect_spill(be_fec_env_t *env, ir_node *node, spillweb_t *web)
 
 	/* already in spill set? */
 	unsigned idx = get_irn_idx(node);
-	if (rbitset_is_set(env->spills_set, idx)) {
+	if (sbitset_is_set(&env->spills_set, idx)) {
 		spill_t *spill = get_spill(env, node);
 		/* create a new web if necesary */
 		spillweb_t *new_web = spill->web;
@@ -170,7 +171,7 @@ static spill_t *collect_spill(be_fec_env_t *env, ir_node *node, spillweb_t *web)
 		spill->web = new_web;
 		return spill;
 	}
-	rbitset_set(env->spills_set, idx);
+	sbitset_set(&env->spills_set, idx);
 
 	spill_t *spill = OALLOC(&env->obst, spill_t);
 	/* insert into set of spills if not already there */
@@ -226,7 +227,7 @@ void be_load_needs_frame_entity(be_fec_env_t *const env, ir_node *const node,
 	merge_slotsizes(spill->web, slot_size, slot_po2align);
 }
 
-static int merge_interferences(be_fec_env_t *env, bitset_t** interferences,
+static int merge_interferences(be_fec_env_t *env, sbitset_t *interferences,
                                int* spillslot_unionfind, int s1, int s2)
 {
 	/* merge spillslots and interferences */
@@ -238,13 +239,13 @@ static int merge_interferences(be_fec_env_t *env, bitset_t** interferences,
 		s2 = t;
 	}
 
-	bitset_or(interferences[s1], interferences[s2]);
+	sbitset_or(&interferences[s1], &interferences[s2]);
 
 	/* update other interferences */
 	for (size_t i = 0, n = ARR_LEN(env->spills); i < n; ++i) {
-		bitset_t *intfs = interferences[i];
-		if (bitset_is_set(intfs, s2))
-			bitset_set(intfs, s1);
+		sbitset_t *intfs = &interferences[i];
+		if (sbitset_is_set(intfs, s2))
+			sbitset_set(intfs, s1);
 	}
 
 	return res;
@@ -268,13 +269,15 @@ static void do_greedy_coalescing(be_fec_env_t *env)
 	struct obstack data;
 	obstack_init(&data);
 
-	bitset_t **interferences       = OALLOCN(&data, bitset_t*, spillcount);
+	/* interferences are usually sparse, so use sparse bitsets instead of a
+	 * quadratic matrix */
+	sbitset_t *interferences       = OALLOCN(&data, sbitset_t, spillcount);
 	int       *spillslot_unionfind = OALLOCN(&data, int,       spillcount);
 
 	uf_init(spillslot_unionfind, spillcount);
 
 	for (size_t i = 0; i < spillcount; ++i) {
-		interferences[i] = bitset_obstack_alloc(&data, spillcount);
+		sbitset_init(&interferences[i], spillcount);
 	}
 
 	/* construct interferences */
@@ -291,8 +294,8 @@ static void do_greedy_coalescing(be_fec_env_t *env)
 			if (be_memory_values_interfere(spill1, spill2)) {
 				DB((dbg, LEVEL_1, "Slot %d and %d interfere\n", i, i2));
 
-				bitset_set(interferences[i], i2);
-				bitset_set(interferences[i2], i);
+				sbitset_set(&interferences[i], i2);
+				sbitset_set(&interferences[i2], i);
 			}
 		}
 	}
@@ -307,8 +310,8 @@ static void do_greedy_coalescing(be_fec_env_t *env)
 		int s2 = uf_find(spillslot_unionfind, edge->slot2);
 
 		/* test if values interfere */
-		if (bitset_is_set(interferences[s1], s2)) {
-			assert(bitset_is_set(interferences[s2], s1));
+		if (sbitset_is_set(&interferences[s1], s2)) {
+			assert(sbitset_is_set(&interferences[s2], s1));
 			continue;
 		}
 
@@ -331,8 +334,8 @@ static void do_greedy_coalescing(be_fec_env_t *env)
 
 			/* Test if values interfere, we have to test n1-n2 and n2-n1,
 			 * because only 1 side gets updated when node merging occurs */
-			if (bitset_is_set(interferences[s1], s2)) {
-				assert(bitset_is_set(interferences[s2], s1));
+			if (sbitset_is_set(&interferences[s1], s2)) {
+				assert(sbitset_is_set(&interferences[s2], s1));
 				continue;
 			}
 
@@ -353,6 +356,10 @@ static void do_greedy_coalescing(be_fec_env_t *env)
 		spills[i]->spillslot = uf_find(spillslot_unionfind, i);
 	}
 
+	for (size_t i = 0; i < spillcount; ++i) {
+		sbitset_free(&interferences[i]);
+	}
+
 	obstack_free(&data, 0);
 }
 
@@ -558,7 +565,7 @@ be_fec_env_t *be_new_frame_entity_coalescer(ir_graph *irg)
 	obstack_init(&env->obst);
 	env->irg            = irg;
 	env->spills         = NEW_ARR_F(spill_t*, 0);
-	env->spills_set     = rbitset_malloc(get_irg_last_idx(irg));
+	sbitset_init(&env->spills_set, get_irg_last_idx(irg));
 	env->reloads        = NEW_ARR_F(ir_node*, 0);
 	env->affinity_edges = NEW_ARR_F(affinity_edge_t*, 0);
 	env->memperms       = new_set(cmp_memperm, 10);
@@ -576,7 +583,7 @@ void be_free_frame_entity_coalescer(be_fec_env_t *env)
 	DEL_ARR_F(env->reloads);
 	DEL_ARR_F(env->affinity_edges);
 	DEL_ARR_F(env->spills);
-	free(env->spills_set);
+	sbitset_free(&env->spills_set);
 	obstack_free(&env->obst, NULL);
 
 	free(env);
@@ -330,7 +330,8 @@ static void spill_node(spill_env_t *env, spill_info_t *spillinfo)
  * Tests whether value @p arg is available before node @p reloader
  * @returns true if value is available
  */
-static bool is_value_available(spill_env_t *env, const ir_node *arg)
+static bool is_value_available(spill_env_t *env, const ir_node *arg,
+                               const ir_node *reloader)
 {
 	if (is_Unknown(arg) || is_NoMem(arg))
 		return true;
@@ -344,7 +345,16 @@ static bool is_value_available(spill_env_t *env, const ir_node *arg)
 	if (arch_irn_is_ignore(arg))
 		return true;
 
-	return false;
+	/* A value which is not spilled and still lives in a register at the
+	 * reloader can be used without extending its live range. This allows
+	 * rematerializing address computations based on a live pointer. */
+	if (ir_nodehashmap_get(spill_info_t, &env->spillmap, arg) != NULL)
+		return false;
+	for (int i = 0, n = get_irn_arity(reloader); i < n; ++i) {
+		if (get_irn_n(reloader, i) == arg)
+			return true;
+	}
+	return be_value_live_after(arg, reloader);
 }
 
 /**
@@ -382,7 +392,7 @@ static int check_remat_conditions_costs(spill_env_t *env,
 
 	int argremats = 0;
 	foreach_irn_in(insn, i, arg) {
-		if (is_value_available(env, arg))
+		if (is_value_available(env, arg, reloader))
 			continue;
 
 		/* we have to rematerialize the argument as well */
@@ -413,7 +423,7 @@ static ir_node *do_remat(spill_env_t *env, ir_node *spilled, ir_node *reloader)
 {
 	ir_node **ins = ALLOCAN(ir_node*, get_irn_arity(spilled));
 	foreach_irn_in(spilled, i, arg) {
-		if (is_value_available(env, arg)) {
+		if (is_value_available(env, arg, reloader)) {
 			ins[i] = arg;
 		} else {
 			ins[i] = do_remat(env, arg, reloader);
@@ -585,7 +595,11 @@ void be_insert_spills_reloads(spill_env_t *env)
 				rld->remat_cost_delta = remat_cost_delta;
 				ir_node *block        = get_block(reloader);
 				double   freq         = get_block_execfreq(block);
-				all_remat_costs      += remat_cost_delta * freq;
+				/* reloaders where a remat is cheaper get rematerialized
+				 * anyway, so only the more expensive ones count against
+				 * saving the spill */
+				if (remat_cost_delta > 0)
+					all_remat_costs += remat_cost_delta * freq;
 				DBG((dbg, LEVEL_2, "\tremat costs delta before %+F: "
 				     "%d (rel %f)\n", reloader, remat_cost_delta,
 				     remat_cost_delta * freq));
@@ -14,6 +14,7 @@
 
 #include "obst.h"
 #include "pmap.h"
+#include "set.h"
 #include "debug.h"
 
 #include "irgwalk.h"
@@ -1600,7 +1600,7 @@ static void ia32_lower_for_target(void)
 
 	/* replace floating point operations by function calls */
 	if (ia32_cg_config.use_softfloat) {
-		lower_floating_point();
+		lower_floating_point(false);
 		be_after_irp_transform("lower-fp");
 	}
 
@@ -1681,6 +1681,8 @@ static arch_isa_if_t const ia32_isa_if = {
 	.generate_code         = ia32_generate_code,
 	.jit_compile           = ia32_jit_compile,
 	.emit_function         = ia32_emit_jit_function,
+	.jit_stub_size         = IA32_JIT_STUB_SIZE,
+	.emit_jit_stub         = ia32_emit_jit_stub,
 	.lower_for_target      = ia32_lower_for_target,
 	.is_valid_clobber      = ia32_is_valid_clobber,
 	.get_op_estimated_cost = ia32_get_op_estimated_cost,
@@ -112,7 +112,8 @@ static bool block_needs_label(const ir_node *block)
 static char *get_unique_label(char *buf, size_t buflen, const char *prefix)
 {
 	static unsigned long id = 0;
-	snprintf(buf, buflen, "%s%s%lu", be_gas_get_private_prefix(), prefix, ++id);
+	snprintf(buf, buflen, "%s%s%lu%s", be_gas_get_private_prefix(), prefix,
+	         ++id, be_gas_get_label_scope());
 	return buf;
 }
 
@@ -661,7 +662,8 @@ x86_condition_code_t ia32_determine_final_cc(ir_node const *const node,
 static void ia32_emit_exc_label(const ir_node *node)
 {
 	be_emit_string(be_gas_insn_label_prefix());
-	be_emit_irprintf("%lu", get_ia32_exc_label_id(node));
+	be_emit_irprintf("%lu%s", get_ia32_exc_label_id(node),
+	                 be_gas_get_label_scope());
 }
 
 /**
@@ -1495,11 +1497,13 @@ static const lc_opt_table_entry_t ia32_emitter_options[] = {
 };
 
 static unsigned emit_jit_entity_relocation_asm(char *const buffer,
+                                               char const *const address,
                                                uint8_t const be_kind,
                                                ir_entity *const entity,
                                                int32_t const offset)
 {
 	(void)buffer;
+	(void)address;
 	assert(buffer == NULL);
 	if (be_kind == IA32_RELOCATION_RELJUMP) {
 		be_emit_irprintf("\t.long %"PRId32"\n", offset);
@@ -1555,7 +1559,11 @@ void ia32_emit_function(ir_graph *const irg)
 		 * normal .s file with .byte directives etc. */
 		ir_jit_segment_t *const segment = be_new_jit_segment();
 		ir_jit_function_t *const function = ia32_emit_jit(segment, irg);
-		be_jit_emit_as_asm(function, emit_jit_entity_relocation_asm);
+		static const be_jit_emit_interface_t asm_emit_interface = {
+			.relocation = emit_jit_entity_relocation_asm,
+			.branch     = ia32_enc_branch,
+		};
+		be_jit_emit_as_asm(function, &asm_emit_interface);
 		be_destroy_jit_segment(segment);
 	} else {
 		emit_function_text(irg, &exc_list);
@@ -91,13 +91,18 @@ static void enc_relocation(x86_imm32_t const *const imm)
 	be_emit_reloc_entity(4, imm->kind, entity, offset);
 }
 
-static void enc_jmp_destination(ir_node const *const cfop)
+/**
+ * Emits a branch to the target of @p cfop, which is relaxed to its rel8 form
+ * when the fragments are laid out.
+ */
+static void enc_branch(uint8_t const short_opcode, ir_node const *const cfop)
 {
 	assert(get_irn_mode(cfop) == mode_X);
 	ir_node const *const dest_block = be_emit_get_cfop_target(cfop);
 	unsigned const fragment_num
 		= PTR_TO_INT(ir_nodehashmap_get(void, &block_fragmentnum, dest_block));
-	be_emit_reloc_fragment(4, IA32_RELOCATION_RELJUMP, fragment_num, -4);
+	unsigned const len = short_opcode == 0xEB ? 5 : 6;
+	be_emit_reloc_branch(len, 2, short_opcode, fragment_num);
 }
 
 /* end emit routines, all emitters following here should only use the functions
@@ -913,8 +918,7 @@ static void enc_call(ir_node const *const node)
 
 static void enc_jmp(ir_node const *const cfop)
 {
-	be_emit8(0xE9);
-	enc_jmp_destination(cfop);
+	enc_branch(0xEB, cfop);
 }
 
 static void enc_jump(const ir_node *node)
@@ -926,16 +930,12 @@ static void enc_jump(const ir_node *node)
 static void enc_jcc(x86_condition_code_t pnc, ir_node const *const cfop)
 {
 	unsigned char cc = pnc2cc(pnc);
-	be_emit8(0x0F);
-	be_emit8(0x80 + cc);
-	enc_jmp_destination(cfop);
+	enc_branch(0x70 + cc, cfop);
 }
 
 static void enc_jp(bool odd, ir_node const *const cfop)
 {
-	be_emit8(0x0F);
-	be_emit8(0x8A + odd);
-	enc_jmp_destination(cfop);
+	enc_branch(0x7A + odd, cfop);
 }
 
 static void enc_ia32_jcc(const ir_node *node)
@@ -975,14 +975,9 @@ static void enc_ia32_jcc(const ir_node *node)
 		if (cc & x86_cc_negated) {
 			enc_jp(false, projs.t);
 		} else {
-			/* we need a local label if the false proj is a fallthrough
-			 * as the falseblock might have no label emitted then */
-			if (fallthrough) {
-				be_emit8(0x7A);
-				be_emit8(0x06);  // jp + 6
-			} else {
-				enc_jp(false, projs.f);
-			}
+			/* every block has a fragment, so this works for a fallthrough
+			 * false proj, too */
+			enc_jp(false, projs.f);
 		}
 	}
 	enc_jcc(cc, projs.t);
@@ -1422,6 +1417,7 @@ static void enc_nop_callback(char *buffer, unsigned size)
 }
 
 static unsigned enc_relocation_callback(char *const buffer,
+                                        char const *const address,
                                         uint8_t const be_kind,
                                         ir_entity *const entity,
                                         int32_t const offset)
@@ -1436,7 +1432,7 @@ static unsigned enc_relocation_callback(char *const buffer,
 			panic("Could not resolve address of entity %+F", entity);
 		intptr_t addr = entity_addr + offset;
 		if (be_kind == X86_IMM_PCREL)
-			addr -= (intptr_t)buffer;
+			addr -= (intptr_t)address;
 		value = (uint32_t)addr;
 		if ((intptr_t)value != addr)
 			panic("Overflow in relocation");
@@ -1446,11 +1442,127 @@ static unsigned enc_relocation_callback(char *const buffer,
 	return 4;
 }
 
-void ia32_emit_jit_function(char *buffer, ir_jit_function_t *const function)
+unsigned ia32_enc_branch(char *const buffer, uint8_t const short_opcode,
+                         bool const is_short, int32_t const displacement)
+{
+	if (is_short) {
+		assert(INT8_MIN <= displacement && displacement <= INT8_MAX);
+		buffer[0] = (char)short_opcode;
+		buffer[1] = (char)displacement;
+		return 2;
+	}
+
+	unsigned len;
+	if (short_opcode == 0xEB) {
+		buffer[0] = (char)0xE9;
+		len       = 1;
+	} else {
+		/* jcc rel32 is 0F 80+cc, jcc rel8 is 70+cc */
+		buffer[0] = 0x0F;
+		buffer[1] = (char)(short_opcode + 0x10);
+		len       = 2;
+	}
+	uint32_t const value = (uint32_t)displacement;
+	memcpy(buffer + len, &value, 4);
+	return len + 4;
+}
+
+void ia32_emit_jit_function(char *const buffer, char const *const address,
+                            ir_jit_function_t *const function)
 {
 	static const be_jit_emit_interface_t jit_emit_interface = {
 		.nops       = enc_nop_callback,
 		.relocation = enc_relocation_callback,
+		.branch     = ia32_enc_branch,
 	};
-	be_jit_emit_memory(buffer, function, &jit_emit_interface);
+	be_jit_emit_memory(buffer, address, function, &jit_emit_interface);
+}
+
+/** Offset of the code calling the resolver in a stub. */
+#define STUB_RESOLVE_OFFSET 20
+
+static char *stub_put8(char *const p, uint8_t const byte)
+{
+	*p = (char)byte;
+	return p + 1;
+}
+
+static char *stub_put32(char *const p, uint32_t const value)
+{
+	memcpy(p, &value, 4);
+	return p + 4;
+}
+
+/**
+ * Appends the displacement of a rel32 operand at @p p to @p dest. The stub is
+ * executed @p delta bytes after the buffer it is written to.
+ */
+static char *stub_put_rel32(char *const p, ptrdiff_t const delta,
+                            void const *const dest)
+{
+	uintptr_t const next = (uintptr_t)p + (uintptr_t)delta + 4;
+	return stub_put32(p, (uint32_t)((uintptr_t)dest - next));
+}
+
+void ia32_emit_jit_stub(char *const buffer, char const *const address,
+                        void const *const *const target,
+                        int32_t *const counter, void (*const resolve)(void*),
+                        void *const data)
+{
+	assert(counter == NULL || target != NULL);
+	ptrdiff_t const delta        = address - buffer;
+	char     *const resolve_code = buffer + STUB_RESOLVE_OFFSET;
+	char           *p            = buffer;
+	if (counter != NULL) {
+		/* lock decl counter; jle resolve_code */
+		p = stub_put8(p, 0xF0);
+		p = stub_put8(p, 0xFF);
+		p = stub_put8(p, 0x0D);
+		p = stub_put32(p, (uint32_t)(uintptr_t)counter);
+		p = stub_put8(p, 0x0F);
+		p = stub_put8(p, 0x8E);
+		p = stub_put_rel32(p, delta, address + STUB_RESOLVE_OFFSET);
+	}
+	if (target != NULL) {
+		/* jmp *target */
+		p = stub_put8(p, 0xFF);
+		p = stub_put8(p, 0x25);
+		p = stub_put32(p, (uint32_t)(uintptr_t)target);
+	} else {
+		/* jmp resolve_code */
+		p = stub_put8(p, 0xE9);
+		p = stub_put_rel32(p, delta, address + STUB_RESOLVE_OFFSET);
+	}
+	assert(p <= resolve_code);
+	memset(p, 0xCC, resolve_code - p);
+
+	/* Keep the argument registers and align the stack for the resolver, which
+	 * rewrites the stub, then start over. */
+	p = resolve_code;
+	p = stub_put8(p, 0x55);                       /* push %ebp */
+	p = stub_put8(p, 0x89);                       /* mov %esp, %ebp */
+	p = stub_put8(p, 0xE5);
+	p = stub_put8(p, 0x50);                       /* push %eax */
+	p = stub_put8(p, 0x51);                       /* push %ecx */
+	p = stub_put8(p, 0x52);                       /* push %edx */
+	p = stub_put8(p, 0x83);                       /* and $-16, %esp */
+	p = stub_put8(p, 0xE4);
+	p = stub_put8(p, 0xF0);
+	p = stub_put8(p, 0x83);                       /* sub $12, %esp */
+	p = stub_put8(p, 0xEC);
+	p = stub_put8(p, 0x0C);
+	p = stub_put8(p, 0x68);                       /* push $data */
+	p = stub_put32(p, (uint32_t)(uintptr_t)data);
+	p = stub_put8(p, 0xE8);                       /* call resolve */
+	p = stub_put_rel32(p, delta, (void const*)(uintptr_t)resolve);
+	p = stub_put8(p, 0x8D);                       /* lea -12(%ebp), %esp */
+	p = stub_put8(p, 0x65);
+	p = stub_put8(p, 0xF4);
+	p = stub_put8(p, 0x5A);                       /* pop %edx */
+	p = stub_put8(p, 0x59);                       /* pop %ecx */
+	p = stub_put8(p, 0x58);                       /* pop %eax */
+	p = stub_put8(p, 0x5D);                       /* pop %ebp */
+	p = stub_put8(p, 0xE9);                       /* jmp address */
+	p = stub_put_rel32(p, delta, address);
+	assert(p == buffer + IA32_JIT_STUB_SIZE);
 }
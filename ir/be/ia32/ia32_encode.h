@@ -11,6 +11,7 @@
 #ifndef FIRM_BE_IA32_IA32_ENCODE_H
 #define FIRM_BE_IA32_IA32_ENCODE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "firm_types.h"
 #include "jit.h"
@@ -21,7 +22,21 @@ enum {
 
 ir_jit_function_t *ia32_emit_jit(ir_jit_segment_t *segment, ir_graph *irg);
 
-void ia32_emit_jit_function(char *buffer, ir_jit_function_t *function);
+void ia32_emit_jit_function(char *buffer, char const *address,
+                            ir_jit_function_t *function);
+
+/** Size of a call-through stub, see be_jit_emit_stub(). */
+#define IA32_JIT_STUB_SIZE 54
+
+void ia32_emit_jit_stub(char *buffer, char const *address,
+                        void const *const *target, int32_t *counter,
+                        void (*resolve)(void *data), void *data);
+
+/**
+ * Encodes a jmp or jcc. @p short_opcode is the opcode of the rel8 form.
+ */
+unsigned ia32_enc_branch(char *buffer, uint8_t short_opcode, bool is_short,
+                         int32_t displacement);
 
 void ia32_enc_simple(uint8_t opcode);
 
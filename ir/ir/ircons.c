@@ -258,18 +258,15 @@ void mature_immBlock(ir_node *block)
 		/* Attach a Bad predecessor if there is no other. This is necessary to
 		 * fulfill the invariant that all nodes can be found through reverse
 		 * edges from the start block. */
-		ir_node             **new_in;
 		struct obstack *const obst    = get_irg_obstack(irg);
-		size_t                n_preds = ARR_LEN(block->in) - 1;
+		int                   n_preds = get_irn_arity(block);
 		if (n_preds == 0) {
-			n_preds   = 1;
-			new_in    = NEW_ARR_D(ir_node*, obst, 2);
-			new_in[0] = NULL;
-			new_in[1] = new_r_Bad(irg, mode_X);
-		} else {
-			new_in = DUP_ARR_D(ir_node*, obst, block->in);
+			n_preds = 1;
+			append_irn_in(block, new_r_Bad(irg, mode_X));
 		}
-		DEL_ARR_F(block->in);
+		ir_node **const new_in = OALLOCN(obst, ir_node*, n_preds + 1);
+		MEMCPY(new_in, block->in, n_preds + 1);
+		free_irn_heap_in(block);
 		block->in                     = new_in;
 		block->attr.block.backedge    = new_backedge_arr(obst, n_preds);
 		block->attr.block.dynamic_ins = false;
@@ -418,7 +415,7 @@ void add_immBlock_pred(ir_node *block, ir_node *jmp)
 	assert(!get_Block_matured(block) && "Error: Block already matured!\n");
 	assert(jmp->kind == k_ir_node);
 
-	ARR_APP1(ir_node *, block->in, jmp);
+	append_irn_in(block, jmp);
 }
 
 void set_cur_block(ir_node *target)
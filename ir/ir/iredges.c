@@ -12,47 +12,23 @@
  *   These are out-edges (also called def-use edges) that are dynamically
  *   updated as the graph changes.
  */
+#include <limits.h>
+#include <string.h>
+
 #include "irnode_t.h"
 #include "iropt_t.h"
 #include "iredgekinds.h"
 #include "iredges_t.h"
-#include "irgwalk.h"
+#include "irgwalk_t.h"
 #include "irnodemap.h"
 #include "irdump_t.h"
 #include "irprintf.h"
+#include "compiler.h"
 #include "debug.h"
 #include "set.h"
 #include "bitset.h"
 
-#include "iredgeset.h"
-#include "hashptr.h"
-
-#define DO_REHASH
-#define SCALAR_RETURN
-#define HashSet                   ir_edgeset_t
-#define HashSetIterator           ir_edgeset_iterator_t
-#define ValueType                 ir_edge_t*
-#define NullValue                 NULL
-#define DeletedValue              ((ir_edge_t*)-1)
-#define Hash(this,key)            (hash_ptr(key->src) ^ (key->pos * 40013))
-#define KeysEqual(this,key1,key2) ((key1->src) == (key2->src) && (key1->pos == key2->pos))
-#define SetRangeEmpty(ptr,size)   memset(ptr, 0, (size) * sizeof((ptr)[0]))
-
-#define hashset_init            ir_edgeset_init
-void ir_edgeset_init_size(ir_edgeset_t *self, size_t size);
-#define hashset_init_size       ir_edgeset_init_size
-#define hashset_destroy         ir_edgeset_destroy
-#define hashset_insert          ir_edgeset_insert
-#define hashset_remove          ir_edgeset_remove
-ir_edge_t *ir_edgeset_find(const ir_edgeset_t *self, const ir_edge_t*);
-#define hashset_find            ir_edgeset_find
-size_t ir_edgeset_size(const ir_edgeset_t *self);
-#define hashset_size            ir_edgeset_size
-#define hashset_iterator_init   ir_edgeset_iterator_init
-#define hashset_iterator_next   ir_edgeset_iterator_next
-#define hashset_remove_iterator ir_edgeset_remove_iterator
-
-#include "hashset.c.h"
+#include "obst.h"
 
 /**
  * A function that allows for setting an edge.
@@ -123,74 +99,170 @@ static const ir_edge_kind_info_t edge_kind_info[EDGE_KIND_LAST+1] = {
 DEBUG_ONLY(static firm_dbg_module_t *dbg;)
 
 /**
- * If set to 1, the list heads are checked every time an edge is changed.
+ * If set to 1, the out arrays are checked every time an edge is changed.
  */
 static int edges_dbg = 0;
 
 /**
- * Returns an ID for the given edge.
+ * Returns whether a node has edge information of the given kind. Only blocks
+ * have block edges.
  */
-static inline long edge_get_id(const ir_edge_t *e)
+static bool has_edge_info(const ir_node *irn, ir_edge_kind_t kind)
 {
-	return (long)e;
+	return kind != EDGE_KIND_BLOCK || is_Block(irn);
 }
 
+/** Marks an input without an edge in the slot array of a node. */
+#define NO_SLOT UINT_MAX
+
+/** Minimum log2 size of a slot array, so it can hold a free list link. */
+#define SLOTS_MIN_LOG (sizeof(void*) <= 2 * sizeof(unsigned) ? 1 : 2)
+
 void edges_init_graph_kind(ir_graph *irg, ir_edge_kind_t kind)
 {
 	if (edges_activated_kind(irg, kind)) {
-		irg_edge_info_t *info   = get_irg_edge_info(irg, kind);
-		size_t           amount = get_irg_last_idx(irg) * 5 / 4;
+		irg_edge_info_t *info = get_irg_edge_info(irg, kind);
 
-		if (info->allocated) {
-			amount = ir_edgeset_size(&info->edges);
-			ir_edgeset_destroy(&info->edges);
+		if (info->allocated)
 			obstack_free(&info->edges_obst, NULL);
-		}
 		obstack_init(&info->edges_obst);
-		INIT_LIST_HEAD(&info->free_edges);
-		ir_edgeset_init_size(&info->edges, amount);
+		memset(info->free_outs,  0, sizeof(info->free_outs));
+		memset(info->free_slots, 0, sizeof(info->free_slots));
 		info->allocated = 1;
 	}
 }
 
 /**
- * Change the out count
- *
- * @param info  the edge info
- * @param ofs   amount to change the edge count
+ * Allocates an array with 2^log elements of size elem_size. Arrays freed
+ * before are reused.
  */
-static inline void edge_change_cnt(irn_edge_info_t *const info, int const ofs)
+static void *alloc_array(irg_edge_info_t *info, void **free_list,
+                         unsigned log, size_t elem_size)
+{
+	void *res = free_list[log];
+	if (res != NULL) {
+		free_list[log] = *(void**)res;
+		return res;
+	}
+	return obstack_alloc(&info->edges_obst, elem_size << log);
+}
+
+static void free_array(void **free_list, unsigned log, void *array)
 {
-	assert((unsigned)info->out_count + ofs < 1U << 31);
-	info->out_count += ofs;
+	*(void**)array = free_list[log];
+	free_list[log] = array;
+}
+
+/**
+ * Returns the index of the edge of input @p pos of a node in the outs array
+ * of the input or NO_SLOT if there is no such edge.
+ */
+static unsigned get_in_slot(const irn_edge_info_t *info, int pos)
+{
+	unsigned idx = pos + 1;
+	if (info->in_slots == NULL || idx >= 1U << info->slots_log)
+		return NO_SLOT;
+	return info->in_slots[idx];
+}
+
+static void set_in_slot(irg_edge_info_t *irg_info, irn_edge_info_t *info,
+                        int pos, unsigned slot)
+{
+	unsigned idx  = pos + 1;
+	unsigned size = info->in_slots != NULL ? 1U << info->slots_log : 0;
+	if (idx >= size) {
+		if (slot == NO_SLOT)
+			return;
+
+		unsigned log = info->in_slots != NULL ? info->slots_log : SLOTS_MIN_LOG;
+		while (idx >= 1U << log)
+			++log;
+		unsigned *slots = (unsigned*)alloc_array(irg_info, irg_info->free_slots,
+		                                         log, sizeof(*slots));
+		if (size > 0) {
+			memcpy(slots, info->in_slots, size * sizeof(*slots));
+			free_array(irg_info->free_slots, info->slots_log, info->in_slots);
+		}
+		for (unsigned i = size, n = 1U << log; i < n; ++i)
+			slots[i] = NO_SLOT;
+		info->in_slots  = slots;
+		info->slots_log = log;
+	}
+	info->in_slots[idx] = slot;
 }
 
 /**
- * Verify the edge list of a node, i.e. ensure it's a loop:
- * head -> e_1 -> ... -> e_n -> head
+ * Appends an edge to the outs array of a node.
+ * @return the index of the new edge
  */
-static inline void verify_list_head(ir_node *irn, ir_edge_kind_t kind)
-{
-	int                     num    = 0;
-	pset                   *lh_set = pset_new_ptr(16);
-	const struct list_head *head   = &get_irn_edge_info(irn, kind)->outs_head;
-	const struct list_head *pos;
-
-	list_for_each(pos, head) {
-		if (pset_find_ptr(lh_set, pos)) {
-			const ir_edge_t *edge = list_entry(pos, ir_edge_t, list);
-
-			ir_fprintf(stderr, "EDGE Verifier: edge list broken (self loop not to head) for %+F:\n", irn);
-			fprintf(stderr, "- at list entry %d\n", num);
-			if (edge->src)
-				ir_fprintf(stderr, "- edge(%ld) %+F(%d)\n", edge_get_id(edge), edge->src, edge->pos);
-			break;
+static unsigned append_out(irg_edge_info_t *irg_info, irn_edge_info_t *info,
+                           ir_node *src, int pos)
+{
+	unsigned const count = info->out_count;
+	if (info->outs == NULL || count == 1U << info->outs_log) {
+		unsigned   log  = info->outs != NULL ? info->outs_log + 1 : 0;
+		ir_edge_t *outs = (ir_edge_t*)alloc_array(irg_info, irg_info->free_outs,
+		                                          log, sizeof(*outs));
+		if (info->outs != NULL) {
+			memcpy(outs, info->outs, count * sizeof(*outs));
+			free_array(irg_info->free_outs, info->outs_log, info->outs);
 		}
-		num++;
-		pset_insert_ptr(lh_set, pos);
+		info->outs     = outs;
+		info->outs_log = log;
 	}
+	info->outs[count].src = src;
+	info->outs[count].pos = pos;
+	info->out_count       = count + 1;
+	return count;
+}
 
-	del_pset(lh_set);
+/**
+ * Removes the edge at index @p slot from the outs array of a node. The last
+ * edge takes its place.
+ */
+static void remove_out(irg_edge_info_t *irg_info, irn_edge_info_t *info,
+                       unsigned slot, ir_edge_kind_t kind)
+{
+	unsigned const last = --info->out_count;
+	if (slot != last) {
+		ir_edge_t const moved = info->outs[last];
+		info->outs[slot] = moved;
+		get_irn_edge_info(moved.src, kind)->in_slots[moved.pos + 1] = slot;
+	}
+	if (last == 0) {
+		free_array(irg_info->free_outs, info->outs_log, info->outs);
+		info->outs = NULL;
+	}
+}
+
+/**
+ * Verify the out array of a node, i.e. ensure that the slot of each edge at
+ * its source refers to the edge.
+ */
+static bool verify_outs(ir_node *irn, ir_edge_kind_t kind)
+{
+	bool                   fine = true;
+	irn_edge_info_t const *info = get_irn_edge_info(irn, kind);
+	for (unsigned i = 0; i < info->out_count; ++i) {
+		ir_edge_t const *const edge = &info->outs[i];
+		irn_edge_info_t *const src_info = get_irn_edge_info(edge->src, kind);
+		if (get_in_slot(src_info, edge->pos) != i) {
+			ir_fprintf(stderr, "Edge Verifier: edge %+F,%d at %+F not registered at its source\n",
+			           edge->src, edge->pos, irn);
+			fine = false;
+		}
+	}
+	return fine;
+}
+
+static void dump_outs(ir_node *irn, void *data)
+{
+	ir_edge_kind_t kind = *(ir_edge_kind_t*)data;
+	if (!has_edge_info(irn, kind))
+		return;
+	foreach_out_edge_kind(irn, e, kind) {
+		ir_printf("%+F %d\n", e->src, e->pos);
+	}
 }
 
 void edges_dump_kind(ir_graph *irg, ir_edge_kind_t kind)
@@ -198,13 +270,7 @@ void edges_dump_kind(ir_graph *irg, ir_edge_kind_t kind)
 	if (!edges_activated_kind(irg, kind))
 		return;
 
-	irg_edge_info_t       *info  = get_irg_edge_info(irg, kind);
-	ir_edgeset_t          *edges = &info->edges;
-	ir_edge_t             *e;
-	ir_edgeset_iterator_t  iter;
-	foreach_ir_edgeset(edges, e, iter) {
-		ir_printf("%+F %d\n", e->src, e->pos);
-	}
+	irg_walk_graph_by_idx(irg, dump_outs, &kind);
 }
 
 static void add_edge(ir_node *src, int pos, ir_node *tgt, ir_edge_kind_t kind,
@@ -213,34 +279,13 @@ static void add_edge(ir_node *src, int pos, ir_node *tgt, ir_edge_kind_t kind,
 	if (tgt == NULL)
 		return;
 	assert(edges_activated_kind(irg, kind));
-	irg_edge_info_t *info  = get_irg_edge_info(irg, kind);
-	ir_edgeset_t    *edges = &info->edges;
-
-	irn_edge_info_t  *tgt_info = get_irn_edge_info(tgt, kind);
-	struct list_head *head     = &tgt_info->outs_head;
-	assert(head->next && head->prev &&
-	       "target list head must have been initialized");
-
-	/* The old target was NULL, thus, the edge is newly created. */
-	ir_edge_t *edge;
-	if (list_empty(&info->free_edges)) {
-		edge = OALLOC(&info->edges_obst, ir_edge_t);
-	} else {
-		edge = list_entry(info->free_edges.next, ir_edge_t, list);
-		list_del(&edge->list);
-	}
+	irg_edge_info_t *info     = get_irg_edge_info(irg, kind);
+	irn_edge_info_t *tgt_info = get_irn_edge_info(tgt, kind);
+	irn_edge_info_t *src_info = get_irn_edge_info(src, kind);
+	assert(get_in_slot(src_info, pos) == NO_SLOT && "edge already present");
 
-	edge->src     = src;
-	edge->pos     = pos;
-#ifdef DEBUG_libfirm
-	edge->present = false;
-#endif
-
-	ir_edge_t *new_edge = ir_edgeset_insert(edges, edge);
-	assert(new_edge == edge);
-
-	list_add(&new_edge->list, head);
-	edge_change_cnt(tgt_info, +1);
+	unsigned slot = append_out(info, tgt_info, src, pos);
+	set_in_slot(info, src_info, pos, slot);
 }
 
 static void delete_edge(ir_node *src, int pos, ir_node *old_tgt,
@@ -250,28 +295,17 @@ static void delete_edge(ir_node *src, int pos, ir_node *old_tgt,
 		return;
 	assert(edges_activated_kind(irg, kind));
 
-	irg_edge_info_t *info  = get_irg_edge_info(irg, kind);
-	ir_edgeset_t    *edges = &info->edges;
-
-	/* Initialize the edge template to search in the set. */
-	ir_edge_t templ;
-	templ.src = src;
-	templ.pos = pos;
-
-	/* search the edge in the set. */
-	ir_edge_t *edge = ir_edgeset_find(edges, &templ);
-
-	/* mark the edge invalid if it was found */
-	if (edge == NULL)
+	/* nothing to do if the edge does not exist */
+	irn_edge_info_t *src_info = get_irn_edge_info(src, kind);
+	unsigned         slot     = get_in_slot(src_info, pos);
+	if (slot == NO_SLOT)
 		return;
 
-	list_del(&edge->list);
-	ir_edgeset_remove(edges, edge);
-	list_add(&edge->list, &info->free_edges);
-	edge->pos = -2;
-	edge->src = NULL;
 	irn_edge_info_t *old_tgt_info = get_irn_edge_info(old_tgt, kind);
-	edge_change_cnt(old_tgt_info, -1);
+	assert(old_tgt_info->outs[slot].src == src
+	    && old_tgt_info->outs[slot].pos == pos);
+	src_info->in_slots[pos + 1] = NO_SLOT;
+	remove_out(get_irg_edge_info(irg, kind), old_tgt_info, slot, kind);
 }
 
 static void edges_notify_edge_kind(ir_node *src, int pos, ir_node *tgt, ir_node *old_tgt, ir_edge_kind_t kind, ir_graph *irg)
@@ -289,38 +323,23 @@ static void edges_notify_edge_kind(ir_node *src, int pos, ir_node *tgt, ir_node
 	if (tgt == old_tgt)
 		return;
 
-	irg_edge_info_t *info  = get_irg_edge_info(irg, kind);
-	ir_edgeset_t    *edges = &info->edges;
-
 	/* The target is not NULL and the old target differs
-	 * from the new target, the edge shall be moved (if the
-	 * old target was != NULL) or added (if the old target was
-	 * NULL). */
-	irn_edge_info_t  *tgt_info = get_irn_edge_info(tgt, kind);
-	struct list_head *head     = &tgt_info->outs_head;
-	assert(head->next && head->prev &&
-	       "target list head must have been initialized");
-
-	/* Initialize the edge template to search in the set. */
-	ir_edge_t templ;
-	templ.src = src;
-	templ.pos = pos;
-
-	ir_edge_t *edge = ir_edgeset_find(edges, &templ);
-	assert(edge && "edge to redirect not found!");
-
-	list_move(&edge->list, head);
+	 * from the new target, the edge shall be moved. */
+	irg_edge_info_t *info     = get_irg_edge_info(irg, kind);
+	irn_edge_info_t *src_info = get_irn_edge_info(src, kind);
+	unsigned         slot     = get_in_slot(src_info, pos);
+	assert(slot != NO_SLOT && "edge to redirect not found!");
+
 	irn_edge_info_t *old_tgt_info = get_irn_edge_info(old_tgt, kind);
-	edge_change_cnt(old_tgt_info, -1);
-	edge_change_cnt(tgt_info,     +1);
+	irn_edge_info_t *tgt_info     = get_irn_edge_info(tgt, kind);
+	remove_out(info, old_tgt_info, slot, kind);
+	src_info->in_slots[pos + 1] = append_out(info, tgt_info, src, pos);
 
 #ifndef DEBUG_libfirm
-	/* verify list heads */
+	/* verify out arrays */
 	if (edges_dbg) {
-		if (tgt)
-			verify_list_head(tgt, kind);
-		if (old_tgt)
-			verify_list_head(old_tgt, kind);
+		verify_outs(tgt, kind);
+		verify_outs(old_tgt, kind);
 	}
 #endif
 }
@@ -386,6 +405,15 @@ static void edges_node_deleted_kind(ir_node *old, ir_edge_kind_t kind)
 		ir_node *old_tgt = get_n(old, i, kind);
 		delete_edge(old, i, old_tgt, kind, irg);
 	}
+
+	if (!has_edge_info(old, kind))
+		return;
+	irn_edge_info_t *info = get_irn_edge_info(old, kind);
+	if (info->in_slots != NULL) {
+		irg_edge_info_t *irg_info = get_irg_edge_info(irg, kind);
+		free_array(irg_info->free_slots, info->slots_log, info->in_slots);
+		info->in_slots = NULL;
+	}
 }
 
 /**
@@ -399,7 +427,7 @@ static void edges_node_revival_kind(ir_node *irn, ir_edge_kind_t kind)
 {
 	ir_graph *irg = get_irn_irg(irn);
 
-	if (!edges_activated_kind(irg, kind))
+	if (!edges_activated_kind(irg, kind) || !has_edge_info(irn, kind))
 		return;
 
 	irn_edge_info_t *info = get_irn_edge_info(irn, kind);
@@ -417,7 +445,6 @@ static void edges_node_revival_kind(ir_node *irn, ir_edge_kind_t kind)
 
 typedef struct build_walker {
 	ir_edge_kind_t kind;
-	bitset_t      *reachable;
 	bool           fine;
 } build_walker;
 
@@ -438,23 +465,25 @@ static void build_edges_walker(ir_node *irn, void *data)
 }
 
 /**
- * Pre-Walker: initializes the list-heads and set the out-count
- * of all nodes to 0.
+ * Walker: resets the out arrays and the out-count of a node.
  */
-static void init_lh_walker(ir_node *irn, void *data)
+static void init_outs_walker(ir_node *irn, void *data)
 {
-	build_walker   *w    = (build_walker*)data;
-	ir_edge_kind_t  kind = w->kind;
-	list_head      *head = &get_irn_edge_info(irn, kind)->outs_head;
-	INIT_LIST_HEAD(head);
-	get_irn_edge_info(irn, kind)->edges_built = 0;
-	get_irn_edge_info(irn, kind)->out_count   = 0;
+	build_walker *w = (build_walker*)data;
+	if (!has_edge_info(irn, w->kind))
+		return;
+
+	irn_edge_info_t *info = get_irn_edge_info(irn, w->kind);
+	info->outs        = NULL;
+	info->in_slots    = NULL;
+	info->out_count   = 0;
+	info->edges_built = 0;
 }
 
 void edges_activate_kind(ir_graph *irg, ir_edge_kind_t kind)
 {
 	/*
-	 * Build the initial edge set.
+	 * Build the initial edges.
 	 * Beware, this is not a simple task because it suffers from two
 	 * difficulties:
 	 * - the anchor set allows access to Nodes that may not be reachable from
@@ -463,17 +492,10 @@ void edges_activate_kind(ir_graph *irg, ir_edge_kind_t kind)
 	 *   from End. However, after some transformations, the CSE may revival these
 	 *   nodes
 	 *
-	 * These problems can be fixed using different strategies:
-	 * - Add an age flag to every node. Whenever the edge of a node is older
-	 *   then the current edge, invalidate the edges of this node.
-	 *   While this would help for revivaled nodes, it increases memory and runtime.
-	 * - Delete the identities set.
-	 *   Solves the revival problem, but may increase the memory consumption, as
-	 *   nodes cannot be revivaled at all.
-	 * - Manually iterate over the identities root set. This did not consume more memory
-	 *   but increase the computation time because the |identities| >= |V|
-	 *
-	 * Currently, we use the last option.
+	 * We reset the edge information of all nodes of the graph (including the
+	 * identities and dead nodes which may still hold arrays of an earlier
+	 * activation) and build the edges of the reachable ones. Identities
+	 * build their edges when they are revived.
 	 */
 	struct build_walker  w    = { .kind = kind };
 	irg_edge_info_t     *info = get_irg_edge_info(irg, kind);
@@ -482,12 +504,11 @@ void edges_activate_kind(ir_graph *irg, ir_edge_kind_t kind)
 
 	info->activated = 1;
 	edges_init_graph_kind(irg, kind);
+	irg_walk_graph_by_idx(irg, init_outs_walker, &w);
 	if (kind == EDGE_KIND_BLOCK) {
-		visit_all_identities(irg, init_lh_walker, &w);
-		irg_block_walk_graph(irg, init_lh_walker, build_edges_walker, &w);
+		irg_block_walk_graph(irg, NULL, build_edges_walker, &w);
 	} else {
-		visit_all_identities(irg, init_lh_walker, &w);
-		irg_walk_anchors(irg, init_lh_walker, build_edges_walker, &w);
+		irg_walk_anchors(irg, NULL, build_edges_walker, &w);
 	}
 }
 
@@ -498,7 +519,6 @@ void edges_deactivate_kind(ir_graph *irg, ir_edge_kind_t kind)
 	info->activated = 0;
 	if (info->allocated) {
 		obstack_free(&info->edges_obst, NULL);
-		ir_edgeset_destroy(&info->edges);
 		info->allocated = 0;
 	}
 	clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES);
@@ -520,14 +540,14 @@ void edges_reroute_kind(ir_node *from, ir_node *to, ir_edge_kind_t kind)
 	set_edge_func_t *set_edge = edge_kind_info[kind].set_edge;
 
 	if (set_edge && edges_activated_kind(irg, kind)) {
-		struct list_head *head = &get_irn_edge_info(from, kind)->outs_head;
+		irn_edge_info_t *info = get_irn_edge_info(from, kind);
 
 		DBG((dbg, LEVEL_5, "reroute from %+F to %+F\n", from, to));
 
-		while (head != head->next) {
-			ir_edge_t *edge = list_entry(head->next, ir_edge_t, list);
-			assert(edge->pos >= -1);
-			set_edge(edge->src, edge->pos, to);
+		while (info->out_count > 0) {
+			ir_edge_t const edge = info->outs[info->out_count - 1];
+			assert(edge.pos >= -1);
+			set_edge(edge.src, edge.pos, to);
 		}
 	}
 }
@@ -549,21 +569,19 @@ void edges_reroute_except(ir_node *from, ir_node *to, ir_node *exception)
 
 static void verify_set_presence(ir_node *irn, void *data)
 {
-	build_walker *w     = (build_walker*)data;
-	ir_graph     *irg   = get_irn_irg(irn);
-	ir_edgeset_t *edges = &get_irg_edge_info(irg, w->kind)->edges;
+	build_walker *w = (build_walker*)data;
+	if (!has_edge_info(irn, w->kind))
+		return;
 
+	irn_edge_info_t const *info = get_irn_edge_info(irn, w->kind);
 	foreach_tgt(irn, i, n, w->kind) {
-		ir_edge_t  templ = { .src = irn, .pos = i };
-		ir_edge_t *e     = ir_edgeset_find(edges, &templ);
-		ir_node   *dst   = get_n(irn, i, w->kind);
+		ir_node *dst = get_n(irn, i, w->kind);
 		if (dst == NULL)
 			continue;
-		if (e != NULL) {
-#ifdef DEBUG_libfirm
-			e->present = true;
-#endif
-		} else {
+		irn_edge_info_t const *dst_info = get_irn_edge_info(dst, w->kind);
+		unsigned               slot     = get_in_slot(info, i);
+		if (slot >= dst_info->out_count || dst_info->outs[slot].src != irn
+		    || dst_info->outs[slot].pos != i) {
 			w->fine = false;
 			ir_fprintf(stderr, "Edge Verifier: %+F,%d is missing\n",
 			           irn, i);
@@ -571,14 +589,16 @@ static void verify_set_presence(ir_node *irn, void *data)
 	}
 }
 
-static void verify_list_presence(ir_node *irn, void *data)
+static void verify_outs_presence(ir_node *irn, void *data)
 {
 	build_walker *w = (build_walker*)data;
+	if (!has_edge_info(irn, w->kind))
+		return;
 
-	bitset_set(w->reachable, get_irn_idx(irn));
-
-	/* check list heads */
-	verify_list_head(irn, w->kind);
+	/* check that the edges are registered at their sources, this also
+	 * finds superfluous edges */
+	if (!verify_outs(irn, w->kind))
+		w->fine = false;
 
 	foreach_out_edge_kind(irn, e, w->kind) {
 		if (w->kind == EDGE_KIND_NORMAL && get_irn_arity(e->src) <= e->pos) {
@@ -599,35 +619,9 @@ static void verify_list_presence(ir_node *irn, void *data)
 
 int edges_verify_kind(ir_graph *irg, ir_edge_kind_t kind)
 {
-	struct build_walker    w     = { .kind      = kind,
-	                                 .reachable = bitset_alloca(get_irg_last_idx(irg)),
-	                                 .fine      = true };
-
-#ifdef DEBUG_libfirm
-	ir_edgeset_t          *edges = &get_irg_edge_info(irg, kind)->edges;
-	ir_edge_t             *e;
-	ir_edgeset_iterator_t iter;
-	/* Clear the present bit in all edges available. */
-	foreach_ir_edgeset(edges, e, iter) {
-		e->present = false;
-	}
-#endif
+	struct build_walker w = { .kind = kind, .fine = true };
 
-	irg_walk_graph(irg, verify_set_presence, verify_list_presence, &w);
-
-#ifdef DEBUG_libfirm
-	/*
-	 * Dump all edges which are not invalid and not present.
-	 * These edges are superfluous and their presence in the
-	 * edge set is wrong.
-	 */
-	foreach_ir_edgeset(edges, e, iter) {
-		if (! e->present && bitset_is_set(w.reachable, get_irn_idx(e->src))) {
-			w.fine = false;
-			ir_fprintf(stderr, "Edge Verifier: edge(%ld) %+F,%d is superfluous\n", edge_get_id(e), e->src, e->pos);
-		}
-	}
-#endif
+	irg_walk_graph(irg, verify_set_presence, verify_outs_presence, &w);
 
 	return w.fine;
 }
@@ -664,24 +658,14 @@ static void count_user(ir_node *irn, void *env)
 }
 
 /**
- * Verifies if collected count, number of edges in list and stored edge count
- * are in sync.
+ * Verifies if collected count and stored edge count are in sync.
  */
 static void verify_edge_counter(ir_node *irn, void *env)
 {
 	build_walker *w = (build_walker*)env;
 
 	bitset_t *bs       = ir_nodemap_get(bitset_t, &usermap, irn);
-	int       list_cnt = 0;
 	int       edge_cnt = get_irn_edge_info(irn, EDGE_KIND_NORMAL)->out_count;
-	const struct list_head *head
-		= &get_irn_edge_info(irn, EDGE_KIND_NORMAL)->outs_head;
-
-	/* We can iterate safely here, list heads have already been verified. */
-	const struct list_head *pos;
-	list_for_each(pos, head) {
-		++list_cnt;
-	}
 
 	/* check all nodes that reference us and count edges that point number
 	 * of ins that actually point to us */
@@ -700,16 +684,10 @@ static void verify_edge_counter(ir_node *irn, void *env)
 		}
 	}
 
-	if (edge_cnt != list_cnt) {
-		w->fine = false;
-		ir_fprintf(stderr, "Edge Verifier: edge count is %d, but %d edge(s) are recorded in list at %+F\n",
-			edge_cnt, list_cnt, irn);
-	}
-
-	if (ref_cnt != list_cnt) {
+	if (ref_cnt != edge_cnt) {
 		w->fine = false;
-		ir_fprintf(stderr, "Edge Verifier: %+F reachable by %d node(s), but the list contains %d edge(s)\n",
-			irn, ref_cnt, list_cnt);
+		ir_fprintf(stderr, "Edge Verifier: %+F reachable by %d node(s), but %d edge(s) are recorded\n",
+			irn, ref_cnt, edge_cnt);
 	}
 
 	free(bs);
@@ -802,6 +780,12 @@ const ir_edge_t *(get_irn_out_edge_next)(const ir_node *irn, const ir_edge_t *la
 	return get_irn_out_edge_next_(irn, last, kind);
 }
 
+int (get_irn_out_edge_before)(const ir_node *irn, int idx, ir_edge_kind_t kind,
+                              ir_edge_t *edge)
+{
+	return get_irn_out_edge_before_(irn, idx, kind, edge);
+}
+
 ir_node *(get_edge_src_irn)(const ir_edge_t *edge)
 {
 	return get_edge_src_irn_(edge);
@@ -822,24 +806,57 @@ int (get_irn_n_edges)(const ir_node *irn)
 	return get_irn_n_edges_kind_(irn, EDGE_KIND_NORMAL);
 }
 
-static void irg_walk_edges2(ir_node *node, irg_walk_func *pre,
-                            irg_walk_func *post, void *env)
+static void enter_user(walk_stack_t *const stack, ir_node *const node,
+                       ir_edge_kind_t const kind, irg_walk_func *const pre,
+                       void *const env)
 {
-	if (irn_visited_else_mark(node))
+	if (kind == EDGE_KIND_BLOCK) {
+		if (Block_block_visited(node))
+			return;
+		mark_Block_block_visited(node);
+	} else if (irn_visited_else_mark(node)) {
 		return;
+	}
 
 	if (pre != NULL)
 		pre(node, env);
 
-	foreach_out_edge_safe(node, edge) {
-		/* find the corresponding successor block. */
-		ir_node *pred = get_edge_src_irn(edge);
-		assert(pred != NULL && "edge deleted while iterating?");
-		irg_walk_edges2(pred, pre, post, env);
+	walk_frame_t *const frame = walk_stack_push(stack, node);
+	frame->next = get_irn_n_edges_kind(node, kind);
+}
+
+/**
+ * Walks the users of a node depth first with an explicit stack. The users
+ * are visited in the same order as by foreach_out_edge_kind(), so the
+ * callbacks may change the edge they are reached by.
+ */
+static void irg_walk_edges2(ir_node *node, ir_edge_kind_t kind,
+                            irg_walk_func *pre, irg_walk_func *post, void *env)
+{
+	walk_stack_t stack;
+	walk_stack_init(&stack);
+	enter_user(&stack, node, kind, pre, env);
+
+	while (!walk_stack_empty(&stack)) {
+		walk_frame_t *const frame = walk_stack_top(&stack);
+		ir_node      *const cur   = frame->node;
+		ir_edge_t           edge;
+		frame->next = get_irn_out_edge_before(cur, frame->next, kind, &edge);
+		if (frame->next < 0) {
+			walk_stack_pop(&stack);
+			if (post != NULL)
+				post(cur, env);
+			continue;
+		}
+
+		if (frame->next > 0)
+			PREFETCH(get_irn_edge_info(cur, kind)->outs[frame->next - 1].src);
+
+		assert(edge.src != NULL && "edge deleted while iterating?");
+		enter_user(&stack, edge.src, kind, pre, env);
 	}
 
-	if (post != NULL)
-		post(node, env);
+	walk_stack_free(&stack);
 }
 
 void irg_walk_edges(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
@@ -853,31 +870,11 @@ void irg_walk_edges(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
 	ir_reserve_resources(irg, IR_RESOURCE_IRN_VISITED);
 
 	inc_irg_visited(irg);
-	irg_walk_edges2(node, pre, post, env);
+	irg_walk_edges2(node, EDGE_KIND_NORMAL, pre, post, env);
 
 	ir_free_resources(irg, IR_RESOURCE_IRN_VISITED);
 }
 
-static void irg_block_edges_walk2(ir_node *bl, irg_walk_func *pre,
-                                  irg_walk_func *post, void *env)
-{
-	if (!Block_block_visited(bl)) {
-		mark_Block_block_visited(bl);
-
-		if (pre)
-			pre(bl, env);
-
-		foreach_block_succ_safe(bl, edge) {
-			/* find the corresponding successor block. */
-			ir_node *pred = get_edge_src_irn(edge);
-			irg_block_edges_walk2(pred, pre, post, env);
-		}
-
-		if (post)
-			post(bl, env);
-	}
-}
-
 void irg_block_edges_walk(ir_node *node, irg_walk_func *pre,
                           irg_walk_func *post, void *env)
 {
@@ -889,7 +886,7 @@ void irg_block_edges_walk(ir_node *node, irg_walk_func *pre,
 	ir_reserve_resources(irg, IR_RESOURCE_BLOCK_VISITED);
 
 	inc_irg_block_visited(irg);
-	irg_block_edges_walk2(node, pre, post, env);
+	irg_walk_edges2(node, EDGE_KIND_BLOCK, pre, post, env);
 
 	ir_free_resources(irg, IR_RESOURCE_BLOCK_VISITED);
 }
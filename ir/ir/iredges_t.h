@@ -14,49 +14,44 @@
 
 #include <stdbool.h>
 
-#include "set.h"
-#include "list.h"
-
 #include "irnode_t.h"
 #include "irgraph_t.h"
 
 #include "iredgekinds.h"
 #include "iredges.h"
+#include "util.h"
 
 #define get_irn_n_edges_kind(irn, kind)   get_irn_n_edges_kind_(irn, kind)
 #define get_edge_src_irn(edge)            get_edge_src_irn_(edge)
 #define get_edge_src_pos(edge)            get_edge_src_pos_(edge)
 #define get_irn_out_edge_next(irn, last, kind)  get_irn_out_edge_next_(irn, last, kind)
+#define get_irn_out_edge_before(irn, idx, kind, edge) get_irn_out_edge_before_(irn, idx, kind, edge)
 #define get_irn_n_edges(irn)              get_irn_n_edges_kind_(irn, EDGE_KIND_NORMAL)
 #define get_irn_out_edge_first(irn)       get_irn_out_edge_first_kind_(irn, EDGE_KIND_NORMAL)
 #define get_block_succ_first(irn)         get_irn_out_edge_first_kind_(irn, EDGE_KIND_BLOCK)
 #define get_block_succ_next(irn, last)    get_irn_out_edge_next_(irn, last, EDGE_KIND_BLOCK)
 
-/**
- * An edge.
- */
-struct ir_edge_t {
-	ir_node *src;         /**< The source node of the edge. */
-	int      pos;         /**< The position of the edge at @p src. */
-#ifdef DEBUG_libfirm
-	bool     present : 1; /**< Used by the verifier. */
-#endif
-	struct list_head list;  /**< The list head to queue all out edges at a node. */
-};
-
 /** Accessor for private irn info. */
 static inline irn_edge_info_t *get_irn_edge_info(ir_node *node,
                                                  ir_edge_kind_t kind)
 {
 	assert(edges_activated_kind(get_irn_irg(node), kind));
-	return &node->edge_info[kind];
+	if (kind == EDGE_KIND_BLOCK) {
+		assert(is_Block(node));
+		return &node->attr.block.succ_edges;
+	}
+	return &node->edge_info;
 }
 
 static inline const irn_edge_info_t *get_irn_edge_info_const(
 		const ir_node *node, ir_edge_kind_t kind)
 {
 	assert(edges_activated_kind(get_irn_irg(node), kind));
-	return &node->edge_info[kind];
+	if (kind == EDGE_KIND_BLOCK) {
+		assert(is_Block(node));
+		return &node->attr.block.succ_edges;
+	}
+	return &node->edge_info;
 }
 
 /** Accessor for private irg info. */
@@ -82,8 +77,8 @@ static inline const irg_edge_info_t *get_irg_edge_info_const(
  */
 static inline const ir_edge_t *get_irn_out_edge_first_kind_(const ir_node *irn, ir_edge_kind_t kind)
 {
-	struct list_head const *const head = &get_irn_edge_info_const(irn, kind)->outs_head;
-	return list_empty(head) ? NULL : list_entry(head->next, ir_edge_t, list);
+	const irn_edge_info_t *info = get_irn_edge_info_const(irn, kind);
+	return info->out_count == 0 ? NULL : &info->outs[info->out_count - 1];
 }
 
 /**
@@ -94,10 +89,20 @@ static inline const ir_edge_t *get_irn_out_edge_first_kind_(const ir_node *irn,
  */
 static inline const ir_edge_t *get_irn_out_edge_next_(const ir_node *irn, const ir_edge_t *last, ir_edge_kind_t kind)
 {
-	struct list_head *next = last->list.next;
-	const struct list_head *head
-		= &get_irn_edge_info_const(irn, kind)->outs_head;
-	return next == head ? NULL : list_entry(next, ir_edge_t, list);
+	const irn_edge_info_t *info = get_irn_edge_info_const(irn, kind);
+	size_t                 idx  = MIN((size_t)(last - info->outs), info->out_count);
+	return idx == 0 ? NULL : &info->outs[idx - 1];
+}
+
+static inline int get_irn_out_edge_before_(const ir_node *irn, int idx, ir_edge_kind_t kind, ir_edge_t *edge)
+{
+	const irn_edge_info_t *info = get_irn_edge_info_const(irn, kind);
+	if ((unsigned)idx > info->out_count)
+		idx = info->out_count;
+	if (idx == 0)
+		return -1;
+	*edge = info->outs[--idx];
+	return idx;
 }
 
 /**
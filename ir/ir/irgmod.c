@@ -73,13 +73,14 @@ void exchange(ir_node *old, ir_node *nw)
 			}
 		}
 
-		if (is_irn_dynamic(old))
-			DEL_ARR_F(old->in);
+		if (has_irn_heap_in(old))
+			free_irn_heap_in(old);
 
 		old->op    = op_Id;
-		old->in    = NEW_ARR_D(ir_node*, get_irg_obstack(irg), 2);
+		old->in    = OALLOCN(get_irg_obstack(irg), ir_node*, 2);
 		old->in[0] = block;
 		old->in[1] = nw;
+		old->arity = 1;
 	}
 
 	/* update irg flags */
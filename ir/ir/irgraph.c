@@ -253,6 +253,24 @@ ir_graph *create_irg_copy(ir_graph *irg)
 	return res;
 }
 
+ir_graph *new_ir_graph_copy(ir_entity *ent, ir_graph *irg)
+{
+	ir_graph *const res = create_irg_copy(irg);
+	hook_new_graph(res, ent);
+
+	res->callee_info_state = irg_callee_info_none;
+	res->mem_disambig_opt  = irg->mem_disambig_opt;
+	res->ent               = ent;
+	set_entity_irg(ent, res);
+
+	res->index = get_irp_new_irg_idx();
+#ifdef DEBUG_libfirm
+	res->graph_nr = get_irp_new_node_nr();
+#endif
+	add_irp_irg(res);
+	return res;
+}
+
 void free_ir_graph(ir_graph *irg)
 {
 	assert(irg->kind == k_ir_graph);
@@ -16,7 +16,6 @@
 #include "entity_t.h"
 #include "firm_types.h"
 #include "iredgekinds.h"
-#include "iredgeset.h"
 #include "irloop.h"
 #include "irnodemap.h"
 #include "irprog.h"
@@ -73,9 +72,12 @@
  * Edge info to put into an irg.
  */
 typedef struct irg_edge_info_t {
-	ir_edgeset_t     edges;          /**< A set containing all edges of the current graph. */
-	struct list_head free_edges;     /**< list of all free edges. */
-	struct obstack   edges_obst;     /**< Obstack, where edges are allocated on. */
+	struct obstack   edges_obst;     /**< Obstack, where the out and slot
+	                                      arrays are allocated on. */
+	void            *free_outs[32];  /**< Lists of free out arrays, indexed
+	                                      by log2 of their size. */
+	void            *free_slots[32]; /**< Lists of free slot arrays, indexed
+	                                      by log2 of their size. */
 	unsigned         allocated : 1;  /**< Set if edges are allocated on the obstack. */
 	unsigned         activated : 1;  /**< Set if edges are activated for the graph. */
 } irg_edge_info_t;
@@ -141,6 +143,9 @@ struct ir_graph {
 	pset               *value_table;
 	struct obstack      out_obst;    /**< Space for the Def-Use arrays. */
 	bool                out_obst_allocated;
+	unsigned            n_outs_nodes; /**< Length of the outs table. */
+	ir_def_use_edges  **outs;        /**< Def-Use arrays of the nodes,
+	                                      indexed by node index. */
 	ir_bitinfo          bitinfo;     /**< bit info */
 	ir_vrp_info         vrp;         /**< vrp info */
 	ir_loop            *loop;        /**< The outermost loop for this graph. */
@@ -191,6 +196,12 @@ ir_graph *new_const_code_irg(void);
  */
 ir_graph *create_irg_copy(ir_graph *irg);
 
+/**
+ * Create a new graph for method entity @p ent that is a copy of @p irg and
+ * register it in the program.
+ */
+ir_graph *new_ir_graph_copy(ir_entity *ent, ir_graph *irg);
+
 /**
  * Set the op_pin_state_pinned state of a graph.
  *
@@ -12,12 +12,14 @@
  *  - execute the pre function before recursion
  *  - execute the post function after recursion
  */
+#include <limits.h>
 #include <stdlib.h>
 
+#include "compiler.h"
 #include "irnode_t.h"
 #include "irgraph_t.h"
 #include "irprog_t.h"
-#include "irgwalk.h"
+#include "irgwalk_t.h"
 #include "irhooks.h"
 #include "entity_t.h"
 #include "ircons.h"
@@ -26,76 +28,60 @@
 #include "pset_new.h"
 #include "array.h"
 
-/**
- * specialized version of irg_walk_2, called if only pre callback exists
- */
-static void irg_walk_2_pre(ir_node *node, irg_walk_func *pre, void *env)
-{
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
-	set_irn_visited(node, visited);
-
-	pre(node, env);
-
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
-		if (pred->visited < visited)
-			irg_walk_2_pre(pred, pre, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_2_pre(pred, pre, env);
-	}
-}
+/** Marks a frame whose block input has not been visited yet. */
+#define POS_BLOCK INT_MAX
 
-/**
- * specialized version of irg_walk_2, called if only post callback exists
- */
-static void irg_walk_2_post(ir_node *node, irg_walk_func *post, void *env)
+static void enter_node(walk_stack_t *const stack, ir_node *const node,
+                       ir_visited_t const visited, irg_walk_func *const pre,
+                       void *const env)
 {
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
 	set_irn_visited(node, visited);
 
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
-		if (pred->visited < visited)
-			irg_walk_2_post(pred, post, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_2_post(pred, post, env);
-	}
+	if (pre != NULL)
+		pre(node, env);
 
-	post(node, env);
+	walk_frame_t *const frame = walk_stack_push(stack, node);
+	frame->next = is_Block(node) ? get_irn_arity(node) : POS_BLOCK;
 }
 
 /**
- * specialized version of irg_walk_2, called if pre and post callbacks exist
+ * Walks the predecessors of a node depth first with an explicit stack.
+ * The order is the same as for the obvious recursive walk: the block of a
+ * node first, then its inputs from last to first.
  */
-static void irg_walk_2_both(ir_node *node, irg_walk_func *pre,
-                                irg_walk_func *post, void *env)
+static void irg_walk_2_(ir_node *const node, irg_walk_func *const pre,
+                        irg_walk_func *const post, void *const env)
 {
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
-	set_irn_visited(node, visited);
-
-	pre(node, env);
+	ir_visited_t const visited = get_irn_irg(node)->visited;
+
+	walk_stack_t stack;
+	walk_stack_init(&stack);
+	enter_node(&stack, node, visited, pre, env);
+
+	while (!walk_stack_empty(&stack)) {
+		walk_frame_t *const frame = walk_stack_top(&stack);
+		ir_node      *const cur   = frame->node;
+		ir_node            *pred;
+		if (frame->next == POS_BLOCK) {
+			frame->next = get_irn_arity(cur);
+			pred            = get_nodes_block(cur);
+		} else if (frame->next > 0) {
+			int const pos = --frame->next;
+			pred = get_irn_n(cur, pos);
+			if (pos > 0)
+				PREFETCH(get_irn_n(cur, pos - 1));
+		} else {
+			walk_stack_pop(&stack);
+			if (post != NULL)
+				post(cur, env);
+			continue;
+		}
 
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
 		if (pred->visited < visited)
-			irg_walk_2_both(pred, pre, post, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_2_both(pred, pre, post, env);
+			enter_node(&stack, pred, visited, pre, env);
 	}
 
-	post(node, env);
+	walk_stack_free(&stack);
 }
 
 void irg_walk_2(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
@@ -104,9 +90,7 @@ void irg_walk_2(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
 	if (irn_visited(node))
 		return;
 
-	if      (post == NULL) irg_walk_2_pre (node, pre, env);
-	else if (pre  == NULL) irg_walk_2_post(node, post, env);
-	else                   irg_walk_2_both(node, pre, post, env);
+	irg_walk_2_(node, pre, post, env);
 }
 
 void irg_walk_core(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
@@ -139,94 +123,6 @@ void all_irg_walk(irg_walk_func *pre, irg_walk_func *post, void *env)
 	}
 }
 
-/**
- * specialized version of irg_walk_in_or_dep_2, called if only pre callback exists
- */
-static void irg_walk_in_or_dep_2_pre(ir_node *node, irg_walk_func *pre,
-                                     void *env)
-{
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
-	set_irn_visited(node, visited);
-
-	pre(node, env);
-
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_pre(pred, pre, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_pre(pred, pre, env);
-	}
-}
-
-/**
- * specialized version of irg_walk_in_or_dep_2, called if only post callback exists
- */
-static void irg_walk_in_or_dep_2_post(ir_node *node, irg_walk_func *post,
-                                      void *env)
-{
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
-	set_irn_visited(node, visited);
-
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_post(pred, post, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_post(pred, post, env);
-	}
-
-	post(node, env);
-}
-
-/**
- * specialized version of irg_walk_in_or_dep_2, called if pre and post callbacks exist
- */
-static void irg_walk_in_or_dep_2_both(ir_node *node, irg_walk_func *pre,
-                                      irg_walk_func *post, void *env)
-{
-	ir_graph    *irg     = get_irn_irg(node);
-	ir_visited_t visited = irg->visited;
-
-	set_irn_visited(node, visited);
-
-	pre(node, env);
-
-	if (!is_Block(node)) {
-		ir_node *pred = get_nodes_block(node);
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_both(pred, pre, post, env);
-	}
-	foreach_irn_in_r(node, i, pred) {
-		if (pred->visited < visited)
-			irg_walk_in_or_dep_2_both(pred, pre, post, env);
-	}
-
-	post(node, env);
-}
-
-/**
- * Intraprozedural graph walker. Follows dependency edges as well.
- */
-static void irg_walk_in_or_dep_2(ir_node *node, irg_walk_func *pre,
-                                 irg_walk_func *post, void *env)
-{
-	if (irn_visited(node))
-		return;
-
-	if      (post == NULL) irg_walk_in_or_dep_2_pre (node, pre, env);
-	else if (pre == NULL)  irg_walk_in_or_dep_2_post(node, post, env);
-	else                   irg_walk_in_or_dep_2_both(node, pre, post, env);
-}
-
 void irg_walk_in_or_dep(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
                         void *env)
 {
@@ -235,7 +131,7 @@ void irg_walk_in_or_dep(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
 	ir_graph *const irg = get_irn_irg(node);
 	ir_reserve_resources(irg, IR_RESOURCE_IRN_VISITED);
 	inc_irg_visited(irg);
-	irg_walk_in_or_dep_2(node, pre, post, env);
+	irg_walk_2(node, pre, post, env);
 	ir_free_resources(irg, IR_RESOURCE_IRN_VISITED);
 }
 
@@ -255,28 +151,49 @@ static ir_node *get_cf_op(ir_node *n)
 	return n;
 }
 
+static void enter_block(walk_stack_t *const stack, ir_node *const block,
+                        irg_walk_func *const pre, void *const env)
+{
+	mark_Block_block_visited(block);
+
+	if (pre != NULL)
+		pre(block, env);
+
+	walk_frame_t *const frame = walk_stack_push(stack, block);
+	frame->next = get_Block_n_cfgpreds(block);
+}
+
 static void irg_block_walk_2(ir_node *node, irg_walk_func *pre,
                              irg_walk_func *post, void *env)
 {
 	if (Block_block_visited(node))
 		return;
-	mark_Block_block_visited(node);
 
-	if (pre != NULL)
-		pre(node, env);
+	walk_stack_t stack;
+	walk_stack_init(&stack);
+	enter_block(&stack, node, pre, env);
+
+	while (!walk_stack_empty(&stack)) {
+		walk_frame_t *const frame = walk_stack_top(&stack);
+		ir_node      *const block = frame->node;
+		if (frame->next == 0) {
+			walk_stack_pop(&stack);
+			if (post != NULL)
+				post(block, env);
+			continue;
+		}
 
-	for (int i = get_Block_n_cfgpreds(node); i-- > 0; ) {
 		/* find the corresponding predecessor block. */
-		ir_node *pred_cfop  = get_cf_op(get_Block_cfgpred(node, i));
+		int      const pos       = --frame->next;
+		ir_node *const pred_cfop = get_cf_op(get_Block_cfgpred(block, pos));
 		if (is_Bad(pred_cfop))
 			continue;
-		ir_node *pred_block = get_nodes_block(pred_cfop);
-		/* recursion */
-		irg_block_walk_2(pred_block, pre, post, env);
+		ir_node *const pred_block = get_nodes_block(pred_cfop);
+		if (!Block_block_visited(pred_block))
+			enter_block(&stack, pred_block, pre, env);
 	}
 
-	if (post != NULL)
-		post(node, env);
+	walk_stack_free(&stack);
 }
 
 void irg_block_walk(ir_node *node, irg_walk_func *pre, irg_walk_func *post,
@@ -307,6 +224,19 @@ void irg_block_walk_graph(ir_graph *irg, irg_walk_func *pre,
 	irg_block_walk(get_irg_end(irg), pre, post, env);
 }
 
+void irg_walk_graph_by_idx(ir_graph *irg, irg_walk_func *func, void *env)
+{
+	unsigned const n = get_irg_last_idx(irg);
+	for (unsigned idx = 0; idx < n; ++idx) {
+		if (idx + 8 < n)
+			PREFETCH(get_idx_irn(irg, idx + 8));
+		ir_node *const node = get_idx_irn(irg, idx);
+		if (node == NULL || is_Deleted(node))
+			continue;
+		func(node, env);
+	}
+}
+
 void irg_walk_anchors(ir_graph *irg, irg_walk_func *pre, irg_walk_func *post,
                       void *env)
 {
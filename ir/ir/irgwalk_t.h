@@ -0,0 +1,86 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Explicit stack used by the graph walkers -- internal header.
+ *
+ * The walkers keep one frame per node on the current path instead of one C
+ * stack frame, so arbitrarily deep graphs can be walked. Small walks do not
+ * allocate: the first frames live inside the stack structure itself.
+ */
+#ifndef FIRM_IR_IRGWALK_T_H
+#define FIRM_IR_IRGWALK_T_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "irgwalk.h"
+#include "xmalloc.h"
+
+#define WALK_STACK_INLINE_FRAMES 32
+
+typedef struct walk_frame_t {
+	ir_node *node;
+	int      next; /**< next input, control flow predecessor resp. out edge */
+} walk_frame_t;
+
+typedef struct walk_stack_t {
+	walk_frame_t *frames;
+	size_t        len;
+	size_t        size;
+	walk_frame_t  inline_frames[WALK_STACK_INLINE_FRAMES];
+} walk_stack_t;
+
+static inline void walk_stack_init(walk_stack_t *const stack)
+{
+	stack->frames = stack->inline_frames;
+	stack->len    = 0;
+	stack->size   = WALK_STACK_INLINE_FRAMES;
+}
+
+static inline void walk_stack_free(walk_stack_t *const stack)
+{
+	if (stack->frames != stack->inline_frames)
+		free(stack->frames);
+}
+
+static inline bool walk_stack_empty(walk_stack_t const *const stack)
+{
+	return stack->len == 0;
+}
+
+/**
+ * Pushes a new frame for @p node.
+ * @note Invalidates pointers to frames returned earlier.
+ */
+static inline walk_frame_t *walk_stack_push(walk_stack_t *const stack,
+                                            ir_node *const node)
+{
+	if (stack->len == stack->size) {
+		size_t        const size   = stack->size * 2;
+		walk_frame_t *const frames = XMALLOCN(walk_frame_t, size);
+		memcpy(frames, stack->frames, stack->len * sizeof(*frames));
+		walk_stack_free(stack);
+		stack->frames = frames;
+		stack->size   = size;
+	}
+	walk_frame_t *const frame = &stack->frames[stack->len++];
+	frame->node = node;
+	return frame;
+}
+
+static inline walk_frame_t *walk_stack_top(walk_stack_t const *const stack)
+{
+	return &stack->frames[stack->len - 1];
+}
+
+static inline void walk_stack_pop(walk_stack_t *const stack)
+{
+	--stack->len;
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include <stdarg.h>
 
 #include "array.h"
+#include "hashptr.h"
 #include "ircons_t.h"
 #include "irflag_t.h"
 #include "irgmod.h"
@@ -32,6 +33,24 @@
 
 #define SYMERROR ((unsigned) ~0)
 
+/**
+ * Token tags of the binary format. Lists and scopes keep their delimiter
+ * characters, so the tags must not collide with them or with whitespace.
+ */
+enum {
+	BIN_NUMBER = 1, /**< zigzag encoded varint */
+	BIN_WORD   = 2, /**< string pool offset of a symbol */
+	BIN_STRING = 3, /**< string pool offset of a string */
+	BIN_NULL   = 4, /**< NULL string */
+};
+
+#define BIN_VERSION      1
+#define BIN_HEADER_SIZE  28
+#define BIN_ENTRY_SIZE   12
+
+/** First bytes of a binary file, the textual format never starts with DEL. */
+static const char binary_magic[8] = "\177firmbin";
+
 typedef enum typetag_t {
 	tt_align,
 	tt_builtin_kind,
@@ -118,7 +137,10 @@ parse_error(read_env_t *env, const char *fmt, ...)
 		line--;
 	}
 
-	fprintf(stderr, "%s:%u: error ", env->inputname, line);
+	if (env->data != NULL)
+		ir_fprintf(stderr, "%s:@%zu: error ", env->inputname, env->pos);
+	else
+		fprintf(stderr, "%s:%u: error ", env->inputname, line);
 	env->read_errors = true;
 
 	va_list ap;
@@ -300,35 +322,119 @@ static unsigned symbol(const char *str, typetag_t typetag)
 	return entry ? entry->code : SYMERROR;
 }
 
+static void write_layout(write_env_t *env, char c)
+{
+	if (!env->binary)
+		fputc(c, env->file);
+}
+
+static void write_bin_varint(write_env_t *env, unsigned long value)
+{
+	while (value >= 0x80) {
+		obstack_1grow(&env->code, (char)(value | 0x80));
+		value >>= 7;
+	}
+	obstack_1grow(&env->code, (char)value);
+}
+
+static void write_bin_number(write_env_t *env, long value)
+{
+	/* zigzag encoding keeps small negative numbers short */
+	unsigned long const zigzag = value < 0 ? ~((unsigned long)value << 1)
+	                                       : (unsigned long)value << 1;
+	obstack_1grow(&env->code, BIN_NUMBER);
+	write_bin_varint(env, zigzag);
+}
+
+static void write_bin_string(write_env_t *env, char tag, const char *string)
+{
+	ident *const id     = new_id_from_str(string);
+	void  *const entry  = pmap_get(void, env->string_offsets, id);
+	size_t       offset;
+	if (entry != NULL) {
+		offset = PTR_TO_INT(entry) - 1;
+	} else {
+		offset = obstack_object_size(&env->strings);
+		obstack_grow0(&env->strings, string, strlen(string));
+		pmap_insert(env->string_offsets, id, INT_TO_PTR(offset + 1));
+	}
+	obstack_1grow(&env->code, tag);
+	write_bin_varint(env, offset);
+}
+
 void write_long(write_env_t *env, long value)
 {
+	if (env->binary) {
+		write_bin_number(env, value);
+		return;
+	}
 	fprintf(env->file, "%ld ", value);
 }
 
 void write_int(write_env_t *env, int value)
 {
+	if (env->binary) {
+		write_bin_number(env, value);
+		return;
+	}
 	fprintf(env->file, "%d ", value);
 }
 
 void write_unsigned(write_env_t *env, unsigned value)
 {
+	if (env->binary) {
+		write_bin_number(env, (long)value);
+		return;
+	}
 	fprintf(env->file, "%u ", value);
 }
 
 void write_size_t(write_env_t *env, size_t value)
 {
+	if (env->binary) {
+		write_bin_number(env, (long)value);
+		return;
+	}
 	ir_fprintf(env->file, "%zu ", value);
 }
 
 void write_symbol(write_env_t *env, const char *symbol)
 {
+	if (env->binary) {
+		write_bin_string(env, BIN_WORD, symbol);
+		return;
+	}
 	fputs(symbol, env->file);
 	fputc(' ', env->file);
 }
 
+/**
+ * Returns the number a node or label is written with. Fingerprints number
+ * them in the order they are written, so they do not depend on how many
+ * nodes were created before.
+ */
+static long get_write_number(write_env_t *env, void const *object, long nr)
+{
+	if (!env->fingerprint)
+		return nr;
+	void *const entry = pmap_get(void, env->numbers, object);
+	if (entry != NULL)
+		return PTR_TO_INT(entry) - 1;
+	long const number = (long)pmap_count(env->numbers);
+	pmap_insert(env->numbers, object, INT_TO_PTR(number + 1));
+	return number;
+}
+
+static void write_entity_description(write_env_t *env, ir_entity *entity);
+static void write_type_description(write_env_t *env, ir_type *type);
+
 void write_entity_ref(write_env_t *env, ir_entity *entity)
 {
-	write_long(env, get_entity_nr(entity));
+	if (env->fingerprint && entity->kind != IR_ENTITY_LABEL) {
+		write_entity_description(env, entity);
+		return;
+	}
+	write_long(env, get_write_number(env, entity, get_entity_nr(entity)));
 }
 
 void write_type_ref(write_env_t *env, ir_type *type)
@@ -343,11 +449,19 @@ void write_type_ref(write_env_t *env, ir_type *type)
 	default:
 		break;
 	}
+	if (env->fingerprint) {
+		write_type_description(env, type);
+		return;
+	}
 	write_long(env, get_type_nr(type));
 }
 
 void write_string(write_env_t *env, const char *string)
 {
+	if (env->binary) {
+		write_bin_string(env, BIN_STRING, string);
+		return;
+	}
 	fputc('"', env->file);
 	for (const char *c = string; *c != '\0'; ++c) {
 		switch (*c) {
@@ -376,7 +490,10 @@ void write_ident(write_env_t *env, ident *id)
 void write_ident_null(write_env_t *env, ident *id)
 {
 	if (id == NULL) {
-		fputs("NULL ", env->file);
+		if (env->binary)
+			obstack_1grow(&env->code, BIN_NULL);
+		else
+			fputs("NULL ", env->file);
 	} else {
 		write_ident(env, id);
 	}
@@ -393,26 +510,22 @@ void write_tarval_ref(write_env_t *env, ir_tarval *tv)
 	write_mode_ref(env, mode);
 	char buf[128];
 	const char *ascii = ir_tarval_to_ascii(buf, sizeof(buf), tv);
-	fputs(ascii, env->file);
-	fputc(' ', env->file);
+	write_symbol(env, ascii);
 }
 
 void write_align(write_env_t *env, ir_align align)
 {
-	fputs(get_align_name(align), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_align_name(align));
 }
 
 void write_builtin_kind(write_env_t *env, ir_builtin_kind kind)
 {
-	fputs(get_builtin_kind_name(kind), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_builtin_kind_name(kind));
 }
 
 void write_cond_jmp_predicate(write_env_t *env, cond_jmp_predicate pred)
 {
-	fputs(get_cond_jmp_predicate_name(pred), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_cond_jmp_predicate_name(pred));
 }
 
 void write_relation(write_env_t *env, ir_relation relation)
@@ -432,37 +545,47 @@ void write_loop(write_env_t *env, bool loop)
 
 static void write_list_begin(write_env_t *env)
 {
-	fputs("[", env->file);
+	if (env->binary)
+		obstack_1grow(&env->code, '[');
+	else
+		fputs("[", env->file);
 }
 
 static void write_list_end(write_env_t *env)
 {
-	fputs("] ", env->file);
+	if (env->binary)
+		obstack_1grow(&env->code, ']');
+	else
+		fputs("] ", env->file);
 }
 
 static void write_scope_begin(write_env_t *env)
 {
-	fputs("{\n", env->file);
+	if (env->binary)
+		obstack_1grow(&env->code, '{');
+	else
+		fputs("{\n", env->file);
 }
 
 static void write_scope_end(write_env_t *env)
 {
-	fputs("}\n\n", env->file);
+	if (env->binary)
+		obstack_1grow(&env->code, '}');
+	else
+		fputs("}\n\n", env->file);
 }
 
 void write_node_ref(write_env_t *env, const ir_node *node)
 {
-	write_long(env, get_irn_node_nr(node));
+	write_long(env, get_write_number(env, node, get_irn_node_nr(node)));
 }
 
 void write_initializer(write_env_t *const env,
                        ir_initializer_t const *const ini)
 {
-	FILE *f = env->file;
 	ir_initializer_kind_t ini_kind = get_initializer_kind(ini);
 
-	fputs(get_initializer_kind_name(ini_kind), f);
-	fputc(' ', f);
+	write_symbol(env, get_initializer_kind_name(ini_kind));
 
 	switch (ini_kind) {
 	case IR_INITIALIZER_CONST:
@@ -489,37 +612,32 @@ void write_initializer(write_env_t *const env,
 
 void write_pin_state(write_env_t *env, op_pin_state state)
 {
-	fputs(get_op_pin_state_name(state), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_op_pin_state_name(state));
 }
 
 void write_volatility(write_env_t *env, ir_volatility vol)
 {
-	fputs(get_volatility_name(vol), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_volatility_name(vol));
 }
 
 static void write_type_state(write_env_t *env, ir_type_state state)
 {
-	fputs(get_type_state_name(state), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_type_state_name(state));
 }
 
 void write_visibility(write_env_t *env, ir_visibility visibility)
 {
-	fputs(get_visibility_name(visibility), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_visibility_name(visibility));
 }
 
 static void write_mode_arithmetic(write_env_t *env, ir_mode_arithmetic arithmetic)
 {
-	fputs(get_mode_arithmetic_name(arithmetic), env->file);
-	fputc(' ', env->file);
+	write_symbol(env, get_mode_arithmetic_name(arithmetic));
 }
 
 static void write_type_common(write_env_t *env, ir_type *tp)
 {
-	fputc('\t', env->file);
+	write_layout(env, '\t');
 	write_symbol(env, "type");
 	write_long(env, get_type_nr(tp));
 	write_symbol(env, get_type_opcode_name(get_type_opcode(tp)));
@@ -553,7 +671,7 @@ static void write_type_primitive(write_env_t *env, ir_type *tp)
 
 	write_type_common(env, tp);
 	write_mode_ref(env, mode);
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 }
 
 static void write_type_compound(write_env_t *env, ir_type *tp)
@@ -567,7 +685,7 @@ static void write_type_compound(write_env_t *env, ir_type *tp)
 	}
 	write_type_common(env, tp);
 	write_ident_null(env, get_compound_ident(tp));
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 
 	for (size_t i = 0, n = get_compound_n_members(tp); i < n; ++i) {
 		ir_entity *member = get_compound_member(tp, i);
@@ -583,7 +701,7 @@ static void write_type_array(write_env_t *env, ir_type *tp)
 	write_type_common(env, tp);
 	write_type_ref(env, element_type);
 	write_unsigned(env, get_array_size(tp));
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 }
 
 static void write_type_method(write_env_t *env, ir_type *tp)
@@ -605,7 +723,7 @@ static void write_type_method(write_env_t *env, ir_type *tp)
 		write_type_ref(env, get_method_param_type(tp, i));
 	for (size_t i = 0; i < nresults; i++)
 		write_type_ref(env, get_method_res_type(tp, i));
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 }
 
 static void write_type_pointer(write_env_t *env, ir_type *tp)
@@ -616,7 +734,7 @@ static void write_type_pointer(write_env_t *env, ir_type *tp)
 
 	write_type_common(env, tp);
 	write_type_ref(env, points_to);
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 }
 
 static void write_type(write_env_t *env, ir_type *tp)
@@ -665,7 +783,7 @@ static void write_entity(write_env_t *env, ir_entity *ent)
 		write_entity(env, aliased);
 	}
 
-	fputc('\t', env->file);
+	write_layout(env, '\t');
 	switch ((ir_entity_kind)ent->kind) {
 	case IR_ENTITY_ALIAS:           write_symbol(env, "alias");           break;
 	case IR_ENTITY_NORMAL:          write_symbol(env, "entity");          break;
@@ -752,7 +870,105 @@ static void write_entity(write_env_t *env, ir_entity *ent)
 		break;
 	}
 
-	fputc('\n', env->file);
+	write_layout(env, '\n');
+}
+
+/**
+ * Writes the properties of a type which the code of a graph using it may
+ * depend on. Pointers are not followed, so this terminates for recursive
+ * types.
+ */
+static void write_type_description(write_env_t *env, ir_type *type)
+{
+	tp_opcode const opcode = get_type_opcode(type);
+	write_list_begin(env);
+	write_symbol(env, get_type_opcode_name(opcode));
+	write_unsigned(env, get_type_size(type));
+	write_unsigned(env, get_type_alignment(type));
+	switch (opcode) {
+	case tpo_primitive:
+	case tpo_pointer:
+		write_mode_ref(env, get_type_mode(type));
+		break;
+
+	case tpo_array:
+		write_type_ref(env, get_array_element_type(type));
+		write_unsigned(env, get_array_size(type));
+		break;
+
+	case tpo_method: {
+		size_t const n_params = get_method_n_params(type);
+		size_t const n_ress   = get_method_n_ress(type);
+		write_unsigned(env, get_method_calling_convention(type));
+		write_unsigned(env, get_method_additional_properties(type));
+		write_unsigned(env, is_method_variadic(type));
+		write_size_t(env, n_params);
+		for (size_t i = 0; i < n_params; ++i)
+			write_type_ref(env, get_method_param_type(type, i));
+		write_size_t(env, n_ress);
+		for (size_t i = 0; i < n_ress; ++i)
+			write_type_ref(env, get_method_res_type(type, i));
+		break;
+	}
+
+	case tpo_class:
+	case tpo_struct:
+	case tpo_union:
+	case tpo_segment:
+		write_ident_null(env, get_compound_ident(type));
+		write_size_t(env, get_compound_n_members(type));
+		break;
+
+	case tpo_code:
+	case tpo_unknown:
+	case tpo_uninitialized:
+		break;
+	}
+	write_list_end(env);
+}
+
+/**
+ * Writes the properties of an entity which the code of a graph referencing
+ * it may depend on, instead of its number.
+ */
+static void write_entity_description(write_env_t *env, ir_entity *entity)
+{
+	ir_linkage const linkage = get_entity_linkage(entity);
+	write_list_begin(env);
+	write_unsigned(env, (unsigned)entity->kind);
+	if (entity->kind != IR_ENTITY_PARAMETER) {
+		write_ident_null(env, get_entity_ident(entity));
+		write_ident_null(env, entity_has_ld_ident(entity)
+		                      ? get_entity_ld_ident(entity) : NULL);
+	}
+	write_visibility(env, get_entity_visibility(entity));
+	write_unsigned(env, (unsigned)linkage);
+	write_volatility(env, get_entity_volatility(entity));
+	write_type_ref(env, get_entity_type(entity));
+
+	switch ((ir_entity_kind)entity->kind) {
+	case IR_ENTITY_PARAMETER:
+		write_size_t(env, get_entity_parameter_number(entity));
+		/* FALLTHROUGH */
+	case IR_ENTITY_COMPOUND_MEMBER:
+		write_long(env, get_entity_offset(entity));
+		write_unsigned(env, get_entity_bitfield_offset(entity));
+		write_unsigned(env, get_entity_bitfield_size(entity));
+		break;
+	case IR_ENTITY_NORMAL:
+		if (is_frame_type(get_entity_owner(entity)))
+			write_long(env, get_entity_offset(entity));
+		break;
+	case IR_ENTITY_METHOD:
+		write_long(env, (long)get_entity_additional_properties(entity));
+		break;
+	case IR_ENTITY_ALIAS:
+	case IR_ENTITY_LABEL:
+	case IR_ENTITY_UNKNOWN:
+	case IR_ENTITY_SPILLSLOT:
+		break;
+	}
+	write_list_end(env);
 }
 
 void write_switch_table_ref(write_env_t *env, const ir_switch_table *table)
@@ -783,7 +999,7 @@ void write_pred_refs(write_env_t *env, const ir_node *node, int from)
 
 void write_node_nr(write_env_t *env, const ir_node *node)
 {
-	write_long(env, get_irn_node_nr(node));
+	write_long(env, get_write_number(env, node, get_irn_node_nr(node)));
 }
 
 static void write_ASM(write_env_t *env, const ir_node *node)
@@ -881,11 +1097,11 @@ static void write_node(const ir_node *node, write_env_t *env)
 	ir_op           *const op   = get_irn_op(node);
 	write_node_func *const func = get_generic_function_ptr(write_node_func, op);
 
-	fputc('\t', env->file);
+	write_layout(env, '\t');
 	if (func == NULL)
 		panic("no write_node_func for %+F", node);
 	func(env, node);
-	fputc('\n', env->file);
+	write_layout(env, '\n');
 }
 
 static void write_node_recursive(ir_node *node, write_env_t *env);
@@ -956,18 +1172,18 @@ static void write_mode(write_env_t *env, ir_mode *mode)
 static void write_modes(write_env_t *env)
 {
 	write_symbol(env, "modes");
-	fputs("{\n", env->file);
+	write_scope_begin(env);
 
 	for (size_t i = 0, n_modes = ir_get_n_modes(); i < n_modes; i++) {
 		ir_mode *mode = ir_get_mode(i);
 		if (is_internal_mode(mode))
 			continue;
-		fputc('\t', env->file);
+		write_layout(env, '\t');
 		write_mode(env, mode);
-		fputc('\n', env->file);
+		write_layout(env, '\n');
 	}
 
-	fputs("}\n\n", env->file);
+	write_scope_end(env);
 }
 
 static void write_program(write_env_t *env)
@@ -975,15 +1191,15 @@ static void write_program(write_env_t *env)
 	write_symbol(env, "program");
 	write_scope_begin(env);
 	if (irp_prog_name_is_set()) {
-		fputc('\t', env->file);
+		write_layout(env, '\t');
 		write_symbol(env, "name");
 		write_string(env, get_irp_name());
-		fputc('\n', env->file);
+		write_layout(env, '\n');
 	}
 
 	for (ir_segment_t s = IR_SEGMENT_FIRST; s <= IR_SEGMENT_LAST; ++s) {
 		ir_type *segment_type = get_segment_type(s);
-		fputc('\t', env->file);
+		write_layout(env, '\t');
 		write_symbol(env, "segment_type");
 		write_symbol(env, get_segment_name(s));
 		if (segment_type == NULL) {
@@ -991,34 +1207,19 @@ static void write_program(write_env_t *env)
 		} else {
 			write_type_ref(env, segment_type);
 		}
-		fputc('\n', env->file);
+		write_layout(env, '\n');
 	}
 
 	for (size_t i = 0, n_asms = get_irp_n_asms(); i < n_asms; ++i) {
 		ident *asm_text = get_irp_asm(i);
-		fputc('\t', env->file);
+		write_layout(env, '\t');
 		write_symbol(env, "asm");
 		write_ident(env, asm_text);
-		fputc('\n', env->file);
+		write_layout(env, '\n');
 	}
 	write_scope_end(env);
 }
 
-int ir_export(const char *filename)
-{
-	FILE *file = fopen(filename, "wt");
-	int   res  = 0;
-	if (file == NULL) {
-		perror(filename);
-		return 1;
-	}
-
-	ir_export_file(file);
-	res = ferror(file);
-	fclose(file);
-	return res;
-}
-
 static void write_node_cb(ir_node *node, void *ctx)
 {
 	write_env_t *env = (write_env_t*)ctx;
@@ -1063,18 +1264,53 @@ static void write_irg(write_env_t *env, ir_graph *irg)
 	write_scope_end(env);
 }
 
-/* Exports the whole irp to the given file in a textual form. */
-void ir_export_file(FILE *file)
+static void write_const_irg(write_env_t *env)
 {
-	write_env_t my_env;
-	write_env_t *env = &my_env;
+	write_symbol(env, "constirg");
+	write_node_ref(env, get_const_code_irg()->current_block);
+	write_scope_begin(env);
+	walk_const_code(NULL, write_node_cb, env);
+	write_scope_end(env);
+}
 
+static void init_write_env(write_env_t *env, FILE *file)
+{
 	memset(env, 0, sizeof(*env));
 	env->file         = file;
 	deq_init(&env->write_queue);
 	deq_init(&env->entity_queue);
 
 	writers_init();
+}
+
+static void free_write_env(write_env_t *env)
+{
+	deq_free(&env->entity_queue);
+	deq_free(&env->write_queue);
+}
+
+int ir_export(const char *filename)
+{
+	FILE *file = fopen(filename, "wt");
+	int   res  = 0;
+	if (file == NULL) {
+		perror(filename);
+		return 1;
+	}
+
+	ir_export_file(file);
+	res = ferror(file);
+	fclose(file);
+	return res;
+}
+
+/* Exports the whole irp to the given file in a textual form. */
+void ir_export_file(FILE *file)
+{
+	write_env_t my_env;
+	write_env_t *env = &my_env;
+
+	init_write_env(env, file);
 	write_modes(env);
 
 	write_typegraph(env);
@@ -1083,22 +1319,128 @@ void ir_export_file(FILE *file)
 		write_irg(env, irg);
 	}
 
-	write_symbol(env, "constirg");
-	write_node_ref(env, get_const_code_irg()->current_block);
-	write_scope_begin(env);
-	walk_const_code(NULL, write_node_cb, env);
-	write_scope_end(env);
+	write_const_irg(env);
 
 	write_program(env);
 
-	deq_free(&env->entity_queue);
-	deq_free(&env->write_queue);
+	free_write_env(env);
+}
+
+unsigned long long ir_graph_fingerprint(ir_graph *irg)
+{
+	write_env_t my_env;
+	write_env_t *env = &my_env;
+
+	init_write_env(env, NULL);
+	env->binary         = true;
+	env->fingerprint    = true;
+	env->string_offsets = pmap_create();
+	env->numbers        = pmap_create();
+	obstack_init(&env->code);
+	obstack_init(&env->strings);
+
+	write_irg(env, irg);
+
+	/* hash the token stream and the string pool */
+	size_t         const code_size    = obstack_object_size(&env->code);
+	size_t         const strings_size = obstack_object_size(&env->strings);
+	unsigned char *const code    = (unsigned char*)obstack_finish(&env->code);
+	unsigned char *const strings = (unsigned char*)obstack_finish(&env->strings);
+	unsigned long long hash = hash_data64(HASH64_START, code, code_size);
+	hash = hash_data64(hash, strings, strings_size);
+
+	obstack_free(&env->strings, NULL);
+	obstack_free(&env->code, NULL);
+	pmap_destroy(env->numbers);
+	pmap_destroy(env->string_offsets);
+	free_write_env(env);
+	return hash;
 }
 
+static void write_u32(FILE *file, size_t value)
+{
+	assert(value <= 0xFFFFFFFFu);
+	for (unsigned i = 0; i < 4; ++i)
+		fputc((int)((value >> (8 * i)) & 0xFF), file);
+}
 
+int ir_export_binary(const char *filename)
+{
+	FILE *file = fopen(filename, "wb");
+	if (file == NULL) {
+		perror(filename);
+		return 1;
+	}
+
+	ir_export_binary_file(file);
+	int res = ferror(file);
+	fclose(file);
+	return res;
+}
+
+/*
+ * The binary file consists of a header, an index entry with entity number,
+ * offset and size for each graph body, the string pool and the token stream.
+ * The token stream starts with everything but the graph bodies, so an
+ * importer can read it and defer the bodies.
+ */
+void ir_export_binary_file(FILE *file)
+{
+	write_env_t my_env;
+	write_env_t *env = &my_env;
+
+	init_write_env(env, file);
+	env->binary         = true;
+	env->string_offsets = pmap_create();
+	obstack_init(&env->code);
+	obstack_init(&env->strings);
+
+	write_modes(env);
+	write_typegraph(env);
+	write_const_irg(env);
+	write_program(env);
+	size_t const toplevel_size = obstack_object_size(&env->code);
+
+	size_t  const n_irgs  = get_irp_n_irgs();
+	size_t *const offsets = XMALLOCN(size_t, n_irgs + 1);
+	foreach_irp_irg(i, irg) {
+		offsets[i] = obstack_object_size(&env->code);
+		write_irg(env, irg);
+	}
+	offsets[n_irgs] = obstack_object_size(&env->code);
+
+	size_t const code_size    = obstack_object_size(&env->code);
+	size_t const strings_size = obstack_object_size(&env->strings);
+	char  *const code         = (char*)obstack_finish(&env->code);
+	char  *const strings      = (char*)obstack_finish(&env->strings);
+
+	fwrite(binary_magic, 1, sizeof(binary_magic), file);
+	write_u32(file, BIN_VERSION);
+	write_u32(file, n_irgs);
+	write_u32(file, strings_size);
+	write_u32(file, code_size);
+	write_u32(file, toplevel_size);
+	foreach_irp_irg(i, irg) {
+		write_u32(file, get_entity_nr(get_irg_entity(irg)));
+		write_u32(file, offsets[i]);
+		write_u32(file, offsets[i + 1] - offsets[i]);
+	}
+	fwrite(strings, 1, strings_size, file);
+	fwrite(code, 1, code_size, file);
+
+	free(offsets);
+	obstack_free(&env->strings, NULL);
+	obstack_free(&env->code, NULL);
+	pmap_destroy(env->string_offsets);
+	free_write_env(env);
+}
 
 static void read_c(read_env_t *env)
 {
+	if (env->data != NULL) {
+		env->c = env->pos < env->end ? env->data[env->pos++] : EOF;
+		return;
+	}
 	int c = fgetc(env->file);
 	env->c = c;
 	if (c == '\n')
@@ -1144,9 +1486,62 @@ static bool expect_char(read_env_t *env, char ch)
 
 #define EXPECT(c) if (expect_char(env, (c))) {} else return
 
+static unsigned long read_bin_varint(read_env_t *env)
+{
+	unsigned long value = 0;
+	for (unsigned shift = 0; env->pos < env->end; shift += 7) {
+		unsigned char const b = env->data[env->pos++];
+		if (shift < sizeof(value) * 8)
+			value |= (unsigned long)(b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+			return value;
+	}
+	parse_error(env, "Unexpected end of data in number\n");
+	exit(1);
+}
+
+static long read_bin_number(read_env_t *env)
+{
+	unsigned long const zigzag = read_bin_varint(env);
+	read_c(env);
+	return (zigzag & 1) ? (long)~(zigzag >> 1) : (long)(zigzag >> 1);
+}
+
+/** Copies a string from the string pool to the obstack. */
+static char *read_bin_string(read_env_t *env)
+{
+	unsigned long const offset = read_bin_varint(env);
+	read_c(env);
+	if (offset >= env->strings_size) {
+		parse_error(env, "Invalid string offset %lu\n", offset);
+		exit(1);
+	}
+	const char *const str = env->strings + offset;
+	return (char*)obstack_copy0(&env->obst, str, strlen(str));
+}
+
+static char *read_bin_word(read_env_t *env)
+{
+	switch (env->c) {
+	case BIN_NUMBER: {
+		long const value = read_bin_number(env);
+		obstack_printf(&env->obst, "%ld", value);
+		obstack_1grow(&env->obst, '\0');
+		return (char*)obstack_finish(&env->obst);
+	}
+	case BIN_WORD:
+	case BIN_STRING:
+		return read_bin_string(env);
+	}
+	parse_error(env, "Expected word, got tag %d\n", env->c);
+	exit(1);
+}
+
 static char *read_word(read_env_t *env)
 {
 	skip_ws(env);
+	if (env->data != NULL)
+		return read_bin_word(env);
 
 	assert(obstack_object_size(&env->obst) == 0);
 	while (true) {
@@ -1174,6 +1569,13 @@ endofword:
 static char *read_string(read_env_t *env)
 {
 	skip_ws(env);
+	if (env->data != NULL) {
+		if (env->c != BIN_STRING) {
+			parse_error(env, "Expected string, got tag %d\n", env->c);
+			exit(1);
+		}
+		return read_bin_string(env);
+	}
 	if (env->c != '"') {
 		parse_error(env, "Expected string, got '%c'\n", env->c);
 		exit(1);
@@ -1234,7 +1636,13 @@ static ident *read_symbol(read_env_t *env)
 static char *read_string_null(read_env_t *env)
 {
 	skip_ws(env);
-	if (env->c == 'N') {
+	if (env->data != NULL) {
+		if (env->c == BIN_NULL) {
+			read_c(env);
+			return NULL;
+		}
+		return read_string(env);
+	} else if (env->c == 'N') {
 		char *str = read_word(env);
 		if (streq(str, "NULL")) {
 			obstack_free(&env->obst, str);
@@ -1262,6 +1670,13 @@ static ident *read_ident_null(read_env_t *env)
 static long read_long(read_env_t *env)
 {
 	skip_ws(env);
+	if (env->data != NULL) {
+		if (env->c != BIN_NUMBER) {
+			parse_error(env, "Expected number, got tag %d\n", env->c);
+			exit(1);
+		}
+		return read_bin_number(env);
+	}
 	if (!isdigit(env->c) && env->c != '-') {
 		parse_error(env, "Expected number, got '%c'\n", env->c);
 		exit(1);
@@ -1309,7 +1724,7 @@ static void expect_list_begin(read_env_t *env)
 
 static bool list_has_next(read_env_t *env)
 {
-	if (feof(env->file)) {
+	if (env->c == EOF) {
 		parse_error(env, "Unexpected EOF while reading list");
 		exit(1);
 	}
@@ -2168,47 +2583,34 @@ static void read_program(read_env_t *env)
 	}
 }
 
-int ir_import(const char *filename)
+static void init_read_env(read_env_t *env, const char *inputname)
 {
-	FILE *file = fopen(filename, "rt");
-	if (file == NULL) {
-		perror(filename);
-		return 1;
-	}
-
-	int res = ir_import_file(file, filename);
-	fclose(file);
-	return res;
-}
-
-int ir_import_file(FILE *input, const char *inputname)
-{
-	read_env_t          myenv;
-	int                 oldoptimize = get_optimize();
-	read_env_t         *env         = &myenv;
-
-	readers_init();
-	symtbl_init();
-
 	memset(env, 0, sizeof(*env));
 	obstack_init(&env->obst);
 	obstack_init(&env->preds_obst);
 	env->idset      = new_set(id_cmp, 128);
 	env->fixedtypes = NEW_ARR_F(ir_type *, 0);
 	env->inputname  = inputname;
-	env->file       = input;
 	env->line       = 1;
 	env->delayed_initializers = NEW_ARR_F(delayed_initializer_t, 0);
+}
 
-	/* read first character */
-	read_c(env);
+static void free_read_env(read_env_t *env)
+{
+	if (env->deferred != NULL)
+		DEL_ARR_F(env->deferred);
+	if (env->bodies != NULL)
+		pmap_destroy(env->bodies);
+	free(env->data);
 
-	/* if the first line starts with '#', it contains a comment. */
-	if (env->c == '#')
-		skip_to(env, '\n');
+	del_set(env->idset);
 
-	set_optimize(0);
+	obstack_free(&env->preds_obst, NULL);
+	obstack_free(&env->obst, NULL);
+}
 
+static void read_toplevel(read_env_t *env)
+{
 	while (true) {
 		keyword_t kw;
 
@@ -2268,13 +2670,253 @@ int ir_import_file(FILE *input, const char *inputname)
 	}
 	DEL_ARR_F(env->delayed_initializers);
 	env->delayed_initializers = NULL;
+}
 
-	del_set(env->idset);
+/** The binary import whose graph bodies are still deferred, if any. */
+static read_env_t *deferred_env;
+
+static void free_deferred_env(void)
+{
+	free_read_env(deferred_env);
+	free(deferred_env);
+	deferred_env         = NULL;
+	irp->n_deferred_irgs = 0;
+
+	pmap_destroy(node_readers);
+	node_readers = NULL;
+}
+
+static void read_deferred_body(read_env_t *env, ir_entity *entity)
+{
+	size_t const          idx  = PTR_TO_INT(pmap_get(void, env->bodies, entity)) - 1;
+	deferred_body_t const body = env->deferred[idx];
+	assert(body.entity == entity);
+	entity->attr.mtd_attr.irg_deferred = false;
+	--irp->n_deferred_irgs;
+
+	int const oldoptimize = get_optimize();
+	set_optimize(0);
+	env->loading = true;
+	env->pos     = body.offset;
+	env->end     = body.offset + body.size;
+	read_c(env);
+	if (read_keyword(env) != kw_irg) {
+		parse_error(env, "Expected graph body of %s\n", get_entity_name(entity));
+	} else {
+		ir_graph *const irg = read_irg(env);
+		if (get_irg_entity(irg) != entity)
+			parse_error(env, "Graph body at index %zu belongs to another entity\n", idx);
+	}
+	env->loading = false;
+	set_optimize(oldoptimize);
+
+	if (env->read_errors)
+		panic("could not read deferred graph of %+F", entity);
+}
+
+ir_graph *load_deferred_irg(ir_entity *entity)
+{
+	read_env_t *const env = deferred_env;
+	assert(env != NULL);
+	/* graph bodies only refer to entities and types, which are all loaded, so
+	 * nothing may ask for another graph while a body is read */
+	if (env->loading)
+		panic("graph of %+F requested while reading a deferred graph", entity);
+
+	read_deferred_body(env, entity);
+	ir_graph *const irg = get_entity_irg(entity);
+	if (irp->n_deferred_irgs == 0)
+		free_deferred_env();
+	return irg;
+}
 
+void load_deferred_irgs(void)
+{
+	read_env_t *const env = deferred_env;
+	if (env == NULL)
+		return;
+	if (env->loading)
+		panic("program graphs requested while reading a deferred graph");
+
+	for (size_t i = 0, n = ARR_LEN(env->deferred); i < n; ++i) {
+		ir_entity *const entity = env->deferred[i].entity;
+		if (entity->attr.mtd_attr.irg_deferred)
+			read_deferred_body(env, entity);
+	}
+	free_deferred_env();
+}
+
+void drop_deferred_irgs(void)
+{
+	read_env_t *const env = deferred_env;
+	if (env == NULL)
+		return;
+
+	for (size_t i = 0, n = ARR_LEN(env->deferred); i < n; ++i)
+		env->deferred[i].entity->attr.mtd_attr.irg_deferred = false;
+	free_deferred_env();
+}
+
+static size_t get_u32(const unsigned char *data)
+{
+	return (size_t)data[0] | (size_t)data[1] << 8 | (size_t)data[2] << 16
+	     | (size_t)data[3] << 24;
+}
+
+static unsigned char *read_file_contents(FILE *input, int first, size_t *size)
+{
+	size_t         capacity = 4096;
+	size_t         len      = 1;
+	unsigned char *data     = XMALLOCN(unsigned char, capacity);
+	data[0] = (unsigned char)first;
+	while (true) {
+		len += fread(data + len, 1, capacity - len, input);
+		if (len < capacity)
+			break;
+		capacity *= 2;
+		data      = XREALLOC(data, unsigned char, capacity);
+	}
+	*size = len;
+	return data;
+}
+
+/**
+ * Imports a binary file. Modes, types, entities, the constant graph and the
+ * program data are read right away, the graph bodies are only recorded and
+ * read when their graph is accessed the first time.
+ */
+static int import_binary(FILE *input, const char *inputname, int first)
+{
+	size_t               size;
+	unsigned char *const data = read_file_contents(input, first, &size);
+
+	size_t n_irgs        = 0;
+	size_t strings_start = 0;
+	size_t strings_size  = 0;
+	size_t code_start    = 0;
+	size_t code_size     = 0;
+	size_t toplevel_size = 0;
+	bool   valid         = size >= BIN_HEADER_SIZE
+	    && memcmp(data, binary_magic, sizeof(binary_magic)) == 0
+	    && get_u32(data + 8) == BIN_VERSION;
+	if (valid) {
+		n_irgs        = get_u32(data + 12);
+		strings_size  = get_u32(data + 16);
+		code_size     = get_u32(data + 20);
+		toplevel_size = get_u32(data + 24);
+		strings_start = BIN_HEADER_SIZE + n_irgs * BIN_ENTRY_SIZE;
+		code_start    = strings_start + strings_size;
+		valid = n_irgs <= (size - BIN_HEADER_SIZE) / BIN_ENTRY_SIZE
+		     && code_start <= size && code_size == size - code_start
+		     && toplevel_size <= code_size
+		     && (strings_size == 0 || data[code_start - 1] == '\0');
+	}
+	if (!valid) {
+		fprintf(stderr, "%s: error invalid binary firm file\n", inputname);
+		free(data);
+		return 1;
+	}
+
+	read_env_t *const env         = XMALLOC(read_env_t);
+	int         const oldoptimize = get_optimize();
+
+	readers_init();
+	symtbl_init();
+
+	init_read_env(env, inputname);
+	/* errors in deferred bodies are reported after the caller's name is gone */
+	env->inputname    = (const char*)obstack_copy0(&env->obst, inputname,
+	                                               strlen(inputname));
+	env->data         = data;
+	env->pos          = code_start;
+	env->end          = code_start + toplevel_size;
+	env->strings      = (const char*)data + strings_start;
+	env->strings_size = strings_size;
+	env->deferred     = NEW_ARR_F(deferred_body_t, 0);
+	env->bodies       = pmap_create();
+
+	set_optimize(0);
+	read_c(env);
+	read_toplevel(env);
 	set_optimize(oldoptimize);
 
-	obstack_free(&env->preds_obst, NULL);
-	obstack_free(&env->obst, NULL);
+	for (size_t i = 0; i < n_irgs; ++i) {
+		const unsigned char *const entry = data + BIN_HEADER_SIZE
+		                                 + i * BIN_ENTRY_SIZE;
+		long       const nr     = (long)get_u32(entry);
+		size_t     const offset = get_u32(entry + 4);
+		size_t     const len    = get_u32(entry + 8);
+		ir_entity *const entity = get_entity(env, nr);
+		if (offset > code_size || len > code_size - offset) {
+			parse_error(env, "Invalid graph body of entity %ld\n", nr);
+			continue;
+		}
+		if (!is_method_entity(entity) || get_entity_irg(entity) != NULL) {
+			parse_error(env, "Entity %ld cannot have a graph body\n", nr);
+			continue;
+		}
+
+		deferred_body_t const body = { entity, code_start + offset, len };
+		ARR_APP1(deferred_body_t, env->deferred, body);
+		pmap_insert(env->bodies, entity, INT_TO_PTR(ARR_LEN(env->deferred)));
+		entity->attr.mtd_attr.irg_deferred = true;
+		++irp->n_deferred_irgs;
+	}
+
+	int const res = env->read_errors;
+	deferred_env = env;
+	if (irp->n_deferred_irgs == 0)
+		free_deferred_env();
+	return res;
+}
+
+int ir_import(const char *filename)
+{
+	FILE *file = fopen(filename, "rb");
+	if (file == NULL) {
+		perror(filename);
+		return 1;
+	}
+
+	int res = ir_import_file(file, filename);
+	fclose(file);
+	return res;
+}
+
+int ir_import_file(FILE *input, const char *inputname)
+{
+	/* only one import may have deferred graph bodies */
+	load_deferred_irgs();
+
+	int const first = fgetc(input);
+	if (first == (unsigned char)binary_magic[0])
+		return import_binary(input, inputname, first);
+	ungetc(first, input);
+
+	read_env_t          myenv;
+	int                 oldoptimize = get_optimize();
+	read_env_t         *env         = &myenv;
+
+	readers_init();
+	symtbl_init();
+
+	init_read_env(env, inputname);
+	env->file       = input;
+
+	/* read first character */
+	read_c(env);
+
+	/* if the first line starts with '#', it contains a comment. */
+	if (env->c == '#')
+		skip_to(env, '\n');
+
+	set_optimize(0);
+
+	read_toplevel(env);
+
+	set_optimize(oldoptimize);
+
+	free_read_env(env);
 
 	pmap_destroy(node_readers);
 	node_readers = NULL;
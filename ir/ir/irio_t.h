@@ -6,6 +6,7 @@
 #include "irnode_t.h"
 #include "obst.h"
 #include "pdeq.h"
+#include "pmap.h"
 #include "set.h"
 #include "type_t.h"
 #include "typerep.h"
@@ -21,12 +22,29 @@ typedef struct delayed_pred_t {
 	long     preds[];
 } delayed_pred_t;
 
+/** A graph body of a binary file which is read on first access. */
+typedef struct deferred_body_t {
+	ir_entity *entity;
+	size_t     offset;
+	size_t     size;
+} deferred_body_t;
+
 typedef struct read_env_t {
 	int            c;           /**< currently read char */
 	FILE          *file;
 	const char    *inputname;
 	unsigned       line;
 
+	/* binary input, data is NULL when reading the textual format */
+	unsigned char *data;
+	size_t         pos;         /**< read position in data */
+	size_t         end;         /**< end of the currently read section */
+	const char    *strings;     /**< string pool */
+	size_t         strings_size;
+	deferred_body_t *deferred;  /**< graph bodies in index order */
+	pmap          *bodies;      /**< maps methods to their index + 1 */
+	bool           loading;     /**< a deferred body is being read */
+
 	ir_graph      *irg;
 	set           *idset;       /**< id_entry set, which maps from file ids to
 	                                 new Firm elements */
@@ -39,9 +57,15 @@ typedef struct read_env_t {
 } read_env_t;
 
 typedef struct write_env_t {
-	FILE *file;
-	deq_t write_queue;
-	deq_t entity_queue;
+	FILE          *file;
+	deq_t          write_queue;
+	deq_t          entity_queue;
+	bool           binary;      /**< write the binary format */
+	struct obstack code;        /**< binary token stream */
+	struct obstack strings;     /**< binary string pool */
+	pmap          *string_offsets;
+	bool           fingerprint; /**< describe entities and types in place */
+	pmap          *numbers;     /**< canonical node and label numbers */
 } write_env_t;
 
 void write_align(write_env_t *env, ir_align align);
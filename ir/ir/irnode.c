@@ -28,6 +28,8 @@
 
 #include "irhooks.h"
 #include "util.h"
+#include "bitfiddle.h"
+#include "xmalloc.h"
 
 #include "beinfo.h"
 
@@ -75,13 +77,52 @@ ir_relation get_inversed_relation(ir_relation relation)
 	return code;
 }
 
+/**
+ * Returns the number of entries allocated for a heap allocated in array with
+ * @p len entries. The allocation grows in powers of two, so appending inputs
+ * is amortized constant.
+ */
+static size_t get_heap_in_capacity(size_t len)
+{
+	return ceil_po2(MAX(len, 4));
+}
+
+/**
+ * Sets the arity of a node with a heap allocated in array.
+ */
+static void resize_heap_in(ir_node *node, int arity)
+{
+	size_t const old_capacity = get_heap_in_capacity(node->arity + 1);
+	size_t const new_capacity = get_heap_in_capacity(arity + 1);
+	if (old_capacity != new_capacity)
+		node->in = XREALLOC(node->in, ir_node*, new_capacity);
+	node->arity = arity;
+}
+
+void append_irn_in(ir_node *node, ir_node *pred)
+{
+	int const arity = node->arity;
+	resize_heap_in(node, arity + 1);
+	node->in[arity + 1] = pred;
+}
+
+void free_irn_heap_in(ir_node *node)
+{
+	free(node->in);
+	node->in = NULL;
+}
+
 ir_node *new_ir_node(dbg_info *db, ir_graph *irg, ir_node *block, ir_op *op,
                      ir_mode *mode, int arity, ir_node *const *in)
 {
 	assert(mode != NULL);
 
-	size_t   const node_size = offsetof(ir_node, attr) + op->attr_size;
-	ir_node *const res       = (ir_node*)OALLOCNZ(get_irg_obstack(irg), char, node_size);
+	/* Nodes with dynamic arity must always have a heap allocated in array, the
+	 * in array of all other nodes directly follows their attributes. */
+	bool     const heap_in   = arity < 0 || op->opar == oparity_dynamic;
+	size_t   const node_size = round_up2(offsetof(ir_node, attr) + op->attr_size, sizeof(ir_node*));
+	size_t   const in_size   = heap_in ? 0 : (arity + 1) * sizeof(ir_node*);
+	ir_node *const res       = (ir_node*)OALLOCNZ(get_irg_obstack(irg), char, node_size + in_size);
 
 	res->kind     = k_ir_node;
 	res->op       = op;
@@ -90,13 +131,14 @@ ir_node *new_ir_node(dbg_info *db, ir_graph *irg, ir_node *block, ir_op *op,
 	res->node_idx = irg_register_node_idx(irg, res);
 
 	if (arity < 0) {
-		res->in = NEW_ARR_F(ir_node *, 1);  /* 1: space for block */
+		res->in    = XMALLOCN(ir_node*, get_heap_in_capacity(1));
+		res->arity = 0;
 	} else {
-		/* Nodes with dynamic arity must always have a flexible array. */
-		if (op->opar == oparity_dynamic)
-			res->in = NEW_ARR_F(ir_node *, (arity+1));
+		if (heap_in)
+			res->in = XMALLOCN(ir_node*, get_heap_in_capacity(arity + 1));
 		else
-			res->in = NEW_ARR_D(ir_node*, get_irg_obstack(irg), arity + 1);
+			res->in = (ir_node**)((char*)res + node_size);
+		res->arity = arity;
 		MEMCPY(&res->in[1], in, arity);
 	}
 
@@ -104,12 +146,10 @@ ir_node *new_ir_node(dbg_info *db, ir_graph *irg, ir_node *block, ir_op *op,
 	set_irn_dbg_info(res, db);
 	res->node_nr = get_irp_new_node_nr();
 
-	for (ir_edge_kind_t i = EDGE_KIND_FIRST; i <= EDGE_KIND_LAST; ++i) {
-		INIT_LIST_HEAD(&res->edge_info[i].outs_head);
-		/* Edges will be built immediately. */
-		res->edge_info[i].edges_built = 1;
-		res->edge_info[i].out_count = 0;
-	}
+	/* Edges will be built immediately. */
+	res->edge_info.edges_built = 1;
+	if (op == op_Block)
+		res->attr.block.succ_edges.edges_built = 1;
 
 	/* don't put this into the for loop, arity is -1 for some nodes! */
 	if (block != NULL)
@@ -151,27 +191,32 @@ void set_irn_in(ir_node *const node, int const arity, ir_node *const *const in)
 	}
 #endif
 
-	ir_graph  *irg     = get_irn_irg(node);
-	ir_node ***pOld_in = &node->in;
-	int        i;
+	ir_graph *irg       = get_irn_irg(node);
+	int       old_arity = node->arity;
+	int       i;
 	for (i = 0; i < arity; i++) {
-		if (i < (int)ARR_LEN(*pOld_in)-1)
-			edges_notify_edge(node, i, in[i], (*pOld_in)[i+1], irg);
+		if (i < old_arity)
+			edges_notify_edge(node, i, in[i], node->in[i+1], irg);
 		else
-			edges_notify_edge(node, i, in[i], NULL,            irg);
+			edges_notify_edge(node, i, in[i], NULL,          irg);
 	}
-	for (;i < (int)ARR_LEN(*pOld_in)-1; i++) {
-		edges_notify_edge(node, i, NULL, (*pOld_in)[i+1], irg);
+	for (;i < old_arity; i++) {
+		edges_notify_edge(node, i, NULL, node->in[i+1], irg);
 	}
 
-	if (arity != (int)ARR_LEN(*pOld_in) - 1) {
-		ir_node * block = (*pOld_in)[0];
-		*pOld_in = NEW_ARR_D(ir_node*, get_irg_obstack(irg), arity + 1);
-		(*pOld_in)[0] = block;
+	if (arity != old_arity) {
+		if (has_irn_heap_in(node)) {
+			resize_heap_in(node, arity);
+		} else {
+			ir_node *block = node->in[0];
+			node->in    = OALLOCN(get_irg_obstack(irg), ir_node*, arity + 1);
+			node->in[0] = block;
+			node->arity = arity;
+		}
 	}
 	fix_backedges(get_irg_obstack(irg), node);
 
-	MEMCPY(*pOld_in + 1, in, arity);
+	MEMCPY(node->in + 1, in, arity);
 
 	/* update irg flags */
 	clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUTS | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
@@ -205,8 +250,8 @@ int add_irn_n(ir_node *node, ir_node *in)
 	ir_graph *irg = get_irn_irg(node);
 
 	assert(is_irn_dynamic(node));
-	int pos = ARR_LEN(node->in) - 1;
-	ARR_APP1(ir_node *, node->in, in);
+	int pos = node->arity;
+	append_irn_in(node, in);
 	edges_notify_edge(node, pos, node->in[pos + 1], NULL, irg);
 
 	/* update irg flags */
@@ -229,7 +274,7 @@ static void remove_irn_n(ir_node *node, int n)
 	}
 	/* Remove last edge. */
 	edges_notify_edge(node, arity - 1, NULL, last, irg);
-	ARR_SHRINKLEN(node->in, arity);
+	resize_heap_in(node, arity - 1);
 
 	/* update irg flags */
 	clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUTS);
@@ -442,10 +487,10 @@ void set_End_keepalives(ir_node *end, int n, ir_node *in[])
 {
 	/* notify that edges are deleted */
 	ir_graph *irg = get_irn_irg(end);
-	for (size_t e = END_KEEPALIVE_OFFSET; e < ARR_LEN(end->in) - 1; ++e) {
+	for (int e = END_KEEPALIVE_OFFSET; e < end->arity; ++e) {
 		edges_notify_edge(end, e, NULL, end->in[e + 1], irg);
 	}
-	ARR_RESIZE(ir_node *, end->in, n + 1 + END_KEEPALIVE_OFFSET);
+	resize_heap_in(end, n + END_KEEPALIVE_OFFSET);
 
 	for (int i = 0; i < n; ++i) {
 		end->in[1 + END_KEEPALIVE_OFFSET + i] = in[i];
@@ -521,9 +566,8 @@ void free_End(ir_node *end)
 {
 	assert(is_End(end));
 	end->kind = k_BAD;
-	DEL_ARR_F(end->in);
-	end->in = NULL;   /* @@@ make sure we get an error if we use the
-	                     in array afterwards ... */
+	/* make sure we get an error if we use the in array afterwards */
+	free_irn_heap_in(end);
 }
 
 int (is_Const_null)(const ir_node *node)
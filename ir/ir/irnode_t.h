@@ -85,11 +85,25 @@ struct ir_switch_table {
 	ir_switch_table_entry entries[];
 };
 
+/**
+ * Edge info to put into an irn.
+ */
+typedef struct irn_edge_kind_info_t {
+	ir_edge_t *outs;            /**< Array of all outs. */
+	unsigned  *in_slots;        /**< Index of the edge of each input in the
+	                                 outs array of its target, indexed by
+	                                 the input position + 1. */
+	unsigned   out_count;       /**< Number of outs in the array. */
+	unsigned   outs_log   : 5;  /**< log2 of the size of the outs array. */
+	unsigned   slots_log  : 5;  /**< log2 of the size of in_slots. */
+	unsigned   edges_built : 1; /**< Set edges where built for this node. */
+} irn_edge_info_t;
+
 /** Attributes for Block nodes. */
 typedef struct block_attr {
 	ir_visited_t block_visited; /**< Visited flag for block walker. */
 	unsigned    is_matured : 1; /**< If set, all inputs are fixed. */
-	unsigned    dynamic_ins: 1; /**< If set in-array is an ARR_F on the heap. */
+	unsigned    dynamic_ins: 1; /**< If set in-array is allocated on the heap. */
 	unsigned    marked     : 1; /**< Can be used to temporary mark the block. */
 	ir_node   **graph_arr;      /**< An array to store construction values. */
 	ir_dom_info dom;            /**< Information about dominators. */
@@ -98,6 +112,9 @@ typedef struct block_attr {
 	ir_entity  *entity;         /**< entity representing this block */
 	ir_node    *phis;           /**< The list of Phi nodes in this block. */
 	double      execfreq;       /**< block execution frequency */
+	ir_loop    *loop;           /**< Loop information. */
+	irn_edge_info_t succ_edges; /**< Control flow edges to the successor
+	                                 blocks (EDGE_KIND_BLOCK). */
 } block_attr;
 
 /** Attributes for Cond nodes. */
@@ -263,17 +280,6 @@ typedef union ir_attr {
 	switch_attr    switcha;
 } ir_attr;
 
-/**
- * Edge info to put into an irn.
- */
-typedef struct irn_edge_kind_info_t {
-	struct list_head outs_head;  /**< The list of all outs. */
-	unsigned edges_built : 1;    /**< Set edges where built for this node. */
-	unsigned out_count   : 31;   /**< Number of outs in the list. */
-} irn_edge_info_t;
-
-typedef irn_edge_info_t irn_edges_info_t[EDGE_KIND_LAST+1];
-
 /**
  * A Def-Use edge.
  */
@@ -295,7 +301,9 @@ struct ir_node {
 	unsigned         node_idx; /**< The node index of this node in its graph. */
 	ir_op           *op;       /**< The Opcode of this node. */
 	ir_mode         *mode;     /**< The Mode of this node. */
-	struct ir_node **in;       /**< The array of predecessors / operands. */
+	struct ir_node **in;       /**< The block and the predecessors. For nodes
+	                                with fixed arity the array directly follows
+	                                the attributes. */
 	ir_graph        *irg;
 	ir_visited_t     visited;  /**< Visited counter for walks of the graph. */
 	void            *link;     /**< To attach additional information to the
@@ -303,15 +311,12 @@ struct ir_node {
 	                                to nodes that shall replace a node. */
 	dbg_info        *dbi;      /**< Information for debug support. */
 	long             node_nr;  /**< Globally unique node number. */
-
-	union {
-		ir_def_use_edges *out;    /**< array of def-use edges. */
-		unsigned          n_outs; /**< number of def-use edges (temporarily used
-		                               during construction of data structure) */
-	} o;
-	ir_loop         *loop;         /**< Loop information. */
+	int              arity;    /**< Number of predecessors, in has arity + 1
+	                                entries. */
 	void            *backend_info;
-	irn_edges_info_t edge_info;    /**< Everlasting out edges. */
+	irn_edge_info_t  edge_info; /**< Everlasting out edges (EDGE_KIND_NORMAL),
+	                                 the block edges are in the block
+	                                 attributes. */
 
 	/** Attributes of this node. Depends on opcode. Must be last field. */
 	ir_attr attr;
@@ -381,7 +386,7 @@ static inline unsigned get_irn_opcode_(const ir_node *node)
  */
 static inline int get_irn_arity_(const ir_node *node)
 {
-	return (int)(ARR_LEN(node->in) - 1);
+	return node->arity;
 }
 
 /**
@@ -533,6 +538,16 @@ static inline bool is_irn_dynamic(ir_node const *const n)
 	return get_irn_op(n)->opar == oparity_dynamic;
 }
 
+/**
+ * Returns whether the in array of a node is allocated on the heap, which is
+ * the case for nodes with dynamic arity and immature blocks.
+ */
+static inline bool has_irn_heap_in(ir_node const *const n)
+{
+	return is_irn_dynamic(n)
+	    || (get_irn_op(n) == op_Block && n->attr.block.dynamic_ins);
+}
+
 /**
  * Get the predecessor block.
  *
@@ -727,6 +742,17 @@ void ir_register_getter_ops(void);
  *  accesses the End node) */
 void remove_keep_alive(const ir_node *kept_node);
 
+/**
+ * Appends @p pred to the heap allocated in array of @p node without notifying
+ * the edges.
+ */
+void append_irn_in(ir_node *node, ir_node *pred);
+
+/**
+ * Frees the heap allocated in array of @p node.
+ */
+void free_irn_heap_in(ir_node *node);
+
 /**
  * Create a node similar to @p old.  Except for @p block and @p in all aspects
  * are copied from @p old.
@@ -461,7 +461,11 @@ static void call_copy_attr(ir_graph *irg, const ir_node *old_node,
 static void block_copy_attr(ir_graph *irg, const ir_node *old_node,
                             ir_node *new_node)
 {
+	/* the block edges of the new node are already registered */
+	irn_edge_info_t const succ_edges = new_node->attr.block.succ_edges;
 	default_copy_attr(irg, old_node, new_node);
+	new_node->attr.block.succ_edges    = succ_edges;
+	new_node->attr.block.loop          = NULL;
 	new_node->attr.block.phis          = NULL;
 	new_node->attr.block.backedge      = new_backedge_arr(get_irg_obstack(irg), get_irn_arity(new_node));
 	new_node->attr.block.block_visited = 0;
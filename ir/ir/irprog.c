@@ -93,6 +93,8 @@ void free_ir_prog(void)
 	if (irp == NULL)
 		return;
 
+	drop_deferred_irgs();
+
 	/* must iterate backwards here */
 	foreach_irp_irg_r(i, irg) {
 		free_ir_graph(irg);
@@ -16,6 +16,7 @@
 
 #include "array.h"
 #include "callgraph.h"
+#include "compiler.h"
 #include "irmemory.h"
 #include "pmap.h"
 #include "typerep.h"
@@ -55,6 +56,8 @@ struct ir_prog {
 	ir_type   *dummy_owner;         /**< owner for internal entities */
 	ir_type   *byte_type;           /**< type for a 'byte' */
 	ident    **global_asms;         /**< An array of global ASM insertions. */
+	size_t     n_deferred_irgs;     /**< Number of graphs whose body is not
+	                                     read from a binary file yet. */
 
 	/** Validity of callee information. Lowest value for all irgs. */
 	irg_callee_info_state          callee_info_state;
@@ -93,8 +96,20 @@ static inline ir_type *get_tls_type_(void)
 	return get_segment_type_(IR_SEGMENT_THREAD_LOCAL);
 }
 
+/**
+ * Reads all deferred graph bodies of a binary import.
+ * Implemented by the importer in irio.c. Panics if called while a body is
+ * read.
+ */
+void load_deferred_irgs(void);
+
+/** Forgets about all deferred graph bodies of a binary import. */
+void drop_deferred_irgs(void);
+
 static inline size_t get_irp_n_irgs_(void)
 {
+	if (UNLIKELY(irp->n_deferred_irgs != 0))
+		load_deferred_irgs();
 	return ARR_LEN(irp->graphs);
 }
 
@@ -74,4 +74,15 @@ ir_node *irn_copy_into_irg(const ir_node *node, ir_graph *irg);
  */
 void irn_rewire_inputs(ir_node *node);
 
+/**
+ * Reconstructs SSA form for the users of @p orig_val in @p orig_block after
+ * @p second_val in @p second_block became an alternative definition, e.g. a
+ * copy of @p orig_val in a duplicated block. Phis are created where both
+ * definitions meet. The users are found through the out edges of
+ * @p orig_val, the function uses the visited flags and links of blocks and
+ * works without dominance information.
+ */
+void construct_ssa_for_copy(ir_node *orig_block, ir_node *orig_val,
+                            ir_node *second_block, ir_node *second_val);
+
 #endif
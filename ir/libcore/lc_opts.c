@@ -475,6 +475,24 @@ void lc_opt_print_help_for_entry(lc_opt_entry_t *ent, char separator, FILE *f)
 	lc_opt_print_help_rec(ent, separator, ent, f);
 }
 
+void lc_opt_append_values(lc_opt_entry_t *ent, struct obstack *obst)
+{
+	lc_grp_special_t *s = lc_get_grp_special(ent);
+	char grp_name[512];
+	char value[256];
+
+	lc_opt_print_grp_path(grp_name, sizeof(grp_name), ent, '.', NULL);
+	list_for_each_entry(lc_opt_entry_t, e, &s->opts, list) {
+		value[0] = '\0';
+		lc_opt_value_to_string(value, sizeof(value), e);
+		obstack_printf(obst, "%s.%s=%s\n", grp_name, e->name, value);
+	}
+
+	list_for_each_entry(lc_opt_entry_t, e, &s->grps, list) {
+		lc_opt_append_values(e, obst);
+	}
+}
+
 int lc_opt_from_single_arg(const lc_opt_entry_t *root, const char *arg)
 {
 	const lc_opt_entry_t *grp = root;
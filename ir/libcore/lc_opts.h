@@ -186,6 +186,14 @@ const char *lc_opt_get_type_name(const lc_opt_entry_t *ent);
  */
 void lc_opt_print_help_for_entry(lc_opt_entry_t *ent, char separator, FILE *f);
 
+struct obstack;
+
+/**
+ * Append a line "path=value" for every option below the given entity to
+ * the current object of the obstack.
+ */
+void lc_opt_append_values(lc_opt_entry_t *ent, struct obstack *obst);
+
 bool lc_opt_add_table(lc_opt_entry_t *grp, const lc_opt_table_entry_t *table);
 
 /**
@@ -14,6 +14,7 @@
 #include "dbginfo_t.h"
 #include "panic.h"
 #include "ircons_t.h"
+#include "array.h"
 #include "iredges_t.h"
 #include "irgmod.h"
 #include "irnodeset.h"
@@ -61,6 +62,12 @@ static pmap *lowered_type;
 
 static ir_nodeset_t created_mux_nodes;
 
+/** Whether common cases are handled inline before calling the library. */
+static bool inline_fast_paths;
+
+/** Mux nodes selecting between an inline fast path and a library call. */
+static ir_node **fast_path_muxes;
+
 /**
  * @return The lowered (floating point) mode.
  */
@@ -291,6 +298,449 @@ static ir_node *make_softfloat_call(ir_node *const n, char const *const name,
 	return result;
 }
 
+/**
+ * Integer view of a floating point operation used to build the inline fast
+ * paths.
+ */
+typedef struct float_bits_t {
+	dbg_info *dbgi;
+	ir_node  *block;
+	ir_mode  *float_mode;
+	ir_mode  *mode;      /**< integer mode holding the bits */
+	unsigned  n_bits;    /**< number of bits */
+	unsigned  mant_size; /**< number of explicit mantissa bits */
+	unsigned  exp_max;   /**< biased exponent of infinity and NaN */
+	ir_node  *checks;    /**< sign bit set if the fast path does not apply */
+} float_bits_t;
+
+static void init_float_bits(float_bits_t *fb, ir_node *node,
+                            ir_mode *float_mode)
+{
+	fb->dbgi       = get_irn_dbg_info(node);
+	fb->block      = get_nodes_block(node);
+	fb->float_mode = float_mode;
+	fb->mode       = get_lowered_mode(float_mode);
+	fb->n_bits     = get_mode_size_bits(fb->mode);
+	fb->mant_size  = get_mode_mantissa_size(float_mode);
+	fb->exp_max    = (1u << get_mode_exponent_size(float_mode)) - 1;
+	fb->checks     = NULL;
+}
+
+static ir_node *fb_const(const float_bits_t *fb, ir_tarval *tv)
+{
+	return new_r_Const(get_irn_irg(fb->block), tv);
+}
+
+static ir_node *fb_long(const float_bits_t *fb, long value)
+{
+	return new_r_Const_long(get_irn_irg(fb->block), fb->mode, value);
+}
+
+/** @return A constant with bit n set. */
+static ir_node *fb_bit(const float_bits_t *fb, unsigned n)
+{
+	return fb_const(fb, tarval_shl_unsigned(get_mode_one(fb->mode), n));
+}
+
+/** @return A constant with the lower n bits set. */
+static ir_node *fb_mask(const float_bits_t *fb, unsigned n)
+{
+	ir_tarval *one = get_mode_one(fb->mode);
+	return fb_const(fb, tarval_sub(tarval_shl_unsigned(one, n), one));
+}
+
+static ir_node *fb_add(const float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	return new_rd_Add(fb->dbgi, fb->block, a, b);
+}
+
+static ir_node *fb_sub(const float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	return new_rd_Sub(fb->dbgi, fb->block, a, b);
+}
+
+static ir_node *fb_and(const float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	return new_rd_And(fb->dbgi, fb->block, a, b);
+}
+
+static ir_node *fb_or(const float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	return new_rd_Or(fb->dbgi, fb->block, a, b);
+}
+
+static ir_node *fb_eor(const float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	return new_rd_Eor(fb->dbgi, fb->block, a, b);
+}
+
+/** @return A shift amount for a variable shift by value. */
+static ir_node *fb_amount(const float_bits_t *fb, ir_node *value)
+{
+	if (get_irn_mode(value) == mode_Iu)
+		return value;
+	return new_rd_Conv(fb->dbgi, fb->block, value, mode_Iu);
+}
+
+static ir_node *fb_shl(const float_bits_t *fb, ir_node *value, ir_node *amount)
+{
+	return new_rd_Shl(fb->dbgi, fb->block, value, fb_amount(fb, amount));
+}
+
+static ir_node *fb_shr(const float_bits_t *fb, ir_node *value, ir_node *amount)
+{
+	return new_rd_Shr(fb->dbgi, fb->block, value, fb_amount(fb, amount));
+}
+
+static ir_node *fb_shl_c(const float_bits_t *fb, ir_node *value, unsigned n)
+{
+	ir_node *amount = new_r_Const_long(get_irn_irg(fb->block), mode_Iu, n);
+	return new_rd_Shl(fb->dbgi, fb->block, value, amount);
+}
+
+static ir_node *fb_shr_c(const float_bits_t *fb, ir_node *value, unsigned n)
+{
+	ir_node *amount = new_r_Const_long(get_irn_irg(fb->block), mode_Iu, n);
+	return new_rd_Shr(fb->dbgi, fb->block, value, amount);
+}
+
+static ir_node *fb_shrs_c(const float_bits_t *fb, ir_node *value, unsigned n)
+{
+	ir_node *amount = new_r_Const_long(get_irn_irg(fb->block), mode_Iu, n);
+	return new_rd_Shrs(fb->dbgi, fb->block, value, amount);
+}
+
+/** @return The bits of a floating point value. */
+static ir_node *fb_bits(const float_bits_t *fb, ir_node *value)
+{
+	return new_rd_Bitcast(fb->dbgi, fb->block, value, fb->mode);
+}
+
+/** @return The biased exponent of a value without sign. */
+static ir_node *fb_exponent(const float_bits_t *fb, ir_node *abs)
+{
+	return fb_shr_c(fb, abs, fb->mant_size);
+}
+
+/** @return The mantissa of a normal value including the hidden bit. */
+static ir_node *fb_mantissa(const float_bits_t *fb, ir_node *bits)
+{
+	ir_node *mant = fb_and(fb, bits, fb_mask(fb, fb->mant_size));
+	return fb_or(fb, mant, fb_bit(fb, fb->mant_size));
+}
+
+/**
+ * Adds a check min <= value <= max to the fast path condition. The values
+ * are interpreted as signed and must be far from overflowing.
+ */
+static void fb_check_range(float_bits_t *fb, ir_node *value, long min,
+                           long max)
+{
+	ir_node *below = fb_sub(fb, value, fb_long(fb, min));
+	ir_node *above = fb_sub(fb, fb_long(fb, max), value);
+	ir_node *check = fb_or(fb, below, above);
+	fb->checks = fb->checks != NULL ? fb_or(fb, fb->checks, check) : check;
+}
+
+/** Adds a check that an exponent belongs to a normal number. */
+static void fb_check_normal(float_bits_t *fb, ir_node *exponent)
+{
+	fb_check_range(fb, exponent, 1, fb->exp_max - 1);
+}
+
+/**
+ * Rounds a normalized mantissa with n_extra additional low bits to nearest
+ * even.
+ */
+static ir_node *fb_round(const float_bits_t *fb, ir_node *mant,
+                         unsigned n_extra)
+{
+	ir_mode *mode     = get_irn_mode(mant);
+	ir_graph *irg     = get_irn_irg(fb->block);
+	ir_node *one      = new_r_Const_long(irg, mode, 1);
+	ir_node *amount   = new_r_Const_long(irg, mode_Iu, n_extra);
+	ir_tarval *half   = tarval_shl_unsigned(get_mode_one(mode), n_extra - 1);
+	ir_node *bias     = new_r_Const(irg, tarval_sub(half, get_mode_one(mode)));
+	ir_node *lsb      = fb_and(fb, new_rd_Shr(fb->dbgi, fb->block, mant, amount),
+	                           one);
+	ir_node *biased   = fb_add(fb, fb_add(fb, mant, bias), lsb);
+	ir_node *rounded  = new_rd_Shr(fb->dbgi, fb->block, biased, amount);
+	if (mode != fb->mode)
+		rounded = new_rd_Conv(fb->dbgi, fb->block, rounded, fb->mode);
+	return rounded;
+}
+
+/**
+ * Assembles the result from sign, exponent and a rounded mantissa including
+ * the hidden bit. A mantissa carry correctly increments the exponent and
+ * overflows to infinity.
+ */
+static ir_node *fb_assemble(const float_bits_t *fb, ir_node *sign,
+                            ir_node *exponent, ir_node *mant)
+{
+	ir_node *exp_m1 = fb_sub(fb, exponent, fb_long(fb, 1));
+	ir_node *high   = fb_or(fb, sign, fb_shl_c(fb, exp_m1, fb->mant_size));
+	return fb_add(fb, high, mant);
+}
+
+/**
+ * Creates the bits of a + b for normal operands and a normal result.
+ * The operands are aligned with three extra guard, round and sticky bits.
+ * Cancellation of more than one bit is left to the slow path.
+ */
+static ir_node *create_fast_add(float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	unsigned const n_bits   = fb->n_bits;
+	unsigned const mant     = fb->mant_size;
+	ir_node       *one      = fb_long(fb, 1);
+	ir_node       *zero     = fb_long(fb, 0);
+	ir_node       *sign_bit = fb_bit(fb, n_bits - 1);
+	ir_node       *abs_mask = fb_mask(fb, n_bits - 1);
+
+	/* order the operands by magnitude, x is the larger one */
+	ir_node *abs_a = fb_and(fb, a, abs_mask);
+	ir_node *abs_b = fb_and(fb, b, abs_mask);
+	ir_node *swap  = fb_shrs_c(fb, fb_sub(fb, abs_a, abs_b), n_bits - 1);
+	ir_node *diff  = fb_and(fb, fb_eor(fb, a, b), swap);
+	ir_node *x     = fb_eor(fb, a, diff);
+	ir_node *y     = fb_eor(fb, b, diff);
+	ir_node *ex    = fb_exponent(fb, fb_and(fb, x, abs_mask));
+	ir_node *ey    = fb_exponent(fb, fb_and(fb, y, abs_mask));
+	fb_check_normal(fb, ex);
+	fb_check_normal(fb, ey);
+
+	/* align y, shifted out bits are collected in the sticky bit */
+	ir_node *mx     = fb_shl_c(fb, fb_mantissa(fb, x), 3);
+	ir_node *my     = fb_shl_c(fb, fb_mantissa(fb, y), 3);
+	ir_node *shift  = fb_sub(fb, ex, ey);
+	fb_check_range(fb, shift, 0, n_bits - 1);
+	ir_node *lost   = fb_and(fb, my, fb_sub(fb, fb_shl(fb, one, shift), one));
+	ir_node *sticky = fb_shr_c(fb, fb_sub(fb, zero, lost), n_bits - 1);
+	ir_node *my_a   = fb_or(fb, fb_shr(fb, my, shift), sticky);
+
+	/* add or subtract depending on the signs */
+	ir_node *eff_sub = fb_shr_c(fb, fb_eor(fb, x, y), n_bits - 1);
+	ir_node *neg     = fb_eor(fb, my_a, fb_sub(fb, zero, eff_sub));
+	ir_node *sum     = fb_add(fb, fb_add(fb, mx, neg), eff_sub);
+
+	/* normalize: the leading bit is at mant + 4, mant + 3 or mant + 2 */
+	fb_check_range(fb, fb_shr_c(fb, sum, mant + 2), 1, 7);
+	ir_node *hi      = fb_shr_c(fb, sum, mant + 4);
+	ir_node *top     = fb_sub(fb, fb_shr_c(fb, sum, mant + 3), one);
+	ir_node *lo      = fb_shr_c(fb, top, n_bits - 1);
+	ir_node *right   = fb_or(fb, fb_shr(fb, sum, hi), fb_and(fb, sum, hi));
+	ir_node *norm    = fb_shl(fb, right, lo);
+	ir_node *exp     = fb_sub(fb, fb_add(fb, ex, hi), lo);
+	fb_check_normal(fb, exp);
+
+	ir_node *rounded = fb_round(fb, norm, 3);
+	return fb_assemble(fb, fb_and(fb, x, sign_bit), exp, rounded);
+}
+
+/**
+ * Creates the bits of a * b for normal operands and a normal result. The
+ * product of the mantissas is computed exactly in an integer mode of twice
+ * the size.
+ */
+static ir_node *create_fast_mul(float_bits_t *fb, ir_node *a, ir_node *b)
+{
+	unsigned const n_bits   = fb->n_bits;
+	unsigned const mant     = fb->mant_size;
+	ir_mode       *wide     = mode_Lu;
+	ir_node       *sign_bit = fb_bit(fb, n_bits - 1);
+	ir_node       *abs_mask = fb_mask(fb, n_bits - 1);
+	ir_node       *ea       = fb_exponent(fb, fb_and(fb, a, abs_mask));
+	ir_node       *eb       = fb_exponent(fb, fb_and(fb, b, abs_mask));
+	fb_check_normal(fb, ea);
+	fb_check_normal(fb, eb);
+
+	/* the product has 2 * mant + 1 or 2 * mant + 2 significant bits */
+	dbg_info *dbgi = fb->dbgi;
+	ir_node  *ma   = new_rd_Conv(dbgi, fb->block, fb_mantissa(fb, a), wide);
+	ir_node  *mb   = new_rd_Conv(dbgi, fb->block, fb_mantissa(fb, b), wide);
+	ir_node  *prod = new_rd_Mul(dbgi, fb->block, ma, mb);
+	ir_node  *top  = new_rd_Conv(dbgi, fb->block,
+	                             fb_shr_c(fb, prod, 2 * mant + 1), fb->mode);
+	ir_node  *norm = fb_shl(fb, prod, fb_sub(fb, fb_long(fb, 1), top));
+
+	ir_node *bias = fb_long(fb, fb->exp_max / 2);
+	ir_node *exp  = fb_add(fb, fb_sub(fb, fb_add(fb, ea, eb), bias), top);
+	fb_check_normal(fb, exp);
+
+	ir_node *rounded = fb_round(fb, norm, mant + 1);
+	ir_node *sign    = fb_and(fb, fb_eor(fb, a, b), sign_bit);
+	return fb_assemble(fb, sign, exp, rounded);
+}
+
+/**
+ * Selects between the fast path result and the library call. The Mux is
+ * turned into control flow after the walk, so the call is only executed if
+ * the fast path does not apply.
+ */
+static ir_node *create_fast_path(const float_bits_t *fb, ir_node *fast,
+                                 ir_node *slow)
+{
+	ir_node *limit  = fb_bit(fb, fb->n_bits - 1);
+	ir_node *cmp    = new_rd_Cmp(fb->dbgi, fb->block, fb->checks, limit,
+	                             ir_relation_less);
+	ir_node *result = new_rd_Bitcast(fb->dbgi, fb->block, fast, fb->float_mode);
+	ir_node *mux    = new_rd_Mux(fb->dbgi, fb->block, cmp, slow, result);
+	if (is_Mux(mux))
+		ARR_APP1(ir_node*, fast_path_muxes, mux);
+	return mux;
+}
+
+/**
+ * Transforms an arithmetic node into a library call, preceded by an inline
+ * fast path if possible.
+ */
+static ir_node *lower_arithmetic(ir_node *const n, char const *const name,
+                                 ir_node *const left, ir_node *const right)
+{
+	ir_node *const in[] = { left, right };
+	ir_node *const slow = make_softfloat_call(n, name, ARRAY_SIZE(in), in);
+	ir_mode *const mode = get_irn_mode(slow);
+	if (!inline_fast_paths || (is_Mul(n) && mode != mode_F))
+		return slow;
+
+	float_bits_t fb;
+	init_float_bits(&fb, n, mode);
+	ir_node *a = fb_bits(&fb, left);
+	ir_node *b = fb_bits(&fb, right);
+	ir_node *fast;
+	if (is_Mul(n)) {
+		fast = create_fast_mul(&fb, a, b);
+	} else {
+		if (is_Sub(n))
+			b = fb_eor(&fb, b, fb_bit(&fb, fb.n_bits - 1));
+		fast = create_fast_add(&fb, a, b);
+	}
+	return create_fast_path(&fb, fast, slow);
+}
+
+/**
+ * Creates an inline floating point comparison. The values are mapped to
+ * integers with the same order. If an operand is NaN the keys are replaced
+ * by constants which give the unordered result.
+ */
+static ir_node *create_inline_cmp(ir_node *const n, ir_relation relation)
+{
+	ir_node *const left  = get_Cmp_left(n);
+	ir_node *const right = get_Cmp_right(n);
+	float_bits_t fb;
+	init_float_bits(&fb, n, get_irn_mode(left));
+
+	unsigned const n_bits   = fb.n_bits;
+	ir_node       *one      = fb_long(&fb, 1);
+	ir_node       *zero     = fb_long(&fb, 0);
+	ir_node       *abs_mask = fb_mask(&fb, n_bits - 1);
+	ir_node       *inf      = fb_shl_c(&fb, fb_long(&fb, fb.exp_max),
+	                                   fb.mant_size);
+	ir_node       *keys[2];
+	ir_node       *unordered = zero;
+	ir_node *const ops[]    = { left, right };
+	for (unsigned i = 0; i < 2; ++i) {
+		ir_node *bits = fb_bits(&fb, ops[i]);
+		ir_node *abs  = fb_and(&fb, bits, abs_mask);
+		ir_node *nan  = fb_shr_c(&fb, fb_sub(&fb, inf, abs), n_bits - 1);
+		ir_node *sign = fb_shrs_c(&fb, bits, n_bits - 1);
+		unordered = fb_or(&fb, unordered, nan);
+		/* negative values are negated, so -0 and +0 are equal */
+		keys[i] = fb_sub(&fb, fb_eor(&fb, abs, sign), sign);
+	}
+
+	ir_relation const ordered = relation & ir_relation_less_equal_greater;
+	bool        const unord   = relation & ir_relation_unordered;
+	if (ordered == ir_relation_false
+	    || ordered == ir_relation_less_equal_greater) {
+		/* only the unordered flag matters */
+		ir_relation const rel = unord ? ir_relation_less_greater
+		                              : ir_relation_equal;
+		return new_rd_Cmp(fb.dbgi, fb.block, unordered, zero, rel);
+	}
+
+	/* choose keys for the unordered case which make the relation false
+	 * (or true if it contains unordered) */
+	ir_relation const target = unord ? ordered
+	                                 : ordered ^ ir_relation_less_equal_greater;
+	long nan_left  = 0;
+	long nan_right = 0;
+	if (!(target & ir_relation_equal)) {
+		if (target & ir_relation_less)
+			nan_right = 1;
+		else
+			nan_left = 1;
+	}
+	ir_node *const keep  = fb_sub(&fb, unordered, one);
+	ir_node *const nan   = fb_sub(&fb, zero, unordered);
+	ir_node *const nan_keys[] = {
+		fb_and(&fb, fb_long(&fb, nan_left),  nan),
+		fb_and(&fb, fb_long(&fb, nan_right), nan),
+	};
+	ir_mode *const signed_mode = find_signed_mode(fb.mode);
+	for (unsigned i = 0; i < 2; ++i) {
+		ir_node *key = fb_or(&fb, fb_and(&fb, keys[i], keep), nan_keys[i]);
+		keys[i] = new_rd_Conv(fb.dbgi, fb.block, key, signed_mode);
+	}
+	return new_rd_Cmp(fb.dbgi, fb.block, keys[0], keys[1], ordered);
+}
+
+/**
+ * Turns a fast path Mux into control flow: the library call is moved into
+ * a block which is only executed if the fast path does not apply.
+ */
+static void lower_fast_path_mux(ir_node *mux)
+{
+	ir_node *slow        = get_Mux_false(mux);
+	ir_node *results     = get_Proj_pred(slow);
+	ir_node *call        = get_Proj_pred(results);
+	ir_node *lower_block = get_nodes_block(mux);
+	part_block(mux);
+	ir_node *upper_block = get_nodes_block(mux);
+
+	ir_graph *irg        = get_irn_irg(mux);
+	ir_node  *cond       = new_r_Cond(upper_block, get_Mux_sel(mux));
+	ir_node  *true_proj  = new_r_Proj(cond, mode_X, pn_Cond_true);
+	ir_node  *false_proj = new_r_Proj(cond, mode_X, pn_Cond_false);
+	ir_node  *slow_block = new_r_Block(irg, 1, &false_proj);
+	set_Cond_jmp_pred(cond, COND_JMP_PRED_TRUE);
+	set_nodes_block(call,    slow_block);
+	set_nodes_block(results, slow_block);
+	set_nodes_block(slow,    slow_block);
+
+	ir_node *jmps[] = { true_proj, new_r_Jmp(slow_block) };
+	assert(get_Block_n_cfgpreds(lower_block) == 1);
+	kill_node(get_Block_cfgpred(lower_block, 0));
+	set_irn_in(lower_block, ARRAY_SIZE(jmps), jmps);
+
+	ir_node *values[] = { get_Mux_true(mux), slow };
+	ir_node *phi      = new_r_Phi(lower_block, ARRAY_SIZE(values), values,
+	                              get_irn_mode(mux));
+	collect_new_phi_node(phi);
+	exchange(mux, phi);
+
+	/* keep the Proj lists intact for the next part_block() */
+	set_irn_link(true_proj,  get_irn_link(cond));
+	set_irn_link(false_proj, true_proj);
+	set_irn_link(cond,       false_proj);
+}
+
+static void lower_fast_path_muxes(ir_graph *irg)
+{
+	if (ARR_LEN(fast_path_muxes) == 0)
+		return;
+
+	ir_resources_t resources = IR_RESOURCE_IRN_LINK | IR_RESOURCE_PHI_LIST;
+	ir_reserve_resources(irg, resources);
+	collect_phiprojs_and_start_block_nodes(irg);
+	for (size_t i = 0, n = ARR_LEN(fast_path_muxes); i < n; ++i) {
+		lower_fast_path_mux(fast_path_muxes[i]);
+	}
+	ir_free_resources(irg, resources);
+	clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE);
+	ARR_SETLEN(ir_node*, fast_path_muxes, 0);
+}
+
 /**
  * Transforms an Add into the appropriate soft float function.
  */
@@ -302,8 +752,7 @@ static bool lower_Add(ir_node *const n)
 
 	ir_node *const left   = get_Add_left(n);
 	ir_node *const right  = get_Add_right(n);
-	ir_node *const in[]   = { left, right };
-	ir_node *const result = make_softfloat_call(n, "add", ARRAY_SIZE(in), in);
+	ir_node *const result = lower_arithmetic(n, "add", left, right);
 	exchange(n, result);
 	return true;
 }
@@ -499,6 +948,11 @@ static bool lower_Cmp(ir_node *const n)
 		break;
 	}
 
+	if (result == NULL && inline_fast_paths) {
+		exchange(n, create_inline_cmp(n, get_Cmp_relation(n)));
+		return true;
+	}
+
 	ir_node *const block = get_nodes_block(n);
 	ir_node *const right = get_Cmp_right(n);
 
@@ -709,9 +1163,19 @@ static bool lower_Minus(ir_node *n)
 	if (!mode_is_float(mode))
 		return false;
 
-	ir_node *const op     = get_Minus_op(n);
-	ir_node *const in[]   = { op };
-	ir_node *const result = make_softfloat_call(n, "neg", ARRAY_SIZE(in), in);
+	ir_node *const op = get_Minus_op(n);
+	ir_node       *result;
+	if (inline_fast_paths) {
+		/* negation only flips the sign bit */
+		float_bits_t fb;
+		init_float_bits(&fb, n, mode);
+		ir_node *const bits = fb_eor(&fb, fb_bits(&fb, op),
+		                             fb_bit(&fb, fb.n_bits - 1));
+		result = new_rd_Bitcast(fb.dbgi, fb.block, bits, mode);
+	} else {
+		ir_node *const in[] = { op };
+		result = make_softfloat_call(n, "neg", ARRAY_SIZE(in), in);
+	}
 	exchange(n, result);
 	return true;
 }
@@ -727,8 +1191,7 @@ static bool lower_Mul(ir_node *n)
 
 	ir_node *const left   = get_Mul_left(n);
 	ir_node *const right  = get_Mul_right(n);
-	ir_node *const in[]   = { left, right };
-	ir_node *const result = make_softfloat_call(n, "mul", ARRAY_SIZE(in), in);
+	ir_node *const result = lower_arithmetic(n, "mul", left, right);
 	exchange(n, result);
 	return true;
 }
@@ -744,8 +1207,7 @@ static bool lower_Sub(ir_node *n)
 
 	ir_node *const left   = get_Sub_left(n);
 	ir_node *const right  = get_Sub_right(n);
-	ir_node *const in[]   = { left, right };
-	ir_node *const result = make_softfloat_call(n, "sub", ARRAY_SIZE(in), in);
+	ir_node *const result = lower_arithmetic(n, "sub", left, right);
 	exchange(n, result);
 	return true;
 }
@@ -830,9 +1292,11 @@ static int lower_mux_cb(ir_node *mux)
 	return ir_nodeset_contains(&created_mux_nodes, mux);
 }
 
-void lower_floating_point(void)
+void lower_floating_point(bool inline_fast_path)
 {
 	ir_prepare_softfloat_lowering();
+	inline_fast_paths = inline_fast_path;
+	fast_path_muxes   = NEW_ARR_F(ir_node*, 0);
 
 	ir_clear_opcodes_generic_func();
 	ir_register_softloat_lower_function(op_Add,   lower_Add);
@@ -853,6 +1317,7 @@ void lower_floating_point(void)
 
 		if (ir_nodeset_size(&created_mux_nodes) > 0)
 			lower_mux(irg, lower_mux_cb);
+		lower_fast_path_muxes(irg);
 
 		ir_nodeset_destroy(&created_mux_nodes);
 	}
@@ -890,4 +1355,5 @@ void lower_floating_point(void)
 		                                            : IR_GRAPH_PROPERTIES_ALL);
 	}
 	free(changed_irgs);
+	DEL_ARR_F(fast_path_muxes);
 }
@@ -11,11 +11,20 @@
 #ifndef FIRM_LOWER_LOWER_SOFTFLOAT_H
 #define FIRM_LOWER_LOWER_SOFTFLOAT_H
 
+#include <stdbool.h>
+
 /**
  * Lowers all floating-point operations.
  *
  * They are replaced by calls into a soft float library.
+ *
+ * @param inline_fast_path  Expand negations and comparisons inline and
+ *                          precede single precision Add, Sub and Mul (and
+ *                          double precision Add and Sub) by an inline fast
+ *                          path for normal operands and results. The library
+ *                          is only called for zeros, denormals, infinities,
+ *                          NaNs and massive cancellation.
  */
-void lower_floating_point(void);
+void lower_floating_point(bool inline_fast_path);
 
 #endif
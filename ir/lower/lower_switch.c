@@ -8,9 +8,11 @@
  * @brief   Lowering of Switches if necessary or advantageous.
  * @author  Moritz Kroll
  */
+#include <limits.h>
 #include <stdbool.h>
 
 #include "array.h"
+#include "execfreq.h"
 #include "ircons.h"
 #include "irgopt.h"
 #include "irgwalk.h"
@@ -21,6 +23,21 @@
 #include "panic.h"
 #include "util.h"
 
+/** Minimum percentage of table entries used by a jump table cluster. */
+#define TABLE_MIN_DENSITY    40
+/** Maximum number of targets of a bit test cluster. */
+#define BIT_TEST_MAX_TARGETS 3
+/** Clusters up to this number are tested linearly instead of bisected. */
+#define MAX_LINEAR_CLUSTERS  2
+
+/**
+ * Minimum number of compares a bit test cluster has to replace depending on
+ * the number of its targets.
+ */
+static const unsigned bit_test_min_compares[BIT_TEST_MAX_TARGETS + 1] = {
+	0, 3, 5, 6
+};
+
 typedef struct walk_env_t {
 	ir_nodeset_t  processed;
 	ir_mode      *selector_mode;
@@ -30,12 +47,30 @@ typedef struct walk_env_t {
 } walk_env_t;
 
 typedef struct target_t {
-	ir_node *block;     /**< block that is targetted */
-	uint16_t n_entries; /**< number of table entries targetting this block */
-	uint16_t i;
+	ir_node  *block;     /**< block that is targetted */
+	unsigned  n_entries; /**< number of table entries targetting this block */
+	double    weight;    /**< estimated frequency of a single entry */
+	ir_node **preds;     /**< new control flow predecessors of the block */
 } target_t;
 
+typedef enum cluster_kind_t {
+	CLUSTER_CASE,     /**< a single table entry tested with a compare */
+	CLUSTER_TABLE,    /**< a dense island lowered to a jump table */
+	CLUSTER_BIT_TEST, /**< a small range tested with bit masks */
+} cluster_kind_t;
+
+/** A range of consecutive switch table entries lowered as a unit. */
+typedef struct case_cluster_t {
+	cluster_kind_t         kind;
+	ir_tarval             *min;       /**< smallest value of the cluster */
+	ir_tarval             *max;       /**< largest value of the cluster */
+	ir_switch_table_entry *entries;   /**< first entry of the cluster */
+	unsigned               n_entries; /**< number of entries */
+	double                 weight;    /**< estimated frequency */
+} case_cluster_t;
+
 typedef struct switch_info_t {
+	walk_env_t  *env;
 	ir_node     *switchn;
 	ir_tarval   *switch_min;
 	ir_tarval   *switch_max;
@@ -106,6 +141,24 @@ static void analyse_switch1(switch_info_t *info)
 		++target->n_entries;
 	}
 
+	/* use the execution frequencies of the targets (if known) to weight the
+	 * entries, otherwise all entries are equally likely */
+	bool has_freqs = false;
+	for (unsigned pn = 0; pn < n_outs; ++pn) {
+		target_t *target = &targets[pn];
+		if (target->block != NULL && get_block_execfreq(target->block) > 0)
+			has_freqs = true;
+	}
+	for (unsigned pn = 0; pn < n_outs; ++pn) {
+		target_t *target = &targets[pn];
+		target->preds  = NEW_ARR_F(ir_node*, 0);
+		target->weight = 1.0;
+		if (has_freqs && target->block != NULL && target->n_entries > 0) {
+			target->weight = get_block_execfreq(target->block)
+			               / target->n_entries;
+		}
+	}
+
 	info->default_block = targets[pn_Switch_default].block;
 	info->targets       = targets;
 }
@@ -270,6 +323,65 @@ static bool normalize_switch(switch_info_t *info, ir_mode *selector_mode)
 	return true;
 }
 
+/**
+ * Returns max - min as a tarval of the unsigned variant of their mode.
+ */
+static ir_tarval *get_distance(ir_tarval *min, ir_tarval *max)
+{
+	ir_mode *umode = find_unsigned_mode(get_tarval_mode(min));
+	return tarval_sub(tarval_convert_to(max, umode),
+	                  tarval_convert_to(min, umode));
+}
+
+/**
+ * Checks whether max - min is smaller than limit and stores the distance
+ * in *distance in that case.
+ */
+static bool distance_below(ir_tarval *min, ir_tarval *max, unsigned limit,
+                           unsigned *distance)
+{
+	ir_tarval *tv = get_distance(min, max);
+	if (!tarval_is_long(tv))
+		return false;
+	long value = get_tarval_long(tv);
+	if (value < 0 || (unsigned long)value >= limit)
+		return false;
+	*distance = (unsigned)value;
+	return true;
+}
+
+/**
+ * Returns max - min for two values of a cluster, which are known to be close
+ * enough to each other.
+ */
+static unsigned get_cluster_distance(ir_tarval *min, ir_tarval *max)
+{
+	unsigned distance = 0;
+	bool     res      = distance_below(min, max, UINT_MAX, &distance);
+	assert(res);
+	(void)res;
+	return distance;
+}
+
+/**
+ * Creates a Cmp checking min <= selector <= max. The check is done with a
+ * single unsigned compare of selector - min, which is returned in *offset.
+ */
+static ir_node *create_range_cmp(dbg_info *dbgi, ir_node *block,
+                                 ir_node *selector, ir_tarval *min,
+                                 ir_tarval *max, ir_node **offset)
+{
+	ir_graph *irg      = get_irn_irg(block);
+	ir_mode  *umode    = find_unsigned_mode(get_irn_mode(selector));
+	ir_node  *minconst = new_r_Const(irg, min);
+	ir_node  *sub      = new_rd_Sub(dbgi, block, selector, minconst);
+	if (get_irn_mode(sub) != umode)
+		sub = new_rd_Conv(dbgi, block, sub, umode);
+	ir_node  *maxconst = new_r_Const(irg, get_distance(min, max));
+	*offset = sub;
+	return new_rd_Cmp(dbgi, block, sub, maxconst, ir_relation_less_equal);
+}
+
 /**
  * Create an if (selector == caseval) Cond node (and handle the special case
  * of ranged cases)
@@ -278,86 +390,372 @@ static ir_node *create_case_cond(const ir_switch_table_entry *entry,
                                  dbg_info *dbgi, ir_node *block,
                                  ir_node *selector)
 {
-	ir_graph *irg      = get_irn_irg(block);
-	ir_node  *minconst = new_r_Const(irg, entry->min);
-
-	ir_node  *cmp;
+	ir_node *cmp;
 	if (entry->min == entry->max) {
+		ir_graph *irg      = get_irn_irg(block);
+		ir_node  *minconst = new_r_Const(irg, entry->min);
 		cmp = new_rd_Cmp(dbgi, block, selector, minconst, ir_relation_equal);
 	} else {
-		ir_tarval *adjusted_max = tarval_sub(entry->max, entry->min);
-		ir_node   *sub          = new_rd_Sub(dbgi, block, selector, minconst);
-		ir_node   *maxconst     = new_r_Const(irg, adjusted_max);
-		cmp = new_rd_Cmp(dbgi, block, sub, maxconst, ir_relation_less_equal);
+		ir_node *offset;
+		cmp = create_range_cmp(dbgi, block, selector, entry->min, entry->max,
+		                       &offset);
 	}
 	return new_rd_Cond(dbgi, block, cmp);
 }
 
 static void connect_to_target(target_t *target, ir_node *cf)
 {
-	ir_node *block     = target->block;
-	unsigned n_entries = target->n_entries;
-	if (get_Block_n_cfgpreds(block) != (int)n_entries) {
-		ir_node **new_in = ALLOCAN(ir_node*, n_entries);
-		ir_graph *irg    = get_irn_irg(block);
-		ir_node  *dummy  = new_r_Dummy(irg, mode_X);
-		for (unsigned i = 0; i < n_entries; ++i) {
-			new_in[i] = dummy;
+	ARR_APP1(ir_node*, target->preds, cf);
+}
+
+static double get_entry_weight(const switch_info_t *info,
+                               const ir_switch_table_entry *entry)
+{
+	return info->targets[entry->pn].weight;
+}
+
+/**
+ * Returns the number of entries starting at entries which form a dense
+ * island suitable for a jump table, 0 if there is none.
+ */
+static unsigned find_table_cluster(const switch_info_t *info,
+                                   const ir_switch_table_entry *entries,
+                                   unsigned n_entries)
+{
+	const walk_env_t *env      = info->env;
+	unsigned          best     = 0;
+	unsigned          n_values = 0;
+	for (unsigned i = 0; i < n_entries; ++i) {
+		const ir_switch_table_entry *entry = &entries[i];
+		unsigned span;
+		if (!distance_below(entries[0].min, entry->max, UINT_MAX / 100, &span))
+			break;
+		unsigned size = get_cluster_distance(entry->min, entry->max);
+		n_values += size + 1;
+		/* the number of unused table entries only grows from here on */
+		if (span + 1 - n_values >= env->spare_size)
+			break;
+		if (i + 1 > env->small_switch
+		    && n_values * 100 >= (span + 1) * TABLE_MIN_DENSITY)
+			best = i + 1;
+	}
+	return best;
+}
+
+/**
+ * Returns the number of entries starting at entries which can be tested
+ * with a bit mask per target, 0 if this is not worth it.
+ */
+static unsigned find_bit_test_cluster(const switch_info_t *info,
+                                      const ir_switch_table_entry *entries,
+                                      unsigned n_entries)
+{
+	unsigned const bits = get_mode_size_bits(info->env->selector_mode);
+	unsigned       pns[BIT_TEST_MAX_TARGETS];
+	unsigned       n_targets  = 0;
+	unsigned       n_compares = 0;
+	unsigned       best       = 0;
+	for (unsigned i = 0; i < n_entries; ++i) {
+		const ir_switch_table_entry *entry = &entries[i];
+		unsigned span;
+		if (!distance_below(entries[0].min, entry->max, bits, &span))
+			break;
+
+		unsigned t = 0;
+		while (t < n_targets && pns[t] != entry->pn)
+			++t;
+		if (t == n_targets) {
+			if (n_targets == BIT_TEST_MAX_TARGETS)
+				break;
+			pns[n_targets++] = entry->pn;
+		}
+
+		n_compares += entry->min == entry->max ? 1 : 2;
+		if (n_compares >= bit_test_min_compares[n_targets])
+			best = i + 1;
+	}
+	return best;
+}
+
+/**
+ * Partitions the sorted table entries into clusters.
+ */
+static case_cluster_t *find_clusters(const switch_info_t *info,
+                                     ir_switch_table_entry *entries,
+                                     unsigned n_entries)
+{
+	case_cluster_t *clusters = NEW_ARR_F(case_cluster_t, 0);
+	for (unsigned i = 0; i < n_entries; ) {
+		ir_switch_table_entry *rest   = &entries[i];
+		unsigned               n_rest = n_entries - i;
+
+		case_cluster_t cluster;
+		cluster.kind      = CLUSTER_CASE;
+		cluster.entries   = rest;
+		cluster.n_entries = 1;
+
+		unsigned n = find_table_cluster(info, rest, n_rest);
+		if (n > 0) {
+			cluster.kind      = CLUSTER_TABLE;
+			cluster.n_entries = n;
+		} else if ((n = find_bit_test_cluster(info, rest, n_rest)) > 0) {
+			cluster.kind      = CLUSTER_BIT_TEST;
+			cluster.n_entries = n;
 		}
-		set_irn_in(block, n_entries, new_in);
-		assert(target->i == 0);
+
+		cluster.min    = rest[0].min;
+		cluster.max    = rest[cluster.n_entries - 1].max;
+		cluster.weight = 0;
+		for (unsigned e = 0; e < cluster.n_entries; ++e) {
+			cluster.weight += get_entry_weight(info, &rest[e]);
+		}
+		ARR_APP1(case_cluster_t, clusters, cluster);
+		i += cluster.n_entries;
+	}
+	return clusters;
+}
+
+/**
+ * Lowers a cluster to a jump table: after a range check the offset of the
+ * selector to the cluster minimum is used as selector of a new (dense and
+ * normalized) Switch node.
+ */
+static void create_table_cluster(switch_info_t *info, ir_node *block,
+                                 const case_cluster_t *cluster,
+                                 ir_node ***misses)
+{
+	walk_env_t *env      = info->env;
+	ir_node    *switchn  = info->switchn;
+	ir_graph   *irg      = get_irn_irg(block);
+	dbg_info   *dbgi     = get_irn_dbg_info(switchn);
+	ir_node    *selector = get_Switch_selector(switchn);
+	ir_node    *offset;
+	ir_node    *cmp      = create_range_cmp(dbgi, block, selector,
+	                                        cluster->min, cluster->max,
+	                                        &offset);
+	ir_node    *cond     = new_rd_Cond(dbgi, block, cmp);
+	ARR_APP1(ir_node*, *misses, new_r_Proj(cond, mode_X, pn_Cond_false));
+
+	ir_node *in[]        = { new_r_Proj(cond, mode_X, pn_Cond_true) };
+	ir_node *table_block = new_r_Block(irg, ARRAY_SIZE(in), in);
+	ir_mode *mode        = env->selector_mode;
+	ir_node *new_sel     = new_rd_Conv(dbgi, table_block, offset, mode);
+
+	/* map the targets of the cluster to consecutive proj numbers */
+	unsigned         n_outs = get_Switch_n_outs(switchn);
+	unsigned        *pn_map = ALLOCANZ(unsigned, n_outs);
+	unsigned         n_pns  = 1;
+	ir_switch_table *table  = ir_new_switch_table(irg, cluster->n_entries);
+	for (unsigned e = 0; e < cluster->n_entries; ++e) {
+		const ir_switch_table_entry *entry = &cluster->entries[e];
+		if (pn_map[entry->pn] == 0)
+			pn_map[entry->pn] = n_pns++;
+		ir_tarval *min = get_distance(cluster->min, entry->min);
+		ir_tarval *max = get_distance(cluster->min, entry->max);
+		ir_switch_table_set(table, e, tarval_convert_to(min, mode),
+		                    tarval_convert_to(max, mode), pn_map[entry->pn]);
 	}
-	assert(target->i < n_entries);
-	set_Block_cfgpred(target->block, target->i++, cf);
+
+	ir_node *new_switch = new_rd_Switch(dbgi, table_block, new_sel, n_pns,
+	                                    table);
+	/* the new Switch is already lowered */
+	ir_nodeset_insert(&env->processed, new_switch);
+
+	ARR_APP1(ir_node*, *misses,
+	         new_r_Proj(new_switch, mode_X, pn_Switch_default));
+	for (unsigned pn = 0; pn < n_outs; ++pn) {
+		if (pn_map[pn] == 0)
+			continue;
+		ir_node *proj = new_r_Proj(new_switch, mode_X, pn_map[pn]);
+		connect_to_target(&info->targets[pn], proj);
+	}
+}
+
+typedef struct bit_test_t {
+	unsigned   pn;     /**< the target */
+	ir_tarval *mask;   /**< bits of the values going to the target */
+	double     weight; /**< estimated frequency */
+} bit_test_t;
+
+static int compare_bit_tests(const void *a, const void *b)
+{
+	const bit_test_t *test0 = (const bit_test_t*)a;
+	const bit_test_t *test1 = (const bit_test_t*)b;
+	if (test0->weight != test1->weight)
+		return test0->weight < test1->weight ? 1 : -1;
+	return QSORT_CMP(test0->pn, test1->pn);
 }
 
 /**
- * Creates an if cascade realizing binary search.
+ * Lowers a cluster to bit tests: after a range check a bit is shifted by
+ * the offset of the selector and tested against a mask of the values for
+ * each target ((1 << (sel - min)) & mask), which backends can match to a
+ * single bit test instruction.
  */
-static void create_if_cascade(switch_info_t *info, ir_node *block,
-                              ir_switch_table_entry *curcases,
-                              unsigned numcases)
+static void create_bit_test_cluster(switch_info_t *info, ir_node *block,
+                                    const case_cluster_t *cluster,
+                                    ir_node ***misses)
+{
+	ir_node  *switchn  = info->switchn;
+	ir_graph *irg      = get_irn_irg(block);
+	dbg_info *dbgi     = get_irn_dbg_info(switchn);
+	ir_node  *selector = get_Switch_selector(switchn);
+	ir_node  *offset;
+	ir_node  *cmp      = create_range_cmp(dbgi, block, selector,
+	                                      cluster->min, cluster->max, &offset);
+	ir_node  *cond     = new_rd_Cond(dbgi, block, cmp);
+	ARR_APP1(ir_node*, *misses, new_r_Proj(cond, mode_X, pn_Cond_false));
+
+	ir_node *in[]     = { new_r_Proj(cond, mode_X, pn_Cond_true) };
+	ir_node *cur      = new_r_Block(irg, ARRAY_SIZE(in), in);
+	ir_mode *mode     = info->env->selector_mode;
+	ir_node *index    = new_rd_Conv(dbgi, cur, offset, mode);
+	ir_node *one      = new_r_Const(irg, get_mode_one(mode));
+	ir_node *bit      = new_rd_Shl(dbgi, cur, one, index);
+	ir_node *zero     = new_r_Const(irg, get_mode_null(mode));
+
+	/* collect the masks of the targets */
+	bit_test_t tests[BIT_TEST_MAX_TARGETS];
+	unsigned   n_tests = 0;
+	ir_tarval *all     = get_mode_null(mode);
+	for (unsigned e = 0; e < cluster->n_entries; ++e) {
+		const ir_switch_table_entry *entry = &cluster->entries[e];
+		unsigned t = 0;
+		while (t < n_tests && tests[t].pn != entry->pn)
+			++t;
+		if (t == n_tests) {
+			assert(n_tests < BIT_TEST_MAX_TARGETS);
+			tests[t].pn     = entry->pn;
+			tests[t].mask   = get_mode_null(mode);
+			tests[t].weight = 0;
+			++n_tests;
+		}
+
+		unsigned min = get_cluster_distance(cluster->min, entry->min);
+		unsigned max = get_cluster_distance(cluster->min, entry->max);
+		for (unsigned v = min; v <= max; ++v) {
+			ir_tarval *value_bit = tarval_shl_unsigned(get_mode_one(mode), v);
+			tests[t].mask = tarval_or(tests[t].mask, value_bit);
+		}
+		tests[t].weight += get_entry_weight(info, entry);
+		all = tarval_or(all, tests[t].mask);
+	}
+	/* test the most frequent targets first */
+	QSORT(tests, n_tests, compare_bit_tests);
+
+	unsigned   span = get_cluster_distance(cluster->min, cluster->max);
+	ir_tarval *full = get_mode_all_one(mode);
+	if (span + 1 < get_mode_size_bits(mode)) {
+		ir_tarval *one = get_mode_one(mode);
+		full = tarval_sub(tarval_shl_unsigned(one, span + 1), one);
+	}
+	bool const dense = all == full;
+
+	for (unsigned t = 0; t < n_tests; ++t) {
+		target_t *target = &info->targets[tests[t].pn];
+		if (t == n_tests - 1 && dense) {
+			/* the remaining values all belong to the last target */
+			connect_to_target(target, new_r_Jmp(cur));
+			break;
+		}
+
+		ir_node *mask     = new_r_Const(irg, tests[t].mask);
+		ir_node *masked    = new_rd_And(dbgi, cur, bit, mask);
+		ir_node *test      = new_rd_Cmp(dbgi, cur, masked, zero,
+		                                ir_relation_less_greater);
+		ir_node *test_cond = new_rd_Cond(dbgi, cur, test);
+		connect_to_target(target, new_r_Proj(test_cond, mode_X, pn_Cond_true));
+
+		ir_node *false_proj = new_r_Proj(test_cond, mode_X, pn_Cond_false);
+		if (t == n_tests - 1) {
+			ARR_APP1(ir_node*, *misses, false_proj);
+		} else {
+			ir_node *next_in[] = { false_proj };
+			cur = new_r_Block(irg, ARRAY_SIZE(next_in), next_in);
+		}
+	}
+}
+
+/**
+ * Creates the code testing for the values of a cluster in block. Control
+ * flow for values not handled by the cluster is appended to misses.
+ */
+static void create_cluster(switch_info_t *info, ir_node *block,
+                           const case_cluster_t *cluster, ir_node ***misses)
+{
+	switch (cluster->kind) {
+	case CLUSTER_CASE: {
+		const ir_switch_table_entry *entry = cluster->entries;
+		ir_node *switchn   = info->switchn;
+		dbg_info *dbgi     = get_irn_dbg_info(switchn);
+		ir_node  *selector = get_Switch_selector(switchn);
+		ir_node  *cond     = create_case_cond(entry, dbgi, block, selector);
+		ir_node  *trueproj = new_r_Proj(cond, mode_X, pn_Cond_true);
+		connect_to_target(&info->targets[entry->pn], trueproj);
+		ARR_APP1(ir_node*, *misses, new_r_Proj(cond, mode_X, pn_Cond_false));
+		return;
+	}
+	case CLUSTER_TABLE:
+		create_table_cluster(info, block, cluster, misses);
+		return;
+	case CLUSTER_BIT_TEST:
+		create_bit_test_cluster(info, block, cluster, misses);
+		return;
+	}
+	panic("invalid cluster kind");
+}
+
+static int compare_cluster_weights(const void *a, const void *b)
+{
+	const case_cluster_t *cluster0 = (const case_cluster_t*)a;
+	const case_cluster_t *cluster1 = (const case_cluster_t*)b;
+	if (cluster0->weight != cluster1->weight)
+		return cluster0->weight < cluster1->weight ? 1 : -1;
+	return cluster0->entries < cluster1->entries ? -1 : 1;
+}
+
+/**
+ * Creates a binary decision tree over the clusters. The clusters are split
+ * at their weighted median, so frequent cases need fewer compares. Few
+ * clusters are tested one after another, most frequent first.
+ */
+static void create_decision_tree(switch_info_t *info, ir_node *block,
+                                 case_cluster_t *clusters,
+                                 unsigned n_clusters)
 {
 	ir_graph      *irg      = get_irn_irg(block);
 	const ir_node *switchn  = info->switchn;
 	dbg_info      *dbgi     = get_irn_dbg_info(switchn);
 	ir_node       *selector = get_Switch_selector(switchn);
 
-	if (numcases == 0) {
+	if (n_clusters == 0) {
 		/* zero cases: "goto default;" */
 		ARR_APP1(ir_node*, info->defusers, new_r_Jmp(block));
-	} else if (numcases == 1) {
-		/*only one case: "if (sel == val) goto target else goto default;"*/
-		const ir_switch_table_entry *entry = &curcases[0];
-		ir_node *cond      = create_case_cond(entry, dbgi, block, selector);
-		ir_node *trueproj  = new_r_Proj(cond, mode_X, pn_Cond_true);
-		ir_node *falseproj = new_r_Proj(cond, mode_X, pn_Cond_false);
-
-		connect_to_target(&info->targets[entry->pn], trueproj);
-		ARR_APP1(ir_node*, info->defusers, falseproj);
-	} else if (numcases == 2) {
-		/* only two cases: "if (sel == val[0]) goto target[0];" */
-		const ir_switch_table_entry *entry0 = &curcases[0];
-		const ir_switch_table_entry *entry1 = &curcases[1];
-		ir_node *cond      = create_case_cond(entry0, dbgi, block, selector);
-		ir_node *trueproj  = new_r_Proj(cond, mode_X, pn_Cond_true);
-		ir_node *falseproj = new_r_Proj(cond, mode_X, pn_Cond_false);
-		connect_to_target(&info->targets[entry0->pn], trueproj);
-
-		ir_node *in[]    = { falseproj };
-		ir_node *neblock = new_r_Block(irg, ARRAY_SIZE(in), in);
-
-		/* second part: "else if (sel == val[1]) goto target[1] else goto default;" */
-		ir_node *cond1      = create_case_cond(entry1, dbgi, neblock, selector);
-		ir_node *trueproj1  = new_r_Proj(cond1, mode_X, pn_Cond_true);
-		ir_node *falseproj1 = new_r_Proj(cond1, mode_X, pn_Cond_false);
-		connect_to_target(&info->targets[entry1->pn], trueproj1);
-		ARR_APP1(ir_node*, info->defusers, falseproj1);
+	} else if (n_clusters <= MAX_LINEAR_CLUSTERS) {
+		/* "if (sel in cluster[0]) ... else if (sel in cluster[1]) ..." */
+		QSORT(clusters, n_clusters, compare_cluster_weights);
+		for (unsigned c = 0; c < n_clusters - 1; ++c) {
+			ir_node **misses = NEW_ARR_F(ir_node*, 0);
+			create_cluster(info, block, &clusters[c], &misses);
+			block = new_r_Block(irg, ARR_LEN(misses), misses);
+			DEL_ARR_F(misses);
+		}
+		create_cluster(info, block, &clusters[n_clusters - 1],
+		               &info->defusers);
 	} else {
-		/* recursive case: split cases in the middle */
-		unsigned midcase = numcases / 2;
-		const ir_switch_table_entry *entry = &curcases[midcase];
-		ir_node *val = new_r_Const(irg, entry->min);
+		/* recursive case: split clusters at the weighted median */
+		double total = 0;
+		for (unsigned c = 0; c < n_clusters; ++c) {
+			total += clusters[c].weight;
+		}
+		unsigned mid  = 1;
+		double   left = clusters[0].weight;
+		while (mid < n_clusters - 1 && left + clusters[mid].weight <= total / 2) {
+			left += clusters[mid].weight;
+			++mid;
+		}
+
+		ir_node *val = new_r_Const(irg, clusters[mid].min);
 		ir_node *cmp = new_rd_Cmp(dbgi, block, selector, val, ir_relation_less);
 		ir_node *cond = new_rd_Cond(dbgi, block, cmp);
 
@@ -367,8 +765,8 @@ static void create_if_cascade(switch_info_t *info, ir_node *block,
 		ir_node *gein[]  = { new_r_Proj(cond, mode_X, pn_Cond_false) };
 		ir_node *geblock = new_r_Block(irg, ARRAY_SIZE(gein), gein);
 
-		create_if_cascade(info, ltblock, curcases, midcase);
-		create_if_cascade(info, geblock, curcases + midcase, numcases - midcase);
+		create_decision_tree(info, ltblock, clusters, mid);
+		create_decision_tree(info, geblock, clusters + mid, n_clusters - mid);
 	}
 }
 
@@ -423,14 +821,33 @@ static void find_switch_nodes(ir_node *block, void *ctx)
 	normalize_table(switchn, selector_mode, NULL);
 	analyse_switch1(&info);
 
-	/* Now create the if cascade */
+	/* Now create the decision tree */
 	env->changed  = true;
+	info.env      = env;
 	info.defusers = NEW_ARR_F(ir_node*, 0);
 	block         = get_nodes_block(switchn);
-	ir_switch_table *table = get_Switch_table(switchn);
-	create_if_cascade(&info, block, table->entries, table->n_entries);
-
-	/* Connect new default case users */
+	ir_switch_table *table    = get_Switch_table(switchn);
+	case_cluster_t  *clusters = find_clusters(&info, table->entries,
+	                                          table->n_entries);
+	create_decision_tree(&info, block, clusters, ARR_LEN(clusters));
+	DEL_ARR_F(clusters);
+
+	/* Connect the targets and the new default case users */
+	ir_graph *irg = get_irn_irg(block);
+	for (unsigned pn = 0, n_outs = get_Switch_n_outs(switchn); pn < n_outs;
+	     ++pn) {
+		target_t *target = &info.targets[pn];
+		if (pn != pn_Switch_default && target->block != NULL) {
+			size_t n_preds = ARR_LEN(target->preds);
+			if (n_preds > 0) {
+				set_irn_in(target->block, n_preds, target->preds);
+			} else {
+				ir_node *in[] = { new_r_Bad(irg, mode_X) };
+				set_irn_in(target->block, ARRAY_SIZE(in), in);
+			}
+		}
+		DEL_ARR_F(target->preds);
+	}
 	set_irn_in(info.default_block, ARR_LEN(info.defusers), info.defusers);
 
 	DEL_ARR_F(info.defusers);
@@ -26,6 +26,7 @@
 #include "tv_t.h"
 #include "valueset.h"
 #include "irloop.h"
+#include "dataflow.h"
 
 #include "irgraph_t.h"
 #include "irnode_t.h"
@@ -71,6 +72,7 @@ typedef struct block_info {
 	ir_nodehashmap_t  *trans;      /* contains translated nodes translated into block */
 	ir_node           *avail;      /* saves available node for insert node phase */
 	int                found;      /* saves kind of availability for insert_node phase */
+	unsigned           antic_visits; /* number of antic_in computations of this block */
 	ir_node           *block;      /* block of the block_info */
 	struct block_info *next;       /* links all instances for easy access */
 } block_info;
@@ -99,7 +101,6 @@ typedef struct pre_env {
 	unsigned        last_idx;     /* last node index of input graph */
 	char            changes;      /* flag for fixed point iterations - non-zero if changes occurred */
 	char            first_iter;   /* non-zero for first fixed point iteration */
-	int             iteration;    /* iteration counter */
 #if OPTIMIZE_NODES
 	pset           *value_table;   /* standard value table*/
 	pset           *gvnpre_values; /* GVN-PRE value table */
@@ -401,6 +402,7 @@ static void alloc_block_info(ir_node *block, pre_env *env)
 	info->avail   = NULL;
 	info->block   = block;
 	info->found   = 1;
+	info->antic_visits = 0;
 
 	info->next = env->list;
 	env->list  = info;
@@ -887,14 +889,16 @@ static ir_node *phi_translate(ir_node *node, ir_node *block, int pos, ir_valuese
 }
 
 /**
- * Block-walker, computes Antic_in(block).
+ * Dataflow transfer function, computes Antic_in(block).
  * Builds a value tree out of the graph by translating values
  * over phi nodes.
  *
  * @param block  the block
- * @param ctx    the walker environment
+ * @param ctx    the environment
+ *
+ * @return true if Antic_in(block) changed
  */
-static void compute_antic(ir_node *block, void *ctx)
+static bool compute_antic(ir_node *block, void *ctx)
 {
 	pre_env                *env       = (pre_env*)ctx;
 	block_info             *succ_info;
@@ -905,22 +909,20 @@ static void compute_antic(ir_node *block, void *ctx)
 	size_t                  size;
 	ir_valueset_iterator_t  iter;
 	int                     n_succ;
-
-	/* filter blocks from topological walker */
-	if (! is_Block(block))
-		return;
+	bool                    first_visit;
 
 	/* the end block has no successor */
 	if (block == env->end_block)
-		return;
+		return false;
 
 	info = get_block_info(block);
 	/* track changes */
 	size = ir_valueset_size(info->antic_in);
 	n_succ = get_Block_n_cfg_outs(block);
+	first_visit = info->antic_visits++ == 0;
 
 	/* add exp_gen */
-	if (env->first_iter) {
+	if (first_visit) {
 #if IGNORE_INF_LOOPS
 		/* keep antic_in of infinite loops empty */
 		if (! is_in_infinite_loop(block)) {
@@ -941,12 +943,6 @@ static void compute_antic(ir_node *block, void *ctx)
 		succ      = get_Block_cfg_out_ex(block, 0, &pos);
 		succ_info = get_block_info(succ);
 
-		/* initialize translated set */
-		if (env->first_iter) {
-			info->trans = XMALLOC(ir_nodehashmap_t);
-			ir_nodehashmap_init(info->trans);
-		}
-
 		foreach_valueset(succ_info->antic_in, value, expr, iter) {
 			ir_node *trans = get_translated(block, expr);
 			ir_node *trans_value;
@@ -970,7 +966,7 @@ static void compute_antic(ir_node *block, void *ctx)
 			if (is_clean_in_block(expr, block, info->antic_in)) {
 #if NO_INF_LOOPS
 				/* Prevent information flow over the backedge of endless loops. */
-				if (env->iteration <= 2 || (is_backedge(succ, pos) && !is_in_infinite_loop(succ))) {
+				if (info->antic_visits <= 2 || (is_backedge(succ, pos) && !is_in_infinite_loop(succ))) {
 					ir_valueset_replace(info->antic_in, trans_value, represent);
 				}
 #else
@@ -1007,8 +1003,7 @@ static void compute_antic(ir_node *block, void *ctx)
 
 	DEBUG_ONLY(dump_value_set(info->antic_in, "Antic_in", block);)
 
-	if (size != ir_valueset_size(info->antic_in))
-		env->changes |= 1;
+	return size != ir_valueset_size(info->antic_in);
 }
 
 /* --------------------------------------------------------
@@ -1791,23 +1786,19 @@ static void gvn_pre(ir_graph *irg, pre_env *env)
 	/* compute the avail_out sets for all blocks */
 	dom_tree_walk_irg(irg, compute_avail_top_down, NULL, env);
 
-	/* compute the anticipated value sets for all blocks */
-	antic_iter      = 0;
-	env->first_iter = 1;
-
-	env->iteration = 1;
-	/* antic_in passes */
-	do {
-		++antic_iter;
-		DB((dbg, LEVEL_2, "= Antic_in Iteration %d ========================\n", antic_iter));
-		env->changes = 0;
-		irg_walk_blkwise_graph(irg, compute_antic, NULL, env);
-		env->first_iter = 0;
-		DB((dbg, LEVEL_2, "----------------------------------------------\n"));
-		env->iteration ++;
-	} while (env->changes != 0 && antic_iter < MAX_ANTIC_ITER);
+	/* compute the anticipated value sets for all blocks, only blocks
+	   whose successors changed are recomputed */
+	dataflow_problem_t const antic_problem = {
+		.direction  = DATAFLOW_BACKWARD,
+		.meet       = NULL,
+		.transfer   = compute_antic,
+		.max_visits = MAX_ANTIC_ITER,
+		.data       = env,
+	};
+	antic_iter = dataflow_solve(irg, &antic_problem);
 
 	DEBUG_ONLY(set_stats(gvnpre_stats->antic_iterations, antic_iter);)
+	(void)antic_iter;
 
 	ir_nodeset_init(env->keeps);
 	insert_iter       = 0;
@@ -1864,6 +1855,7 @@ void do_gvn_pre(ir_graph *irg)
 		| IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
 		| IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO
 		| IR_GRAPH_PROPERTY_CONSISTENT_OUTS
+		| IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
 		| IR_GRAPH_PROPERTY_NO_CRITICAL_EDGES
 		| IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE);
 
@@ -1873,8 +1865,6 @@ void do_gvn_pre(ir_graph *irg)
 	save_optimization_state(&state);
 	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_LOOP_LINK);
 
-	edges_activate(irg);
-
 	environment = &env;
 	DEBUG_ONLY(init_stats();)
 
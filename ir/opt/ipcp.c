@@ -0,0 +1,624 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Interprocedural constant and range propagation.
+ *
+ * Every parameter of a function whose call sites are all known gets the meet
+ * of the arguments passed at these call sites: A constant or a value range.
+ * The ranges of the arguments are derived from their known bits and the
+ * Confirms on them, so call sites in unreachable code do not contribute.
+ * Graphs are processed top down, so the parameters of a caller are known
+ * when its arguments are analysed. The results of functions are propagated
+ * back bottom up. Ranges are attached as Confirm nodes.
+ *
+ * Before propagating, call sites passing the same constants to a function get
+ * a local copy of it, if the weight of the constant parameters times the
+ * number of calls outweighs the size of the function. The propagation then
+ * turns these parameters into constants in the copy.
+ */
+#include "iroptimize.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "analyze_irg_args.h"
+#include "array.h"
+#include "callgraph.h"
+#include "cgana.h"
+#include "constbits.h"
+#include "debug.h"
+#include "entity_t.h"
+#include "iredges_t.h"
+#include "irgmod.h"
+#include "irgopt.h"
+#include "irgraph_t.h"
+#include "irgwalk.h"
+#include "irnode_t.h"
+#include "irprog_t.h"
+#include "obst.h"
+#include "pmap.h"
+#include "tv.h"
+#include "util.h"
+
+/** Maximal number of specialized copies of one function. */
+#define MAX_CLONES 8
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/**
+ * Lattice value of a parameter or result. Both bounds are NULL as long as no
+ * value was seen and tarval_bad if nothing is known.
+ */
+typedef struct value_range_t {
+	ir_tarval *lo; /**< lower bound */
+	ir_tarval *hi; /**< upper bound, equal to lo for a constant */
+} value_range_t;
+
+typedef struct method_info_t {
+	size_t         pos;           /**< position in the bottom up order */
+	bool           all_calls_known; /**< parameters may be specialized */
+	bool           results_valid; /**< results are known */
+	value_range_t *params;
+	value_range_t *results;
+} method_info_t;
+
+typedef struct ipcp_env_t {
+	struct obstack obst;
+	pmap          *infos; /**< method entity -> method_info_t */
+	ir_graph     **order; /**< graphs with callees before callers */
+} ipcp_env_t;
+
+static void record_order(ir_graph *irg, void *data)
+{
+	ipcp_env_t *const env = (ipcp_env_t*)data;
+	ARR_APP1(ir_graph*, env->order, irg);
+}
+
+/**
+ * Computes the call graph and the processing order and creates the info of
+ * every graph.
+ */
+static void analyze_calls(ipcp_env_t *env)
+{
+	ir_entity **free_methods;
+	size_t const n_free = cgana(&free_methods);
+	compute_callgraph();
+
+	env->infos = pmap_create();
+	env->order = NEW_ARR_F(ir_graph*, 0);
+	callgraph_walk_func *const passes[] = { record_order };
+	callgraph_run_bottom_up(passes, ARRAY_SIZE(passes), env);
+
+	for (size_t i = 0, n = ARR_LEN(env->order); i < n; ++i) {
+		ir_graph      *const irg    = env->order[i];
+		ir_entity     *const entity = get_irg_entity(irg);
+		ir_type       *const mtp    = get_entity_type(entity);
+		method_info_t *const info   = OALLOCZ(&env->obst, method_info_t);
+		info->pos             = i;
+		info->all_calls_known = get_entity_linktime_irg(entity) == irg
+		                     && !is_method_variadic(mtp);
+		info->params  = OALLOCNZ(&env->obst, value_range_t,
+		                         get_method_n_params(mtp));
+		info->results = OALLOCNZ(&env->obst, value_range_t,
+		                         get_method_n_ress(mtp));
+		pmap_insert(env->infos, entity, info);
+	}
+	for (size_t i = 0; i < n_free; ++i) {
+		method_info_t *const info = pmap_get(method_info_t, env->infos,
+		                                     free_methods[i]);
+		if (info != NULL)
+			info->all_calls_known = false;
+	}
+	free(free_methods);
+}
+
+static void free_calls_info(ipcp_env_t *env)
+{
+	pmap_destroy(env->infos);
+	DEL_ARR_F(env->order);
+	free_callgraph();
+}
+
+static method_info_t *get_method_info(ipcp_env_t *env, ir_entity *entity)
+{
+	return pmap_get(method_info_t, env->infos, entity);
+}
+
+static void set_bottom(value_range_t *range)
+{
+	range->lo = tarval_bad;
+	range->hi = tarval_bad;
+}
+
+/** Lowers @p range, so it includes [lo, hi]. */
+static void range_meet(value_range_t *range, ir_tarval *lo, ir_tarval *hi)
+{
+	if (range->lo == tarval_bad)
+		return;
+	if (lo == tarval_bad || range->lo == NULL) {
+		range->lo = lo;
+		range->hi = hi;
+		return;
+	}
+
+	ir_mode *const mode = get_tarval_mode(lo);
+	if (get_tarval_mode(range->lo) != mode) {
+		set_bottom(range);
+	} else if (!mode_is_int(mode)) {
+		if (range->lo != lo)
+			set_bottom(range);
+	} else {
+		if (tarval_cmp(lo, range->lo) == ir_relation_less)
+			range->lo = lo;
+		if (tarval_cmp(hi, range->hi) == ir_relation_greater)
+			range->hi = hi;
+	}
+}
+
+/** Restricts [*lo, *hi] to the values in @p relation to @p bound. */
+static void range_restrict(ir_tarval **lo, ir_tarval **hi,
+                           ir_relation relation, ir_tarval *bound)
+{
+	ir_mode   *const mode   = get_tarval_mode(bound);
+	ir_tarval *const one    = get_mode_one(mode);
+	ir_tarval       *new_lo = *lo;
+	ir_tarval       *new_hi = *hi;
+	if (relation == ir_relation_less && bound != get_mode_min(mode)) {
+		relation = ir_relation_less_equal;
+		bound    = tarval_sub(bound, one);
+	} else if (relation == ir_relation_greater && bound != get_mode_max(mode)) {
+		relation = ir_relation_greater_equal;
+		bound    = tarval_add(bound, one);
+	}
+
+	if (relation == ir_relation_equal) {
+		new_lo = bound;
+		new_hi = bound;
+	} else if (relation == ir_relation_less_equal) {
+		if (tarval_cmp(bound, new_hi) == ir_relation_less)
+			new_hi = bound;
+	} else if (relation == ir_relation_greater_equal) {
+		if (tarval_cmp(bound, new_lo) == ir_relation_greater)
+			new_lo = bound;
+	} else {
+		return;
+	}
+	/* an empty range means unreachable code, keep what is known */
+	if (tarval_cmp(new_lo, new_hi) != ir_relation_greater) {
+		*lo = new_lo;
+		*hi = new_hi;
+	}
+}
+
+/**
+ * Computes the range of the value @p node from its known bits and the
+ * Confirms on it. Needs the known bits of its graph.
+ */
+static void get_value_range(ir_node *node, ir_tarval **lo, ir_tarval **hi)
+{
+	ir_mode *const mode = get_irn_mode(node);
+	if (!mode_is_int(mode)) {
+		ir_node *const value = skip_Confirm(node);
+		*lo = *hi = is_Const(value) ? get_Const_tarval(value) : tarval_bad;
+		return;
+	}
+
+	*lo = get_mode_min(mode);
+	*hi = get_mode_max(mode);
+	/* the unknown bits all zero resp. all one are the bounds, if the sign is
+	 * known */
+	bitinfo const *const b = get_bitinfo(node);
+	if (b != NULL
+	 && (!mode_is_signed(mode) || tarval_is_negative(b->o)
+	  || !tarval_is_negative(b->z))
+	 && tarval_cmp(b->o, b->z) != ir_relation_greater) {
+		*lo = b->o;
+		*hi = b->z;
+	}
+
+	for (ir_node *n = node; is_Confirm(n); n = get_Confirm_value(n)) {
+		ir_node *const bound = get_Confirm_bound(n);
+		if (is_Const(bound))
+			range_restrict(lo, hi, get_Confirm_relation(n),
+			               get_Const_tarval(bound));
+	}
+}
+
+static bool is_unreachable(ir_node const *node)
+{
+	bitinfo const *const b = get_bitinfo(get_nodes_block(node));
+	return b != NULL && b->z == tarval_b_false;
+}
+
+/**
+ * Makes @p node use the lattice value @p range: A constant replaces it, a
+ * range is attached as Confirms.
+ */
+static bool apply_range(ir_node *node, value_range_t const *range)
+{
+	ir_tarval *const lo   = range->lo;
+	ir_mode   *const mode = get_irn_mode(node);
+	if (lo == NULL || lo == tarval_bad || get_tarval_mode(lo) != mode)
+		return false;
+
+	ir_graph  *const irg = get_irn_irg(node);
+	ir_tarval *const hi  = range->hi;
+	if (lo == hi) {
+		DB((dbg, LEVEL_2, "%+F is %T\n", node, lo));
+		exchange(node, new_r_Const(irg, lo));
+		return true;
+	}
+
+	ir_node *const block = get_nodes_block(node);
+	ir_node       *first = NULL;
+	ir_node       *value = node;
+	if (lo != get_mode_min(mode)) {
+		value = new_r_Confirm(block, value, new_r_Const(irg, lo),
+		                      ir_relation_greater_equal);
+		first = value;
+	}
+	if (hi != get_mode_max(mode)) {
+		value = new_r_Confirm(block, value, new_r_Const(irg, hi),
+		                      ir_relation_less_equal);
+		if (first == NULL)
+			first = value;
+	}
+	if (first == NULL || value == node)
+		return false;
+
+	DB((dbg, LEVEL_2, "%+F is in [%T, %T]\n", node, lo, hi));
+	edges_reroute_except(node, value, first);
+	return true;
+}
+
+/** Collects the reachable Calls with known callees. */
+static void collect_calls(ir_node *node, void *data)
+{
+	ir_node ***const calls = (ir_node***)data;
+	if (is_Call(node) && cg_call_has_callees(node) && !is_unreachable(node))
+		ARR_APP1(ir_node*, *calls, node);
+}
+
+/** Checks whether @p node passes parameter @p pos of its own graph on. */
+static bool is_parameter(ir_node *node, size_t pos)
+{
+	ir_node *const value = skip_Confirm(node);
+	return is_Proj(value) && get_Proj_pred(value) == get_irg_args(get_irn_irg(value))
+	    && get_Proj_num(value) == pos;
+}
+
+/** Adds the arguments of a call to the parameters of @p callee. */
+static void record_call_arguments(ir_node *call, ir_entity *callee,
+                                  method_info_t *callee_info)
+{
+	ir_graph *const irg      = get_irn_irg(call);
+	ir_type  *const mtp      = get_entity_type(callee);
+	size_t    const n_args   = get_Call_n_params(call);
+	bool      const is_self  = get_irg_entity(irg) == callee;
+	for (size_t i = 0, n = get_method_n_params(mtp); i < n; ++i) {
+		value_range_t *const range = &callee_info->params[i];
+		ir_type       *const type  = get_method_param_type(mtp, i);
+		if (i >= n_args) {
+			set_bottom(range);
+			continue;
+		}
+
+		ir_node *const arg = get_Call_param(call, i);
+		/* a recursive call passing the parameter on adds nothing */
+		if (is_self && is_parameter(arg, i))
+			continue;
+		if (get_irn_mode(arg) != get_type_mode(type)) {
+			set_bottom(range);
+			continue;
+		}
+
+		ir_tarval *lo;
+		ir_tarval *hi;
+		get_value_range(arg, &lo, &hi);
+		range_meet(range, lo, hi);
+	}
+}
+
+/**
+ * Adds the arguments of the calls in @p irg to the parameters of the callees.
+ * Callees are either the ones processed before @p irg or the ones processed
+ * after it, depending on @p back_edges.
+ */
+static void record_arguments(ipcp_env_t *env, ir_graph *irg, bool back_edges)
+{
+	method_info_t *const info = get_method_info(env, get_irg_entity(irg));
+	ir_node      **calls = NEW_ARR_F(ir_node*, 0);
+
+	constbits_analyze(irg);
+	irg_walk_graph(irg, NULL, collect_calls, &calls);
+	for (size_t c = 0, n_calls = ARR_LEN(calls); c < n_calls; ++c) {
+		ir_node *const call = calls[c];
+		for (size_t i = 0, n = cg_get_call_n_callees(call); i < n; ++i) {
+			ir_entity     *const callee      = cg_get_call_callee(call, i);
+			method_info_t *const callee_info = get_method_info(env, callee);
+			if (callee_info == NULL || !callee_info->all_calls_known
+			 || (callee_info->pos >= info->pos) != back_edges)
+				continue;
+			record_call_arguments(call, callee, callee_info);
+		}
+	}
+	constbits_clear(irg);
+	DEL_ARR_F(calls);
+}
+
+static bool specialize_parameters(ir_graph *irg, method_info_t const *info)
+{
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES);
+
+	bool changed = false;
+	foreach_out_edge_safe(get_irg_args(irg), edge) {
+		ir_node *const proj = get_edge_src_irn(edge);
+		if (!is_Proj(proj))
+			continue;
+		size_t const pos = get_Proj_num(proj);
+		if (pos < get_method_n_params(get_entity_type(get_irg_entity(irg))))
+			changed |= apply_range(proj, &info->params[pos]);
+	}
+	return changed;
+}
+
+static void optimize_changed_graph(ir_graph *irg)
+{
+	confirm_irg_properties(irg, IR_GRAPH_PROPERTIES_CONTROL_FLOW);
+	optimize_graph_df(irg);
+}
+
+/**
+ * Propagates the arguments into the callees top down. Calls of callees
+ * processed before their caller, i.e. in recursions, are recorded from the
+ * unchanged graphs before.
+ */
+static void propagate_parameters(ipcp_env_t *env)
+{
+	size_t const n = ARR_LEN(env->order);
+	for (size_t i = 0; i < n; ++i)
+		record_arguments(env, env->order[i], true);
+
+	for (size_t i = n; i-- > 0;) {
+		ir_graph      *const irg  = env->order[i];
+		method_info_t *const info = get_method_info(env, get_irg_entity(irg));
+		if (info->all_calls_known && specialize_parameters(irg, info))
+			optimize_changed_graph(irg);
+		record_arguments(env, irg, false);
+	}
+}
+
+/** Replaces the results of calls with a single finished callee. */
+static bool apply_results(ipcp_env_t *env, ir_graph *irg)
+{
+	ir_node **calls = NEW_ARR_F(ir_node*, 0);
+	irg_walk_graph(irg, NULL, collect_calls, &calls);
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES);
+
+	bool changed = false;
+	for (size_t c = 0, n_calls = ARR_LEN(calls); c < n_calls; ++c) {
+		ir_node *const call = calls[c];
+		if (cg_get_call_n_callees(call) != 1)
+			continue;
+		ir_entity     *const callee      = cg_get_call_callee(call, 0);
+		method_info_t *const callee_info = get_method_info(env, callee);
+		if (callee_info == NULL || !callee_info->results_valid)
+			continue;
+
+		size_t const n_ress = get_method_n_ress(get_entity_type(callee));
+		foreach_out_edge(call, edge) {
+			ir_node *const proj = get_edge_src_irn(edge);
+			if (!is_Proj(proj) || get_Proj_num(proj) != pn_Call_T_result)
+				continue;
+			foreach_out_edge_safe(proj, res_edge) {
+				ir_node *const res = get_edge_src_irn(res_edge);
+				size_t   const pos = get_Proj_num(res);
+				if (pos < n_ress)
+					changed |= apply_range(res, &callee_info->results[pos]);
+			}
+		}
+	}
+	DEL_ARR_F(calls);
+	return changed;
+}
+
+static void record_results(method_info_t *info, ir_graph *irg)
+{
+	constbits_analyze(irg);
+	size_t const n_ress = get_method_n_ress(get_entity_type(get_irg_entity(irg)));
+	ir_node *const end_block = get_irg_end_block(irg);
+	for (int i = 0, n = get_Block_n_cfgpreds(end_block); i < n; ++i) {
+		ir_node *const ret = get_Block_cfgpred(end_block, i);
+		if (!is_Return(ret) || is_unreachable(ret))
+			continue;
+		for (size_t r = 0; r < n_ress; ++r) {
+			value_range_t *const range = &info->results[r];
+			if ((size_t)get_Return_n_ress(ret) <= r) {
+				set_bottom(range);
+				continue;
+			}
+			ir_tarval *lo;
+			ir_tarval *hi;
+			get_value_range(get_Return_res(ret, r), &lo, &hi);
+			range_meet(range, lo, hi);
+		}
+	}
+	constbits_clear(irg);
+	info->results_valid = true;
+}
+
+/**
+ * Propagates the results into the callers bottom up. Results of callees in
+ * the same recursion, which are not processed yet, stay unknown.
+ */
+static void propagate_results(ipcp_env_t *env)
+{
+	for (size_t i = 0, n = ARR_LEN(env->order); i < n; ++i) {
+		ir_graph  *const irg    = env->order[i];
+		ir_entity *const entity = get_irg_entity(irg);
+		if (apply_results(env, irg))
+			optimize_changed_graph(irg);
+		if (get_entity_linktime_irg(entity) == irg)
+			record_results(get_method_info(env, entity), irg);
+	}
+}
+
+/** Call sites passing the same constants to one function. */
+typedef struct call_group_t {
+	ir_tarval **consts;  /**< constant per parameter or NULL */
+	ir_node   **calls;
+	unsigned    benefit;
+} call_group_t;
+
+typedef struct clone_env_t {
+	ipcp_env_t *env;
+	pmap       *groups; /**< callee entity -> flexible array of call_group_t */
+} clone_env_t;
+
+static void collect_clone_calls(ir_node *node, void *data)
+{
+	if (!is_Call(node))
+		return;
+	ir_entity *const callee = get_Call_callee(node);
+	if (callee == NULL)
+		return;
+	ir_graph *const callee_irg = get_entity_linktime_irg(callee);
+	ir_type  *const mtp        = get_entity_type(callee);
+	size_t    const n_params   = get_method_n_params(mtp);
+	if (callee_irg == NULL || is_method_variadic(mtp) || n_params == 0
+	 || (size_t)get_Call_n_params(node) != n_params)
+		return;
+
+	clone_env_t *const cenv   = (clone_env_t*)data;
+	ir_tarval  **const consts = OALLOCN(&cenv->env->obst, ir_tarval*, n_params);
+	for (size_t i = 0; i < n_params; ++i) {
+		ir_node *const arg = get_Call_param(node, i);
+		consts[i] = is_Const(arg)
+		         && get_irn_mode(arg) == get_type_mode(get_method_param_type(mtp, i))
+		          ? get_Const_tarval(arg) : NULL;
+	}
+
+	call_group_t *groups = pmap_get(call_group_t, cenv->groups, callee);
+	if (groups == NULL)
+		groups = NEW_ARR_F(call_group_t, 0);
+	for (size_t g = 0, n = ARR_LEN(groups); g < n; ++g) {
+		if (memcmp(groups[g].consts, consts, n_params * sizeof(*consts)) == 0) {
+			ARR_APP1(ir_node*, groups[g].calls, node);
+			obstack_free(&cenv->env->obst, consts);
+			return;
+		}
+	}
+	call_group_t const group = { consts, NEW_ARR_F(ir_node*, 1), 0 };
+	group.calls[0] = node;
+	ARR_APP1(call_group_t, groups, group);
+	pmap_insert(cenv->groups, callee, groups);
+}
+
+static void count_node(ir_node *node, void *data)
+{
+	(void)node;
+	++*(unsigned*)data;
+}
+
+static int cmp_group_benefit(void const *a, void const *b)
+{
+	call_group_t const *const ga = (call_group_t const*)a;
+	call_group_t const *const gb = (call_group_t const*)b;
+	return QSORT_CMP(gb->benefit, ga->benefit);
+}
+
+/** Redirects the calls of @p group to a new local copy of @p callee. */
+static void clone_for_group(ir_entity *callee, call_group_t const *group)
+{
+	ident     *const name  = id_unique(get_entity_ident(callee));
+	ir_entity *const clone = clone_entity(callee, name, get_entity_owner(callee));
+	set_entity_visibility(clone, ir_visibility_local);
+	new_ir_graph_copy(clone, get_entity_linktime_irg(callee));
+
+	DB((dbg, LEVEL_1, "specialize %+F as %+F for %zu calls\n", callee, clone,
+	    ARR_LEN(group->calls)));
+	for (size_t i = 0, n = ARR_LEN(group->calls); i < n; ++i) {
+		ir_node *const call = group->calls[i];
+		set_Call_ptr(call, new_r_Address(get_irn_irg(call), clone));
+	}
+}
+
+/** Clones the callees of the call groups with the highest benefit. */
+static bool clone_callee(ipcp_env_t *env, ir_entity *callee,
+                         call_group_t *groups, float threshold)
+{
+	/* the propagation handles a single group of calls by itself */
+	size_t         const n_groups = ARR_LEN(groups);
+	method_info_t *const info     = get_method_info(env, callee);
+	if (n_groups == 1 && info != NULL && info->all_calls_known)
+		return false;
+
+	size_t const n_params = get_method_n_params(get_entity_type(callee));
+	for (size_t g = 0; g < n_groups; ++g) {
+		call_group_t *const group  = &groups[g];
+		unsigned            weight = 0;
+		for (size_t i = 0; i < n_params; ++i) {
+			if (group->consts[i] != NULL)
+				weight += get_method_param_weight(callee, i) + 1;
+		}
+		group->benefit = weight * (unsigned)ARR_LEN(group->calls);
+	}
+	QSORT_ARR(groups, cmp_group_benefit);
+
+	unsigned n_nodes = 0;
+	irg_walk_graph(get_entity_linktime_irg(callee), count_node, NULL,
+	               &n_nodes);
+
+	bool changed = false;
+	for (size_t g = 0; g < MIN(n_groups, MAX_CLONES); ++g) {
+		call_group_t const *const group = &groups[g];
+		if (group->benefit == 0 || group->benefit * threshold < n_nodes)
+			break;
+		clone_for_group(callee, group);
+		changed = true;
+	}
+	return changed;
+}
+
+/** Specializes functions for the constants passed at their call sites. */
+static bool clone_methods(ipcp_env_t *env, float threshold)
+{
+	clone_env_t cenv = { env, pmap_create() };
+	all_irg_walk(NULL, collect_clone_calls, &cenv);
+
+	bool changed = false;
+	foreach_pmap(cenv.groups, entry) {
+		ir_entity    *const callee = (ir_entity*)entry->key;
+		call_group_t *const groups = (call_group_t*)entry->value;
+		changed |= clone_callee(env, callee, groups, threshold);
+		for (size_t g = 0, n = ARR_LEN(groups); g < n; ++g)
+			DEL_ARR_F(groups[g].calls);
+		DEL_ARR_F(groups);
+	}
+	pmap_destroy(cenv.groups);
+	return changed;
+}
+
+void opt_ipcp(float threshold)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.ipcp");
+
+	ipcp_env_t env;
+	obstack_init(&env.obst);
+	analyze_calls(&env);
+	if (clone_methods(&env, threshold)) {
+		/* the copies changed the calls */
+		free_calls_info(&env);
+		analyze_calls(&env);
+	}
+
+	propagate_parameters(&env);
+	propagate_results(&env);
+
+	free_calls_info(&env);
+	obstack_free(&env.obst, NULL);
+}
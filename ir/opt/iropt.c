@@ -7920,7 +7920,7 @@ ir_node *optimize_node(ir_node *n)
 				oldn = (ir_node *)alloca(node_size);
 
 				memcpy(oldn, n, node_size);
-				size_t n_in = ARR_LEN(n->in);
+				size_t n_in = get_irn_arity(n) + 1;
 				oldn->in = ALLOCAN(ir_node*, n_in);
 
 				/* ARG, copy the in array, we need it for statistics */
@@ -6,7 +6,7 @@
 /**
  * @file
  * @author   Christian Helmer
- * @brief    loop inversion and loop unrolling
+ * @brief    loop inversion, loop unrolling and loop unswitching
  *
  */
 
@@ -16,6 +16,7 @@
 #include "util.h"
 #include "array.h"
 #include "debug.h"
+#include "execfreq.h"
 #include "panic.h"
 #include "irbackedge_t.h"
 #include "ircons_t.h"
@@ -91,6 +92,9 @@ typedef struct loop_stats_t {
 	unsigned constant_unroll;
 	unsigned invariant_unroll;
 
+	unsigned unswitched;
+	unsigned unswitch_over_budget;
+
 	unsigned unhandled;
 } loop_stats_t;
 
@@ -115,6 +119,8 @@ static void print_stats(void)
 	DB((dbg, LEVEL_2, "u_simple_counting :   %d\n", stats.u_simple_counting_loop));
 	DB((dbg, LEVEL_2, "constant_unroll   :   %d\n", stats.constant_unroll));
 	DB((dbg, LEVEL_2, "invariant_unroll  :   %d\n", stats.invariant_unroll));
+	DB((dbg, LEVEL_2, "unswitched        :   %d\n", stats.unswitched));
+	DB((dbg, LEVEL_2, "unswitch_over_budget: %d\n", stats.unswitch_over_budget));
 	DB((dbg, LEVEL_2, "=======================================\n"));
 }
 
@@ -132,6 +138,9 @@ typedef struct loop_opt_params_t {
 	bool     allow_const_unrolling;
 	bool     allow_invar_unrolling;
 	unsigned invar_unrolling_min_size;  /* [nodes] */
+
+	unsigned max_unswitch_size;   /* Maximum loop size for unswitching [nodes] */
+	unsigned unswitch_budget;     /* Nodes duplicated by unswitching per graph [nodes] */
 } loop_opt_params_t;
 
 static loop_opt_params_t opt_params;
@@ -189,9 +198,13 @@ static struct obstack obst;
 typedef enum loop_op_t {
 	loop_op_inversion,
 	loop_op_unrolling,
-	loop_op_peeling
+	loop_op_peeling,
+	loop_op_unswitching
 } loop_op_t;
 
+/* Nodes unswitching may still duplicate in the current graph. */
+static unsigned unswitch_budget_left;
+
 /* Returns the maximum nodes for the given nest depth */
 static unsigned get_max_nodes_adapted(unsigned const depth)
 {
@@ -2224,6 +2237,180 @@ static void unroll_loop(ir_graph *const irg)
 	}
 }
 
+/***** Unswitching *****/
+
+/* Returns true if the selector @p sel of a Cond has the same value in every
+ * iteration of cur_loop and can be computed in front of it. */
+static bool is_invariant_selector(ir_node *const sel)
+{
+	if (is_Const(sel))
+		return false;
+	if (!is_in_loop(sel))
+		return true;
+	/* A compare of invariant values is copied in front of the loop. */
+	return is_Cmp(sel) && !is_in_loop(get_Cmp_left(sel))
+	    && !is_in_loop(get_Cmp_right(sel));
+}
+
+/* Returns true if a Proj of @p cond leaves cur_loop. */
+static bool is_loop_exit(ir_node const *const cond)
+{
+	foreach_out_edge(cond, edge) {
+		ir_node *const proj = get_edge_src_irn(edge);
+		foreach_out_edge(proj, succ_edge) {
+			ir_node *const succ = get_edge_src_irn(succ_edge);
+			if (is_Block(succ) && !is_in_loop(succ))
+				return true;
+		}
+	}
+	return false;
+}
+
+/* Remembers the most frequently executed Cond with an invariant selector.
+ * Exit tests are skipped: Folding them makes one of the loops endless. */
+static void find_invariant_cond(ir_node *const node, void *const env)
+{
+	ir_node **const best = (ir_node**)env;
+	if (!is_Cond(node) || !is_in_loop(node)
+	 || !is_invariant_selector(get_Cond_selector(node)) || is_loop_exit(node))
+		return;
+
+	double const freq = get_block_execfreq(get_nodes_block(node));
+	if (*best == NULL || freq > get_block_execfreq(get_nodes_block(*best)))
+		*best = node;
+}
+
+/* Replaces the Projs of @p cond by a Jmp for the outcome @p value and a Bad
+ * for the other one. */
+static void fold_cond(ir_node *const cond, bool const value)
+{
+	ir_graph *const irg   = get_irn_irg(cond);
+	ir_node  *const block = get_nodes_block(cond);
+	foreach_out_edge_safe(cond, edge) {
+		ir_node *const proj  = get_edge_src_irn(edge);
+		bool     const taken = (get_Proj_num(proj) == pn_Cond_true) == value;
+		exchange(proj, taken ? new_r_Jmp(block) : new_r_Bad(irg, mode_X));
+	}
+}
+
+/* Moves a loop invariant condition in front of cur_loop: The loop is copied,
+ * the original runs if the condition is true and the copy otherwise. */
+static void unswitch_loop(ir_graph *const irg)
+{
+	if (loop_info.nodes > opt_params.max_unswitch_size) {
+		DB((dbg, LEVEL_1, "Nodes %d > allowed nodes %d\n",
+		    loop_info.nodes, opt_params.max_unswitch_size));
+		++stats.too_large;
+		return;
+	}
+	if (loop_info.nodes > unswitch_budget_left) {
+		DB((dbg, LEVEL_1, "Nodes %d > remaining budget %d\n",
+		    loop_info.nodes, unswitch_budget_left));
+		++stats.unswitch_over_budget;
+		return;
+	}
+	if (loop_info.cf_outs == 0)
+		return;
+
+	/* The test is placed on the only edge entering the head. */
+	int entry_pos = -1;
+	for (int i = 0, n = get_Block_n_cfgpreds(loop_head); i < n; ++i) {
+		if (is_in_loop(get_Block_cfgpred(loop_head, i)))
+			continue;
+		if (entry_pos >= 0)
+			return;
+		entry_pos = i;
+	}
+	if (entry_pos < 0)
+		return;
+
+	ir_node *cond = NULL;
+	irg_walk_graph(irg, find_invariant_cond, NULL, &cond);
+	if (cond == NULL)
+		return;
+	DB((dbg, LEVEL_2, "Unswitching %N\n", cond));
+
+	ir_nodemap_init(&map, irg);
+	obstack_init(&obst);
+	loop_entries = NEW_ARR_F(entry_edge, 0);
+	irg_walk_graph(irg, get_loop_entries, NULL, NULL);
+
+	/* 1. copy the whole loop */
+	ir_reserve_resources(irg, IR_RESOURCE_IRN_VISITED);
+	inc_irg_visited(irg);
+	for (size_t i = 0; i < ARR_LEN(loop_entries); ++i)
+		copy_walk(loop_entries[i].pred, is_in_loop, cur_loop);
+	ir_free_resources(irg, IR_RESOURCE_IRN_VISITED);
+
+	/* 2. test the condition in front of the loop and enter the original loop
+	 *    if it is true and the copy otherwise */
+	ir_node *const head_copy = get_inversion_copy(loop_head);
+	ir_node *const entry     = get_Block_cfgpred(loop_head, entry_pos);
+	ir_node *const guard     = new_r_Block(irg, 1, &entry);
+	ir_node       *sel       = get_Cond_selector(cond);
+	if (is_in_loop(sel)) {
+		sel = new_r_Cmp(guard, get_Cmp_left(sel), get_Cmp_right(sel),
+		                get_Cmp_relation(sel));
+	}
+	ir_node *const guard_cond = new_r_Cond(guard, sel);
+	set_Cond_jmp_pred(guard_cond, get_Cond_jmp_pred(cond));
+	set_Block_cfgpred(loop_head, entry_pos,
+	                  new_r_Proj(guard_cond, mode_X, pn_Cond_true));
+	set_Block_cfgpred(head_copy, entry_pos,
+	                  new_r_Proj(guard_cond, mode_X, pn_Cond_false));
+
+	/* 3. the copy leaves the loop on the same edges as the original */
+	for (size_t i = 0; i < ARR_LEN(loop_entries); ++i) {
+		entry_edge const exit = loop_entries[i];
+		if (is_Block(exit.node))
+			extend_ins_by_copy(exit.node, exit.pos);
+	}
+	for (size_t i = 0; i < ARR_LEN(loop_entries); ++i) {
+		entry_edge const exit = loop_entries[i];
+		ir_node   *const cp   = get_inversion_copy(exit.pred);
+		if (is_End(exit.node)) {
+			add_End_keepalive(exit.node, cp);
+		} else if (!is_Block(exit.node)) {
+			construct_ssa(get_nodes_block(exit.pred), exit.pred,
+			              get_nodes_block(cp), cp);
+		}
+	}
+
+	/* 4. the condition is known inside of both loops */
+	ir_node *const cond_copy = get_inversion_copy(cond);
+	fold_cond(cond, true);
+	fold_cond(cond_copy, false);
+
+	unswitch_budget_left -= loop_info.nodes;
+	++stats.unswitched;
+	clear_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE
+	                   | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+
+	DEL_ARR_F(loop_entries);
+	obstack_free(&obst, NULL);
+	ir_nodemap_destroy(&map);
+}
+
+/* Returns the highest execution frequency of the blocks of @p loop. */
+static double get_loop_execfreq(ir_loop *const loop)
+{
+	double freq = 0.0;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind == k_ir_node)
+			freq = MAX(freq, get_block_execfreq(element.node));
+	}
+	return freq;
+}
+
+/* Orders loops by decreasing execution frequency. */
+static int cmp_loop_execfreq(void const *const a, void const *const b)
+{
+	double const freq_a = get_loop_execfreq(*(ir_loop *const*)a);
+	double const freq_b = get_loop_execfreq(*(ir_loop *const*)b);
+	return (freq_a < freq_b) - (freq_a > freq_b);
+}
+
 /* Analyzes the loop, and checks if size is within allowed range.
  * Decides if loop will be processed. */
 static void init_analyze(ir_graph *const irg, ir_loop *const loop, loop_op_t const loop_op)
@@ -2257,6 +2444,7 @@ static void init_analyze(ir_graph *const irg, ir_loop *const loop, loop_op_t con
 	switch (loop_op) {
 		case loop_op_inversion: loop_inversion(irg); break;
 		case loop_op_unrolling: unroll_loop(irg);    break;
+		case loop_op_unswitching: unswitch_loop(irg); break;
 		default: panic("loop optimization not implemented");
 	}
 	DB((dbg, LEVEL_1, "       <<<< end of loop with node %ld >>>>\n", get_loop_loop_nr(loop)));
@@ -2291,6 +2479,8 @@ static void set_loop_params(void)
 	opt_params.invar_unrolling_min_size =   20;
 	opt_params.max_unrolled_loop_size   =  400;
 	opt_params.max_branches             = 9999;
+	opt_params.max_unswitch_size        =  100;
+	opt_params.unswitch_budget          =  400;
 }
 
 /**
@@ -2315,6 +2505,11 @@ static void loop_optimization(ir_graph *const irg, loop_op_t const loop_op)
 	/* Reset stats for this procedure */
 	reset_stats();
 
+	if (loop_op == loop_op_unswitching) {
+		ir_estimate_execfreq(irg);
+		unswitch_budget_left = opt_params.unswitch_budget;
+	}
+
 	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_PHI_LIST);
 	collect_phiprojs_and_start_block_nodes(irg);
 
@@ -2329,9 +2524,12 @@ static void loop_optimization(ir_graph *const irg, loop_op_t const loop_op)
 			continue;
 		find_innermost_loop(element.son);
 	}
+	/* Hot loops get the unswitching budget first. */
+	if (loop_op == loop_op_unswitching)
+		QSORT_ARR(loops, cmp_loop_execfreq);
 
 	/* Set all links to NULL */
-	irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+	irg_walk_graph_by_idx(irg, firm_clear_link, NULL);
 
 	for (size_t i = 0; i < ARR_LEN(loops); ++i) {
 		ir_loop *const loop = loops[i];
@@ -2346,7 +2544,7 @@ static void loop_optimization(ir_graph *const irg, loop_op_t const loop_op)
 
 		/* Set links to NULL
 		 * TODO Still necessary? */
-		irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+		irg_walk_graph_by_idx(irg, firm_clear_link, NULL);
 	}
 
 	print_stats();
@@ -2372,6 +2570,17 @@ void do_loop_peeling(ir_graph *const irg)
 	loop_optimization(irg, loop_op_peeling);
 }
 
+void do_loop_unswitching(ir_graph *const irg)
+{
+	loop_optimization(irg, loop_op_unswitching);
+
+	/* The folded conditions left unreachable blocks behind. */
+	if (stats.unswitched > 0) {
+		remove_unreachable_code(irg);
+		remove_bads(irg);
+	}
+}
+
 void firm_init_loop_opt(void)
 {
 	FIRM_DBG_REGISTER(dbg, "firm.opt.loop");
@@ -0,0 +1,843 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Interchange and tiling of perfectly nested loops.
+ *
+ * A nest is an innermost loop and its parent, which contains nothing but the
+ * inner loop.  Both loops must test their induction variable against a nest
+ * invariant bound in the header, and the addresses of all memory accesses must
+ * be affine in both induction variables.  The loops are interchanged if the
+ * inner loop then touches fewer cache lines per iteration.  The inner loop is
+ * tiled if the next outer iteration reuses the cache lines it touches, but one
+ * sweep over it does not fit into the cache.  Both transformations are only
+ * legal if no dependence has opposite directions in the two loops.
+ */
+#include <stdlib.h>
+
+#include "array.h"
+#include "debug.h"
+#include "ircons.h"
+#include "iredges_t.h"
+#include "irgmod.h"
+#include "irloop_t.h"
+#include "irnode_t.h"
+#include "iroptimize.h"
+#include "tv.h"
+#include "util.h"
+
+/** The largest iteration distance the dependence test enumerates. */
+#define MAX_DISTANCE_SEARCH (1 << 16)
+/** The number of nest invariant integer terms allowed in an address. */
+#define MAX_TERMS           4
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/** The iteration space of an induction variable. */
+typedef struct loop_control_t {
+	ir_node    *init;     /**< the first value */
+	ir_node    *bound;    /**< the nest invariant bound */
+	ir_tarval  *step;     /**< the constant increment */
+	ir_relation relation; /**< the loop runs while the variable has this
+	                           relation to the bound */
+	long        trip;     /**< the number of iterations, -1 if unknown */
+} loop_control_t;
+
+/** One of the two loops of a nest. */
+typedef struct nest_loop_t {
+	ir_loop       *loop;
+	ir_node       *header;
+	int            entry_pos;    /**< the input of the entry edge in header */
+	ir_node       *exit_block;   /**< the block entered when leaving */
+	int            exit_pos;     /**< the input of the exit edge in exit_block */
+	ir_node       *cond;         /**< the loop test */
+	ir_node       *cmp;          /**< the selector of cond */
+	bool           exit_on_true; /**< the loop is left if cmp is true */
+	ir_node       *phi;          /**< the induction variable */
+	ir_node       *incr;         /**< phi + step */
+	int            step_pos;     /**< the input of the step in incr */
+	ir_node       *mem_phi;      /**< the memory Phi of the header */
+	loop_control_t control;
+} nest_loop_t;
+
+/** A nest invariant value times a constant factor. */
+typedef struct term_t {
+	ir_node *node;
+	long     factor;
+} term_t;
+
+/** A memory access, whose address is base + terms + c[0] * k0 + c[1] * k1 +
+ * offset in the k0-th iteration of the first and the k1-th iteration of the
+ * second induction variable. */
+typedef struct access_t {
+	ir_node *addr;
+	ir_node *base;
+	term_t   terms[MAX_TERMS];
+	unsigned n_terms;
+	long     c[2];
+	long     offset;
+	unsigned size;
+	bool     is_store;
+} access_t;
+
+typedef struct nest_t {
+	nest_loop_t loops[2]; /**< the outer and the inner loop */
+	ir_node   **blocks;   /**< all blocks of the nest */
+	ir_node   **nodes;    /**< all nodes of the nest */
+	access_t   *accesses;
+} nest_t;
+
+static bool is_in_loop(ir_node const *const node, ir_loop const *const loop)
+{
+	ir_node const *const block = is_Block(node) ? node : get_nodes_block(node);
+	for (ir_loop *l = get_irn_loop(block); l != NULL;
+	     l = get_loop_outer_loop(l)) {
+		if (l == loop)
+			return true;
+		if (get_loop_depth(l) == 0)
+			break;
+	}
+	return false;
+}
+
+static long get_trip_count(loop_control_t const *const control)
+{
+	if (!is_Const(control->init) || !is_Const(control->bound))
+		return -1;
+	ir_tarval *const init_tv  = get_Const_tarval(control->init);
+	ir_tarval *const bound_tv = get_Const_tarval(control->bound);
+	if (!tarval_is_long(init_tv) || !tarval_is_long(bound_tv))
+		return -1;
+
+	long const init  = get_tarval_long(init_tv);
+	long const bound = get_tarval_long(bound_tv);
+	long       step  = get_tarval_long(control->step);
+	long       range;
+	switch (control->relation) {
+	case ir_relation_less:
+		range = bound - init;
+		break;
+	case ir_relation_less_equal:
+		range = bound - init + 1;
+		break;
+	case ir_relation_greater:
+		range = init - bound;
+		step  = -step;
+		break;
+	case ir_relation_greater_equal:
+		range = init - bound + 1;
+		step  = -step;
+		break;
+	default:
+		return -1;
+	}
+	if (step <= 0)
+		return -1;
+	return range <= 0 ? 0 : (range + step - 1) / step;
+}
+
+/** Recognizes a loop, which tests its induction variable in the header and
+ * has no other exit. */
+static bool analyze_loop(nest_t *const nest, nest_loop_t *const l)
+{
+	ir_loop *const outer     = nest->loops[0].loop;
+	unsigned       n_entries = 0;
+	unsigned       n_exits   = 0;
+	ir_node       *exit_src  = NULL;
+	for (size_t i = 0, n = ARR_LEN(nest->blocks); i < n; ++i) {
+		ir_node *const block = nest->blocks[i];
+		if (!is_in_loop(block, l->loop))
+			continue;
+		for (int p = 0, arity = get_Block_n_cfgpreds(block); p < arity; ++p) {
+			if (!is_in_loop(get_Block_cfgpred_block(block, p), l->loop)) {
+				l->header    = block;
+				l->entry_pos = p;
+				++n_entries;
+			}
+		}
+		foreach_block_succ(block, edge) {
+			ir_node *const succ = get_edge_src_irn(edge);
+			if (is_in_loop(succ, l->loop))
+				continue;
+			l->exit_block = succ;
+			l->exit_pos   = get_edge_src_pos(edge);
+			exit_src      = block;
+			++n_exits;
+		}
+	}
+	if (n_entries != 1 || n_exits != 1 || exit_src != l->header)
+		return false;
+
+	ir_node *const exit = get_Block_cfgpred(l->exit_block, l->exit_pos);
+	if (!is_Proj(exit) || !is_Cond(get_Proj_pred(exit)))
+		return false;
+	l->cond         = get_Proj_pred(exit);
+	l->cmp          = get_Cond_selector(l->cond);
+	l->exit_on_true = get_Proj_num(exit) == pn_Cond_true;
+	if (!is_Cmp(l->cmp))
+		return false;
+
+	foreach_out_edge(l->header, edge) {
+		ir_node *const node = get_edge_src_irn(edge);
+		if (!is_Phi(node))
+			continue;
+		if (get_irn_mode(node) == mode_M) {
+			if (l->mem_phi != NULL)
+				return false;
+			l->mem_phi = node;
+		} else if (l->phi != NULL) {
+			return false;
+		} else {
+			l->phi = node;
+		}
+	}
+	ir_node *const phi = l->phi;
+	if (phi == NULL || get_Phi_n_preds(phi) != 2
+	    || !mode_is_int(get_irn_mode(phi)))
+		return false;
+
+	loop_control_t *const control = &l->control;
+	control->relation = get_Cmp_relation(l->cmp);
+	if (get_Cmp_left(l->cmp) == phi) {
+		control->bound = get_Cmp_right(l->cmp);
+	} else if (get_Cmp_right(l->cmp) == phi) {
+		control->bound    = get_Cmp_left(l->cmp);
+		control->relation = get_inversed_relation(control->relation);
+	} else {
+		return false;
+	}
+	if (l->exit_on_true)
+		control->relation = get_negated_relation(control->relation);
+	control->init = get_irn_n(phi, l->entry_pos);
+	if (is_in_loop(control->bound, outer) || is_in_loop(control->init, outer))
+		return false;
+
+	l->incr = get_irn_n(phi, 1 - l->entry_pos);
+	if (!is_Add(l->incr) || get_irn_n_edges(l->incr) != 1)
+		return false;
+	l->step_pos = get_Add_left(l->incr) == phi ? n_Add_right : n_Add_left;
+	ir_node *const step = get_irn_n(l->incr, l->step_pos);
+	if (get_irn_n(l->incr, 1 - l->step_pos) != phi || !is_Const(step)
+	    || !tarval_is_long(get_Const_tarval(step)))
+		return false;
+	control->step = get_Const_tarval(step);
+	control->trip = get_trip_count(control);
+	return true;
+}
+
+static bool get_const_factor(ir_node const *const node, long *const factor)
+{
+	if (!is_Const(node) || !tarval_is_long(get_Const_tarval(node)))
+		return false;
+	*factor = get_tarval_long(get_Const_tarval(node));
+	return true;
+}
+
+/** Adds an invariant term, keeping the terms sorted to make them comparable. */
+static bool add_term(access_t *const access, ir_node *const node,
+                     long const factor)
+{
+	unsigned i = 0;
+	while (i < access->n_terms && get_irn_idx(access->terms[i].node)
+	                              < get_irn_idx(node))
+		++i;
+	if (i < access->n_terms && access->terms[i].node == node) {
+		access->terms[i].factor += factor;
+		return true;
+	}
+	if (access->n_terms == MAX_TERMS)
+		return false;
+	for (unsigned j = access->n_terms++; j > i; --j)
+		access->terms[j] = access->terms[j - 1];
+	access->terms[i] = (term_t){ node, factor };
+	return true;
+}
+
+static bool has_same_terms(access_t const *const a, access_t const *const b)
+{
+	if (a->n_terms != b->n_terms)
+		return false;
+	for (unsigned i = 0; i < a->n_terms; ++i) {
+		if (a->terms[i].node != b->terms[i].node
+		    || a->terms[i].factor != b->terms[i].factor)
+			return false;
+	}
+	return true;
+}
+
+/** Adds @p factor times the affine form of @p node to @p access. */
+static bool linearize(nest_t const *const nest, ir_node *const node,
+                      long const factor, access_t *const access)
+{
+	for (size_t k = 0; k < 2; ++k) {
+		if (node == nest->loops[k].phi) {
+			access->c[k] += factor;
+			return true;
+		}
+	}
+
+	long value;
+	if (!is_in_loop(node, nest->loops[0].loop)) {
+		if (get_const_factor(node, &value)) {
+			access->offset += factor * value;
+			return true;
+		}
+		if (mode_is_reference(get_irn_mode(node))) {
+			if (access->base != NULL || factor != 1)
+				return false;
+			access->base = node;
+			return true;
+		}
+		return add_term(access, node, factor);
+	}
+
+	switch (get_irn_opcode(node)) {
+	case iro_Add:
+		return linearize(nest, get_Add_left(node), factor, access)
+		    && linearize(nest, get_Add_right(node), factor, access);
+	case iro_Sub:
+		return linearize(nest, get_Sub_left(node), factor, access)
+		    && linearize(nest, get_Sub_right(node), -factor, access);
+	case iro_Mul:
+		if (get_const_factor(get_Mul_right(node), &value))
+			return linearize(nest, get_Mul_left(node), factor * value, access);
+		if (get_const_factor(get_Mul_left(node), &value))
+			return linearize(nest, get_Mul_right(node), factor * value, access);
+		return false;
+	case iro_Shl:
+		if (!get_const_factor(get_Shl_right(node), &value) || value < 0
+		    || value >= 32)
+			return false;
+		return linearize(nest, get_Shl_left(node), factor * (1L << value),
+		                 access);
+	case iro_Conv: {
+		ir_node *const op   = get_Conv_op(node);
+		ir_mode *const from = get_irn_mode(op);
+		ir_mode *const to   = get_irn_mode(node);
+		if (!mode_is_int(from) || !(mode_is_int(to) || mode_is_reference(to))
+		    || get_mode_size_bits(to) < get_mode_size_bits(from))
+			return false;
+		return linearize(nest, op, factor, access);
+	}
+	default:
+		return false;
+	}
+}
+
+static bool add_access(nest_t *const nest, ir_node *const addr,
+                       ir_mode *const mode, bool const is_store)
+{
+	access_t access = {
+		.addr     = addr,
+		.size     = get_mode_size_bytes(mode),
+		.is_store = is_store,
+	};
+	if (!linearize(nest, addr, 1, &access))
+		return false;
+	for (size_t k = 0; k < 2; ++k)
+		access.c[k] *= get_tarval_long(nest->loops[k].control.step);
+	ARR_APP1(access_t, nest->accesses, access);
+	return true;
+}
+
+/** Checks that the outer loop contains nothing but the inner loop and collects
+ * the memory accesses of the inner loop. */
+static bool analyze_nodes(nest_t *const nest)
+{
+	ir_loop *const outer = nest->loops[0].loop;
+	ir_loop *const inner = nest->loops[1].loop;
+	for (size_t i = 0, n = ARR_LEN(nest->nodes); i < n; ++i) {
+		ir_node *const node     = nest->nodes[i];
+		bool     const in_inner = is_in_loop(node, inner);
+		if (is_Load(node) || is_Store(node)) {
+			if (!in_inner)
+				return false;
+			if (is_Load(node)) {
+				if (get_Load_volatility(node) != volatility_non_volatile
+				    || !add_access(nest, get_Load_ptr(node),
+				                   get_Load_mode(node), false))
+					return false;
+			} else {
+				ir_node *const value = get_Store_value(node);
+				if (get_Store_volatility(node) != volatility_non_volatile
+				    || !add_access(nest, get_Store_ptr(node),
+				                   get_irn_mode(value), true))
+					return false;
+			}
+		} else if (is_Cond(node) || is_Switch(node)) {
+			if (!in_inner && node != nest->loops[0].cond)
+				return false;
+		} else if (is_Phi(node)) {
+			if (!in_inner && node != nest->loops[0].phi
+			    && node != nest->loops[0].mem_phi)
+				return false;
+		} else if (!is_Proj(node) && !is_Sync(node) && !is_Div(node)
+		        && !is_Mod(node)) {
+			foreach_irn_in(node, p, pred) {
+				if (get_irn_mode(pred) == mode_M) {
+					DB((dbg, LEVEL_2, "  %+F prevents the transformation\n",
+					    node));
+					return false;
+				}
+			}
+		}
+
+		/* only memory may be used behind the nest */
+		ir_mode *const mode = get_irn_mode(node);
+		if (mode == mode_M || mode == mode_X)
+			continue;
+		foreach_out_edge(node, edge) {
+			ir_node *const user = get_edge_src_irn(edge);
+			if (!is_End(user) && !is_in_loop(user, outer))
+				return false;
+		}
+	}
+	return true;
+}
+
+static bool is_distant(long const distance, long const trip)
+{
+	return trip >= 0 && labs(distance) >= trip;
+}
+
+/**
+ * Checks whether c0 * d0 + c1 * d1 = t has a solution, where d0 and d1 are
+ * iteration distances with opposite signs.
+ */
+static bool has_crossing_distance(long const c0, long const c1, long const t,
+                                  long const trip0, long const trip1)
+{
+	if ((trip0 >= 0 && trip0 <= 1) || (trip1 >= 0 && trip1 <= 1))
+		return false;
+	if (c0 == 0 && c1 == 0)
+		return t == 0;
+	if (c0 == 0)
+		return t % c1 == 0 && t != 0 && !is_distant(t / c1, trip1);
+	if (c1 == 0)
+		return t % c0 == 0 && t != 0 && !is_distant(t / c0, trip0);
+
+	if (trip0 >= 0 && trip0 <= MAX_DISTANCE_SEARCH) {
+		for (long d0 = 1 - trip0; d0 < trip0; ++d0) {
+			long const rest = t - c0 * d0;
+			if (d0 == 0 || rest % c1 != 0)
+				continue;
+			long const d1 = rest / c1;
+			if ((d0 < 0) != (d1 < 0) && d1 != 0 && !is_distant(d1, trip1))
+				return true;
+		}
+		return false;
+	}
+	if (trip1 >= 0 && trip1 <= MAX_DISTANCE_SEARCH)
+		return has_crossing_distance(c1, c0, t, trip1, trip0);
+	return true;
+}
+
+static ir_entity *get_object(ir_node const *const addr)
+{
+	if (is_Address(addr))
+		return get_Address_entity(addr);
+	if (is_Member(addr)) {
+		ir_node const *const ptr = get_Member_ptr(addr);
+		if (ptr == get_irg_frame(get_irn_irg(addr)))
+			return get_Member_entity(addr);
+		return get_object(ptr);
+	}
+	return NULL;
+}
+
+/** Checks whether the accesses may touch the same memory in iterations, whose
+ * order differs in the two loops. */
+static bool has_crossing_dependence(nest_t const *const nest,
+                                    access_t const *const a,
+                                    access_t const *const b)
+{
+	if (a->base != b->base) {
+		/* an address without base, e.g. a converted integer, may point
+		 * anywhere */
+		if (a->base == NULL || b->base == NULL)
+			return true;
+		ir_entity const *const object_a = get_object(a->base);
+		ir_entity const *const object_b = get_object(b->base);
+		return object_a == NULL || object_b == NULL || object_a == object_b;
+	}
+	if (!has_same_terms(a, b) || a->c[0] != b->c[0] || a->c[1] != b->c[1])
+		return true;
+
+	/* b at iteration y overlaps a at iteration x if
+	 * -a->size < c * (y - x) + b->offset - a->offset < b->size */
+	long const delta = b->offset - a->offset;
+	long const trip0 = nest->loops[0].control.trip;
+	long const trip1 = nest->loops[1].control.trip;
+	for (long t = 1 - (long)a->size; t < (long)b->size; ++t) {
+		if (has_crossing_distance(a->c[0], a->c[1], t - delta, trip0, trip1))
+			return true;
+	}
+	return false;
+}
+
+/** Checks whether the iterations of the nest may be reordered. */
+static bool is_permutable(nest_t const *const nest)
+{
+	for (size_t i = 0, n = ARR_LEN(nest->accesses); i < n; ++i) {
+		access_t const *const a = &nest->accesses[i];
+		for (size_t j = i; j < n; ++j) {
+			access_t const *const b = &nest->accesses[j];
+			if (!a->is_store && !b->is_store)
+				continue;
+			if (has_crossing_dependence(nest, a, b)) {
+				DB((dbg, LEVEL_2, "  dependence between %+F and %+F\n",
+				    a->addr, b->addr));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/** Sums up the bytes of cache lines touched per iteration of variable @p k. */
+static long get_bytes_per_iteration(nest_t const *const nest, size_t const k,
+                                    unsigned const cache_line_size)
+{
+	long bytes = 0;
+	for (size_t i = 0, n = ARR_LEN(nest->accesses); i < n; ++i) {
+		access_t const *const access = &nest->accesses[i];
+		bool                  seen   = false;
+		for (size_t j = 0; j < i; ++j)
+			seen |= nest->accesses[j].addr == access->addr;
+		if (!seen)
+			bytes += MIN(labs(access->c[k]), (long)cache_line_size);
+	}
+	return bytes;
+}
+
+static void set_control(nest_loop_t *const l, loop_control_t const *const control)
+{
+	ir_graph *const irg = get_irn_irg(l->phi);
+	set_irn_n(l->phi, l->entry_pos, control->init);
+	set_irn_n(l->incr, l->step_pos, new_r_Const(irg, control->step));
+
+	ir_relation const relation = l->exit_on_true
+		? get_negated_relation(control->relation) : control->relation;
+	ir_node *const cmp = new_r_Cmp(get_nodes_block(l->cmp), l->phi,
+	                               control->bound, relation);
+	if (cmp != l->cmp) {
+		exchange(l->cmp, cmp);
+		l->cmp = cmp;
+	}
+	l->control = *control;
+}
+
+typedef struct use_t {
+	ir_node *user;
+	int      pos;
+} use_t;
+
+/** Interchanges the loops by exchanging the iteration spaces and the uses of
+ * their induction variables. */
+static void interchange(nest_t *const nest)
+{
+	use_t *uses[2];
+	for (size_t k = 0; k < 2; ++k) {
+		nest_loop_t const *const l = &nest->loops[k];
+		uses[k] = NEW_ARR_F(use_t, 0);
+		foreach_out_edge(l->phi, edge) {
+			ir_node *const user = get_edge_src_irn(edge);
+			if (user == l->incr || user == l->cmp)
+				continue;
+			use_t const use = { user, get_edge_src_pos(edge) };
+			ARR_APP1(use_t, uses[k], use);
+		}
+	}
+	for (size_t k = 0; k < 2; ++k) {
+		ir_node *const other = nest->loops[1 - k].phi;
+		for (size_t i = 0, n = ARR_LEN(uses[k]); i < n; ++i)
+			set_irn_n(uses[k][i].user, uses[k][i].pos, other);
+		DEL_ARR_F(uses[k]);
+	}
+
+	loop_control_t const control = nest->loops[0].control;
+	set_control(&nest->loops[0], &nest->loops[1].control);
+	set_control(&nest->loops[1], &control);
+}
+
+/** Collects the memory values of the nest used behind it. */
+static void get_memory_behind(nest_t const *const nest, ir_node ***const mems,
+                              use_t **const uses)
+{
+	ir_loop *const outer = nest->loops[0].loop;
+	for (size_t i = 0, n = ARR_LEN(nest->nodes); i < n; ++i) {
+		ir_node *const node = nest->nodes[i];
+		if (get_irn_mode(node) != mode_M)
+			continue;
+		bool used = false;
+		foreach_out_edge(node, edge) {
+			ir_node *const user = get_edge_src_irn(edge);
+			if (is_End(user) || is_in_loop(user, outer))
+				continue;
+			use_t const use = { user, get_edge_src_pos(edge) };
+			ARR_APP1(use_t, *uses, use);
+			used = true;
+		}
+		if (used)
+			ARR_APP1(ir_node*, *mems, node);
+	}
+}
+
+/**
+ * Checks that the end of a tile, which is at most @p span above the bound,
+ * cannot wrap around. This requires a constant bound.
+ */
+static bool is_tile_end_in_range(loop_control_t const *const control,
+                                 long const span)
+{
+	if (!is_Const(control->bound))
+		return false;
+	ir_tarval *const bound   = get_Const_tarval(control->bound);
+	ir_mode   *const mode    = get_tarval_mode(bound);
+	ir_tarval *const span_tv = new_tarval_from_long(span, mode);
+	if (!tarval_is_long(span_tv) || get_tarval_long(span_tv) != span)
+		return false;
+	ir_tarval *const limit = tarval_sub(get_mode_max(mode), span_tv);
+	return tarval_cmp(bound, limit) & ir_relation_less_equal;
+}
+
+/**
+ * Tiles the inner loop: a new loop around the nest runs over the iteration
+ * space of the inner loop in steps of @p tile iterations, and the inner loop
+ * only runs over one tile.
+ */
+static bool tile_inner_loop(nest_t *const nest, long const tile)
+{
+	nest_loop_t          *const outer   = &nest->loops[0];
+	nest_loop_t          *const inner   = &nest->loops[1];
+	loop_control_t const *const control = &inner->control;
+	long                  const span    = tile * get_tarval_long(control->step);
+	if (!is_tile_end_in_range(control, span))
+		return false;
+
+	ir_node **mems = NEW_ARR_F(ir_node*, 0);
+	use_t    *uses = NEW_ARR_F(use_t, 0);
+	get_memory_behind(nest, &mems, &uses);
+	size_t const n_mems = ARR_LEN(mems);
+	if (n_mems == 0) {
+		DEL_ARR_F(uses);
+		DEL_ARR_F(mems);
+		return false;
+	}
+
+	ir_graph *const irg        = get_irn_irg(outer->header);
+	ir_node  *const exit       = get_Block_cfgpred(outer->exit_block,
+	                                               outer->exit_pos);
+	ir_node  *const latch      = new_r_Block(irg, 1, &exit);
+	ir_node  *const entry_in[] = {
+		get_Block_cfgpred(outer->header, outer->entry_pos), new_r_Jmp(latch)
+	};
+	ir_node  *const header     = new_r_Block(irg, ARRAY_SIZE(entry_in),
+	                                         entry_in);
+
+	ir_mode *const mode     = get_irn_mode(inner->phi);
+	ir_node *const dummy    = new_r_Dummy(irg, mode);
+	ir_node *const phi_in[] = { control->init, dummy };
+	ir_node *const start    = new_r_Phi(header, ARRAY_SIZE(phi_in), phi_in,
+	                                    mode);
+	ir_node *const end      = new_r_Add(header, start,
+	                                    new_r_Const_long(irg, mode, span));
+	exchange(dummy, end);
+
+	ir_node *const mem_out  = n_mems == 1 ? mems[0]
+	                        : new_r_Sync(latch, (int)n_mems, mems);
+	ir_node       *mem_in[] = {
+		get_irn_n(outer->mem_phi, outer->entry_pos), mem_out
+	};
+	ir_node *const mem      = new_r_Phi_loop(header, ARRAY_SIZE(mem_in),
+	                                         mem_in);
+	set_irn_n(outer->mem_phi, outer->entry_pos, mem);
+	for (size_t i = 0, n = ARR_LEN(uses); i < n; ++i)
+		set_irn_n(uses[i].user, uses[i].pos, mem);
+	DEL_ARR_F(uses);
+	DEL_ARR_F(mems);
+
+	ir_node *const cmp   = new_r_Cmp(header, start, control->bound,
+	                                 control->relation);
+	ir_node *const cond  = new_r_Cond(header, cmp);
+	ir_node *const enter = new_r_Proj(cond, mode_X, pn_Cond_true);
+	ir_node *const clip  = new_r_Block(irg, 1, &enter);
+	set_Block_cfgpred(outer->exit_block, outer->exit_pos,
+	                  new_r_Proj(cond, mode_X, pn_Cond_false));
+
+	/* the inner loop runs from start up to min(last, bound), which is left to
+	 * if-conversion, as the target may not support Mux */
+	ir_node *last = end;
+	if (control->relation == ir_relation_less_equal)
+		last = new_r_Sub(clip, end, new_r_Const_long(irg, mode, 1));
+	ir_node *const in_bound   = new_r_Cmp(clip, last, control->bound,
+	                                      ir_relation_less);
+	ir_node *const clip_cond  = new_r_Cond(clip, in_bound);
+	ir_node *const join_in[]  = {
+		new_r_Proj(clip_cond, mode_X, pn_Cond_true),
+		new_r_Proj(clip_cond, mode_X, pn_Cond_false),
+	};
+	ir_node *const join       = new_r_Block(irg, ARRAY_SIZE(join_in), join_in);
+	ir_node *const limit_in[] = { last, control->bound };
+	ir_node *const limit      = new_r_Phi(join, ARRAY_SIZE(limit_in),
+	                                      limit_in, mode);
+	set_Block_cfgpred(outer->header, outer->entry_pos, new_r_Jmp(join));
+
+	loop_control_t tiled = *control;
+	tiled.init  = start;
+	tiled.bound = limit;
+	tiled.trip  = tile;
+	set_control(inner, &tiled);
+	return true;
+}
+
+static bool optimize_nest(nest_t *const nest, unsigned const cache_size,
+                          unsigned const cache_line_size)
+{
+	if (!is_permutable(nest))
+		return false;
+
+	/* the loop touching fewer cache lines per iteration becomes the inner
+	 * loop */
+	bool       changed = false;
+	long const bytes0  = get_bytes_per_iteration(nest, 0, cache_line_size);
+	long const bytes1  = get_bytes_per_iteration(nest, 1, cache_line_size);
+	size_t     var     = 1;
+	if (bytes0 < bytes1) {
+		DB((dbg, LEVEL_1, "interchanging loops of %+F and %+F\n",
+		    nest->loops[0].header, nest->loops[1].header));
+		interchange(nest);
+		var     = 0;
+		changed = true;
+	}
+
+	/* tile if the next outer iteration reuses the cache lines of the inner
+	 * loop */
+	bool reuse = false;
+	for (size_t i = 0, n = ARR_LEN(nest->accesses); i < n; ++i) {
+		access_t const *const access = &nest->accesses[i];
+		reuse |= access->c[var] != 0
+		      && labs(access->c[1 - var]) < (long)cache_line_size;
+	}
+	long const            bytes   = var == 0 ? bytes0 : bytes1;
+	loop_control_t const *control = &nest->loops[1].control;
+	if (!reuse || bytes == 0 || nest->loops[0].mem_phi == NULL
+	    || (control->relation != ir_relation_less
+	        && control->relation != ir_relation_less_equal)
+	    || tarval_is_negative(control->step))
+		return changed;
+
+	long size = (long)cache_size / bytes;
+	while (size & (size - 1))
+		size &= size - 1;
+	if (size < 4 || (control->trip >= 0 && control->trip <= size))
+		return changed;
+	if (tile_inner_loop(nest, size)) {
+		DB((dbg, LEVEL_1, "tiling loop of %+F by %ld\n",
+		    nest->loops[1].header, size));
+		changed = true;
+	}
+	return changed;
+}
+
+static void collect_blocks(ir_loop *const loop, ir_node ***const blocks)
+{
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind == k_ir_loop)
+			collect_blocks(element.son, blocks);
+		else if (*element.kind == k_ir_node)
+			ARR_APP1(ir_node*, *blocks, element.node);
+	}
+}
+
+static bool analyze_nest(nest_t *const nest)
+{
+	collect_blocks(nest->loops[0].loop, &nest->blocks);
+	for (size_t i = 0, n = ARR_LEN(nest->blocks); i < n; ++i) {
+		foreach_out_edge(nest->blocks[i], edge) {
+			ir_node *const node = get_edge_src_irn(edge);
+			if (!is_Block(node))
+				ARR_APP1(ir_node*, nest->nodes, node);
+		}
+	}
+
+	return analyze_loop(nest, &nest->loops[0])
+	    && analyze_loop(nest, &nest->loops[1])
+	    && get_irn_mode(nest->loops[0].phi) == get_irn_mode(nest->loops[1].phi)
+	    && analyze_nodes(nest);
+}
+
+/** Returns the only child of @p loop or NULL. */
+static ir_loop *get_only_son(ir_loop const *const loop)
+{
+	ir_loop *son = NULL;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind == k_ir_loop) {
+			if (son != NULL)
+				return NULL;
+			son = element.son;
+		}
+	}
+	return son;
+}
+
+/** Finds innermost loops, whose parent has no other child. */
+static void find_nests(ir_loop *const loop, ir_loop ***const inners)
+{
+	bool had_sons = false;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind == k_ir_loop) {
+			find_nests(element.son, inners);
+			had_sons = true;
+		}
+	}
+	ir_loop *const outer = get_loop_outer_loop(loop);
+	if (!had_sons && get_loop_depth(loop) > 1 && get_only_son(outer) == loop)
+		ARR_APP1(ir_loop*, *inners, loop);
+}
+
+void do_loop_nest_optimization(ir_graph *irg, unsigned cache_size,
+                               unsigned cache_line_size)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.loop_nest");
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
+	                         | IR_GRAPH_PROPERTY_NO_BADS
+	                         | IR_GRAPH_PROPERTY_NO_TUPLES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+
+	ir_loop **inners = NEW_ARR_F(ir_loop*, 0);
+	find_nests(get_irg_loop(irg), &inners);
+
+	bool changed = false;
+	for (size_t i = 0, n = ARR_LEN(inners); i < n; ++i) {
+		nest_t nest = {
+			.loops = {
+				{ .loop = get_loop_outer_loop(inners[i]) },
+				{ .loop = inners[i] },
+			},
+			.blocks   = NEW_ARR_F(ir_node*, 0),
+			.nodes    = NEW_ARR_F(ir_node*, 0),
+			.accesses = NEW_ARR_F(access_t, 0),
+		};
+		if (analyze_nest(&nest))
+			changed |= optimize_nest(&nest, cache_size, cache_line_size);
+		DEL_ARR_F(nest.accesses);
+		DEL_ARR_F(nest.nodes);
+		DEL_ARR_F(nest.blocks);
+	}
+	DEL_ARR_F(inners);
+
+	confirm_irg_properties(irg, changed ? IR_GRAPH_PROPERTIES_NONE
+	                                    : IR_GRAPH_PROPERTIES_ALL);
+	/* uses of the induction variables may now be placed in front of their
+	 * definition */
+	if (changed)
+		place_code(irg);
+}
@@ -24,7 +24,10 @@
 #include "iroptimize.h"
 #include "irnodehashmap.h"
 #include "irmemory.h"
-#include "raw_bitset.h"
+#include "dataflow.h"
+#include "sbitset.h"
+#include "set.h"
+#include "hashptr.h"
 #include "debug.h"
 #include "panic.h"
 #include "type_t.h"
@@ -86,17 +89,26 @@ typedef struct block_t block_t;
 struct block_t {
 	memop_t  *memop_forward;     /**< topologically sorted list of memory ops in this block */
 	memop_t  *memop_backward;    /**< last memop in the list */
-	unsigned *avail_out;         /**< out-set of available addresses */
-	memop_t  **id_2_memop_avail; /**< maps avail address ids to memops */
-	unsigned *anticL_in;         /**< in-set of anticipated Load addresses */
-	memop_t  **id_2_memop_antic; /**< maps anticipated address ids to memops */
+	sbitset_t avail_out;         /**< out-set of available addresses */
+	memop_t  **avail_memops;     /**< memops of avail_out, sorted by address id */
+	sbitset_t anticL_in;         /**< in-set of anticipated Load addresses */
+	memop_t  **antic_memops;     /**< memops of anticL_in, sorted by address id */
 	ir_node  *block;             /**< the associated block */
 	block_t  *forward_next;      /**< next block entry for forward iteration */
 	block_t  *backward_next;     /**< next block entry for backward iteration */
 	memop_t  *avail;             /**< used locally for the avail map */
-	memop_t  **trans_results;    /**< used to cached translated nodes due antic calculation. */
 };
 
+/**
+ * A Phi-translated memop, cached for a block and the address id of the
+ * untranslated memop.
+ */
+typedef struct trans_result_t {
+	block_t const *bl;  /**< the block the memop was translated into */
+	unsigned       id;  /**< the id of the untranslated address */
+	memop_t       *op;  /**< the translated memop */
+} trans_result_t;
+
 /**
  * Metadata for this pass.
  */
@@ -106,8 +118,10 @@ typedef struct ldst_env_t {
 	block_t         *forward;          /**< Inverse post-order list of all blocks Start->End */
 	block_t         *backward;         /**< Inverse post-order list of all blocks End->Start */
 	ir_node         *end_bl;           /**< end block of the current graph */
-	unsigned        *curr_set;         /**< current set of addresses */
+	sbitset_t       *curr_set;         /**< current set of addresses */
+	sbitset_t        tmp_set;          /**< storage for the temporary current set */
 	memop_t         **curr_id_2_memop; /**< current map of address ids to memops */
+	set             *trans_results;    /**< caches translated memops for the antic calculation */
 	unsigned        curr_adr_id;       /**< number for address mapping */
 	unsigned        n_mem_ops;         /**< number of memory operations (Loads/Stores) */
 	size_t          rbs_size;          /**< size of all bitsets in bytes */
@@ -171,7 +185,7 @@ static void dump_curr(block_t *bl, const char *s)
 
 	DB((dbg, LEVEL_2, "%s[%+F] = {", s, bl->block));
 	i = 0;
-	for (pos = rbitset_next(env.curr_set, 0, 1); pos < end; pos = rbitset_next(env.curr_set, pos + 1, 1)) {
+	for (pos = sbitset_next(env.curr_set, 0); pos < end; pos = sbitset_next(env.curr_set, pos + 1)) {
 		memop_t *op = env.curr_id_2_memop[pos];
 
 		if (i == 0) {
@@ -335,15 +349,12 @@ static void prepare_blocks(ir_node *irn, void *ctx)
 
 		entry->memop_forward    = NULL;
 		entry->memop_backward   = NULL;
-		entry->avail_out        = NULL;
-		entry->id_2_memop_avail = NULL;
-		entry->anticL_in        = NULL;
-		entry->id_2_memop_antic = NULL;
+		entry->avail_memops     = NULL;
+		entry->antic_memops     = NULL;
 		entry->block            = irn;
 		entry->forward_next     = NULL;
 		entry->backward_next    = NULL;
 		entry->avail            = NULL;
-		entry->trans_results    = NULL;
 		set_irn_link(irn, entry);
 
 		set_Block_phis(irn, NULL);
@@ -861,7 +872,7 @@ static void collect_memops(ir_node *irn, void *ctx)
  */
 static memop_t *find_address(const value_t *value)
 {
-	if (rbitset_is_set(env.curr_set, value->id)) {
+	if (sbitset_is_set(env.curr_set, value->id)) {
 		memop_t *res = env.curr_id_2_memop[value->id];
 
 		if (res->value.mode == value->mode)
@@ -875,6 +886,72 @@ static memop_t *find_address(const value_t *value)
 	return NULL;
 }
 
+/**
+ * Find the memop of an address in a per-block memop array.
+ *
+ * @param memops  the memops, sorted by address id
+ * @param id      the address id
+ *
+ * @return the memop or NULL if the address is not in the array
+ */
+static memop_t *find_memop(memop_t *const *memops, unsigned id)
+{
+	size_t lo = 0;
+	size_t hi = ARR_LEN(memops);
+
+	while (lo < hi) {
+		size_t   mid    = lo + (hi - lo) / 2;
+		unsigned mid_id = memops[mid]->value.id;
+
+		if (mid_id == id)
+			return memops[mid];
+		if (mid_id < id)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return NULL;
+}
+
+/**
+ * Store the memops of the current set into a per-block memop array.
+ * Only the addresses in the set are stored, so the array is as small as
+ * the set instead of covering every address of the graph.
+ *
+ * @param memops  the memop array of the block
+ */
+static void store_curr_memops(memop_t ***memops)
+{
+	size_t end = env.rbs_size - 1;
+	size_t n   = 0;
+	size_t pos;
+
+	/* the sentinel has no memop */
+	ARR_RESIZE(memop_t*, *memops, sbitset_popcount(env.curr_set) - 1);
+	for (pos = sbitset_next(env.curr_set, 0); pos < end; pos = sbitset_next(env.curr_set, pos + 1)) {
+		memop_t *op = env.curr_id_2_memop[pos];
+
+		assert(op->value.id == pos);
+		(*memops)[n++] = op;
+	}
+}
+
+/**
+ * Load a per-block set and its memops into the current set.
+ *
+ * @param set     the set of the block
+ * @param memops  the memop array of the block
+ */
+static void load_curr_memops(const sbitset_t *set, memop_t *const *memops)
+{
+	sbitset_copy(env.curr_set, set);
+	for (size_t i = 0, n = ARR_LEN(memops); i < n; ++i) {
+		memop_t *op = memops[i];
+
+		env.curr_id_2_memop[op->value.id] = op;
+	}
+}
+
 /**
  * Find an address in the avail_out set.
  *
@@ -882,8 +959,8 @@ static memop_t *find_address(const value_t *value)
  */
 static memop_t *find_address_avail(const block_t *bl, unsigned id, const ir_mode *mode)
 {
-	if (rbitset_is_set(bl->avail_out, id)) {
-		memop_t *res = bl->id_2_memop_avail[id];
+	if (sbitset_is_set(&bl->avail_out, id)) {
+		memop_t *res = find_memop(bl->avail_memops, id);
 
 		if (res->value.mode == mode)
 			return res;
@@ -901,10 +978,10 @@ static memop_t *find_address_avail(const block_t *bl, unsigned id, const ir_mode
  */
 static void kill_all(void)
 {
-	rbitset_clear_all(env.curr_set, env.rbs_size);
+	sbitset_clear_all(env.curr_set);
 
 	/* set sentinel */
-	rbitset_set(env.curr_set, env.rbs_size - 1);
+	sbitset_set(env.curr_set, env.rbs_size - 1);
 }
 
 /**
@@ -917,7 +994,7 @@ static void kill_memops(const value_t *value)
 	size_t end = env.rbs_size - 1;
 	size_t pos;
 
-	for (pos = rbitset_next(env.curr_set, 0, 1); pos < end; pos = rbitset_next(env.curr_set, pos + 1, 1)) {
+	for (pos = sbitset_next(env.curr_set, 0); pos < end; pos = sbitset_next(env.curr_set, pos + 1)) {
 		memop_t *op = env.curr_id_2_memop[pos];
 
 		ir_type *value_type = get_type_for_mode(value->mode);
@@ -929,7 +1006,7 @@ static void kill_memops(const value_t *value)
 
 		if (ir_no_alias != get_alias_relation(value->address, value_type, value_size,
 		                                      op->value.address, op_type, op_size)) {
-			rbitset_clear(env.curr_set, pos);
+			sbitset_clear(env.curr_set, pos);
 			env.curr_id_2_memop[pos] = NULL;
 			DB((dbg, LEVEL_2, "KILLING %+F because of possible alias address %+F\n", op->node, value->address));
 		}
@@ -943,7 +1020,7 @@ static void kill_memops(const value_t *value)
  */
 static void add_memop(memop_t *op)
 {
-	rbitset_set(env.curr_set, op->value.id);
+	sbitset_set(env.curr_set, op->value.id);
 	env.curr_id_2_memop[op->value.id] = op;
 }
 
@@ -955,8 +1032,43 @@ static void add_memop(memop_t *op)
  */
 static void add_memop_avail(block_t *bl, memop_t *op)
 {
-	rbitset_set(bl->avail_out, op->value.id);
-	bl->id_2_memop_avail[op->value.id] = op;
+	unsigned id = op->value.id;
+	size_t   n  = ARR_LEN(bl->avail_memops);
+	size_t   i  = n;
+
+	sbitset_set(&bl->avail_out, id);
+
+	/* keep the memops sorted by address id */
+	while (i > 0 && bl->avail_memops[i - 1]->value.id > id)
+		--i;
+	if (i > 0 && bl->avail_memops[i - 1]->value.id == id) {
+		bl->avail_memops[i - 1] = op;
+		return;
+	}
+	ARR_APP1(memop_t*, bl->avail_memops, op);
+	memmove(&bl->avail_memops[i + 1], &bl->avail_memops[i],
+	        (n - i) * sizeof(*bl->avail_memops));
+	bl->avail_memops[i] = op;
+}
+
+/**
+ * Compare two cached Phi-translation results.
+ */
+static int cmp_trans_result(const void *elt, const void *key, size_t size)
+{
+	const trans_result_t *a = (const trans_result_t*)elt;
+	const trans_result_t *b = (const trans_result_t*)key;
+	(void)size;
+
+	return a->bl != b->bl || a->id != b->id;
+}
+
+/**
+ * Hash a cached Phi-translation result.
+ */
+static unsigned hash_trans_result(const trans_result_t *result)
+{
+	return hash_combine(hash_ptr(result->bl), result->id);
 }
 
 /**
@@ -1115,58 +1227,55 @@ static void calc_gen_kill_avail(block_t *bl)
  */
 static void forward_avail(block_t *bl)
 {
-	/* fill the data from the current block */
-	env.curr_id_2_memop = bl->id_2_memop_avail;
-	env.curr_set        = bl->avail_out;
-
+	/* the avail_out set is computed from the empty set */
+	kill_all();
 	calc_gen_kill_avail(bl);
+
+	sbitset_copy(&bl->avail_out, env.curr_set);
+	store_curr_memops(&bl->avail_memops);
 	dump_curr(bl, "Avail_out");
 }
 
 /**
- * Do backward dataflow analysis on a given block to calculate the antic set
- * of Loaded addresses.
+ * Meet function of the backward dataflow analysis calculating the antic set
+ * of Loaded addresses: computes AnticL_out of a block into the current set.
  *
- * @param bl  the block
- *
- * @return non-zero if the set has changed since last iteration
+ * @param block  the block
+ * @param ctx    unused
  */
-static int backward_antic(block_t *bl)
+static void antic_meet(ir_node *block, void *ctx)
 {
-	memop_t *op;
-	ir_node *block = bl->block;
-	int     n = get_Block_n_cfg_outs(block);
+	block_t *bl = get_block_entry(block);
+	int     n   = get_Block_n_cfg_outs(block);
+	(void)ctx;
 
 	if (n == 1) {
-		int       pred_pos;
-		ir_node  *succ     = get_Block_cfg_out_ex(block, 0, &pred_pos);
-		block_t  *succ_bl  = get_block_entry(succ);
-		size_t    end      = env.rbs_size - 1;
-		size_t    pos;
+		int             pred_pos;
+		ir_node        *succ    = get_Block_cfg_out_ex(block, 0, &pred_pos);
+		block_t        *succ_bl = get_block_entry(succ);
+		memop_t *const *memops  = succ_bl->antic_memops;
 
 		kill_all();
 
-		if (bl->trans_results == NULL) {
-			/* allocate the translate cache */
-			bl->trans_results = OALLOCNZ(&env.obst, memop_t*, env.curr_adr_id);
-		}
-
 		/* check for partly redundant values */
-		for (pos = rbitset_next(succ_bl->anticL_in, 0, 1);
-		     pos < end;
-		     pos = rbitset_next(succ_bl->anticL_in, pos + 1, 1)) {
+		for (size_t m = 0, n_memops = ARR_LEN(memops); m < n_memops; ++m) {
 			/*
 			 * do Phi-translation here: Note that at this point the nodes are
 			 * not changed, so we can safely cache the results.
 			 * However: Loads of Load results ARE bad, because we have no way
 			  to translate them yet ...
 			 */
-			memop_t *op = bl->trans_results[pos];
-			if (op == NULL) {
+			memop_t        *op   = memops[m];
+			trans_result_t  key  = { .bl = bl, .id = op->value.id, .op = NULL };
+			unsigned        hash = hash_trans_result(&key);
+			trans_result_t *res  = set_find(trans_result_t, env.trans_results,
+			                                &key, sizeof(key), hash);
+			if (res != NULL) {
+				op = res->op;
+			} else {
 				/* not yet translated */
 				ir_node *adr, *trans_adr;
 
-				op  = succ_bl->id_2_memop_antic[pos];
 				adr = op->value.address;
 
 				trans_adr = phi_translate(adr, succ, pred_pos);
@@ -1182,27 +1291,28 @@ static int backward_antic(block_t *bl)
 					new_op->node          = op->node; /* we need the node to decide if Load/Store */
 					new_op->flags         = op->flags;
 
-					bl->trans_results[pos] = new_op;
+					key.op = new_op;
+					(void)set_insert(trans_result_t, env.trans_results, &key,
+					                 sizeof(key), hash);
 					op = new_op;
 				}
 			}
 			env.curr_id_2_memop[op->value.id] = op;
-			rbitset_set(env.curr_set, op->value.id);
+			sbitset_set(env.curr_set, op->value.id);
 		}
 	} else if (n > 1) {
 		ir_node *succ    = get_Block_cfg_out(block, 0);
 		block_t *succ_bl = get_block_entry(succ);
 		int i;
 
-		rbitset_copy(env.curr_set, succ_bl->anticL_in, env.rbs_size);
-		MEMCPY(env.curr_id_2_memop, succ_bl->id_2_memop_antic, env.rbs_size);
+		load_curr_memops(&succ_bl->anticL_in, succ_bl->antic_memops);
 
 		/* Hmm: probably we want kill merges of Loads ans Stores here */
 		for (i = n - 1; i > 0; --i) {
 			ir_node *succ    = get_Block_cfg_out(bl->block, i);
 			block_t *succ_bl = get_block_entry(succ);
 
-			rbitset_and(env.curr_set, succ_bl->anticL_in, env.rbs_size);
+			sbitset_and(env.curr_set, &succ_bl->anticL_in);
 		}
 	} else {
 		/* block ends with a noreturn call */
@@ -1210,6 +1320,23 @@ static int backward_antic(block_t *bl)
 	}
 
 	dump_curr(bl, "AnticL_out");
+}
+
+/**
+ * Transfer function of the backward dataflow analysis calculating the antic
+ * set of Loaded addresses: computes AnticL_in of a block from the AnticL_out
+ * in the current set.
+ *
+ * @param block  the block
+ * @param ctx    unused
+ *
+ * @return true if the set has changed since the last visit
+ */
+static bool antic_transfer(ir_node *block, void *ctx)
+{
+	block_t *bl = get_block_entry(block);
+	memop_t *op;
+	(void)ctx;
 
 	for (op = bl->memop_backward; op != NULL; op = op->prev) {
 		switch (get_irn_opcode(op->node)) {
@@ -1237,15 +1364,15 @@ static int backward_antic(block_t *bl)
 		}
 	}
 
-	MEMCPY(bl->id_2_memop_antic, env.curr_id_2_memop, env.rbs_size);
-	if (! rbitsets_equal(bl->anticL_in, env.curr_set, env.rbs_size)) {
+	store_curr_memops(&bl->antic_memops);
+	if (! sbitsets_equal(&bl->anticL_in, env.curr_set)) {
 		/* changed */
-		rbitset_copy(bl->anticL_in, env.curr_set, env.rbs_size);
+		sbitset_copy(&bl->anticL_in, env.curr_set);
 		dump_curr(bl, "AnticL_in*");
-		return 1;
+		return true;
 	}
 	dump_curr(bl, "AnticL_in");
-	return 0;
+	return false;
 }
 
 /**
@@ -1353,9 +1480,7 @@ static void do_replacements(block_t *bl)
  */
 static void calcAvail(void)
 {
-	memop_t  **tmp_memop = env.curr_id_2_memop;
-	unsigned *tmp_set    = env.curr_set;
-	block_t  *bl;
+	block_t *bl;
 
 	/* calculate avail_out */
 	DB((dbg, LEVEL_2, "Calculate Avail_out\n"));
@@ -1364,37 +1489,28 @@ static void calcAvail(void)
 	for (bl = env.forward->forward_next; bl != NULL; bl = bl->forward_next) {
 		forward_avail(bl);
 	}
-
-	/* restore the current sets */
-	env.curr_id_2_memop = tmp_memop;
-	env.curr_set        = tmp_set;
 }
 
 /**
  * Calculate the Antic_in sets for all basic blocks.
+ *
+ * @param irg  the graph
  */
-static void calcAntic(void)
+static void calcAntic(ir_graph *irg)
 {
-	int need_iter;
-
 	/* calculate antic_in */
 	DB((dbg, LEVEL_2, "Calculate Antic_in\n"));
 
-	DEBUG_ONLY(int i = 0;)
-	do {
-		block_t *bl;
-
-		DB((dbg, LEVEL_2, "Iteration %d:\n=========\n", i));
-
-		need_iter = 0;
-
-		/* over all blocks in reverse post order */
-		for (bl = env.backward->backward_next; bl != NULL; bl = bl->backward_next) {
-			need_iter |= backward_antic(bl);
-		}
-		DEBUG_ONLY(++i;)
-	} while (need_iter);
-	DB((dbg, LEVEL_2, "Get anticipated Load set after %d iterations\n", i));
+	dataflow_problem_t const problem = {
+		.direction  = DATAFLOW_BACKWARD,
+		.meet       = antic_meet,
+		.transfer   = antic_transfer,
+		.max_visits = 0,
+		.data       = NULL,
+	};
+	unsigned n_visits = dataflow_solve(irg, &problem);
+	DB((dbg, LEVEL_2, "Get anticipated Load set after %u block visits\n", n_visits));
+	(void)n_visits;
 }
 
 /**
@@ -1430,7 +1546,7 @@ static void reroute_all_mem_users(ir_node *omem, ir_node *nmem)
 	}
 
 	/* all edges previously point to omem now point to nmem */
-	nmem->o.out = omem->o.out;
+	set_irn_def_use_edges(nmem, get_irn_def_use_edges(omem));
 }
 
 /**
@@ -1471,30 +1587,35 @@ static void reroute_mem_through(ir_node *omem, ir_node *nmem, ir_node *pass_bl)
 	   temporary obstack here. This should be no problem, as we invalidate the
 	   edges at the end either. */
 	/* first entry is used for the length */
-	nmem->o.out = new_out;
+	set_irn_def_use_edges(nmem, new_out);
 }
 
 /**
- * insert Loads, making partly redundant Loads fully redundant
+ * Meet function of the Load insertion: joins the avail_out sets of all
+ * predecessors into the current set, building Phis where necessary.
+ *
+ * @param block  the block
+ * @param ctx    unused
  */
-static int insert_Load(block_t *bl)
+static void insert_Load_meet(ir_node *block, void *ctx)
 {
-	ir_node  *block = bl->block;
+	block_t  *bl = get_block_entry(block);
 	int      i, n = get_Block_n_cfgpreds(block);
-	size_t   end = env.rbs_size - 1;
+	(void)ctx;
 
 	DB((dbg, LEVEL_3, "processing %+F\n", block));
 
 	if (n == 0) {
 		/* might still happen for an unreachable block (end for instance) */
-		return 0;
+		return;
 	}
 
 	if (n > 1) {
 		ir_node **ins = ALLOCAN(ir_node*, n);
+		size_t    end = env.rbs_size - 1;
 		size_t    pos;
 
-		rbitset_set_all(env.curr_set, env.rbs_size);
+		sbitset_set_all(env.curr_set);
 
 		/* More than one predecessors, calculate the join for all avail_outs ignoring unevaluated
 		   Blocks. These put in Top anyway. */
@@ -1504,68 +1625,64 @@ static int insert_Load(block_t *bl)
 			block_t *pred_bl;
 
 			pred_bl = get_block_entry(blk);
-			rbitset_and(env.curr_set, pred_bl->avail_out, env.rbs_size);
+			sbitset_and(env.curr_set, &pred_bl->avail_out);
 
 			if (is_Load(pred) || is_Store(pred)) {
 				/* We reached this block by an exception from a Load or Store:
 				 * the memop creating the exception was NOT completed than, kill it
 				 */
 				memop_t *exc_op = get_irn_memop(pred);
-				rbitset_clear(env.curr_set, exc_op->value.id);
+				sbitset_clear(env.curr_set, exc_op->value.id);
 			}
 
 		}
 		/*
 		 * Ensure that all values are in the map: build Phi's if necessary:
-		 * Note: the last bit is the sentinel and ALWAYS set, so end with -2.
+		 * Note: the last bit is the sentinel and ALWAYS set.
 		 */
-		for (pos = 0; pos < env.rbs_size - 1; ++pos) {
-			if (!rbitset_is_set(env.curr_set, pos)) {
-				env.curr_id_2_memop[pos] = NULL;
-			} else {
-				int      need_phi = 0;
-				memop_t *first    = NULL;
-				ir_mode *mode     = NULL;
+		for (pos = sbitset_next(env.curr_set, 0); pos < end; pos = sbitset_next(env.curr_set, pos + 1)) {
+			int      need_phi = 0;
+			memop_t *first    = NULL;
+			ir_mode *mode     = NULL;
 
-				for (i = 0; i < n; ++i) {
-					ir_node *pred    = get_Block_cfgpred_block(bl->block, i);
-					block_t *pred_bl = get_block_entry(pred);
+			for (i = 0; i < n; ++i) {
+				ir_node *pred    = get_Block_cfgpred_block(bl->block, i);
+				block_t *pred_bl = get_block_entry(pred);
+
+				memop_t *mop = find_memop(pred_bl->avail_memops, pos);
+				if (first == NULL) {
+					first = mop;
+					ins[0] = first->value.value;
+					mode = get_irn_mode(ins[0]);
 
-					memop_t *mop = pred_bl->id_2_memop_avail[pos];
-					if (first == NULL) {
-						first = mop;
-						ins[0] = first->value.value;
-						mode = get_irn_mode(ins[0]);
-
-						/* no Phi needed so far */
-						env.curr_id_2_memop[pos] = first;
-					} else {
-						ins[i] = conv_to(mop->value.value, mode);
-						if (ins[i] != ins[0]) {
-							if (ins[i] == NULL) {
-								/* conversion failed */
-								env.curr_id_2_memop[pos] = NULL;
-								rbitset_clear(env.curr_set, pos);
-								break;
-							}
-							need_phi = 1;
+					/* no Phi needed so far */
+					env.curr_id_2_memop[pos] = first;
+				} else {
+					ins[i] = conv_to(mop->value.value, mode);
+					if (ins[i] != ins[0]) {
+						if (ins[i] == NULL) {
+							/* conversion failed */
+							env.curr_id_2_memop[pos] = NULL;
+							sbitset_clear(env.curr_set, pos);
+							break;
 						}
+						need_phi = 1;
 					}
 				}
-				if (need_phi) {
-					/* build a Phi  */
-					ir_node *phi = new_r_Phi(bl->block, n, ins, mode);
-					memop_t *phiop = alloc_memop(phi);
+			}
+			if (need_phi) {
+				/* build a Phi  */
+				ir_node *phi = new_r_Phi(bl->block, n, ins, mode);
+				memop_t *phiop = alloc_memop(phi);
 
-					phiop->value = first->value;
-					phiop->value.value = phi;
+				phiop->value = first->value;
+				phiop->value.value = phi;
 
-					/* no need to link it in, as it is a DATA phi */
+				/* no need to link it in, as it is a DATA phi */
 
-					env.curr_id_2_memop[pos] = phiop;
+				env.curr_id_2_memop[pos] = phiop;
 
-					DB((dbg, LEVEL_3, "Created new %+F on merging value for address %+F\n", phi, first->value.address));
-				}
+				DB((dbg, LEVEL_3, "Created new %+F on merging value for address %+F\n", phi, first->value.address));
 			}
 		}
 	} else {
@@ -1573,23 +1690,38 @@ static int insert_Load(block_t *bl)
 		ir_node *pred    = get_Block_cfgpred_block(bl->block, 0);
 		block_t *pred_bl = get_block_entry(pred);
 
-		rbitset_copy(env.curr_set, pred_bl->avail_out, env.rbs_size);
-
-		MEMCPY(env.curr_id_2_memop, pred_bl->id_2_memop_avail, env.rbs_size);
+		load_curr_memops(&pred_bl->avail_out, pred_bl->avail_memops);
 	}
+}
+
+/**
+ * Transfer function of the Load insertion: insert Loads, making partly
+ * redundant Loads fully redundant and recalculate the avail_out set.
+ *
+ * @param block  the block
+ * @param ctx    unused
+ *
+ * @return true if the avail_out set has changed since the last visit
+ */
+static bool insert_Load_transfer(ir_node *block, void *ctx)
+{
+	block_t  *bl = get_block_entry(block);
+	int      i, n = get_Block_n_cfgpreds(block);
+	(void)ctx;
+
+	if (n == 0)
+		return false;
 
 	if (n > 1) {
-		size_t pos;
+		memop_t *const *memops = bl->antic_memops;
 
 		/* check for partly redundant values */
-		for (pos = rbitset_next(bl->anticL_in, 0, 1);
-		     pos < end;
-		     pos = rbitset_next(bl->anticL_in, pos + 1, 1)) {
-			memop_t *op = bl->id_2_memop_antic[pos];
+		for (size_t m = 0, n_memops = ARR_LEN(memops); m < n_memops; ++m) {
+			memop_t *op = memops[m];
 			int     have_some, all_same;
 			ir_node *first;
 
-			if (rbitset_is_set(env.curr_set, pos)) {
+			if (sbitset_is_set(env.curr_set, op->value.id)) {
 				/* already avail */
 				continue;
 			}
@@ -1710,43 +1842,38 @@ static int insert_Load(block_t *bl)
 	calc_gen_kill_avail(bl);
 
 	/* always update the map after gen/kill, as values might have been changed due to RAR/WAR/WAW */
-	MEMCPY(bl->id_2_memop_avail, env.curr_id_2_memop, env.rbs_size);
+	store_curr_memops(&bl->avail_memops);
 
-	if (!rbitsets_equal(bl->avail_out, env.curr_set, env.rbs_size)) {
+	if (!sbitsets_equal(&bl->avail_out, env.curr_set)) {
 		/* the avail set has changed */
-		rbitset_copy(bl->avail_out, env.curr_set, env.rbs_size);
+		sbitset_copy(&bl->avail_out, env.curr_set);
 		dump_curr(bl, "Avail_out*");
-		return 1;
+		return true;
 	}
 	dump_curr(bl, "Avail_out");
-	return 0;
+	return false;
 }
 
 /**
  * Insert Loads upwards.
+ *
+ * @param irg  the graph
  */
-static void insert_Loads_upwards(void)
+static void insert_Loads_upwards(ir_graph *irg)
 {
-	int      need_iter;
-	block_t *bl;
-
 	/* recalculate antic_in and insert Loads */
 	DB((dbg, LEVEL_2, "Inserting Loads\n"));
 
-	DEBUG_ONLY(int i = 0;)
-	do {
-		DB((dbg, LEVEL_2, "Iteration %d:\n=========\n", i));
-
-		need_iter = 0;
-
-		/* over all blocks in reverse post order, skip the start block */
-		for (bl = env.forward->forward_next; bl != NULL; bl = bl->forward_next) {
-			need_iter |= insert_Load(bl);
-		}
-		DEBUG_ONLY(++i;)
-	} while (need_iter);
-
-	DB((dbg, LEVEL_2, "Finished Load inserting after %d iterations\n", i));
+	dataflow_problem_t const problem = {
+		.direction  = DATAFLOW_FORWARD,
+		.meet       = insert_Load_meet,
+		.transfer   = insert_Load_transfer,
+		.max_visits = 0,
+		.data       = NULL,
+	};
+	unsigned n_visits = dataflow_solve(irg, &problem);
+	DB((dbg, LEVEL_2, "Finished Load inserting after %u block visits\n", n_visits));
+	(void)n_visits;
 }
 
 void opt_ldst(ir_graph *irg)
@@ -1761,6 +1888,7 @@ void opt_ldst(ir_graph *irg)
 		IR_GRAPH_PROPERTY_NO_CRITICAL_EDGES /* we need landing pads */
 		| IR_GRAPH_PROPERTY_CONSISTENT_ENTITY_USAGE
 		| IR_GRAPH_PROPERTY_CONSISTENT_OUTS
+		| IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
 		| IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
 		| IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE);
 
@@ -1784,7 +1912,7 @@ void opt_ldst(ir_graph *irg)
 	env.id_2_address  = NEW_ARR_F(ir_node *, 0);
 #endif
 
-	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_BLOCK_MARK);
+	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_BLOCK_MARK | IR_RESOURCE_PHI_LIST);
 
 	/* first step: allocate block entries. Note that some blocks might be
 	   unreachable here. Using the normal walk ensures that ALL blocks are initialized. */
@@ -1837,30 +1965,44 @@ void opt_ldst(ir_graph *irg)
 	   needed for the sentinel */
 	env.rbs_size = env.curr_adr_id + 1;
 
-	/* create the current set */
-	env.curr_set = rbitset_obstack_alloc(&env.obst, env.rbs_size);
-	rbitset_set(env.curr_set, env.rbs_size - 1);
+	/* create the current set and map, the only ones covering all addresses;
+	   the per-block sets are sparse bitsets and the per-block memops only
+	   hold the addresses in the sets, as most blocks only see a few of the
+	   addresses of the whole graph */
+	env.curr_set = &env.tmp_set;
+	sbitset_init(env.curr_set, env.rbs_size);
+	sbitset_set(env.curr_set, env.rbs_size - 1);
 	env.curr_id_2_memop = NEW_ARR_DZ(memop_t*, &env.obst, env.rbs_size);
+	env.trans_results   = new_set(cmp_trans_result, 16);
 
 	for (bl = env.forward; bl != NULL; bl = bl->forward_next) {
 		/* set sentinel bits */
-		bl->avail_out  = rbitset_obstack_alloc(&env.obst, env.rbs_size);
-		rbitset_set(bl->avail_out, env.rbs_size - 1);
+		sbitset_init(&bl->avail_out, env.rbs_size);
+		sbitset_set(&bl->avail_out, env.rbs_size - 1);
 
-		bl->id_2_memop_avail = NEW_ARR_DZ(memop_t*, &env.obst, env.rbs_size);
+		bl->avail_memops = NEW_ARR_F(memop_t*, 0);
 
-		bl->anticL_in  = rbitset_obstack_alloc(&env.obst, env.rbs_size);
-		rbitset_set(bl->anticL_in, env.rbs_size - 1);
+		sbitset_init(&bl->anticL_in, env.rbs_size);
+		sbitset_set(&bl->anticL_in, env.rbs_size - 1);
 
-		bl->id_2_memop_antic = NEW_ARR_DZ(memop_t*, &env.obst, env.rbs_size);
+		bl->antic_memops = NEW_ARR_F(memop_t*, 0);
 	}
 
 	(void)dump_block_list;
 
 	calcAvail();
-	calcAntic();
+	calcAntic(irg);
 
-	insert_Loads_upwards();
+	insert_Loads_upwards(irg);
+
+	for (bl = env.forward; bl != NULL; bl = bl->forward_next) {
+		sbitset_free(&bl->avail_out);
+		DEL_ARR_F(bl->avail_memops);
+		sbitset_free(&bl->anticL_in);
+		DEL_ARR_F(bl->antic_memops);
+	}
+	sbitset_free(&env.tmp_set);
+	del_set(env.trans_results);
 
 	if (env.changed) {
 		/* over all blocks in reverse post order */
@@ -1876,7 +2018,7 @@ no_changes:
 		confirm_irg_properties(irg, IR_GRAPH_PROPERTIES_ALL);
 	}
 
-	ir_free_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_BLOCK_MARK);
+	ir_free_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_BLOCK_MARK | IR_RESOURCE_PHI_LIST);
 	ir_nodehashmap_destroy(&env.adr_map);
 	obstack_free(&env.obst, NULL);
 
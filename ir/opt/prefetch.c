@@ -0,0 +1,283 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Software prefetching for strided Loads in loops.
+ *
+ * The address of a Load in a loop is written as a sum of loop invariant
+ * values, induction variables times constant factors and a constant offset.
+ * If the induction variables move the address by a constant stride per
+ * iteration, a prefetch builtin for the address accessed a given number of
+ * iterations later is inserted in front of the Load.  Loads whose addresses
+ * only differ by a constant within one cache line share a prefetch.
+ *
+ * The prefetch is threaded into the memory chain in front of the Load, so the
+ * pass should run after the other memory optimizations.
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "array.h"
+#include "debug.h"
+#include "ircons.h"
+#include "irgwalk.h"
+#include "irloop_t.h"
+#include "irnode_t.h"
+#include "iroptimize.h"
+#include "tv.h"
+#include "util.h"
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/** The number of distinct summands allowed in an address. */
+#define MAX_TERMS 4
+
+/** A loop invariant value or an induction variable times a factor. */
+typedef struct term_t {
+	ir_node *node;
+	long     factor;
+} term_t;
+
+/** An address in the form terms + offset, which moves by stride bytes per
+ * iteration of its loop. */
+typedef struct address_t {
+	ir_node *load;
+	ir_loop *loop;
+	term_t   terms[MAX_TERMS];
+	unsigned n_terms;
+	long     offset;
+	long     stride;
+	bool     prefetched;
+} address_t;
+
+static bool is_in_loop(ir_node const *const node, ir_loop const *const loop)
+{
+	ir_node const *const block = is_Block(node) ? node : get_nodes_block(node);
+	for (ir_loop *l = get_irn_loop(block); l != NULL;
+	     l = get_loop_outer_loop(l)) {
+		if (l == loop)
+			return true;
+		if (get_loop_depth(l) == 0)
+			break;
+	}
+	return false;
+}
+
+/**
+ * Checks whether @p phi is an induction variable of @p loop, which is
+ * advanced by the same constant on every back edge, and returns the constant
+ * in @p step.
+ */
+static bool get_iv_step(ir_node *const phi, ir_loop const *const loop,
+                        long *const step)
+{
+	ir_mode *const mode = get_irn_mode(phi);
+	if (!mode_is_int(mode) && !mode_is_reference(mode))
+		return false;
+
+	ir_node *const block     = get_nodes_block(phi);
+	bool           has_entry = false;
+	bool           has_back  = false;
+	foreach_irn_in(phi, i, pred) {
+		if (!is_in_loop(get_Block_cfgpred_block(block, i), loop)) {
+			if (is_in_loop(pred, loop))
+				return false;
+			has_entry = true;
+			continue;
+		}
+
+		if (!is_Add(pred) && !is_Sub(pred))
+			return false;
+		ir_node *const left  = get_binop_left(pred);
+		ir_node *const right = get_binop_right(pred);
+		ir_node *value;
+		if (left == phi && is_Const(right))
+			value = right;
+		else if (is_Add(pred) && right == phi && is_Const(left))
+			value = left;
+		else
+			return false;
+		ir_tarval *const tv = get_Const_tarval(value);
+		if (!tarval_is_long(tv))
+			return false;
+		long const pred_step = is_Sub(pred) ? -get_tarval_long(tv)
+		                                    : get_tarval_long(tv);
+		if (has_back && pred_step != *step)
+			return false;
+		*step    = pred_step;
+		has_back = true;
+	}
+	return has_entry && has_back;
+}
+
+static bool add_term(address_t *const address, ir_node *const node,
+                     long const factor)
+{
+	for (unsigned i = 0; i < address->n_terms; ++i) {
+		if (address->terms[i].node == node) {
+			address->terms[i].factor += factor;
+			return true;
+		}
+	}
+	if (address->n_terms == MAX_TERMS)
+		return false;
+	address->terms[address->n_terms++] = (term_t){ node, factor };
+	return true;
+}
+
+/** Adds @p factor times @p node to @p address. */
+static bool linearize(address_t *const address, ir_node *const node,
+                      long const factor)
+{
+	if (is_Const(node)) {
+		ir_tarval *const tv = get_Const_tarval(node);
+		if (!tarval_is_long(tv))
+			return false;
+		address->offset += factor * get_tarval_long(tv);
+		return true;
+	}
+	if (!is_in_loop(node, address->loop))
+		return add_term(address, node, factor);
+
+	switch (get_irn_opcode(node)) {
+	case iro_Add:
+		return linearize(address, get_Add_left(node), factor)
+		    && linearize(address, get_Add_right(node), factor);
+	case iro_Sub:
+		return linearize(address, get_Sub_left(node), factor)
+		    && linearize(address, get_Sub_right(node), -factor);
+	case iro_Mul: {
+		ir_node *const right = get_Mul_right(node);
+		if (!is_Const(right) || !tarval_is_long(get_Const_tarval(right)))
+			return false;
+		long const c = get_tarval_long(get_Const_tarval(right));
+		return linearize(address, get_Mul_left(node), factor * c);
+	}
+	case iro_Shl: {
+		ir_node *const right = get_Shl_right(node);
+		if (!is_Const(right) || !tarval_is_long(get_Const_tarval(right)))
+			return false;
+		long const c = get_tarval_long(get_Const_tarval(right));
+		if (c < 0 || c >= 16)
+			return false;
+		return linearize(address, get_Shl_left(node), factor << c);
+	}
+	case iro_Conv: {
+		ir_mode *const mode = get_irn_mode(get_Conv_op(node));
+		if (!mode_is_int(mode) && !mode_is_reference(mode))
+			return false;
+		return linearize(address, get_Conv_op(node), factor);
+	}
+	case iro_Phi: {
+		long step = 0;
+		if (!get_iv_step(node, address->loop, &step))
+			return false;
+		address->stride += factor * step;
+		return add_term(address, node, factor);
+	}
+	default:
+		return false;
+	}
+}
+
+static bool has_same_terms(address_t const *const a, address_t const *const b)
+{
+	if (a->n_terms != b->n_terms)
+		return false;
+	for (unsigned i = 0; i < a->n_terms; ++i) {
+		bool found = false;
+		for (unsigned j = 0; j < b->n_terms; ++j) {
+			if (a->terms[i].node == b->terms[j].node) {
+				found = a->terms[i].factor == b->terms[j].factor;
+				break;
+			}
+		}
+		if (!found)
+			return false;
+	}
+	return true;
+}
+
+static void collect_loads(ir_node *node, void *env)
+{
+	if (!is_Load(node) || get_Load_volatility(node) == volatility_is_volatile)
+		return;
+	ir_loop *const loop = get_irn_loop(get_nodes_block(node));
+	if (loop == NULL || get_loop_depth(loop) == 0)
+		return;
+
+	address_t address = { .load = node, .loop = loop };
+	if (!linearize(&address, get_Load_ptr(node), 1) || address.stride == 0)
+		return;
+	address_t **const addresses = (address_t**)env;
+	ARR_APP1(address_t, *addresses, address);
+}
+
+/** Returns whether a prefetch for an earlier address covers @p address. */
+static bool is_covered(address_t const *const addresses, size_t const n,
+                       unsigned const cache_line_size)
+{
+	address_t const *const address = &addresses[n];
+	for (size_t i = 0; i < n; ++i) {
+		address_t const *const other = &addresses[i];
+		if (other->prefetched && other->loop == address->loop
+		    && other->stride == address->stride
+		    && has_same_terms(other, address)
+		    && labs(other->offset - address->offset) < (long)cache_line_size)
+			return true;
+	}
+	return false;
+}
+
+static void insert_prefetch(ir_node *const load, long const delta)
+{
+	ir_graph *const irg   = get_irn_irg(load);
+	ir_node  *const block = get_nodes_block(load);
+	ir_node  *const ptr   = get_Load_ptr(load);
+	ir_mode  *const mode  = get_reference_offset_mode(get_irn_mode(ptr));
+	ir_node  *const addr  = new_r_Add(block, ptr,
+	                                  new_r_Const_long(irg, mode, delta));
+
+	/* read access, keep the data in all cache levels */
+	ir_node *const in[] = {
+		addr,
+		new_r_Const_long(irg, mode_Is, 0),
+		new_r_Const_long(irg, mode_Is, 3),
+	};
+	ir_node *const mem      = get_Load_mem(load);
+	ir_node *const prefetch = new_r_Builtin(block, mem, ARRAY_SIZE(in), in,
+	                                        ir_bk_prefetch,
+	                                        get_unknown_type());
+	set_Load_mem(load, new_r_Proj(prefetch, mode_M, pn_Builtin_M));
+	DB((dbg, LEVEL_2, "prefetching %+F by %ld bytes ahead\n", load, delta));
+}
+
+void opt_prefetch(ir_graph *irg, unsigned distance, unsigned cache_line_size)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.prefetch");
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
+	                         | IR_GRAPH_PROPERTY_NO_BADS
+	                         | IR_GRAPH_PROPERTY_NO_TUPLES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+
+	/* analyze all Loads before the graph changes */
+	address_t *addresses = NEW_ARR_F(address_t, 0);
+	irg_walk_graph(irg, NULL, collect_loads, &addresses);
+
+	bool changed = false;
+	for (size_t i = 0, n = ARR_LEN(addresses); i < n; ++i) {
+		if (is_covered(addresses, i, cache_line_size))
+			continue;
+		address_t *const address = &addresses[i];
+		insert_prefetch(address->load, address->stride * (long)distance);
+		address->prefetched = true;
+		changed             = true;
+	}
+	DEL_ARR_F(addresses);
+
+	confirm_irg_properties(irg, changed ? IR_GRAPH_PROPERTIES_CONTROL_FLOW
+	                                    : IR_GRAPH_PROPERTIES_ALL);
+}
@@ -0,0 +1,571 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Elimination of redundant range checks.
+ *
+ * A compare-and-branch is decided if the relations known at its block already
+ * determine its outcome.  Known relations come from the conditions of
+ * dominating branches, from Confirm nodes on the operands, from the lower
+ * bound of counted loop induction variables and from value range
+ * propagation.  Relations of two values with a common third one are chained,
+ * so a check i < len below the loop test i < n is decided by a dominating
+ * n <= len.
+ *
+ * A check of the induction variable of a counted loop against a loop
+ * invariant value, which cannot be decided, gets a loop invariant guard,
+ * which implies it for all iterations.  Loop unswitching moves the guard in
+ * front of the loop, so the copy entered if the guard holds runs without the
+ * check.
+ */
+#include <stdbool.h>
+
+#include "array.h"
+#include "debug.h"
+#include "ircons.h"
+#include "irdom.h"
+#include "iredges_t.h"
+#include "irgwalk.h"
+#include "irloop_t.h"
+#include "irnode_t.h"
+#include "iroptimize.h"
+#include "tv.h"
+#include "vrp.h"
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/** The relation between two values known at some block. */
+typedef struct fact_t {
+	ir_node    *left;
+	ir_node    *right;
+	ir_relation relation;
+} fact_t;
+
+/** A counted loop, whose induction variable phi starts at init and is
+ * incremented by one until phi relation bound fails. */
+typedef struct loop_iv_t {
+	ir_loop    *loop;
+	ir_node    *preheader; /**< the block of the only loop entry edge */
+	ir_node    *body;      /**< the block entered if the loop continues */
+	ir_node    *phi;
+	ir_node    *init;
+	ir_node    *bound;
+	ir_relation relation;  /**< less or less_equal */
+	ir_node    *guard;     /**< the conjunction of the guards in the loop */
+} loop_iv_t;
+
+/** A check, which is skipped if the guard of its loop holds. */
+typedef struct guarded_check_t {
+	ir_node   *cond;
+	bool       taken;      /**< the outcome implied by the guard */
+	loop_iv_t *iv;
+} guarded_check_t;
+
+typedef struct guard_env_t {
+	loop_iv_t       *ivs;
+	guarded_check_t *checks;
+} guard_env_t;
+
+static bool is_in_loop(ir_node const *const node, ir_loop const *const loop)
+{
+	ir_node const *const block = is_Block(node) ? node : get_nodes_block(node);
+	for (ir_loop *l = get_irn_loop(block); l != NULL;
+	     l = get_loop_outer_loop(l)) {
+		if (l == loop)
+			return true;
+		if (get_loop_depth(l) == 0)
+			break;
+	}
+	return false;
+}
+
+/** Returns the only control flow predecessor of @p block, which is not a
+ * back edge, or NULL. */
+static ir_node *get_entry_pred(ir_node *const block)
+{
+	ir_node *entry = NULL;
+	for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+		if (block_dominates(block, get_Block_cfgpred_block(block, i)))
+			continue;
+		if (entry != NULL)
+			return NULL;
+		entry = get_Block_cfgpred(block, i);
+	}
+	return entry;
+}
+
+static ir_relation get_cmp_relation(ir_node const *const cmp)
+{
+	return get_Cmp_relation(cmp) & ir_relation_less_equal_greater;
+}
+
+/** Negates @p relation of two integer values. */
+static ir_relation negate(ir_relation const relation)
+{
+	return get_negated_relation(relation) & ir_relation_less_equal_greater;
+}
+
+static ir_node *get_succ_block(ir_node const *const proj)
+{
+	if (get_irn_n_edges(proj) != 1)
+		return NULL;
+	return get_edge_src_irn(get_irn_out_edge_first(proj));
+}
+
+static bool is_increment(ir_node const *const node, ir_node const *const phi)
+{
+	if (!is_Add(node))
+		return false;
+	ir_node const *const left  = get_Add_left(node);
+	ir_node const *const right = get_Add_right(node);
+	ir_node const *const step  = left == phi ? right : right == phi ? left : NULL;
+	return step != NULL && is_Const(step) && is_Const_one(step);
+}
+
+/** Recognizes a loop, whose header tests phi < bound or phi <= bound. */
+static bool analyze_loop(ir_loop *const loop, loop_iv_t *const iv)
+{
+	ir_node *header    = NULL;
+	int      entry_pos = -1;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind != k_ir_node)
+			continue;
+		ir_node *const block = element.node;
+		for (int p = 0, arity = get_Block_n_cfgpreds(block); p < arity; ++p) {
+			if (is_in_loop(get_Block_cfgpred_block(block, p), loop))
+				continue;
+			if (header != NULL)
+				return false;
+			header    = block;
+			entry_pos = p;
+		}
+	}
+	if (header == NULL)
+		return false;
+
+	ir_node *cond = NULL;
+	foreach_out_edge(header, edge) {
+		ir_node *const node = get_edge_src_irn(edge);
+		if (is_Cond(node))
+			cond = node;
+	}
+	if (cond == NULL || !is_Cmp(get_Cond_selector(cond)))
+		return false;
+
+	ir_node *body  = NULL;
+	bool     taken = false;
+	foreach_out_edge(cond, edge) {
+		ir_node *const proj = get_edge_src_irn(edge);
+		ir_node *const succ = get_succ_block(proj);
+		if (succ == NULL)
+			return false;
+		if (!is_in_loop(succ, loop))
+			continue;
+		if (body != NULL || get_Block_n_cfgpreds(succ) != 1)
+			return false;
+		body  = succ;
+		taken = get_Proj_num(proj) == pn_Cond_true;
+	}
+	if (body == NULL || get_irn_n_edges(cond) != 2)
+		return false;
+
+	ir_node    *const cmp      = get_Cond_selector(cond);
+	ir_relation       relation = get_cmp_relation(cmp);
+	ir_node          *phi      = get_Cmp_left(cmp);
+	ir_node          *bound    = get_Cmp_right(cmp);
+	if (!is_Phi(phi) || get_nodes_block(phi) != header) {
+		ir_node *const tmp = phi;
+		phi      = bound;
+		bound    = tmp;
+		relation = get_inversed_relation(relation);
+	}
+	if (!taken)
+		relation = negate(relation);
+	if (!is_Phi(phi) || get_nodes_block(phi) != header
+	    || !mode_is_int(get_irn_mode(phi)) || is_in_loop(bound, loop))
+		return false;
+	/* the increment must not wrap around */
+	if (relation == ir_relation_less_equal) {
+		if (!is_Const(bound)
+		    || get_Const_tarval(bound) == get_mode_max(get_irn_mode(bound)))
+			return false;
+	} else if (relation != ir_relation_less) {
+		return false;
+	}
+
+	foreach_irn_in(phi, i, pred) {
+		if (i == entry_pos)
+			continue;
+		if (!is_increment(pred, phi))
+			return false;
+	}
+
+	*iv = (loop_iv_t){
+		.loop      = loop,
+		.preheader = get_Block_cfgpred_block(header, entry_pos),
+		.body      = body,
+		.phi       = phi,
+		.init      = get_irn_n(phi, entry_pos),
+		.bound     = bound,
+		.relation  = relation,
+	};
+	return !is_in_loop(iv->init, loop);
+}
+
+static void find_loops(ir_loop *const loop, loop_iv_t **const ivs)
+{
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind != k_ir_loop)
+			continue;
+		loop_iv_t iv;
+		if (analyze_loop(element.son, &iv))
+			ARR_APP1(loop_iv_t, *ivs, iv);
+		find_loops(element.son, ivs);
+	}
+}
+
+static void add_fact(fact_t **const facts, ir_node *const left,
+                     ir_node *const right, ir_relation const relation)
+{
+	fact_t const fact = {
+		skip_Confirm(left), skip_Confirm(right),
+		relation & ir_relation_less_equal_greater
+	};
+	ARR_APP1(fact_t, *facts, fact);
+}
+
+static void add_confirm_facts(fact_t **const facts, ir_node *node)
+{
+	for (; is_Confirm(node); node = get_Confirm_value(node)) {
+		add_fact(facts, node, get_Confirm_bound(node),
+		         get_Confirm_relation(node));
+	}
+}
+
+/** Returns the relations between @p left and @p right allowed by a single
+ * fact. */
+static ir_relation get_direct_relation(fact_t const *const facts,
+                                       ir_node *const left,
+                                       ir_node *const right)
+{
+	if (left == right)
+		return ir_relation_equal;
+	if (is_Const(left) && is_Const(right))
+		return tarval_cmp(get_Const_tarval(left), get_Const_tarval(right));
+
+	ir_relation possible = ir_relation_less_equal_greater;
+	for (size_t i = 0, n = ARR_LEN(facts); i < n; ++i) {
+		fact_t const *const fact = &facts[i];
+		if (fact->left == left && fact->right == right)
+			possible &= fact->relation;
+		else if (fact->left == right && fact->right == left)
+			possible &= get_inversed_relation(fact->relation);
+	}
+	return possible;
+}
+
+/** Combines a relation a ? b with a relation b ? c into one for a ? c. */
+static ir_relation chain_relations(ir_relation const ab, ir_relation const bc)
+{
+	if (ab == ir_relation_false || bc == ir_relation_false)
+		return ir_relation_less_equal_greater;
+	if (ab == ir_relation_equal)
+		return bc;
+	if (bc == ir_relation_equal)
+		return ab;
+	if ((ab | bc) == ir_relation_less_equal || (ab | bc) == ir_relation_less)
+		return ab == ir_relation_less || bc == ir_relation_less
+		     ? ir_relation_less : ir_relation_less_equal;
+	if ((ab | bc) == ir_relation_greater_equal
+	    || (ab | bc) == ir_relation_greater)
+		return ab == ir_relation_greater || bc == ir_relation_greater
+		     ? ir_relation_greater : ir_relation_greater_equal;
+	return ir_relation_less_equal_greater;
+}
+
+static ir_relation get_possible_relations(fact_t const *const facts,
+                                          ir_node *const left,
+                                          ir_node *const right)
+{
+	ir_relation possible = vrp_cmp(left, right)
+	                     & get_direct_relation(facts, skip_Confirm(left),
+	                                           skip_Confirm(right));
+	ir_node *const l = skip_Confirm(left);
+	ir_node *const r = skip_Confirm(right);
+	for (size_t i = 0, n = ARR_LEN(facts); i < n; ++i) {
+		ir_node *const ends[] = { facts[i].left, facts[i].right };
+		for (size_t e = 0; e < ARRAY_SIZE(ends); ++e) {
+			ir_node *const middle = ends[e];
+			if (middle == l || middle == r)
+				continue;
+			ir_relation const lm = get_direct_relation(facts, l, middle);
+			ir_relation const mr = get_direct_relation(facts, middle, r);
+			possible &= chain_relations(lm, mr);
+		}
+	}
+	return possible;
+}
+
+/** Collects the facts known at the Cond @p cond.  Returns true and the
+ * outcome in @p taken if a dominating branch has the same selector. */
+static bool collect_facts(ir_node *const cond, loop_iv_t const *const ivs,
+                          fact_t **const facts, bool *const taken)
+{
+	ir_node *const sel = get_Cond_selector(cond);
+	for (ir_node *block = get_nodes_block(cond); block != NULL;
+	     block = get_Block_idom(block)) {
+		ir_node *const pred = get_entry_pred(block);
+		if (pred == NULL || !is_Proj(pred) || !is_Cond(get_Proj_pred(pred)))
+			continue;
+		bool     const pred_taken = get_Proj_num(pred) == pn_Cond_true;
+		ir_node *const pred_sel   = get_Cond_selector(get_Proj_pred(pred));
+		if (pred_sel == sel) {
+			*taken = pred_taken;
+			return true;
+		}
+		if (!is_Cmp(pred_sel))
+			continue;
+		ir_relation relation = get_cmp_relation(pred_sel);
+		if (!pred_taken)
+			relation = negate(relation);
+		add_fact(facts, get_Cmp_left(pred_sel), get_Cmp_right(pred_sel),
+		         relation);
+	}
+
+	ir_node *const block = get_nodes_block(cond);
+	for (size_t i = 0, n = ARR_LEN(ivs); i < n; ++i) {
+		loop_iv_t const *const iv = &ivs[i];
+		if (is_in_loop(block, iv->loop) && block_dominates(iv->body, block))
+			add_fact(facts, iv->phi, iv->init, ir_relation_greater_equal);
+	}
+	add_confirm_facts(facts, get_Cmp_left(sel));
+	add_confirm_facts(facts, get_Cmp_right(sel));
+	return false;
+}
+
+typedef struct fold_env_t {
+	loop_iv_t const *ivs;
+	fact_t          *facts;
+	bool             changed;
+} fold_env_t;
+
+static void fold_check(ir_node *node, void *data)
+{
+	if (!is_Cond(node))
+		return;
+	ir_node *const sel = get_Cond_selector(node);
+	if (!is_Cmp(sel) || !mode_is_int(get_irn_mode(get_Cmp_left(sel))))
+		return;
+
+	fold_env_t *const env = (fold_env_t*)data;
+	ARR_RESIZE(fact_t, env->facts, 0);
+	bool taken;
+	if (!collect_facts(node, env->ivs, &env->facts, &taken)) {
+		ir_relation const relation = get_cmp_relation(sel);
+		ir_relation const possible
+			= get_possible_relations(env->facts, get_Cmp_left(sel),
+			                         get_Cmp_right(sel));
+		if (possible == ir_relation_false)
+			return;
+		if ((possible & ~relation) == 0)
+			taken = true;
+		else if ((possible & relation) == 0)
+			taken = false;
+		else
+			return;
+	}
+
+	DB((dbg, LEVEL_2, "%+F is always %s\n", node, taken ? "true" : "false"));
+	ir_graph *const irg = get_irn_irg(node);
+	set_Cond_selector(node, new_r_Const(irg, taken ? tarval_b_true
+	                                               : tarval_b_false));
+	env->changed = true;
+}
+
+/** Decides all checks, whose outcome is known. */
+static bool fold_checks(ir_graph *const irg, loop_iv_t const *const ivs)
+{
+	fold_env_t env = { ivs, NEW_ARR_F(fact_t, 0), false };
+	irg_walk_graph(irg, NULL, fold_check, &env);
+	DEL_ARR_F(env.facts);
+	return env.changed;
+}
+
+/** Returns a loop invariant condition, which implies phi relation value in
+ * every iteration, or NULL. */
+static ir_node *get_guard(loop_iv_t const *const iv, ir_relation const relation,
+                          ir_node *const value)
+{
+	ir_node *const block = iv->preheader;
+	switch (relation) {
+	case ir_relation_less:
+		/* phi < bound <= value or phi <= bound < value */
+		return new_r_Cmp(block, iv->bound, value,
+		                 iv->relation == ir_relation_less
+		                 ? ir_relation_less_equal : ir_relation_less);
+	case ir_relation_less_equal:
+		return new_r_Cmp(block, iv->bound, value, ir_relation_less_equal);
+	case ir_relation_greater:
+	case ir_relation_greater_equal:
+		return new_r_Cmp(block, iv->init, value, relation);
+	default:
+		return NULL;
+	}
+}
+
+static void find_guarded_check(ir_node *node, void *data)
+{
+	if (!is_Cond(node))
+		return;
+	ir_node *const sel = get_Cond_selector(node);
+	if (!is_Cmp(sel) || get_irn_n_edges(node) != 2)
+		return;
+
+	guard_env_t *const env   = (guard_env_t*)data;
+	ir_node     *const block = get_nodes_block(node);
+	ir_loop     *const loop  = get_irn_loop(block);
+	loop_iv_t         *iv    = NULL;
+	for (size_t i = 0, n = ARR_LEN(env->ivs); i < n; ++i) {
+		if (env->ivs[i].loop == loop)
+			iv = &env->ivs[i];
+	}
+	if (iv == NULL || !block_dominates(iv->body, block))
+		return;
+
+	ir_relation relation = get_cmp_relation(sel);
+	ir_node    *left     = skip_Confirm(get_Cmp_left(sel));
+	ir_node    *right    = skip_Confirm(get_Cmp_right(sel));
+	if (right == iv->phi) {
+		right    = left;
+		left     = iv->phi;
+		relation = get_inversed_relation(relation);
+	}
+	if (left != iv->phi || is_in_loop(right, loop))
+		return;
+
+	/* guard the outcome staying in the loop, the other one usually reports
+	 * the failed check */
+	unsigned n_stay = 0;
+	bool     taken  = false;
+	foreach_out_edge(node, edge) {
+		ir_node *const proj = get_edge_src_irn(edge);
+		ir_node *const succ = get_succ_block(proj);
+		if (succ == NULL)
+			return;
+		if (is_in_loop(succ, loop)) {
+			++n_stay;
+			taken = get_Proj_num(proj) == pn_Cond_true;
+		}
+	}
+	if (n_stay != 1)
+		return;
+	if (!taken)
+		relation = negate(relation);
+	ir_node *const guard = get_guard(iv, relation, right);
+	if (guard == NULL)
+		return;
+
+	iv->guard = iv->guard == NULL ? guard
+	                              : new_r_And(iv->preheader, iv->guard, guard);
+	guarded_check_t const check = { node, taken, iv };
+	ARR_APP1(guarded_check_t, env->checks, check);
+}
+
+/** Lets the check @p check branch to its outcome directly if the guard of
+ * its loop holds. */
+static void insert_guard(guarded_check_t const *const check)
+{
+	ir_node *const cond = check->cond;
+	ir_node       *proj = NULL;
+	foreach_out_edge(cond, edge) {
+		ir_node *const p = get_edge_src_irn(edge);
+		if ((get_Proj_num(p) == pn_Cond_true) == check->taken)
+			proj = p;
+	}
+	ir_node *const succ = get_succ_block(proj);
+	if (succ == NULL)
+		return;
+	int pos = -1;
+	for (int i = 0, n = get_Block_n_cfgpreds(succ); i < n; ++i) {
+		if (get_Block_cfgpred(succ, i) == proj)
+			pos = i;
+	}
+
+	ir_graph *const irg        = get_irn_irg(cond);
+	ir_node  *const block      = get_nodes_block(cond);
+	ir_node  *const guard_cond = new_r_Cond(block, check->iv->guard);
+	ir_node  *const holds      = new_r_Proj(guard_cond, mode_X, pn_Cond_true);
+	ir_node  *const fails      = new_r_Proj(guard_cond, mode_X, pn_Cond_false);
+
+	/* the check is only evaluated if the guard fails */
+	ir_node *const check_block = new_r_Block(irg, 1, &fails);
+	set_nodes_block(cond, check_block);
+	foreach_out_edge(cond, edge) {
+		set_nodes_block(get_edge_src_irn(edge), check_block);
+	}
+
+	ir_node *const join_in[] = { holds, proj };
+	ir_node *const join      = new_r_Block(irg, ARRAY_SIZE(join_in), join_in);
+	set_Block_cfgpred(succ, pos, new_r_Jmp(join));
+}
+
+/** Inserts loop invariant guards for the checks of induction variables. */
+static bool guard_checks(ir_graph *const irg, loop_iv_t *const ivs)
+{
+	guard_env_t env = { ivs, NEW_ARR_F(guarded_check_t, 0) };
+	irg_walk_graph(irg, NULL, find_guarded_check, &env);
+
+	size_t const n = ARR_LEN(env.checks);
+	for (size_t i = 0; i < n; ++i) {
+		DB((dbg, LEVEL_2, "guarding %+F\n", env.checks[i].cond));
+		insert_guard(&env.checks[i]);
+	}
+	DEL_ARR_F(env.checks);
+	return n > 0;
+}
+
+static loop_iv_t *analyze_loops(ir_graph *const irg)
+{
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
+	                         | IR_GRAPH_PROPERTY_NO_BADS
+	                         | IR_GRAPH_PROPERTY_NO_TUPLES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+	loop_iv_t *ivs = NEW_ARR_F(loop_iv_t, 0);
+	find_loops(get_irg_loop(irg), &ivs);
+	return ivs;
+}
+
+void opt_range_checks(ir_graph *irg)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.range_checks");
+
+	loop_iv_t *ivs = analyze_loops(irg);
+	set_vrp_data(irg);
+	bool changed = fold_checks(irg, ivs);
+	free_vrp_data(irg);
+
+	bool const guarded = guard_checks(irg, ivs);
+	DEL_ARR_F(ivs);
+	if (guarded) {
+		confirm_irg_properties(irg, IR_GRAPH_PROPERTIES_NONE);
+		/* move the guards in front of the loops and decide them in both
+		 * copies */
+		do_loop_unswitching(irg);
+		ivs = analyze_loops(irg);
+		set_vrp_data(irg);
+		fold_checks(irg, ivs);
+		free_vrp_data(irg);
+		DEL_ARR_F(ivs);
+		changed = true;
+	}
+
+	confirm_irg_properties(irg, changed ? IR_GRAPH_PROPERTIES_CONTROL_FLOW
+	                                    : IR_GRAPH_PROPERTIES_ALL);
+}
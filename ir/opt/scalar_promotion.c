@@ -0,0 +1,498 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Scalar promotion of memory locations in loops.
+ *
+ * A location with a loop invariant address, which is accessed by Loads and
+ * Stores in an innermost loop, is kept in a value instead: it is loaded once
+ * on the loop entry edge, every access in the loop is replaced by SSA
+ * construction and the final value is stored on the loop exit edge.  This is
+ * only legal if the memory disambiguator proves that no other memory
+ * operation in the loop touches the location, so loops containing calls or
+ * other memory operations are left alone.  The Store on the exit edge must
+ * not introduce a write other threads could observe, so a stored location
+ * is either stored in every iteration or a local variable whose address is
+ * never taken.
+ */
+#include <stdbool.h>
+
+#include "array.h"
+#include "debug.h"
+#include "ircons_t.h"
+#include "irdom.h"
+#include "iredges_t.h"
+#include "irgmod.h"
+#include "irgwalk.h"
+#include "irloop_t.h"
+#include "irmemory.h"
+#include "irnode_t.h"
+#include "iroptimize.h"
+#include "irtools.h"
+#include "util.h"
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/** A memory location promoted to a value. */
+typedef struct promotion_t {
+	ir_node  *addr;          /**< the loop invariant address */
+	ir_mode  *mode;          /**< the mode of all accesses */
+	ir_type  *type;          /**< the type of the accesses */
+	ir_node  *value;         /**< the value loaded on loop entry */
+	bool      stored;        /**< the loop contains a Store to the location */
+	bool      always_stored; /**< a Store runs before the loop is left */
+	bool      safe;          /**< the location may be accessed on loop entry */
+	bool      invalid;       /**< the location cannot be promoted */
+	unsigned  vnum;          /**< the value number used for SSA construction */
+} promotion_t;
+
+/** An innermost loop with a single entry and a single exit edge. */
+typedef struct loop_env_t {
+	ir_loop     *loop;
+	ir_node     *header;     /**< the block entered from outside */
+	int          entry_pos;  /**< the input of the entry edge in header */
+	ir_node     *exit_block; /**< the block left to outside */
+	int          exit_pos;   /**< the input of the exit edge in exit_block */
+	ir_node     *mem_phi;    /**< the memory Phi of the header */
+	ir_node    **nodes;      /**< all nodes of the loop */
+	promotion_t *promotions; /**< the candidates of the loop */
+	ir_node     *preheader;
+	ir_node     *exit;
+} loop_env_t;
+
+static bool is_in_loop(ir_node const *const node, ir_loop const *const loop)
+{
+	ir_node const *const block = is_Block(node) ? node : get_nodes_block(node);
+	return get_irn_loop(block) == loop;
+}
+
+/** Checks whether @p addr always points to accessible memory, i.e. to a global
+ * entity or into the frame. */
+static bool is_dereferenceable(ir_node const *addr)
+{
+	for (;;) {
+		if (is_Address(addr)) {
+			ir_entity const *const entity = get_Address_entity(addr);
+			return !(get_entity_linkage(entity) & IR_LINKAGE_WEAK);
+		} else if (is_Member(addr)) {
+			addr = get_Member_ptr(addr);
+		} else {
+			return addr == get_irg_frame(get_irn_irg(addr));
+		}
+	}
+}
+
+/** Checks whether @p addr points to a local variable whose address is never
+ * taken, so no other thread can access it. */
+static bool is_private(ir_node const *const addr)
+{
+	if (!is_Member(addr)
+	 || get_Member_ptr(addr) != get_irg_frame(get_irn_irg(addr)))
+		return false;
+	ir_entity const *const entity = get_Member_entity(addr);
+	return !(get_entity_usage(entity) & ir_usage_address_taken);
+}
+
+static promotion_t *find_promotion(loop_env_t *const env, ir_node *const addr)
+{
+	for (size_t i = 0, n = ARR_LEN(env->promotions); i < n; ++i) {
+		if (env->promotions[i].addr == addr)
+			return &env->promotions[i];
+	}
+	promotion_t const promotion = { .addr = addr };
+	ARR_APP1(promotion_t, env->promotions, promotion);
+	return &env->promotions[ARR_LEN(env->promotions) - 1];
+}
+
+/** Records an access of @p node to @p addr in the candidates of the loop. */
+static void add_access(loop_env_t *const env, ir_node *const node,
+                       ir_node *const addr, ir_mode *const mode,
+                       ir_type *const type, bool const is_store,
+                       bool const is_plain)
+{
+	if (is_in_loop(addr, env->loop))
+		return;
+
+	promotion_t *const promotion = find_promotion(env, addr);
+	if (promotion->mode == NULL) {
+		promotion->mode = mode;
+		promotion->type = type;
+	} else if (promotion->mode != mode) {
+		promotion->invalid = true;
+	}
+	if (!is_plain || ir_throws_exception(node))
+		promotion->invalid = true;
+	promotion->stored |= is_store;
+
+	/* the location is accessed in every iteration before the loop is left */
+	ir_node *const exit_src
+		= get_nodes_block(get_Block_cfgpred(env->exit_block, env->exit_pos));
+	if (block_dominates(get_nodes_block(node), exit_src)) {
+		promotion->safe = true;
+		promotion->always_stored |= is_store;
+	}
+}
+
+/** Invalidates all candidates which may alias the access of @p node. */
+static void check_aliasing(loop_env_t *const env, ir_node *const node,
+                           ir_node *const addr, ir_mode *const mode,
+                           ir_type *const type, bool const is_store)
+{
+	(void)node;
+	unsigned const size = get_mode_size_bytes(mode);
+	for (size_t i = 0, n = ARR_LEN(env->promotions); i < n; ++i) {
+		promotion_t *const promotion = &env->promotions[i];
+		if (promotion->addr == addr || (!is_store && !promotion->stored))
+			continue;
+		ir_alias_relation const rel = get_alias_relation(
+			promotion->addr, promotion->type,
+			get_mode_size_bytes(promotion->mode), addr, type, size);
+		if (rel != ir_no_alias) {
+			DB((dbg, LEVEL_3, "  %+F may alias %+F\n", node, promotion->addr));
+			promotion->invalid = true;
+		}
+	}
+}
+
+/** Finds the single entry and exit edge and the memory Phi of the loop. */
+static bool analyze_loop_shape(loop_env_t *const env)
+{
+	ir_loop *const loop     = env->loop;
+	unsigned       n_entries = 0;
+	unsigned       n_exits   = 0;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind != k_ir_node)
+			continue;
+		ir_node *const block = element.node;
+		for (int p = 0, arity = get_Block_n_cfgpreds(block); p < arity; ++p) {
+			ir_node *const pred = get_Block_cfgpred_block(block, p);
+			if (!is_in_loop(pred, loop)) {
+				env->header    = block;
+				env->entry_pos = p;
+				++n_entries;
+			}
+		}
+		foreach_block_succ(block, edge) {
+			ir_node *const succ = get_edge_src_irn(edge);
+			if (is_in_loop(succ, loop))
+				continue;
+			env->exit_block = succ;
+			env->exit_pos   = get_edge_src_pos(edge);
+			++n_exits;
+		}
+	}
+	if (n_entries != 1 || n_exits != 1)
+		return false;
+
+	foreach_out_edge(env->header, edge) {
+		ir_node *const node = get_edge_src_irn(edge);
+		if (is_Phi(node) && get_irn_mode(node) == mode_M) {
+			env->mem_phi = node;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Collects the candidates of the loop and checks their legality.
+ * Returns false if the loop contains memory operations other than Loads and
+ * Stores.
+ */
+static bool analyze_loop(loop_env_t *const env)
+{
+	ir_loop *const loop = env->loop;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind != k_ir_node)
+			continue;
+		foreach_out_edge(element.node, edge) {
+			ir_node *const node = get_edge_src_irn(edge);
+			if (is_Block(node))
+				continue;
+			ARR_APP1(ir_node*, env->nodes, node);
+		}
+	}
+
+	for (size_t i = 0, n = ARR_LEN(env->nodes); i < n; ++i) {
+		ir_node *const node = env->nodes[i];
+		if (is_Load(node)) {
+			add_access(env, node, get_Load_ptr(node), get_Load_mode(node),
+			           get_Load_type(node), false,
+			           get_Load_volatility(node) == volatility_non_volatile
+			           && get_Load_unaligned(node) == align_is_aligned);
+		} else if (is_Store(node)) {
+			ir_node *const value = get_Store_value(node);
+			add_access(env, node, get_Store_ptr(node), get_irn_mode(value),
+			           get_Store_type(node), true,
+			           get_Store_volatility(node) == volatility_non_volatile
+			           && get_Store_unaligned(node) == align_is_aligned);
+		} else if (!is_Phi(node) && !is_Proj(node) && !is_Sync(node)
+		        && !is_Div(node) && !is_Mod(node)) {
+			foreach_irn_in(node, p, pred) {
+				if (get_irn_mode(pred) == mode_M) {
+					DB((dbg, LEVEL_2, "  %+F prevents promotion\n", node));
+					return false;
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0, n = ARR_LEN(env->nodes); i < n; ++i) {
+		ir_node *const node = env->nodes[i];
+		if (is_Load(node)) {
+			check_aliasing(env, node, get_Load_ptr(node), get_Load_mode(node),
+			               get_Load_type(node), false);
+		} else if (is_Store(node)) {
+			ir_node *const value = get_Store_value(node);
+			check_aliasing(env, node, get_Store_ptr(node),
+			               get_irn_mode(value), get_Store_type(node), true);
+		}
+	}
+
+	bool found = false;
+	for (size_t i = 0, n = ARR_LEN(env->promotions); i < n; ++i) {
+		promotion_t *const promotion = &env->promotions[i];
+		if (!promotion->safe && is_dereferenceable(promotion->addr))
+			promotion->safe = true;
+		if (!promotion->safe)
+			promotion->invalid = true;
+		/* a conditional Store must not become unconditional */
+		if (promotion->stored && !promotion->always_stored
+		 && !is_private(promotion->addr))
+			promotion->invalid = true;
+		found |= !promotion->invalid;
+	}
+	return found;
+}
+
+/** Marks the Loads and Stores of the promoted locations for SSA
+ * construction. */
+static void mark_accesses(loop_env_t const *const env)
+{
+	for (size_t i = 0, n = ARR_LEN(env->nodes); i < n; ++i) {
+		ir_node *const node = env->nodes[i];
+		ir_node *addr;
+		if (is_Load(node)) {
+			addr = get_Load_ptr(node);
+		} else if (is_Store(node)) {
+			addr = get_Store_ptr(node);
+		} else {
+			continue;
+		}
+		for (size_t j = 0, m = ARR_LEN(env->promotions); j < m; ++j) {
+			promotion_t *const promotion = &env->promotions[j];
+			if (promotion->addr == addr && !promotion->invalid)
+				set_irn_link(node, promotion);
+		}
+	}
+}
+
+/** Splits the edge @p pos of @p block and returns the new block. */
+static ir_node *split_edge(ir_node *const block, int const pos)
+{
+	ir_node *const pred     = get_Block_cfgpred(block, pos);
+	ir_node *const new_block = new_r_Block(get_irn_irg(block), 1, &pred);
+	set_Block_cfgpred(block, pos, new_r_Jmp(new_block));
+	return new_block;
+}
+
+/** Inserts the Loads of the promoted locations on the loop entry edge. */
+static void create_preheader(loop_env_t *const env)
+{
+	env->preheader = split_edge(env->header, env->entry_pos);
+	env->exit      = split_edge(env->exit_block, env->exit_pos);
+
+	ir_node *mem = get_irn_n(env->mem_phi, env->entry_pos);
+	for (size_t i = 0, n = ARR_LEN(env->promotions); i < n; ++i) {
+		promotion_t *const promotion = &env->promotions[i];
+		if (promotion->invalid)
+			continue;
+		ir_node *const load = new_r_Load(env->preheader, mem, promotion->addr,
+		                                 promotion->mode, promotion->type,
+		                                 cons_none);
+		mem = new_r_Proj(load, mode_M, pn_Load_M);
+		promotion->value = new_r_Proj(load, promotion->mode, pn_Load_res);
+		set_irn_link(load, NULL);
+	}
+	set_irn_n(env->mem_phi, env->entry_pos, mem);
+}
+
+/** Inserts the Stores of the promoted locations on the loop exit edge and lets
+ * all memory users after the loop depend on them. */
+static void create_exit_stores(loop_env_t const *const env)
+{
+	ir_graph *const irg   = get_irn_irg(env->header);
+	ir_loop  *const loop  = env->loop;
+	ir_node       **users = NEW_ARR_F(ir_node*, 0);
+	ir_node       **mems  = NEW_ARR_F(ir_node*, 0);
+	for (size_t i = 0, n = ARR_LEN(env->nodes); i < n; ++i) {
+		ir_node *const node = env->nodes[i];
+		if (get_irn_mode(node) != mode_M)
+			continue;
+		bool used = false;
+		foreach_out_edge(node, edge) {
+			ir_node *const user = get_edge_src_irn(edge);
+			if (is_End(user) || is_in_loop(user, loop))
+				continue;
+			ARR_APP1(ir_node*, users, user);
+			used = true;
+		}
+		if (used)
+			ARR_APP1(ir_node*, mems, node);
+	}
+
+	/* without memory users behind the loop the stores are dead */
+	size_t const n_mems = ARR_LEN(mems);
+	if (n_mems == 0)
+		goto out;
+
+	set_r_cur_block(irg, env->exit);
+	ir_node *mem = n_mems == 1 ? mems[0]
+	             : new_r_Sync(env->exit, (int)n_mems, mems);
+	for (size_t i = 0, n = ARR_LEN(env->promotions); i < n; ++i) {
+		promotion_t const *const promotion = &env->promotions[i];
+		if (promotion->invalid || !promotion->stored)
+			continue;
+		ir_node *const value = get_r_value(irg, promotion->vnum,
+		                                   promotion->mode);
+		ir_node *const store = new_r_Store(env->exit, mem, promotion->addr,
+		                                   value, promotion->type, cons_none);
+		mem = new_r_Proj(store, mode_M, pn_Store_M);
+	}
+
+	for (size_t i = 0, n = ARR_LEN(users); i < n; ++i) {
+		ir_node *const user = users[i];
+		foreach_irn_in(user, p, pred) {
+			for (size_t j = 0; j < n_mems; ++j) {
+				if (pred == mems[j])
+					set_irn_n(user, p, mem);
+			}
+		}
+	}
+out:
+	DEL_ARR_F(mems);
+	DEL_ARR_F(users);
+}
+
+static void replace_access(ir_node *const node, void *const env)
+{
+	(void)env;
+	if (!is_Load(node) && !is_Store(node))
+		return;
+	promotion_t const *const promotion = (promotion_t const*)get_irn_link(node);
+	if (promotion == NULL)
+		return;
+
+	DB((dbg, LEVEL_3, "  replacing %+F by value %u\n", node, promotion->vnum));
+	ir_node  *const block = get_nodes_block(node);
+	ir_graph *const irg   = get_irn_irg(node);
+	set_r_cur_block(irg, block);
+	if (is_Load(node)) {
+		ir_node *const val = get_r_value(irg, promotion->vnum, promotion->mode);
+		ir_node *const in[] = {
+			[pn_Load_M]   = get_Load_mem(node),
+			[pn_Load_res] = val,
+		};
+		turn_into_tuple(node, ARRAY_SIZE(in), in);
+	} else {
+		set_r_value(irg, promotion->vnum, get_Store_value(node));
+		ir_node *const in[] = { [pn_Store_M] = get_Store_mem(node) };
+		turn_into_tuple(node, ARRAY_SIZE(in), in);
+	}
+}
+
+static void find_innermost_loops(ir_loop *const loop, ir_loop ***const loops)
+{
+	bool had_sons = false;
+	for (size_t i = 0, n = get_loop_n_elements(loop); i < n; ++i) {
+		loop_element const element = get_loop_element(loop, i);
+		if (*element.kind == k_ir_loop) {
+			find_innermost_loops(element.son, loops);
+			had_sons = true;
+		}
+	}
+	if (!had_sons && get_loop_depth(loop) > 0)
+		ARR_APP1(ir_loop*, *loops, loop);
+}
+
+void opt_scalar_promotion(ir_graph *irg)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.scalar_promotion");
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
+	                         | IR_GRAPH_PROPERTY_NO_BADS
+	                         | IR_GRAPH_PROPERTY_NO_TUPLES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_DOMINANCE
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_ENTITY_USAGE);
+
+	ir_loop **loops = NEW_ARR_F(ir_loop*, 0);
+	find_innermost_loops(get_irg_loop(irg), &loops);
+
+	/* analyze all loops before the graph changes */
+	loop_env_t *envs   = NEW_ARR_F(loop_env_t, 0);
+	unsigned    n_vals = 0;
+	for (size_t i = 0, n = ARR_LEN(loops); i < n; ++i) {
+		loop_env_t env = { .loop = loops[i] };
+		if (!analyze_loop_shape(&env))
+			continue;
+		env.nodes      = NEW_ARR_F(ir_node*, 0);
+		env.promotions = NEW_ARR_F(promotion_t, 0);
+		if (!analyze_loop(&env)) {
+			DEL_ARR_F(env.promotions);
+			DEL_ARR_F(env.nodes);
+			continue;
+		}
+		DB((dbg, LEVEL_1, "promoting locations in loop of %+F\n", env.header));
+		for (size_t p = 0, m = ARR_LEN(env.promotions); p < m; ++p) {
+			promotion_t *const promotion = &env.promotions[p];
+			if (promotion->invalid)
+				continue;
+			DB((dbg, LEVEL_2, "  %+F\n", promotion->addr));
+			promotion->vnum = n_vals++;
+		}
+		ARR_APP1(loop_env_t, envs, env);
+	}
+	DEL_ARR_F(loops);
+
+	size_t const n_envs = ARR_LEN(envs);
+	if (n_envs > 0) {
+		ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK);
+		irg_walk_graph(irg, firm_clear_link, NULL, NULL);
+		for (size_t i = 0; i < n_envs; ++i) {
+			mark_accesses(&envs[i]);
+			create_preheader(&envs[i]);
+		}
+
+		ssa_cons_start(irg, (int)n_vals);
+		for (size_t i = 0; i < n_envs; ++i) {
+			loop_env_t const *const env = &envs[i];
+			set_r_cur_block(irg, env->preheader);
+			for (size_t p = 0, m = ARR_LEN(env->promotions); p < m; ++p) {
+				promotion_t const *const promotion = &env->promotions[p];
+				if (promotion->invalid)
+					continue;
+				set_r_value(irg, promotion->vnum, promotion->value);
+			}
+		}
+		irg_walk_blkwise_graph(irg, NULL, replace_access, NULL);
+		for (size_t i = 0; i < n_envs; ++i)
+			create_exit_stores(&envs[i]);
+		ssa_cons_finish(irg);
+		ir_free_resources(irg, IR_RESOURCE_IRN_LINK);
+	}
+
+	for (size_t i = 0; i < n_envs; ++i) {
+		DEL_ARR_F(envs[i].promotions);
+		DEL_ARR_F(envs[i].nodes);
+	}
+	DEL_ARR_F(envs);
+
+	confirm_irg_properties(irg, n_envs > 0 ? IR_GRAPH_PROPERTIES_NONE
+	                                       : IR_GRAPH_PROPERTIES_ALL);
+}
@@ -0,0 +1,366 @@
+/*
+ * This file is part of libFirm.
+ * Copyright (C) 2016 University of Karlsruhe.
+ */
+
+/**
+ * @file
+ * @brief   Superblock formation by tail duplication.
+ *
+ * Blocks are grouped into traces along their most frequent control flow
+ * edges, starting with the most frequently executed block.  A trace does not
+ * leave its loop and does not enter a loop header.  A block in a trace, which
+ * is also entered from outside of the trace, is duplicated for its trace
+ * predecessor, so every trace becomes a superblock, which is only entered at
+ * its head.  The duplication stops when the code size budget is exhausted.
+ *
+ * The execution frequencies already attached to the blocks drive the trace
+ * selection, so they may come from a profile or from an estimation.  Control
+ * flow optimization afterwards merges the blocks of a superblock, which exposes
+ * straight-line code to local optimization, scheduling and if-conversion.
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "array.h"
+#include "debug.h"
+#include "execfreq_t.h"
+#include "ircons.h"
+#include "iredges_t.h"
+#include "irgwalk.h"
+#include "irloop_t.h"
+#include "irnode_t.h"
+#include "iroptimize.h"
+#include "irtools.h"
+#include "util.h"
+
+DEBUG_ONLY(static firm_dbg_module_t *dbg;)
+
+/** The minimal probability of an edge to continue a trace. */
+#define MIN_PROBABILITY 0.5
+
+/** Adds the predecessor @p pred to the Block or Phi @p node. */
+static void add_pred(ir_node *const node, ir_node *const pred)
+{
+	int       const n  = get_irn_arity(node);
+	ir_node **const in = ALLOCAN(ir_node*, n + 1);
+	foreach_irn_in(node, i, p) {
+		in[i] = p;
+	}
+	in[n] = pred;
+	set_irn_in(node, n + 1, in);
+}
+
+/** Removes the predecessor at @p pos from the Block or Phi @p node. */
+static void remove_pred(ir_node *const node, int const pos)
+{
+	int       const n  = get_irn_arity(node);
+	ir_node **const in = ALLOCAN(ir_node*, n - 1);
+	int             k  = 0;
+	foreach_irn_in(node, i, p) {
+		if (i != pos)
+			in[k++] = p;
+	}
+	set_irn_in(node, k, in);
+}
+
+/** Estimates how often the edge from @p pred to @p block is taken. */
+static double get_edge_freq(ir_node const *const pred,
+                            ir_node const *const block)
+{
+	if (get_Block_n_cfgpreds(block) == 1)
+		return get_block_execfreq(block);
+	if (get_irn_n_edges_kind(pred, EDGE_KIND_BLOCK) == 1)
+		return get_block_execfreq(pred);
+	return MIN(get_block_execfreq(pred), get_block_execfreq(block));
+}
+
+/** Returns whether @p block may become part of a trace in @p loop. */
+static bool may_join_trace(ir_node const *const block,
+                           ir_loop const *const loop)
+{
+	ir_graph const *const irg = get_irn_irg(block);
+	return !Block_block_visited(block) && get_irn_loop(block) == loop
+	    && block != get_irg_end_block(irg) && get_Block_entity(block) == NULL;
+}
+
+/** Returns the successor of @p block, for which @p block is also the most
+ * frequent predecessor, or NULL. */
+static ir_node *get_likely_succ(ir_node *const block)
+{
+	ir_node *best      = NULL;
+	double   best_freq = 0.0;
+	foreach_block_succ(block, edge) {
+		ir_node *const succ = get_edge_src_irn(edge);
+		double   const freq = get_edge_freq(block, succ);
+		if (freq > best_freq) {
+			best      = succ;
+			best_freq = freq;
+		}
+	}
+	if (best == NULL || best_freq < MIN_PROBABILITY * get_block_execfreq(block))
+		return NULL;
+
+	for (int i = 0, n = get_Block_n_cfgpreds(best); i < n; ++i) {
+		ir_node *const pred = get_Block_cfgpred_block(best, i);
+		if (pred != block && get_edge_freq(pred, best) > best_freq)
+			return NULL;
+	}
+	return best;
+}
+
+/** Returns the block continuing the trace after @p block, or NULL. */
+static ir_node *get_trace_succ(ir_node *const block, ir_loop const *const loop)
+{
+	/* a trace enters a loop header only at its head */
+	ir_node *const succ = get_likely_succ(block);
+	if (succ == NULL || !may_join_trace(succ, loop) || get_Block_mark(succ))
+		return NULL;
+	return succ;
+}
+
+/** Returns the block continuing the trace before @p block, or NULL. */
+static ir_node *get_trace_pred(ir_node *const block, ir_loop const *const loop)
+{
+	if (get_Block_mark(block))
+		return NULL;
+
+	ir_node *best = NULL;
+	for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+		ir_node *const pred = get_Block_cfgpred_block(block, i);
+		if (best == NULL
+		    || get_edge_freq(pred, block) > get_edge_freq(best, block))
+			best = pred;
+	}
+	if (best == NULL || !may_join_trace(best, loop)
+	    || get_likely_succ(best) != block)
+		return NULL;
+	return best;
+}
+
+static void mark_loop_header(ir_node *block, void *env)
+{
+	(void)env;
+	bool is_header = false;
+	for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+		if (is_backedge(block, i))
+			is_header = true;
+	}
+	set_Block_mark(block, is_header);
+}
+
+static void collect_blocks(ir_node *block, void *env)
+{
+	ir_node ***const blocks = (ir_node***)env;
+	ARR_APP1(ir_node*, *blocks, block);
+}
+
+static int cmp_block_execfreq(void const *const a, void const *const b)
+{
+	double const freq_a = get_block_execfreq(*(ir_node *const*)a);
+	double const freq_b = get_block_execfreq(*(ir_node *const*)b);
+	return (freq_a < freq_b) - (freq_a > freq_b);
+}
+
+/** Returns the number of nodes in @p block. */
+static unsigned get_block_size(ir_node const *const block)
+{
+	unsigned size = 0;
+	foreach_out_edge(block, edge) {
+		if (!is_End(get_edge_src_irn(edge)))
+			++size;
+	}
+	return size;
+}
+
+static ir_node *get_copy(ir_node *const block, ir_node *const node)
+{
+	if (is_Block(node) || get_nodes_block(node) != block)
+		return node;
+	return (ir_node*)get_irn_link(node);
+}
+
+/**
+ * Duplicates @p block for its predecessor @p pred.  The copy is only entered
+ * from @p pred, the original keeps all other predecessors.
+ */
+static ir_node *duplicate_block(ir_node *const block, ir_node *const pred)
+{
+	int pos = -1;
+	for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+		if (get_Block_cfgpred_block(block, i) != pred)
+			continue;
+		if (pos >= 0)
+			return NULL;
+		pos = i;
+	}
+	if (pos < 0)
+		return NULL;
+
+	double    const freq  = get_edge_freq(pred, block);
+	ir_graph *const irg   = get_irn_irg(block);
+	ir_node  *const in[]  = { get_Block_cfgpred(block, pos) };
+	ir_node  *const copy  = new_r_Block(irg, ARRAY_SIZE(in), in);
+	ir_node **nodes       = NEW_ARR_F(ir_node*, 0);
+
+	/* Phis are decided by the predecessor, all other nodes get copied */
+	foreach_out_edge(block, edge) {
+		ir_node *const node = get_edge_src_irn(edge);
+		if (is_End(node)) {
+			keep_alive(copy);
+			continue;
+		}
+		ir_node *const node_copy = is_Phi(node) ? get_Phi_pred(node, pos)
+		                                        : exact_copy(node);
+		if (!is_Phi(node))
+			set_nodes_block(node_copy, copy);
+		set_irn_link(node, node_copy);
+		ARR_APP1(ir_node*, nodes, node);
+	}
+	for (size_t i = 0, n = ARR_LEN(nodes); i < n; ++i) {
+		ir_node *const node = nodes[i];
+		if (is_Phi(node))
+			continue;
+		ir_node *const node_copy = (ir_node*)get_irn_link(node);
+		foreach_irn_in(node, j, node_pred) {
+			set_irn_n(node_copy, j, get_copy(block, node_pred));
+		}
+	}
+
+	/* the copy jumps to the successors of the original */
+	for (size_t i = 0, n = ARR_LEN(nodes); i < n; ++i) {
+		ir_node *const node = nodes[i];
+		if (get_irn_mode(node) != mode_X)
+			continue;
+		foreach_out_edge_safe(node, edge) {
+			ir_node *const succ = get_edge_src_irn(edge);
+			if (!is_Block(succ))
+				continue;
+			int const succ_pos = get_edge_src_pos(edge);
+			foreach_out_edge(succ, succ_edge) {
+				ir_node *const phi = get_edge_src_irn(succ_edge);
+				if (is_Phi(phi))
+					add_pred(phi, get_copy(block, get_Phi_pred(phi, succ_pos)));
+			}
+			add_pred(succ, get_copy(block, node));
+		}
+	}
+
+	/* the original is not entered from pred anymore */
+	foreach_out_edge(block, edge) {
+		ir_node *const node = get_edge_src_irn(edge);
+		if (is_Phi(node))
+			remove_pred(node, pos);
+	}
+	remove_pred(block, pos);
+
+	for (size_t i = 0, n = ARR_LEN(nodes); i < n; ++i) {
+		ir_node *const node = nodes[i];
+		if (get_irn_mode(node) == mode_X)
+			continue;
+		construct_ssa_for_copy(block, node, copy, (ir_node*)get_irn_link(node));
+	}
+	DEL_ARR_F(nodes);
+
+	set_block_execfreq(copy, freq);
+	set_block_execfreq(block, MAX(get_block_execfreq(block) - freq, 0.0));
+	return copy;
+}
+
+/** Turns the trace @p trace into a superblock, until @p budget is
+ * exhausted. */
+static bool form_superblock(ir_node **const trace, unsigned *const budget)
+{
+	bool     changed = false;
+	ir_node *prev    = trace[0];
+	for (size_t i = 1, n = ARR_LEN(trace); i < n; ++i) {
+		ir_node *const block = trace[i];
+		if (get_Block_n_cfgpreds(block) > 1) {
+			unsigned const size = get_block_size(block);
+			if (size > *budget)
+				break;
+			ir_node *const copy = duplicate_block(block, prev);
+			if (copy == NULL)
+				break;
+			DB((dbg, LEVEL_2, "duplicated %+F for %+F as %+F\n", block, prev,
+			    copy));
+			mark_Block_block_visited(copy);
+			*budget -= size;
+			changed  = true;
+			prev     = copy;
+		} else {
+			prev = block;
+		}
+	}
+	return changed;
+}
+
+static void count_node(ir_node *node, void *env)
+{
+	(void)node;
+	++*(unsigned*)env;
+}
+
+void opt_tail_duplication(ir_graph *irg, unsigned max_growth)
+{
+	FIRM_DBG_REGISTER(dbg, "firm.opt.tail_duplication");
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_NO_UNREACHABLE_CODE
+	                         | IR_GRAPH_PROPERTY_NO_BADS
+	                         | IR_GRAPH_PROPERTY_NO_TUPLES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES
+	                         | IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+
+	unsigned n_nodes = 0;
+	irg_walk_graph(irg, NULL, count_node, &n_nodes);
+	unsigned budget = (unsigned)((unsigned long long)n_nodes * max_growth
+	                             / 100);
+
+	/* the loop information gets invalid, when blocks change, so remember the
+	 * loop headers now */
+	ir_reserve_resources(irg, IR_RESOURCE_BLOCK_MARK);
+	ir_node **blocks = NEW_ARR_F(ir_node*, 0);
+	irg_block_walk_graph(irg, mark_loop_header, collect_blocks, &blocks);
+	QSORT_ARR(blocks, cmp_block_execfreq);
+
+	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_IRN_VISITED
+	                        | IR_RESOURCE_BLOCK_VISITED);
+	inc_irg_block_visited(irg);
+
+	bool      changed = false;
+	ir_node **trace   = NEW_ARR_F(ir_node*, 0);
+	for (size_t i = 0, n = ARR_LEN(blocks); i < n && budget > 0; ++i) {
+		ir_node *const seed = blocks[i];
+		ir_loop *const loop = get_irn_loop(seed);
+		if (!may_join_trace(seed, loop) || get_block_execfreq(seed) <= 0.0)
+			continue;
+
+		/* grow the trace backwards from the seed and reverse it */
+		ARR_RESIZE(ir_node*, trace, 0);
+		mark_Block_block_visited(seed);
+		ARR_APP1(ir_node*, trace, seed);
+		for (ir_node *pred, *head = seed;
+		     (pred = get_trace_pred(head, loop)) != NULL; head = pred) {
+			mark_Block_block_visited(pred);
+			ARR_APP1(ir_node*, trace, pred);
+		}
+		for (size_t l = 0, r = ARR_LEN(trace) - 1; l < r; ++l, --r) {
+			ir_node *const tmp = trace[l];
+			trace[l] = trace[r];
+			trace[r] = tmp;
+		}
+		for (ir_node *succ, *tail = seed;
+		     (succ = get_trace_succ(tail, loop)) != NULL; tail = succ) {
+			mark_Block_block_visited(succ);
+			ARR_APP1(ir_node*, trace, succ);
+		}
+
+		changed |= form_superblock(trace, &budget);
+	}
+	DEL_ARR_F(trace);
+	DEL_ARR_F(blocks);
+
+	ir_free_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_IRN_VISITED
+	                     | IR_RESOURCE_BLOCK_VISITED | IR_RESOURCE_BLOCK_MARK);
+	confirm_irg_properties(irg, changed ? IR_GRAPH_PROPERTIES_NONE
+	                                    : IR_GRAPH_PROPERTIES_ALL);
+}
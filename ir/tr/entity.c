@@ -68,6 +68,7 @@ static ir_entity *new_entity_vis(ir_type *owner, ident *name, ir_type *type,
 		res->attr.mtd_attr.param_access  = NULL;
 		res->attr.mtd_attr.param_weight  = NULL;
 		res->attr.mtd_attr.irg           = NULL;
+		res->attr.mtd_attr.irg_deferred  = false;
 	} else if (is_compound_type(owner) && !is_segment_type(owner)) {
 		res = intern_new_entity(owner, IR_ENTITY_COMPOUND_MEMBER, name, type,
 		                        vis);
@@ -185,6 +186,9 @@ ir_entity *clone_entity(ir_entity const *const old, ident *const name,
 {
 	ir_entity *res = XMALLOC(ir_entity);
 
+	/* the clone shares the graph, so it must be read before copying */
+	if (is_method_entity(old))
+		(void)get_entity_irg(old);
 	*res = *old;
 	/* FIXME: the initializers are NOT copied */
 	if (is_method_entity(old)) {
@@ -114,6 +114,8 @@ typedef struct method_ent_attr {
 	global_ent_attr           base;
 	ir_graph *irg;                 /**< The corresponding irg if known.
 	                                    The ir_graph constructor automatically sets this field. */
+	bool      irg_deferred;        /**< The irg is not read from a binary
+	                                    file yet, see load_deferred_irg(). */
 
 	unsigned vtable_number;        /**< For a dynamically called method, the number assigned
 	                                    in the virtual function table. */
@@ -403,10 +405,22 @@ static inline void _set_entity_link(ir_entity *ent, void *l)
 	ent->link = l;
 }
 
+/**
+ * Reads the deferred graph body of @p entity from a binary file.
+ * Implemented by the importer in irio.c.
+ *
+ * This creates the graph, appends it to the program graphs and frees the
+ * importer once the last body is read. It panics if called while another
+ * body is read, as a graph body never needs another graph.
+ */
+ir_graph *load_deferred_irg(ir_entity *entity);
+
 static inline ir_graph *_get_entity_irg(const ir_entity *ent)
 {
 	assert(ent->firm_tag == k_entity);
 	assert(ent->kind == IR_ENTITY_METHOD);
+	if (UNLIKELY(ent->attr.mtd_attr.irg_deferred))
+		return load_deferred_irg((ir_entity*)ent);
 	return ent->attr.mtd_attr.irg;
 }
 
@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "firm.h"
+
+typedef struct order_t {
+	ir_graph *irgs[8];
+	unsigned  n;
+} order_t;
+
+static ir_type *mtp;
+
+static ir_entity *new_function(char const *name)
+{
+	return new_global_entity(get_glob_type(), new_id_from_str(name), mtp,
+	                         ir_visibility_external, IR_LINKAGE_DEFAULT);
+}
+
+/* builds a graph for entity calling the given callees */
+static ir_graph *build_graph(ir_entity *entity, ir_entity *const *callees,
+                             size_t n_callees)
+{
+	ir_graph *irg = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+	for (size_t i = 0; i < n_callees; ++i) {
+		ir_node *call = new_Call(get_store(), new_Address(callees[i]), 0,
+		                         NULL, mtp);
+		set_store(new_Proj(call, mode_M, pn_Call_M));
+	}
+	ir_node *ret = new_Return(get_store(), 0, NULL);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+static void record(ir_graph *irg, void *env)
+{
+	order_t *order = (order_t*)env;
+	order->irgs[order->n++] = irg;
+}
+
+static void count(ir_graph *irg, void *env)
+{
+	(void)irg;
+	++*(unsigned*)env;
+}
+
+static unsigned position(order_t const *order, ir_graph *irg)
+{
+	for (unsigned i = 0; i < order->n; ++i) {
+		if (order->irgs[i] == irg)
+			return i;
+	}
+	abort();
+}
+
+int main(void)
+{
+	ir_init();
+	mtp = new_type_method(0, 0, 0, cc_cdecl_set, mtp_no_property);
+
+	ir_entity *top  = new_function("top");
+	ir_entity *mid  = new_function("mid");
+	ir_entity *rec  = new_function("rec");
+	ir_entity *leaf = new_function("leaf");
+	ir_entity *solo = new_function("solo");
+
+	ir_entity *top_callees[] = { mid };
+	ir_entity *mid_callees[] = { rec, leaf };
+	ir_entity *rec_callees[] = { mid };
+	ir_graph  *top_irg  = build_graph(top, top_callees, 1);
+	ir_graph  *mid_irg  = build_graph(mid, mid_callees, 2);
+	ir_graph  *rec_irg  = build_graph(rec, rec_callees, 1);
+	ir_graph  *leaf_irg = build_graph(leaf, NULL, 0);
+	ir_graph  *solo_irg = build_graph(solo, NULL, 0);
+
+	ir_entity **free_methods;
+	cgana(&free_methods);
+	free(free_methods);
+	compute_callgraph();
+
+	order_t order = { { NULL }, 0 };
+	callgraph_walk_func *const passes[] = { record };
+	callgraph_run_bottom_up(passes, 1, &order);
+	assert(order.n == 5);
+
+	/* every pass runs once per graph */
+	unsigned n_runs = 0;
+	callgraph_walk_func *const counter[] = { count, count };
+	callgraph_run_bottom_up(counter, 2, &n_runs);
+	assert(n_runs == 10);
+
+	/* leaves first in program order, then the recursion, then its caller */
+	assert(order.irgs[0] == leaf_irg);
+	assert(order.irgs[1] == solo_irg);
+	assert(position(&order, mid_irg) < position(&order, top_irg));
+	assert(position(&order, rec_irg) < position(&order, top_irg));
+	assert(order.irgs[4] == top_irg);
+
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,202 @@
+#include <assert.h>
+#include <stdbool.h>
+#include "dataflow.h"
+#include "firm.h"
+
+#define MAX_BLOCKS 32
+
+/* the blocks of the graph and their index */
+static ir_node *blocks[MAX_BLOCKS];
+static unsigned n_blocks;
+
+typedef struct reach_t {
+	unsigned in[MAX_BLOCKS];
+	unsigned out[MAX_BLOCKS];
+	unsigned visits[MAX_BLOCKS];
+	dataflow_direction_t direction;
+} reach_t;
+
+static unsigned get_index(ir_node const *block)
+{
+	for (unsigned i = 0; i < n_blocks; ++i) {
+		if (blocks[i] == block)
+			return i;
+	}
+	assert(false);
+	return 0;
+}
+
+static void add_block(ir_node *block, void *env)
+{
+	(void)env;
+	assert(n_blocks < MAX_BLOCKS);
+	blocks[n_blocks++] = block;
+}
+
+static void meet(ir_node *block, void *data)
+{
+	reach_t *reach = (reach_t*)data;
+	unsigned idx   = get_index(block);
+	unsigned in    = 0;
+	if (reach->direction == DATAFLOW_FORWARD) {
+		for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i)
+			in |= reach->out[get_index(get_Block_cfgpred_block(block, i))];
+	} else {
+		foreach_block_succ(block, edge) {
+			in |= reach->out[get_index(get_edge_src_irn(edge))];
+		}
+	}
+	reach->in[idx] = in;
+}
+
+/* out = in | self, so in is the set of blocks reaching the block resp. the
+ * set of blocks reached from the block */
+static bool transfer(ir_node *block, void *data)
+{
+	reach_t *reach = (reach_t*)data;
+	unsigned idx   = get_index(block);
+	unsigned out   = reach->in[idx] | 1u << idx;
+	++reach->visits[idx];
+	if (out == reach->out[idx])
+		return false;
+	reach->out[idx] = out;
+	return true;
+}
+
+static unsigned solve(ir_graph *irg, reach_t *reach)
+{
+	for (unsigned i = 0; i < n_blocks; ++i)
+		reach->visits[i] = 0;
+	dataflow_problem_t problem = {
+		.direction = reach->direction,
+		.meet      = meet,
+		.transfer  = transfer,
+		.data      = reach,
+	};
+	return dataflow_solve(irg, &problem);
+}
+
+/* The reference: whether block to is reachable from block from by a
+ * non-empty path. */
+static bool is_reachable(unsigned from, unsigned to, unsigned *visited)
+{
+	foreach_block_succ(blocks[from], edge) {
+		unsigned succ = get_index(get_edge_src_irn(edge));
+		if (succ == to)
+			return true;
+		if (*visited & 1u << succ)
+			continue;
+		*visited |= 1u << succ;
+		if (is_reachable(succ, to, visited))
+			return true;
+	}
+	return false;
+}
+
+/* void f(void)
+ * {
+ *     for (int o = 0; o < 8; ++o)
+ *         for (int i = 0; i < 8; ++i) {}
+ * } */
+static ir_graph *build_graph(void)
+{
+	ir_type   *mtp    = new_type_method(0, 0, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str("f"), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+	ir_graph *irg   = new_ir_graph(entity, 2);
+	set_current_ir_graph(irg);
+	ir_node  *zero  = new_Const_long(mode_Is, 0);
+	ir_node  *one   = new_Const_long(mode_Is, 1);
+	ir_node  *eight = new_Const_long(mode_Is, 8);
+	set_value(0, zero);
+
+	ir_node *outer = new_immBlock();
+	add_immBlock_pred(outer, new_Jmp());
+	set_cur_block(outer);
+	ir_node *outer_cond = new_Cond(new_Cmp(get_value(0, mode_Is), eight,
+	                                       ir_relation_less));
+
+	ir_node *outer_body = new_immBlock();
+	add_immBlock_pred(outer_body, new_Proj(outer_cond, mode_X, pn_Cond_true));
+	mature_immBlock(outer_body);
+	set_cur_block(outer_body);
+	set_value(1, zero);
+
+	ir_node *inner = new_immBlock();
+	add_immBlock_pred(inner, new_Jmp());
+	set_cur_block(inner);
+	ir_node *inner_cond = new_Cond(new_Cmp(get_value(1, mode_Is), eight,
+	                                       ir_relation_less));
+
+	ir_node *inner_body = new_immBlock();
+	add_immBlock_pred(inner_body, new_Proj(inner_cond, mode_X, pn_Cond_true));
+	mature_immBlock(inner_body);
+	set_cur_block(inner_body);
+	set_value(1, new_Add(get_value(1, mode_Is), one));
+	add_immBlock_pred(inner, new_Jmp());
+	mature_immBlock(inner);
+
+	ir_node *inner_exit = new_immBlock();
+	add_immBlock_pred(inner_exit, new_Proj(inner_cond, mode_X,
+	                                       pn_Cond_false));
+	mature_immBlock(inner_exit);
+	set_cur_block(inner_exit);
+	set_value(0, new_Add(get_value(0, mode_Is), one));
+	add_immBlock_pred(outer, new_Jmp());
+	mature_immBlock(outer);
+
+	ir_node *outer_exit = new_immBlock();
+	add_immBlock_pred(outer_exit, new_Proj(outer_cond, mode_X,
+	                                       pn_Cond_false));
+	mature_immBlock(outer_exit);
+	set_cur_block(outer_exit);
+	ir_node *ret = new_Return(get_store(), 0, NULL);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+static void check(ir_graph *irg, dataflow_direction_t direction)
+{
+	reach_t reach = { .direction = direction };
+	solve(irg, &reach);
+
+	/* the fixpoint is the reachability relation */
+	for (unsigned b = 0; b < n_blocks; ++b) {
+		for (unsigned o = 0; o < n_blocks; ++o) {
+			unsigned visited = 0;
+			bool     expect  = direction == DATAFLOW_FORWARD
+				? is_reachable(o, b, &visited) : is_reachable(b, o, &visited);
+			assert(((reach.in[b] >> o) & 1) == expect);
+		}
+	}
+
+	/* the blocks in front of and after the loops see no changed inputs
+	 * after their first visit */
+	unsigned start = get_index(get_irg_start_block(irg));
+	unsigned end   = get_index(get_irg_end_block(irg));
+	assert(reach.visits[start] == 1);
+	assert(reach.visits[end] == 1);
+
+	/* solving again from the fixpoint visits every block exactly once */
+	unsigned n_processed = solve(irg, &reach);
+	for (unsigned b = 0; b < n_blocks; ++b)
+		assert(reach.visits[b] == 1);
+	assert(n_processed == n_blocks);
+}
+
+int main(void)
+{
+	ir_init();
+	ir_graph *irg = build_graph();
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_OUT_EDGES);
+	irg_block_walk_graph(irg, add_block, NULL, NULL);
+	check(irg, DATAFLOW_FORWARD);
+	check(irg, DATAFLOW_BACKWARD);
+	ir_finish();
+	return 0;
+}
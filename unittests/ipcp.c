@@ -0,0 +1,146 @@
+#include <assert.h>
+#include "firm.h"
+
+static ir_type *int_type;
+
+static ir_type *new_method_type(size_t n_params)
+{
+	ir_type *mtp = new_type_method(n_params, 1, 0, cc_cdecl_set,
+	                               mtp_no_property);
+	for (size_t i = 0; i < n_params; ++i)
+		set_method_param_type(mtp, i, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	return mtp;
+}
+
+static ir_entity *new_function(char const *name, size_t n_params,
+                               ir_visibility visibility)
+{
+	return new_global_entity(get_glob_type(), new_id_from_str(name),
+	                         new_method_type(n_params), visibility,
+	                         IR_LINKAGE_DEFAULT);
+}
+
+static ir_node *new_arg(ir_graph *irg, unsigned pos)
+{
+	return new_Proj(get_irg_args(irg), mode_Is, pos);
+}
+
+static ir_node *new_call(ir_entity *callee, int n_args, ir_node **args)
+{
+	ir_node *call = new_Call(get_store(), new_Address(callee), n_args, args,
+	                         get_entity_type(callee));
+	set_store(new_Proj(call, mode_M, pn_Call_M));
+	ir_node *ress = new_Proj(call, mode_T, pn_Call_T_result);
+	return new_Proj(ress, mode_Is, 0);
+}
+
+static ir_graph *new_graph(ir_entity *entity)
+{
+	ir_graph *irg = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+	return irg;
+}
+
+static void finish_graph(ir_graph *irg, ir_node *res)
+{
+	ir_node *in[] = { res };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+}
+
+static ir_node *get_result(ir_graph *irg)
+{
+	ir_node *ret = get_Block_cfgpred(get_irg_end_block(irg), 0);
+	return get_Return_res(ret, 0);
+}
+
+int main(void)
+{
+	ir_init();
+	int_type = new_type_primitive(mode_Is);
+
+	/* static int sel(int mode, int v) { return mode + v; } */
+	ir_entity *sel = new_function("sel", 2, ir_visibility_local);
+	ir_graph  *sel_irg = new_graph(sel);
+	finish_graph(sel_irg, new_Add(new_arg(sel_irg, 0), new_arg(sel_irg, 1)));
+
+	/* static int three(void) { return 3; } */
+	ir_entity *three = new_function("three", 0, ir_visibility_local);
+	ir_graph  *three_irg = new_graph(three);
+	finish_graph(three_irg, new_Const_long(mode_Is, 3));
+
+	/* int scale(int f, int v) { return (v * f) + f; } */
+	ir_entity *scale = new_function("scale", 2, ir_visibility_external);
+	ir_graph  *scale_irg = new_graph(scale);
+	ir_node   *f = new_arg(scale_irg, 0);
+	finish_graph(scale_irg, new_Add(new_Mul(new_arg(scale_irg, 1), f), f));
+	ir_type   *scale_type = get_entity_type(scale);
+
+	/* int e1(int v) { return sel(2, v) + three(); } */
+	ir_entity *e1 = new_function("e1", 1, ir_visibility_external);
+	ir_graph  *e1_irg = new_graph(e1);
+	ir_node   *e1_args[] = { new_Const_long(mode_Is, 2), new_arg(e1_irg, 0) };
+	ir_node   *e1_sel = new_call(sel, 2, e1_args);
+	finish_graph(e1_irg, new_Add(e1_sel, new_call(three, 0, NULL)));
+
+	/* int e2(int v) { return sel(2, v) + scale(5, v); } */
+	ir_entity *e2 = new_function("e2", 1, ir_visibility_external);
+	ir_graph  *e2_irg = new_graph(e2);
+	ir_node   *e2_args[] = { new_Const_long(mode_Is, 2), new_arg(e2_irg, 0) };
+	ir_node   *e2_scale[] = { new_Const_long(mode_Is, 5), new_arg(e2_irg, 0) };
+	ir_node   *e2_sel = new_call(sel, 2, e2_args);
+	finish_graph(e2_irg, new_Add(e2_sel, new_call(scale, 2, e2_scale)));
+
+	/* int e3(int v) { return three() + 1; } */
+	ir_entity *e3 = new_function("e3", 1, ir_visibility_external);
+	ir_graph  *e3_irg = new_graph(e3);
+	finish_graph(e3_irg, new_Add(new_call(three, 0, NULL),
+	                             new_Const_long(mode_Is, 1)));
+
+	/* static int low(int x) { return x; } */
+	ir_entity *low = new_function("low", 1, ir_visibility_local);
+	ir_graph  *low_irg = new_graph(low);
+	finish_graph(low_irg, new_arg(low_irg, 0));
+
+	/* int e4(int v) { return low(v & 7); } */
+	ir_entity *e4 = new_function("e4", 1, ir_visibility_external);
+	ir_graph  *e4_irg = new_graph(e4);
+	ir_node   *e4_args[] = { new_And(new_arg(e4_irg, 0),
+	                                 new_Const_long(mode_Is, 7)) };
+	finish_graph(e4_irg, new_call(low, 1, e4_args));
+
+	size_t n_irgs = get_irp_n_irgs();
+	opt_ipcp(100.0f);
+
+	/* both calls pass 2 for mode */
+	ir_node *sel_res = get_result(sel_irg);
+	assert(is_Add(sel_res));
+	ir_node *sel_const = get_Add_right(sel_res);
+	assert(is_Const(sel_const) && get_tarval_long(get_Const_tarval(sel_const)) == 2);
+
+	/* the result of three() is known in its callers */
+	ir_node *e3_res = get_result(e3_irg);
+	assert(is_Const(e3_res) && get_tarval_long(get_Const_tarval(e3_res)) == 4);
+
+	/* scale is visible outside, so the call got a specialized copy */
+	assert(get_irp_n_irgs() == n_irgs + 1);
+	ir_graph  *clone_irg = get_irp_irg(n_irgs);
+	ir_entity *clone     = get_irg_entity(clone_irg);
+	assert(clone != scale && get_entity_type(clone) == scale_type);
+	assert(get_entity_visibility(clone) == ir_visibility_local);
+	ir_node *clone_res = get_result(clone_irg);
+	assert(is_Add(clone_res));
+	ir_node *clone_const = get_Add_right(clone_res);
+	assert(is_Const(clone_const)
+	       && get_tarval_long(get_Const_tarval(clone_const)) == 5);
+
+	/* low only gets values in [0, 7] */
+	ir_node *low_res = get_result(low_irg);
+	assert(is_Confirm(low_res) && is_Confirm(get_Confirm_value(low_res)));
+
+	ir_finish();
+	return 0;
+}
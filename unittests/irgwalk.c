@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "firm.h"
+
+/* deep enough to overflow the C stack with one frame per node */
+#define CHAIN_LENGTH 300000
+#define N_BLOCKS     100000
+
+typedef struct walk_data_t {
+	unsigned  n_pre;
+	unsigned  n_post;
+	unsigned *post_num;
+} walk_data_t;
+
+static void count_pre(ir_node *node, void *env)
+{
+	(void)node;
+	walk_data_t *data = (walk_data_t*)env;
+	++data->n_pre;
+}
+
+static void count_post(ir_node *node, void *env)
+{
+	walk_data_t *data = (walk_data_t*)env;
+	/* the graph is acyclic, so all predecessors must be finished before */
+	if (!is_Block(node))
+		assert(data->post_num[get_irn_idx(get_nodes_block(node))] != 0);
+	for (int i = 0, n = get_irn_arity(node); i < n; ++i) {
+		ir_node *pred = get_irn_n(node, i);
+		assert(data->post_num[get_irn_idx(pred)] != 0);
+	}
+	data->post_num[get_irn_idx(node)] = ++data->n_post;
+}
+
+static ir_graph *build_graph(void)
+{
+	ir_type   *type   = new_type_primitive(mode_Iu);
+	ir_type   *mtp    = new_type_method(1, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, type);
+	set_method_res_type(mtp, 0, type);
+	ir_entity *entity = new_entity(get_glob_type(), new_id_from_str("deep"),
+	                               mtp);
+	ir_graph  *irg    = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+
+	/* a long def chain x ^ 1 ^ 2 ^ ... */
+	ir_node *args = get_irg_args(irg);
+	ir_node *val  = new_Proj(args, mode_Iu, 0);
+	for (unsigned i = 0; i < CHAIN_LENGTH; ++i)
+		val = new_Eor(val, new_Const_long(mode_Iu, i + 1));
+
+	/* followed by a long chain of blocks */
+	for (unsigned i = 0; i < N_BLOCKS; ++i) {
+		ir_node *jmp   = new_Jmp();
+		ir_node *block = new_immBlock();
+		add_immBlock_pred(block, jmp);
+		mature_immBlock(block);
+		set_cur_block(block);
+		/* keep the SSA construction from recursing through all blocks */
+		set_store(get_store());
+	}
+
+	ir_node *in[] = { val };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+int main(void)
+{
+	ir_init();
+	set_optimize(0);
+
+	ir_graph *irg    = build_graph();
+	unsigned  n_idx  = get_irg_last_idx(irg);
+	unsigned  n_live = 0;
+
+	walk_data_t data = { 0, 0, NULL };
+	data.post_num = calloc(n_idx, sizeof(*data.post_num));
+	irg_walk_graph(irg, count_pre, count_post, &data);
+	assert(data.n_pre == data.n_post);
+	assert(data.n_pre > 2 * CHAIN_LENGTH + 2 * N_BLOCKS);
+	n_live = data.n_pre;
+
+	walk_data_t blocks = { 0, 0, NULL };
+	irg_block_walk_graph(irg, count_pre, NULL, &blocks);
+	assert(blocks.n_pre >= N_BLOCKS + 2);
+
+	/* every reachable node is in the index map */
+	walk_data_t flat = { 0, 0, NULL };
+	irg_walk_graph_by_idx(irg, count_pre, &flat);
+	assert(flat.n_pre >= n_live);
+
+	edges_activate(irg);
+	walk_data_t users = { 0, 0, NULL };
+	irg_walk_edges(get_irg_start_block(irg), count_pre, NULL, &users);
+	assert(users.n_pre > CHAIN_LENGTH);
+
+	walk_data_t succs = { 0, 0, NULL };
+	irg_block_edges_walk(get_irg_start_block(irg), count_pre, NULL, &succs);
+	assert(succs.n_pre == blocks.n_pre);
+	edges_deactivate(irg);
+
+	free(data.post_num);
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,109 @@
+#include <assert.h>
+#include <stdio.h>
+#include "firm.h"
+
+static void count_node(ir_node *node, void *env)
+{
+	(void)node;
+	++*(unsigned*)env;
+}
+
+static unsigned count_nodes(ir_graph *irg)
+{
+	unsigned n = 0;
+	irg_walk_graph(irg, count_node, NULL, &n);
+	return n;
+}
+
+/* int name(int x) { return callee(x) + value; } resp. x + value without a
+ * callee */
+static ir_entity *build_graph(char const *name, long value, ir_entity *callee)
+{
+	ir_type   *type   = new_type_primitive(mode_Is);
+	ir_type   *mtp    = new_type_method(1, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, type);
+	set_method_res_type(mtp, 0, type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+	ir_graph  *irg    = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+
+	ir_node *arg = new_Proj(get_irg_args(irg), mode_Is, 0);
+	if (callee != NULL) {
+		ir_node *args[] = { arg };
+		ir_node *call   = new_Call(get_store(), new_Address(callee), 1, args,
+		                           get_entity_type(callee));
+		set_store(new_Proj(call, mode_M, pn_Call_M));
+		ir_node *ress = new_Proj(call, mode_T, pn_Call_T_result);
+		arg = new_Proj(ress, mode_Is, 0);
+	}
+	ir_node *in[] = { new_Add(arg, new_Const_long(mode_Is, value)) };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return entity;
+}
+
+int main(void)
+{
+	ir_init();
+	set_optimize(0);
+
+	ir_entity *old_f = build_graph("f", 1, NULL);
+	ir_entity *old_g = build_graph("g", 2, NULL);
+	ir_entity *old_h = build_graph("h", 3, old_f);
+	unsigned   n_f   = count_nodes(get_entity_irg(old_f));
+	unsigned   n_g   = count_nodes(get_entity_irg(old_g));
+	unsigned   n_h   = count_nodes(get_entity_irg(old_h));
+	unsigned long long fp_f = ir_graph_fingerprint(get_entity_irg(old_f));
+	unsigned long long fp_g = ir_graph_fingerprint(get_entity_irg(old_g));
+	assert(fp_f != fp_g);
+	assert(fp_f == ir_graph_fingerprint(get_entity_irg(old_f)));
+
+	FILE *file = tmpfile();
+	assert(file != NULL);
+	ir_export_binary_file(file);
+	assert(!ferror(file));
+
+	/* import into the same program, so move the originals out of the way */
+	set_entity_ld_ident(old_f, new_id_from_str("old_f"));
+	set_entity_ld_ident(old_g, new_id_from_str("old_g"));
+	set_entity_ld_ident(old_h, new_id_from_str("old_h"));
+	rewind(file);
+	int res = ir_import_file(file, "<tmpfile>");
+	assert(res == 0);
+	fclose(file);
+
+	/* the graph of g is read first, so it comes first after the originals */
+	ir_entity *g = ir_get_global(new_id_from_str("g"));
+	assert(g != NULL && g != old_g);
+	ir_graph *g_irg = get_entity_irg(g);
+	assert(g_irg != NULL && get_irg_entity(g_irg) == g);
+	assert(get_irp_irg(3) == g_irg);
+	assert(count_nodes(g_irg) == n_g);
+	/* the imported graph has new node numbers but the same fingerprint */
+	assert(ir_graph_fingerprint(g_irg) == fp_g);
+
+	/* reading a body which calls a deferred graph only refers to its
+	 * entity and leaves the callee deferred */
+	ir_entity *h = ir_get_global(new_id_from_str("h"));
+	assert(h != NULL && h != old_h);
+	ir_graph *h_irg = get_entity_irg(h);
+	assert(h_irg != NULL && get_irg_entity(h_irg) == h);
+	assert(get_irp_irg(4) == h_irg);
+	assert(count_nodes(h_irg) == n_h);
+
+	/* asking for all graphs reads the remaining ones */
+	assert(get_irp_n_irgs() == 6);
+	ir_entity *f = ir_get_global(new_id_from_str("f"));
+	assert(f != NULL && get_irp_irg(5) == get_entity_irg(f));
+	assert(count_nodes(get_entity_irg(f)) == n_f);
+	assert(ir_graph_fingerprint(get_entity_irg(f)) == fp_f);
+
+	ir_finish();
+	return 0;
+}
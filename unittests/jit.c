@@ -0,0 +1,72 @@
+#include <assert.h>
+#include <sched.h>
+#include "firm.h"
+#include "jit.h"
+#include "bejit.h"
+
+/* int name(int x) { return x + 1; } */
+static ir_graph *new_increment(char const *name)
+{
+	ir_type *int_type = new_type_primitive(mode_Is);
+	ir_type *mtp      = new_type_method(1, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+
+	ir_graph *irg = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+	ir_node *x    = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node *in[] = { new_Add(x, new_Const_long(mode_Is, 1)) };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+int main(void)
+{
+	ir_init();
+	/* code is only compiled, the stubs are called by be_jit_call_stub() */
+	be_parse_arg("isa=ia32");
+	be_parse_arg("omitfp");
+	ir_graph *f = new_increment("f");
+	ir_graph *g = new_increment("g");
+	be_lower_for_target();
+
+	ir_jit_segment_t *segment = be_new_jit_segment();
+	be_jit_set_tiering(segment, 2, NULL);
+
+	/* without workers, a hot stub called by the thread holding the lock keeps
+	 * running its tier-0 code */
+	void *f_stub = be_jit_create_stub(segment, f);
+	void const *f_tier_0 = be_jit_call_stub(segment, f_stub);
+	assert(f_tier_0 != NULL);
+	be_jit_lock();
+	for (int i = 0; i < 8; ++i)
+		assert(be_jit_call_stub(segment, f_stub) == f_tier_0);
+	be_jit_unlock();
+	void const *f_final = be_jit_call_stub(segment, f_stub);
+	assert(f_final != NULL && f_final != f_tier_0);
+	assert(be_jit_call_stub(segment, f_stub) == f_final);
+
+	/* a worker recompiles the function once the lock is released */
+	void *g_stub = be_jit_create_stub(segment, g);
+	void const *g_tier_0 = be_jit_call_stub(segment, g_stub);
+	assert(g_tier_0 != NULL);
+	be_jit_lock();
+	be_jit_set_workers(segment, 1);
+	for (int i = 0; i < 8; ++i)
+		assert(be_jit_call_stub(segment, g_stub) == g_tier_0);
+	be_jit_unlock();
+	while (be_jit_call_stub(segment, g_stub) == g_tier_0)
+		sched_yield();
+
+	be_destroy_jit_segment(segment);
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,191 @@
+#include <assert.h>
+#include <stdbool.h>
+#include "firm.h"
+
+#define N 128
+
+static ir_type   *int_type;
+static ir_entity *a;
+static ir_entity *b;
+
+static ir_node *new_index(ir_node *var, long size)
+{
+	ir_mode *offset_mode = get_reference_offset_mode(mode_P);
+	return new_Mul(new_Conv(var, offset_mode), new_Const_long(offset_mode, size));
+}
+
+/* &array[row][col] */
+static ir_node *new_element(ir_entity *array, ir_node *row, ir_node *col)
+{
+	ir_node *offset = new_Add(new_index(row, N * 4), new_index(col, 4));
+	return new_Add(new_Address(array), offset);
+}
+
+/* void name(void)
+ * {
+ *     for (T o = 0; o < n; ++o) {
+ *         for (T i = 0; i < n; ++i) {
+ *             if (transpose) b[o][i] = a[i][o]; else a[i][o] = o + i;
+ *         }
+ *     }
+ * } */
+static ir_graph *build_graph(char const *name, bool transpose, ir_mode *mode,
+                             long n)
+{
+	ir_type *mtp = new_type_method(0, 0, 0, cc_cdecl_set, mtp_no_property);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+
+	ir_graph *irg = new_ir_graph(entity, 2);
+	set_current_ir_graph(irg);
+	ir_node *zero  = new_Const_long(mode, 0);
+	ir_node *one   = new_Const_long(mode, 1);
+	ir_node *bound = new_Const_long(mode, n);
+	set_value(0, zero);
+
+	ir_node *outer = new_immBlock();
+	add_immBlock_pred(outer, new_Jmp());
+	set_cur_block(outer);
+	ir_node *outer_cond = new_Cond(new_Cmp(get_value(0, mode), bound,
+	                                       ir_relation_less));
+	ir_node *outer_body = new_immBlock();
+	add_immBlock_pred(outer_body, new_Proj(outer_cond, mode_X, pn_Cond_true));
+	mature_immBlock(outer_body);
+	set_cur_block(outer_body);
+	set_value(1, zero);
+
+	ir_node *inner = new_immBlock();
+	add_immBlock_pred(inner, new_Jmp());
+	set_cur_block(inner);
+	ir_node *inner_cond = new_Cond(new_Cmp(get_value(1, mode), bound,
+	                                       ir_relation_less));
+	ir_node *body = new_immBlock();
+	add_immBlock_pred(body, new_Proj(inner_cond, mode_X, pn_Cond_true));
+	mature_immBlock(body);
+	set_cur_block(body);
+	ir_node *o = get_value(0, mode);
+	ir_node *i = get_value(1, mode);
+	ir_node *value;
+	ir_node *addr;
+	if (transpose) {
+		ir_node *load = new_Load(get_store(), new_element(a, i, o), mode_Is,
+		                         int_type, cons_none);
+		set_store(new_Proj(load, mode_M, pn_Load_M));
+		value = new_Proj(load, mode_Is, pn_Load_res);
+		addr  = new_element(b, o, i);
+	} else {
+		value = new_Conv(new_Add(o, i), mode_Is);
+		addr  = new_element(a, i, o);
+	}
+	ir_node *store = new_Store(get_store(), addr, value, int_type, cons_none);
+	set_store(new_Proj(store, mode_M, pn_Store_M));
+	set_value(1, new_Add(i, one));
+	add_immBlock_pred(inner, new_Jmp());
+	mature_immBlock(inner);
+
+	ir_node *latch = new_immBlock();
+	add_immBlock_pred(latch, new_Proj(inner_cond, mode_X, pn_Cond_false));
+	mature_immBlock(latch);
+	set_cur_block(latch);
+	set_value(0, new_Add(get_value(0, mode), one));
+	add_immBlock_pred(outer, new_Jmp());
+	mature_immBlock(outer);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, new_Proj(outer_cond, mode_X, pn_Cond_false));
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	ir_node *ret = new_Return(get_store(), 0, NULL);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+static void find_store(ir_node *node, void *env)
+{
+	if (is_Store(node))
+		*(ir_node**)env = node;
+}
+
+/* returns the variable multiplied by stride in the address */
+static ir_node *get_stride_var(ir_node *addr, long stride)
+{
+	if (is_Add(addr)) {
+		ir_node *var = get_stride_var(get_Add_left(addr), stride);
+		return var != NULL ? var : get_stride_var(get_Add_right(addr), stride);
+	}
+	if (is_Mul(addr) && is_Const(get_Mul_right(addr))
+	    && get_tarval_long(get_Const_tarval(get_Mul_right(addr))) == stride) {
+		ir_node *var = get_Mul_left(addr);
+		return is_Conv(var) ? get_Conv_op(var) : var;
+	}
+	return NULL;
+}
+
+static unsigned get_var_depth(ir_graph *irg, long stride)
+{
+	ir_node *store = NULL;
+	irg_walk_graph(irg, find_store, NULL, &store);
+	ir_node *var = get_stride_var(get_Store_ptr(store), stride);
+	assure_loopinfo(irg);
+	return get_loop_depth(get_irn_loop(get_nodes_block(var)));
+}
+
+static void max_depth(ir_node *block, void *env)
+{
+	unsigned *depth = (unsigned*)env;
+	unsigned  block_depth = get_loop_depth(get_irn_loop(block));
+	if (block_depth > *depth)
+		*depth = block_depth;
+}
+
+static unsigned get_max_depth(ir_graph *irg)
+{
+	assure_loopinfo(irg);
+	unsigned depth = 0;
+	irg_block_walk_graph(irg, max_depth, NULL, &depth);
+	return depth;
+}
+
+int main(void)
+{
+	ir_init();
+	int_type = new_type_primitive(mode_Is);
+	ir_type *array_type = new_type_array(int_type, N * N);
+	a = new_global_entity(get_glob_type(), new_id_from_str("a"), array_type,
+	                      ir_visibility_external, IR_LINKAGE_DEFAULT);
+	b = new_global_entity(get_glob_type(), new_id_from_str("b"), array_type,
+	                      ir_visibility_external, IR_LINKAGE_DEFAULT);
+
+	/* the column is walked by the inner loop */
+	ir_graph *f = build_graph("f", false, mode_Is, N);
+	assert(get_var_depth(f, 4) == 1);
+	do_loop_nest_optimization(f, 1024, 64);
+	assert(irg_verify(f));
+	assert(get_var_depth(f, 4) == 2);
+	assert(get_max_depth(f) == 2);
+
+	/* both orders access one array by column, so the inner loop is tiled */
+	ir_graph *g = build_graph("g", true, mode_Is, N);
+	do_loop_nest_optimization(g, 1024, 64);
+	assert(irg_verify(g));
+	assert(get_max_depth(g) == 3);
+
+	/* the end of the last tile stays below the maximum of the mode... */
+	ir_graph *h = build_graph("h", true, mode_Bs, 100);
+	do_loop_nest_optimization(h, 1024, 64);
+	assert(irg_verify(h));
+	assert(get_max_depth(h) == 3);
+
+	/* ...but would wrap around here */
+	ir_graph *k = build_graph("k", true, mode_Bs, 127);
+	do_loop_nest_optimization(k, 1024, 64);
+	assert(irg_verify(k));
+	assert(get_max_depth(k) == 2);
+
+	ir_finish();
+	return 0;
+}
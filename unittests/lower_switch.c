@@ -0,0 +1,216 @@
+#include <assert.h>
+#include <stdbool.h>
+#include "firm.h"
+
+#define N_OUTS 10
+
+static ir_type *int_type;
+
+/* the result of the switch for x, which is also the Proj number */
+static unsigned reference(unsigned x)
+{
+	switch (x) {
+	case 0: case 3: case 5: case 9: case 12: return 1;
+	case 1: case 7:                          return 2;
+	case 1000:                               return 7;
+	case 5000:                               return 8;
+	case 20000:                              return 9;
+	}
+	if (x >= 100 && x < 116)
+		return 3 + (x - 100) % 4;
+	return 0;
+}
+
+static void set_entry(ir_switch_table *table, size_t *n, unsigned value,
+                      unsigned pn)
+{
+	ir_tarval *tv = new_tarval_from_long(value, mode_Iu);
+	ir_switch_table_set(table, (*n)++, tv, tv, pn);
+}
+
+/* unsigned f(unsigned x) { switch (x) { ... } } as in reference() */
+static ir_graph *build_graph(void)
+{
+	ir_type *mtp = new_type_method(1, 1, 0, cc_cdecl_set, mtp_no_property);
+	set_method_param_type(mtp, 0, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str("f"), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+	ir_graph *irg = new_ir_graph(entity, 0);
+	set_current_ir_graph(irg);
+	ir_node *x = new_Proj(get_irg_args(irg), mode_Iu, 0);
+
+	static unsigned const bit_tests[][2] = {
+		{ 0, 1 }, { 1, 2 }, { 3, 1 }, { 5, 1 }, { 7, 2 }, { 9, 1 }, { 12, 1 },
+	};
+	ir_switch_table *table = ir_new_switch_table(irg, 7 + 16 + 3);
+	size_t           n     = 0;
+	for (size_t i = 0; i < 7; ++i)
+		set_entry(table, &n, bit_tests[i][0], bit_tests[i][1]);
+	for (unsigned v = 100; v < 116; ++v)
+		set_entry(table, &n, v, 3 + (v - 100) % 4);
+	set_entry(table, &n, 1000, 7);
+	set_entry(table, &n, 5000, 8);
+	set_entry(table, &n, 20000, 9);
+	ir_node *switchn = new_Switch(x, N_OUTS, table);
+
+	for (unsigned pn = 0; pn < N_OUTS; ++pn) {
+		ir_node *block = new_immBlock();
+		add_immBlock_pred(block, new_Proj(switchn, mode_X, pn));
+		mature_immBlock(block);
+		set_cur_block(block);
+		ir_node *in[] = { new_Const_long(mode_Iu, pn) };
+		ir_node *ret  = new_Return(get_store(), 1, in);
+		add_immBlock_pred(get_irg_end_block(irg), ret);
+	}
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+static ir_tarval *eval(ir_node *node, ir_tarval *x)
+{
+	switch (get_irn_opcode(node)) {
+	case iro_Const: return get_Const_tarval(node);
+	case iro_Proj:  return x;
+	case iro_Conv:
+		return tarval_convert_to(eval(get_Conv_op(node), x),
+		                         get_irn_mode(node));
+	case iro_Add:
+		return tarval_add(eval(get_Add_left(node), x),
+		                  eval(get_Add_right(node), x));
+	case iro_Sub:
+		return tarval_sub(eval(get_Sub_left(node), x),
+		                  eval(get_Sub_right(node), x));
+	case iro_And:
+		return tarval_and(eval(get_And_left(node), x),
+		                  eval(get_And_right(node), x));
+	case iro_Shl:
+		return tarval_shl(eval(get_Shl_left(node), x),
+		                  eval(get_Shl_right(node), x));
+	default:
+		assert(false);
+		return NULL;
+	}
+}
+
+static unsigned eval_switch(ir_node *switchn, ir_tarval *value)
+{
+	ir_switch_table const *table = get_Switch_table(switchn);
+	for (size_t e = 0, n = ir_switch_table_get_n_entries(table); e < n; ++e) {
+		ir_tarval *min = ir_switch_table_get_min(table, e);
+		ir_tarval *max = ir_switch_table_get_max(table, e);
+		if ((tarval_cmp(min, value) & ir_relation_less_equal)
+		    && (tarval_cmp(value, max) & ir_relation_less_equal))
+			return ir_switch_table_get_pn(table, e);
+	}
+	return pn_Switch_default;
+}
+
+static ir_node *get_succ(ir_node *node, unsigned pn)
+{
+	for (unsigned i = 0, n = get_irn_n_outs(node); i < n; ++i) {
+		ir_node *proj = get_irn_out(node, i);
+		if (get_Proj_num(proj) == pn)
+			return get_irn_out(proj, 0);
+	}
+	assert(false);
+	return NULL;
+}
+
+/* Interprets the lowered control flow for the argument x. */
+static unsigned run(ir_graph *irg, unsigned x)
+{
+	ir_tarval *arg   = new_tarval_from_long(x, mode_Iu);
+	ir_node   *block = get_irg_start_block(irg);
+	for (;;) {
+		ir_node *next = NULL;
+		for (unsigned i = 0, n = get_irn_n_outs(block); i < n; ++i) {
+			ir_node *node = get_irn_out(block, i);
+			if (is_Return(node)) {
+				ir_tarval *res = eval(get_Return_res(node, 0), arg);
+				return (unsigned)get_tarval_long(res);
+			} else if (is_Jmp(node)) {
+				next = get_irn_out(node, 0);
+			} else if (is_Cond(node)) {
+				ir_node   *cmp   = get_Cond_selector(node);
+				ir_tarval *l     = eval(get_Cmp_left(cmp), arg);
+				ir_tarval *r     = eval(get_Cmp_right(cmp), arg);
+				bool       taken = tarval_cmp(l, r) & get_Cmp_relation(cmp);
+				next = get_succ(node, taken ? pn_Cond_true : pn_Cond_false);
+			} else if (is_Switch(node)) {
+				ir_tarval *sel = eval(get_Switch_selector(node), arg);
+				next = get_succ(node, eval_switch(node, sel));
+			}
+		}
+		assert(next != NULL);
+		block = next;
+	}
+}
+
+typedef struct counts_t {
+	unsigned switches;
+	unsigned table_entries;
+	unsigned bit_tests;
+	unsigned bisections;
+} counts_t;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (is_Switch(node)) {
+		++counts->switches;
+		counts->table_entries
+			= ir_switch_table_get_n_entries(get_Switch_table(node));
+	} else if (is_And(node) && is_Shl(get_And_left(node))) {
+		++counts->bit_tests;
+	} else if (is_Cmp(node) && is_Proj(get_Cmp_left(node))
+	           && is_Const(get_Cmp_right(node))) {
+		/* x < min resp. x <= min - 1 for the minimum of a cluster */
+		long bound = get_tarval_long(get_Const_tarval(get_Cmp_right(node)));
+		ir_relation relation = get_Cmp_relation(node);
+		if (relation == ir_relation_less_equal)
+			++bound;
+		else if (relation != ir_relation_less)
+			return;
+		if (bound == 100 || bound == 1000 || bound == 5000 || bound == 20000)
+			++counts->bisections;
+	}
+}
+
+int main(void)
+{
+	ir_init();
+	int_type = new_type_primitive(mode_Iu);
+
+	ir_graph *irg = build_graph();
+	lower_switch(irg, 10, 128, mode_Iu);
+	assert(irg_verify(irg));
+
+	/* 100..115 is a jump table, 0..12 uses bit tests for its two targets and
+	 * the tree bisects the clusters */
+	counts_t counts = { 0, 0, 0, 0 };
+	irg_walk_graph(irg, count, NULL, &counts);
+	assert(counts.switches == 1);
+	assert(counts.table_entries == 16);
+	assert(counts.bit_tests == 2);
+	assert(counts.bisections >= 2);
+
+	assure_irg_outs(irg);
+	static unsigned const values[] = {
+		2, 4, 6, 8, 10, 11, 13, 31, 32, 33, 64, 99, 116, 117, 999, 1001, 4999,
+		5001, 19999, 20001, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF,
+	};
+	for (unsigned x = 0; x < 120; ++x)
+		assert(run(irg, x) == reference(x));
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+		assert(run(irg, values[i]) == reference(values[i]));
+		assert(run(irg, values[i] + 1000) == reference(values[i] + 1000));
+	}
+	assert(run(irg, 1000) == 7 && run(irg, 5000) == 8 && run(irg, 20000) == 9);
+
+	ir_finish();
+	return 0;
+}
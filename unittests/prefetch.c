@@ -0,0 +1,115 @@
+#include <assert.h>
+#include "firm.h"
+
+typedef struct counts_t {
+	unsigned prefetches;
+	long     min_delta;
+} counts_t;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (!is_Builtin(node) || get_Builtin_kind(node) != ir_bk_prefetch)
+		return;
+	++counts->prefetches;
+	ir_node *addr = get_Builtin_param(node, 0);
+	assert(is_Add(addr) && is_Const(get_Add_right(addr)));
+	long delta = get_tarval_long(get_Const_tarval(get_Add_right(addr)));
+	if (counts->prefetches == 1 || delta < counts->min_delta)
+		counts->min_delta = delta;
+}
+
+static ir_node *new_element(ir_node *array, ir_node *index, long offset)
+{
+	ir_mode *offset_mode = get_reference_offset_mode(mode_P);
+	ir_node *scaled = new_Mul(new_Conv(index, offset_mode),
+	                          new_Const_long(offset_mode, 4));
+	ir_node *addr = new_Add(array, scaled);
+	if (offset != 0)
+		addr = new_Add(addr, new_Const_long(offset_mode, offset * 4));
+	return addr;
+}
+
+static ir_node *new_load(ir_type *type, ir_node *addr)
+{
+	ir_node *load = new_Load(get_store(), addr, mode_Is, type, cons_none);
+	set_store(new_Proj(load, mode_M, pn_Load_M));
+	return new_Proj(load, mode_Is, pn_Load_res);
+}
+
+int main(void)
+{
+	ir_init();
+	ir_type *int_type = new_type_primitive(mode_Is);
+	ir_type *mtp      = new_type_method(3, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, new_type_pointer(int_type));
+	set_method_param_type(mtp, 1, new_type_pointer(int_type));
+	set_method_param_type(mtp, 2, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str("f"), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+
+	/* int f(int *a, int *p, int n)
+	 * {
+	 *     int s = 0;
+	 *     for (int i = 0; i < n; ++i)
+	 *         s += a[i] + a[i + 1] + a[i + 32] + *p;
+	 *     return s;
+	 * } */
+	ir_graph *irg = new_ir_graph(entity, 2);
+	set_current_ir_graph(irg);
+	ir_node *a    = new_Proj(get_irg_args(irg), mode_P, 0);
+	ir_node *p    = new_Proj(get_irg_args(irg), mode_P, 1);
+	ir_node *n    = new_Proj(get_irg_args(irg), mode_Is, 2);
+	ir_node *zero = new_Const_long(mode_Is, 0);
+	set_value(0, zero);
+	set_value(1, zero);
+
+	ir_node *header = new_immBlock();
+	add_immBlock_pred(header, new_Jmp());
+	set_cur_block(header);
+	ir_node *cond = new_Cond(new_Cmp(get_value(0, mode_Is), n,
+	                                 ir_relation_less));
+	ir_node *enter = new_Proj(cond, mode_X, pn_Cond_true);
+	ir_node *leave = new_Proj(cond, mode_X, pn_Cond_false);
+
+	ir_node *body = new_immBlock();
+	add_immBlock_pred(body, enter);
+	mature_immBlock(body);
+	set_cur_block(body);
+	ir_node *i   = get_value(0, mode_Is);
+	ir_node *sum = get_value(1, mode_Is);
+	sum = new_Add(sum, new_load(int_type, new_element(a, i, 0)));
+	sum = new_Add(sum, new_load(int_type, new_element(a, i, 1)));
+	sum = new_Add(sum, new_load(int_type, new_element(a, i, 32)));
+	sum = new_Add(sum, new_load(int_type, p));
+	set_value(1, sum);
+	set_value(0, new_Add(i, new_Const_long(mode_Is, 1)));
+	add_immBlock_pred(header, new_Jmp());
+	mature_immBlock(header);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, leave);
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	ir_node *in[] = { get_value(1, mode_Is) };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+
+	opt_prefetch(irg, 16, 64);
+	assert(irg_verify(irg));
+
+	/* a[i] and a[i + 1] share a cache line, the invariant *p needs none */
+	counts_t counts = { 0, 0 };
+	irg_walk_graph(irg, count, NULL, &counts);
+	assert(counts.prefetches == 2);
+	assert(counts.min_delta == 16 * 4);
+
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,211 @@
+#include <assert.h>
+#include "firm.h"
+
+typedef struct counts_t {
+	ir_node *len;
+	unsigned len_checks;   /* Conds in loops comparing with len */
+	unsigned guards;       /* Conds outside of loops comparing with len */
+	unsigned decided;      /* Conds with a constant selector */
+} counts_t;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (!is_Cond(node))
+		return;
+	ir_node *sel = get_Cond_selector(node);
+	if (is_Const(sel)) {
+		++counts->decided;
+		return;
+	}
+	if (!is_Cmp(sel)
+	    || (get_Cmp_left(sel) != counts->len
+	        && get_Cmp_right(sel) != counts->len))
+		return;
+	if (get_loop_depth(get_irn_loop(get_nodes_block(node))) > 0)
+		++counts->len_checks;
+	else
+		++counts->guards;
+}
+
+static counts_t count_conds(ir_graph *irg, ir_node *len)
+{
+	assure_loopinfo(irg);
+	counts_t counts = { len, 0, 0, 0 };
+	irg_walk_graph(irg, count, NULL, &counts);
+	return counts;
+}
+
+static ir_graph *new_graph(char const *name, size_t n_params, int n_locs)
+{
+	ir_type *int_type = new_type_primitive(mode_Is);
+	ir_type *mtp      = new_type_method(n_params, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	for (size_t i = 0; i < n_params; ++i)
+		set_method_param_type(mtp, i, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+	ir_graph *irg = new_ir_graph(entity, n_locs);
+	set_current_ir_graph(irg);
+	return irg;
+}
+
+static void new_return(ir_graph *irg, ir_node *value)
+{
+	ir_node *in[] = { value };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+}
+
+/* int checks(int x, int len)
+ * {
+ *     if (x < len) {
+ *         if (x <= len) {
+ *             if (x < 10) {
+ *                 if (x < 20)
+ *                     return 1;
+ *             }
+ *         }
+ *     }
+ *     return 0;
+ * } */
+static ir_graph *build_checks(ir_node **len)
+{
+	ir_graph *irg = new_graph("checks", 2, 0);
+	ir_node  *x   = new_Proj(get_irg_args(irg), mode_Is, 0);
+	*len = new_Proj(get_irg_args(irg), mode_Is, 1);
+
+	ir_node     *bounds[4]    = {
+		*len, *len, new_Const_long(mode_Is, 10), new_Const_long(mode_Is, 20)
+	};
+	ir_relation  relations[4] = {
+		ir_relation_less, ir_relation_less_equal, ir_relation_less,
+		ir_relation_less
+	};
+	ir_node     *exit         = new_immBlock();
+	for (size_t i = 0; i < 4; ++i) {
+		ir_node *cond = new_Cond(new_Cmp(x, bounds[i], relations[i]));
+		add_immBlock_pred(exit, new_Proj(cond, mode_X, pn_Cond_false));
+		ir_node *then = new_immBlock();
+		add_immBlock_pred(then, new_Proj(cond, mode_X, pn_Cond_true));
+		mature_immBlock(then);
+		set_cur_block(then);
+	}
+	new_return(irg, new_Const_long(mode_Is, 1));
+
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	new_return(irg, new_Const_long(mode_Is, 0));
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+/* int loop(int n, int len)
+ * {
+ *     int s = 0;
+ *     for (int i = 0; i < n; ++i) {
+ *         if (i < 0)
+ *             return -2;
+ *         if (i >= len)
+ *             return -1;
+ *         s += i;
+ *     }
+ *     return s;
+ * } */
+static ir_graph *build_loop(ir_node **len)
+{
+	ir_graph *irg  = new_graph("loop", 2, 2);
+	ir_node  *n    = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node  *zero = new_Const_long(mode_Is, 0);
+	*len = new_Proj(get_irg_args(irg), mode_Is, 1);
+	set_value(0, zero);
+	set_value(1, zero);
+
+	ir_node *header = new_immBlock();
+	add_immBlock_pred(header, new_Jmp());
+	set_cur_block(header);
+	ir_node *cond = new_Cond(new_Cmp(get_value(0, mode_Is), n,
+	                                 ir_relation_less));
+	ir_node *leave = new_Proj(cond, mode_X, pn_Cond_false);
+
+	ir_node *body = new_immBlock();
+	add_immBlock_pred(body, new_Proj(cond, mode_X, pn_Cond_true));
+	mature_immBlock(body);
+	set_cur_block(body);
+	ir_node *i             = get_value(0, mode_Is);
+	ir_node *negative_cond = new_Cond(new_Cmp(i, zero, ir_relation_less));
+
+	ir_node *negative = new_immBlock();
+	add_immBlock_pred(negative, new_Proj(negative_cond, mode_X,
+	                                     pn_Cond_true));
+	mature_immBlock(negative);
+	set_cur_block(negative);
+	new_return(irg, new_Const_long(mode_Is, -2));
+
+	ir_node *positive = new_immBlock();
+	add_immBlock_pred(positive, new_Proj(negative_cond, mode_X,
+	                                     pn_Cond_false));
+	mature_immBlock(positive);
+	set_cur_block(positive);
+	ir_node *bounds_cond = new_Cond(new_Cmp(i, *len,
+	                                        ir_relation_greater_equal));
+
+	ir_node *out_of_bounds = new_immBlock();
+	add_immBlock_pred(out_of_bounds, new_Proj(bounds_cond, mode_X,
+	                                          pn_Cond_true));
+	mature_immBlock(out_of_bounds);
+	set_cur_block(out_of_bounds);
+	new_return(irg, new_Const_long(mode_Is, -1));
+
+	ir_node *in_bounds = new_immBlock();
+	add_immBlock_pred(in_bounds, new_Proj(bounds_cond, mode_X,
+	                                      pn_Cond_false));
+	mature_immBlock(in_bounds);
+	set_cur_block(in_bounds);
+	set_value(1, new_Add(get_value(1, mode_Is), i));
+	set_value(0, new_Add(i, new_Const_long(mode_Is, 1)));
+	add_immBlock_pred(header, new_Jmp());
+	mature_immBlock(header);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, leave);
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	new_return(irg, get_value(1, mode_Is));
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+int main(void)
+{
+	ir_init();
+
+	/* x <= len and x < 20 are implied by the dominating checks */
+	ir_node  *len;
+	ir_graph *checks = build_checks(&len);
+	opt_range_checks(checks);
+	assert(irg_verify(checks));
+	counts_t counts = count_conds(checks, len);
+	assert(counts.decided == 2);
+	assert(counts.guards == 1);
+
+	/* i < 0 is decided by the induction variable, i >= len is moved in
+	 * front of the loop as n <= len */
+	ir_graph *loop = build_loop(&len);
+	counts_t before = count_conds(loop, len);
+	assert(before.len_checks == 1 && before.guards == 0);
+	opt_range_checks(loop);
+	assert(irg_verify(loop));
+	counts_t after = count_conds(loop, len);
+	assert(after.guards == 1);
+	assert(after.len_checks == 1);
+	assert(after.decided == 2);
+
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include "sbitset.h"
+#include <stdio.h>
+#include <assert.h>
+
+#define UNIVERSE 5000
+
+static unsigned rnd_state = 12345;
+
+static unsigned rnd(void)
+{
+	rnd_state = rnd_state * 1103515245u + 12345u;
+	return rnd_state >> 8;
+}
+
+/** Check that a sparse bitset contains exactly the bits of a raw bitset. */
+static void verify(const sbitset_t *set, const unsigned *ref)
+{
+	size_t n = 0;
+	sbitset_foreach(set, elm) {
+		assert(rbitset_is_set(ref, elm));
+		++n;
+	}
+	assert(n == rbitset_popcount(ref, UNIVERSE));
+	assert(sbitset_popcount(set) == n);
+	assert(sbitset_is_empty(set) == (n == 0));
+	for (size_t i = 0; i < UNIVERSE; ++i)
+		assert(sbitset_is_set(set, i) == rbitset_is_set(ref, i));
+}
+
+static void fill(sbitset_t *set, unsigned *ref, unsigned n_bits)
+{
+	for (unsigned i = 0; i < n_bits; ++i) {
+		size_t pos = rnd() % UNIVERSE;
+		sbitset_set(set, pos);
+		rbitset_set(ref, pos);
+	}
+}
+
+static void test_basic(void)
+{
+	sbitset_t set;
+	sbitset_init(&set, 1000);
+	assert(sbitset_is_empty(&set));
+	assert(sbitset_next(&set, 0) == (size_t)-1);
+
+	sbitset_set(&set, 3);
+	sbitset_set(&set, 59);
+	assert(!sbitset_is_dense(&set));
+	assert(sbitset_next(&set, 0) == 3);
+	assert(sbitset_next(&set, 3) == 3);
+	assert(sbitset_next(&set, 4) == 59);
+	assert(sbitset_next(&set, 60) == (size_t)-1);
+	assert(sbitset_next(&set, 1000) == (size_t)-1);
+
+	sbitset_clear(&set, 3);
+	sbitset_clear(&set, 59);
+	assert(sbitset_is_empty(&set));
+
+	sbitset_set_all(&set);
+	assert(sbitset_is_dense(&set));
+	assert(sbitset_popcount(&set) == 1000);
+	sbitset_clear_all(&set);
+	assert(!sbitset_is_dense(&set));
+	assert(sbitset_is_empty(&set));
+	sbitset_free(&set);
+}
+
+static void test_sparse_large(void)
+{
+	/* a few bits in a huge universe must stay sparse */
+	sbitset_t set;
+	sbitset_init(&set, 1000000);
+	sbitset_set(&set, 999999);
+	sbitset_set(&set, 17);
+	sbitset_set(&set, 500000);
+	assert(!sbitset_is_dense(&set));
+	assert(sbitset_next(&set, 0) == 17);
+	assert(sbitset_next(&set, 18) == 500000);
+	assert(sbitset_next(&set, 500001) == 999999);
+	assert(sbitset_popcount(&set) == 3);
+	sbitset_free(&set);
+}
+
+static void test_random(unsigned n1, unsigned n2)
+{
+	sbitset_t a;
+	sbitset_t b;
+	sbitset_t c;
+	sbitset_init(&a, UNIVERSE);
+	sbitset_init(&b, UNIVERSE);
+	sbitset_init(&c, UNIVERSE);
+	unsigned *ra = rbitset_malloc(UNIVERSE);
+	unsigned *rb = rbitset_malloc(UNIVERSE);
+
+	fill(&a, ra, n1);
+	fill(&b, rb, n2);
+	verify(&a, ra);
+	verify(&b, rb);
+
+	sbitset_copy(&c, &a);
+	assert(sbitsets_equal(&c, &a));
+	verify(&c, ra);
+
+	sbitset_or(&c, &b);
+	rbitset_or(ra, rb, UNIVERSE);
+	verify(&c, ra);
+
+	sbitset_and(&c, &b);
+	rbitset_and(ra, rb, UNIVERSE);
+	verify(&c, ra);
+	assert(sbitsets_equal(&c, &b));
+
+	sbitset_copy(&c, &a);
+	rbitset_clear_all(ra, UNIVERSE);
+	sbitset_foreach(&a, elm) {
+		rbitset_set(ra, elm);
+	}
+	sbitset_andnot(&c, &b);
+	rbitset_andnot(ra, rb, UNIVERSE);
+	verify(&c, ra);
+
+	for (unsigned i = 0; i < n1; ++i) {
+		size_t pos = rnd() % UNIVERSE;
+		sbitset_clear(&a, pos);
+		sbitset_clear(&c, pos);
+		rbitset_clear(ra, pos);
+	}
+	verify(&c, ra);
+
+	sbitset_set_all(&c);
+	sbitset_and(&c, &b);
+	verify(&c, rb);
+	assert(sbitsets_equal(&b, &c));
+
+	sbitset_free(&a);
+	sbitset_free(&b);
+	sbitset_free(&c);
+	free(ra);
+	free(rb);
+}
+
+int main(void)
+{
+	test_basic();
+	test_sparse_large();
+
+	/* exercise sparse/sparse, sparse/dense and dense/dense combinations */
+	test_random(10, 10);
+	test_random(10, 3000);
+	test_random(3000, 10);
+	test_random(3000, 3000);
+	test_random(0, 500);
+	test_random(500, 0);
+
+	return 0;
+}
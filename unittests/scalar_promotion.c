@@ -0,0 +1,167 @@
+#include <assert.h>
+#include <stdbool.h>
+#include "firm.h"
+
+typedef struct counts_t {
+	unsigned loads;
+	unsigned stores;
+	unsigned in_loop;
+} counts_t;
+
+static ir_type   *int_type;
+static ir_entity *sum;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (is_Load(node))
+		++counts->loads;
+	else if (is_Store(node))
+		++counts->stores;
+	else
+		return;
+	if (get_loop_depth(get_irn_loop(get_nodes_block(node))) > 0)
+		++counts->in_loop;
+}
+
+static counts_t count_memops(ir_graph *irg)
+{
+	assure_loopinfo(irg);
+	counts_t counts = { 0, 0, 0 };
+	irg_walk_graph(irg, count, NULL, &counts);
+	return counts;
+}
+
+/* int name(int n, int *p)
+ * {
+ *     int i = 0;
+ *     do {
+ *         int s = loc;
+ *         if (!conditional || (i & 1))
+ *             loc = s + i;
+ *         if (store_p) *p = i;
+ *     } while (++i < n);
+ *     return n;
+ * }
+ * loc is the global sum or a local variable if local is set. */
+static ir_graph *build_graph(char const *name, bool local, bool conditional,
+                             bool store_p)
+{
+	ir_type *mtp = new_type_method(2, 1, 0, cc_cdecl_set, mtp_no_property);
+	set_method_param_type(mtp, 0, int_type);
+	set_method_param_type(mtp, 1, new_type_pointer(int_type));
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+
+	ir_graph *irg = new_ir_graph(entity, 1);
+	set_current_ir_graph(irg);
+	ir_node *n = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node *p = new_Proj(get_irg_args(irg), mode_P, 1);
+	set_value(0, new_Const_long(mode_Is, 0));
+	ir_node *addr;
+	if (local) {
+		ir_entity *var = new_entity(get_irg_frame_type(irg),
+		                            new_id_from_str("loc"), int_type);
+		addr = new_Member(get_irg_frame(irg), var);
+	} else {
+		addr = new_Address(sum);
+	}
+
+	ir_node *header = new_immBlock();
+	add_immBlock_pred(header, new_Jmp());
+	set_cur_block(header);
+	ir_node *i    = get_value(0, mode_Is);
+	ir_node *load = new_Load(get_store(), addr, mode_Is, int_type, cons_none);
+	set_store(new_Proj(load, mode_M, pn_Load_M));
+	ir_node *val  = new_Add(new_Proj(load, mode_Is, pn_Load_res), i);
+	ir_node *skip = NULL;
+	if (conditional) {
+		ir_node *odd  = new_Cmp(new_And(i, new_Const_long(mode_Is, 1)),
+		                        new_Const_long(mode_Is, 0),
+		                        ir_relation_less_greater);
+		ir_node *cond = new_Cond(odd);
+		skip = new_Proj(cond, mode_X, pn_Cond_false);
+		ir_node *then = new_immBlock();
+		add_immBlock_pred(then, new_Proj(cond, mode_X, pn_Cond_true));
+		mature_immBlock(then);
+		set_cur_block(then);
+	}
+	ir_node *store = new_Store(get_store(), addr, val, int_type, cons_none);
+	set_store(new_Proj(store, mode_M, pn_Store_M));
+	if (conditional) {
+		ir_node *join = new_immBlock();
+		add_immBlock_pred(join, new_Jmp());
+		add_immBlock_pred(join, skip);
+		mature_immBlock(join);
+		set_cur_block(join);
+	}
+	if (store_p) {
+		store = new_Store(get_store(), p, i, int_type, cons_none);
+		set_store(new_Proj(store, mode_M, pn_Store_M));
+	}
+	ir_node *next = new_Add(i, new_Const_long(mode_Is, 1));
+	set_value(0, next);
+	ir_node *cond = new_Cond(new_Cmp(next, n, ir_relation_less));
+	add_immBlock_pred(header, new_Proj(cond, mode_X, pn_Cond_true));
+	mature_immBlock(header);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, new_Proj(cond, mode_X, pn_Cond_false));
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	ir_node *in[] = { n };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+int main(void)
+{
+	ir_init();
+	int_type = new_type_primitive(mode_Is);
+	sum      = new_global_entity(get_glob_type(), new_id_from_str("sum"),
+	                             int_type, ir_visibility_external,
+	                             IR_LINKAGE_DEFAULT);
+
+	ir_graph *f = build_graph("f", false, false, false);
+	counts_t before = count_memops(f);
+	assert(before.loads == 1 && before.stores == 1 && before.in_loop == 2);
+
+	/* sum lives in a value, it is loaded before and stored after the loop */
+	opt_scalar_promotion(f);
+	assert(irg_verify(f));
+	counts_t after = count_memops(f);
+	assert(after.loads == 1 && after.stores == 1 && after.in_loop == 0);
+
+	/* the Store through p may change sum */
+	ir_graph *g = build_graph("g", false, false, true);
+	opt_scalar_promotion(g);
+	assert(irg_verify(g));
+	counts_t unchanged = count_memops(g);
+	assert(unchanged.loads == 1 && unchanged.stores == 2);
+	assert(unchanged.in_loop == 3);
+
+	/* sum is only stored in odd iterations, the Store after the loop would
+	 * write it in even ones, too */
+	ir_graph *h = build_graph("h", false, true, false);
+	opt_scalar_promotion(h);
+	assert(irg_verify(h));
+	counts_t conditional = count_memops(h);
+	assert(conditional.loads == 1 && conditional.stores == 1);
+	assert(conditional.in_loop == 2);
+
+	/* no other thread can see the local variable */
+	ir_graph *l = build_graph("l", true, true, false);
+	opt_scalar_promotion(l);
+	assert(irg_verify(l));
+	counts_t local = count_memops(l);
+	assert(local.loads == 1 && local.stores == 1 && local.in_loop == 0);
+
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,465 @@
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "firm.h"
+#include "lower_softfloat.h"
+
+typedef ir_node *(*binop_cons)(ir_node *left, ir_node *right);
+
+/* the relations which are not folded at construction */
+#define N_RELATIONS 14
+
+static ir_graph *add_f;
+static ir_graph *sub_f;
+static ir_graph *mul_f;
+static ir_graph *add_d;
+static ir_graph *sub_d;
+static ir_graph *cmp_f[N_RELATIONS];
+static ir_graph *cmp_d[N_RELATIONS];
+
+/* the state of the interpreter */
+static ir_tarval *args[2];
+static int        entered_pos;
+
+static uint64_t float_bits(float f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+static uint64_t double_bits(double d)
+{
+	uint64_t bits;
+	memcpy(&bits, &d, sizeof(bits));
+	return bits;
+}
+
+static float bits_float(uint64_t bits)
+{
+	uint32_t b = (uint32_t)bits;
+	float    f;
+	memcpy(&f, &b, sizeof(f));
+	return f;
+}
+
+static double bits_double(uint64_t bits)
+{
+	double d;
+	memcpy(&d, &bits, sizeof(d));
+	return d;
+}
+
+static ir_tarval *new_tarval_from_bits(uint64_t bits, ir_mode *mode)
+{
+	unsigned char buf[8];
+	for (unsigned i = 0; i < sizeof(buf); ++i)
+		buf[i] = (unsigned char)(bits >> (8 * i));
+	return new_tarval_from_bytes(buf, mode);
+}
+
+static uint64_t get_tarval_bits(ir_tarval const *tv)
+{
+	uint64_t bits = 0;
+	for (unsigned i = 0, n = get_mode_size_bytes(get_tarval_mode(tv)); i < n;
+	     ++i)
+		bits |= (uint64_t)get_tarval_sub_bits(tv, i) << (8 * i);
+	return bits;
+}
+
+static ir_graph *new_graph(char const *name, ir_mode *mode, ir_mode *res_mode)
+{
+	ir_type *type     = new_type_primitive(mode);
+	ir_type *res_type = new_type_primitive(res_mode);
+	ir_type *mtp      = new_type_method(2, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, type);
+	set_method_param_type(mtp, 1, type);
+	set_method_res_type(mtp, 0, res_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str(name), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+	ir_graph *irg = new_ir_graph(entity, 1);
+	set_current_ir_graph(irg);
+	return irg;
+}
+
+static void finish_graph(ir_graph *irg, ir_node *res)
+{
+	ir_node *ret = new_Return(get_store(), 1, &res);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+}
+
+/* T f(T a, T b) { return a op b; } */
+static ir_graph *build_binop(char const *name, ir_mode *mode, binop_cons cons)
+{
+	ir_graph *irg    = new_graph(name, mode, mode);
+	ir_node  *params = get_irg_args(irg);
+	ir_node  *a      = new_Proj(params, mode, 0);
+	ir_node  *b      = new_Proj(params, mode, 1);
+	finish_graph(irg, cons(a, b));
+	return irg;
+}
+
+/* int f(T a, T b) { if (a relation b) return 1; return 0; } */
+static ir_graph *build_cmp(char const *name, ir_mode *mode,
+                           ir_relation relation)
+{
+	ir_graph *irg    = new_graph(name, mode, mode_Is);
+	ir_node  *params = get_irg_args(irg);
+	ir_node  *a      = new_Proj(params, mode, 0);
+	ir_node  *b      = new_Proj(params, mode, 1);
+	ir_node  *cond   = new_Cond(new_Cmp(a, b, relation));
+	ir_node  *join   = new_immBlock();
+	ir_node  *then   = new_immBlock();
+	add_immBlock_pred(then, new_Proj(cond, mode_X, pn_Cond_true));
+	mature_immBlock(then);
+	set_cur_block(then);
+	set_value(0, new_Const_long(mode_Is, 1));
+	add_immBlock_pred(join, new_Jmp());
+	ir_node *other = new_immBlock();
+	add_immBlock_pred(other, new_Proj(cond, mode_X, pn_Cond_false));
+	mature_immBlock(other);
+	set_cur_block(other);
+	set_value(0, new_Const_long(mode_Is, 0));
+	add_immBlock_pred(join, new_Jmp());
+	mature_immBlock(join);
+	set_cur_block(join);
+	finish_graph(irg, get_value(0, mode_Is));
+	return irg;
+}
+
+static ir_tarval *eval(ir_node *node);
+
+static ir_tarval *eval_op(ir_node *node, unsigned n)
+{
+	return eval(get_irn_n(node, n));
+}
+
+static ir_tarval *eval_uncached(ir_node *node)
+{
+	switch (get_irn_opcode(node)) {
+	case iro_Const: return get_Const_tarval(node);
+	case iro_Proj:  return args[get_Proj_num(node)];
+	case iro_Conv:
+		return tarval_convert_to(eval_op(node, 0), get_irn_mode(node));
+	case iro_Minus: return tarval_neg(eval_op(node, 0));
+	case iro_Not:   return tarval_not(eval_op(node, 0));
+	case iro_Add: return tarval_add(eval_op(node, 0), eval_op(node, 1));
+	case iro_Sub: return tarval_sub(eval_op(node, 0), eval_op(node, 1));
+	case iro_Mul: return tarval_mul(eval_op(node, 0), eval_op(node, 1));
+	case iro_And: return tarval_and(eval_op(node, 0), eval_op(node, 1));
+	case iro_Or:  return tarval_or(eval_op(node, 0), eval_op(node, 1));
+	case iro_Eor: return tarval_eor(eval_op(node, 0), eval_op(node, 1));
+	case iro_Shl: return tarval_shl(eval_op(node, 0), eval_op(node, 1));
+	case iro_Shr: return tarval_shr(eval_op(node, 0), eval_op(node, 1));
+	case iro_Shrs: return tarval_shrs(eval_op(node, 0), eval_op(node, 1));
+	case iro_Phi:  return eval_op(node, entered_pos);
+	default:
+		assert(false);
+		return NULL;
+	}
+}
+
+/* The values are cached in the links for one run. */
+static ir_tarval *eval(ir_node *node)
+{
+	if (irn_visited_else_mark(node))
+		return (ir_tarval*)get_irn_link(node);
+	ir_tarval *tv = eval_uncached(node);
+	set_irn_link(node, tv);
+	return tv;
+}
+
+static bool eval_cmp(ir_node *cmp)
+{
+	ir_tarval *l = eval(get_Cmp_left(cmp));
+	ir_tarval *r = eval(get_Cmp_right(cmp));
+	return tarval_cmp(l, r) & get_Cmp_relation(cmp);
+}
+
+static ir_node *get_succ(ir_node *node, unsigned pn)
+{
+	for (unsigned i = 0, n = get_irn_n_outs(node); i < n; ++i) {
+		ir_node *proj = get_irn_out(node, i);
+		if (get_Proj_num(proj) == pn)
+			return proj;
+	}
+	assert(false);
+	return NULL;
+}
+
+static bool interpret(ir_graph *irg, uint64_t *result)
+{
+	ir_node *block = get_irg_start_block(irg);
+	for (;;) {
+		ir_node *next = NULL;
+		for (unsigned i = 0, n = get_irn_n_outs(block); i < n; ++i) {
+			ir_node *node = get_irn_out(block, i);
+			if (is_Call(node)) {
+				return false;
+			} else if (is_Return(node)) {
+				*result = get_tarval_bits(eval(get_Return_res(node, 0)));
+				return true;
+			} else if (is_Jmp(node)) {
+				next = node;
+			} else if (is_Cond(node)) {
+				bool taken = eval_cmp(get_Cond_selector(node));
+				next = get_succ(node, taken ? pn_Cond_true : pn_Cond_false);
+			}
+		}
+		assert(next != NULL);
+		block = get_irn_out(next, 0);
+		for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+			if (get_Block_cfgpred(block, i) == next)
+				entered_pos = i;
+		}
+	}
+}
+
+/**
+ * Interprets the lowered graph for the operand bits a and b.
+ * @return false if the library is called.
+ */
+static bool run(ir_graph *irg, uint64_t a, uint64_t b, uint64_t *result)
+{
+	ir_mode *mode = get_type_mode(get_method_param_type(
+		get_entity_type(get_irg_entity(irg)), 0));
+	args[0] = new_tarval_from_bits(a, mode);
+	args[1] = new_tarval_from_bits(b, mode);
+
+	ir_reserve_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_IRN_VISITED);
+	inc_irg_visited(irg);
+	bool fast = interpret(irg, result);
+	ir_free_resources(irg, IR_RESOURCE_IRN_LINK | IR_RESOURCE_IRN_VISITED);
+	return fast;
+}
+
+static void check_add_f(ir_graph *irg, float a, float b, float expect,
+                        bool must_be_fast, bool must_be_slow)
+{
+	uint64_t result;
+	bool     fast = run(irg, float_bits(a), float_bits(b), &result);
+	assert(!must_be_fast || fast);
+	assert(!must_be_slow || !fast);
+	assert(!fast || result == float_bits(expect));
+}
+
+static void check_f(float a, float b, bool must_be_fast, bool must_be_slow)
+{
+	volatile float va = a;
+	volatile float vb = b;
+	check_add_f(add_f, a, b, va + vb, must_be_fast, must_be_slow);
+	check_add_f(sub_f, a, -b, va - -vb, must_be_fast, must_be_slow);
+}
+
+static void check_mul_f(float a, float b, bool must_be_fast,
+                        bool must_be_slow)
+{
+	volatile float va = a;
+	volatile float vb = b;
+	check_add_f(mul_f, a, b, va * vb, must_be_fast, must_be_slow);
+}
+
+static void check_d(double a, double b, bool must_be_fast, bool must_be_slow)
+{
+	volatile double va = a;
+	volatile double vb = b;
+	uint64_t result;
+	bool     fast = run(add_d, double_bits(a), double_bits(b), &result);
+	assert(!must_be_fast || fast);
+	assert(!must_be_slow || !fast);
+	assert(!fast || result == double_bits(va + vb));
+	fast = run(sub_d, double_bits(a), double_bits(-b), &result);
+	assert(!must_be_fast || fast);
+	assert(!must_be_slow || !fast);
+	assert(!fast || result == double_bits(va - -vb));
+}
+
+static ir_relation host_relation(double a, double b)
+{
+	if (isnan(a) || isnan(b))
+		return ir_relation_unordered;
+	return a < b ? ir_relation_less
+	     : a > b ? ir_relation_greater : ir_relation_equal;
+}
+
+static void check_cmp(double a, double b)
+{
+	ir_relation const expect = host_relation(a, b);
+	for (unsigned r = 0; r < N_RELATIONS; ++r) {
+		ir_relation const relation = (ir_relation)(r + 1);
+		uint64_t          result   = 0;
+		bool fast = run(cmp_f[r], float_bits((float)a), float_bits((float)b),
+		                &result);
+		assert(fast);
+		assert(result == ((expect & relation) != 0));
+		fast = run(cmp_d[r], double_bits(a), double_bits(b), &result);
+		assert(fast);
+		assert(result == ((expect & relation) != 0));
+	}
+}
+
+static uint64_t random_state = 0x123456789ABCDEFull;
+
+static uint64_t random_bits(void)
+{
+	random_state = random_state * 6364136223846793005ull
+	             + 1442695040888963407ull;
+	return random_state >> 11;
+}
+
+/* A random normal float with a biased exponent in [exp, exp + range). */
+static float random_float(unsigned exp, unsigned range)
+{
+	uint64_t bits  = random_bits();
+	uint64_t sign  = (bits & 1) << 31;
+	uint64_t e     = exp + (bits >> 1) % range;
+	uint64_t mant  = (bits >> 8) & 0x7FFFFF;
+	return bits_float(sign | e << 23 | mant);
+}
+
+static double random_double(unsigned exp, unsigned range)
+{
+	uint64_t bits = random_bits();
+	uint64_t sign = (bits & 1) << 63;
+	uint64_t e    = exp + (bits >> 1) % range;
+	uint64_t mant = (random_bits() << 11 ^ bits) & 0xFFFFFFFFFFFFFull;
+	return bits_double(sign | e << 52 | mant);
+}
+
+static void test_add(void)
+{
+	float const denorm = FLT_MIN / 4;
+	float const eps    = FLT_EPSILON;
+
+	/* normal operands and results are computed inline, including the
+	 * rounding to nearest even and a mantissa carry */
+	check_f(1.0f, 2.0f, true, false);
+	check_f(1.0f, eps / 2, true, false);
+	check_f(1.0f, eps / 2 * 3, true, false);
+	check_f(1.0f + eps, eps / 2, true, false);
+	check_f(2.0f - eps, eps, true, false);
+	check_f(1.0f, ldexpf(1.0f, -30), true, false);
+	check_f(-3.5f, 1.25f, true, false);
+	check_f(FLT_MAX / 4, FLT_MAX / 2, true, false);
+
+	/* the library handles everything else */
+	check_f(0.0f, 1.0f, false, true);
+	check_f(1.0f, -0.0f, false, true);
+	check_f(denorm, 1.0f, false, true);
+	check_f(denorm, denorm, false, true);
+	check_f(INFINITY, 1.0f, false, true);
+	check_f(1.0f, -INFINITY, false, true);
+	check_f(NAN, 1.0f, false, true);
+	check_f(FLT_MAX, FLT_MAX, false, true);
+	check_f(1.0f, -1.0f, false, true);
+	check_f(1.0f, -(1.0f - eps / 2), false, true);
+	check_f(FLT_MIN * 1.5f, -FLT_MIN, false, true);
+	check_f(1.0f, ldexpf(1.0f, -40), false, true);
+
+	unsigned n_fast = 0;
+	for (unsigned i = 0; i < 2000; ++i) {
+		float    a = random_float(100, 50);
+		float    b = random_float(100, 50);
+		uint64_t result;
+		n_fast += run(add_f, float_bits(a), float_bits(b), &result);
+		check_f(a, b, false, false);
+	}
+	assert(n_fast > 1000);
+
+	check_d(1.0, 2.0, true, false);
+	check_d(1.0, DBL_EPSILON / 2, true, false);
+	check_d(1.0 + DBL_EPSILON, DBL_EPSILON / 2, true, false);
+	check_d(2.0 - DBL_EPSILON, DBL_EPSILON, true, false);
+	check_d(0.0, 1.0, false, true);
+	check_d(DBL_MIN / 4, 1.0, false, true);
+	check_d(INFINITY, 1.0, false, true);
+	check_d(NAN, 1.0, false, true);
+	check_d(DBL_MAX, DBL_MAX, false, true);
+	check_d(1.0, -(1.0 - DBL_EPSILON / 2), false, true);
+	for (unsigned i = 0; i < 2000; ++i)
+		check_d(random_double(1000, 50), random_double(1000, 50), false,
+		        false);
+}
+
+static void test_mul(void)
+{
+	float const eps = FLT_EPSILON;
+	check_mul_f(3.0f, 5.0f, true, false);
+	check_mul_f(1.5f, -1.5f, true, false);
+	check_mul_f(1.0f + eps, 1.0f + eps, true, false);
+	check_mul_f(1.0f + eps, 1.0f - eps / 2, true, false);
+	check_mul_f(2.0f - eps, 2.0f - eps, true, false);
+	check_mul_f(FLT_MIN, 2.0f, true, false);
+
+	check_mul_f(0.0f, 1.0f, false, true);
+	check_mul_f(FLT_MIN / 4, 2.0f, false, true);
+	check_mul_f(INFINITY, 2.0f, false, true);
+	check_mul_f(NAN, 2.0f, false, true);
+	check_mul_f(FLT_MAX, 2.0f, false, true);
+	check_mul_f(1e20f, 1e20f, false, true);
+	check_mul_f(FLT_MIN, 0.5f, false, true);
+	check_mul_f(1e-20f, 1e-20f, false, true);
+
+	for (unsigned i = 0; i < 2000; ++i) {
+		float    a = random_float(64, 126);
+		float    b = random_float(64, 126);
+		uint64_t result;
+		assert(run(mul_f, float_bits(a), float_bits(b), &result));
+		check_mul_f(a, b, true, false);
+	}
+}
+
+static void test_cmp(void)
+{
+	static double const values[] = {
+		0.0, -0.0, 1.0, -1.0, 2.0, -2.0, 1.5, FLT_MIN / 4, -FLT_MIN / 4,
+		FLT_MAX, -FLT_MAX, INFINITY, -INFINITY, NAN, -NAN,
+	};
+	size_t const n_values = sizeof(values) / sizeof(values[0]);
+	for (size_t i = 0; i < n_values; ++i) {
+		for (size_t j = 0; j < n_values; ++j)
+			check_cmp(values[i], values[j]);
+	}
+}
+
+int main(void)
+{
+	ir_init();
+
+	add_f = build_binop("add_f", mode_F, new_Add);
+	sub_f = build_binop("sub_f", mode_F, new_Sub);
+	mul_f = build_binop("mul_f", mode_F, new_Mul);
+	add_d = build_binop("add_d", mode_D, new_Add);
+	sub_d = build_binop("sub_d", mode_D, new_Sub);
+	for (unsigned r = 0; r < N_RELATIONS; ++r) {
+		ir_relation relation = (ir_relation)(r + 1);
+		char        name[16];
+		snprintf(name, sizeof(name), "cmp_f%u", r);
+		cmp_f[r] = build_cmp(name, mode_F, relation);
+		snprintf(name, sizeof(name), "cmp_d%u", r);
+		cmp_d[r] = build_cmp(name, mode_D, relation);
+	}
+
+	lower_floating_point(true);
+	for (size_t i = 0, n = get_irp_n_irgs(); i < n; ++i) {
+		ir_graph *irg = get_irp_irg(i);
+		assert(irg_verify(irg));
+		assure_irg_outs(irg);
+	}
+
+	test_add();
+	test_mul();
+	test_cmp();
+
+	ir_finish();
+	return 0;
+}
@@ -0,0 +1,240 @@
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include "firm.h"
+
+#define MAX_RETURNS 4
+
+typedef struct counts_t {
+	unsigned n_returns;
+	ir_node *return_blocks[MAX_RETURNS];
+	unsigned n_cmps;
+	unsigned n_muls;
+} counts_t;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (is_Return(node)) {
+		assert(counts->n_returns < MAX_RETURNS);
+		counts->return_blocks[counts->n_returns++] = get_nodes_block(node);
+	} else if (is_Cmp(node)) {
+		++counts->n_cmps;
+	} else if (is_Mul(node)) {
+		++counts->n_muls;
+	}
+}
+
+static counts_t get_counts(ir_graph *irg)
+{
+	counts_t counts = { .n_returns = 0 };
+	irg_walk_graph(irg, count, NULL, &counts);
+	return counts;
+}
+
+static ir_entity *new_function(char const *name)
+{
+	ir_type *int_type = new_type_primitive(mode_Is);
+	ir_type *mtp      = new_type_method(1, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	return new_global_entity(get_glob_type(), new_id_from_str(name), mtp,
+	                         ir_visibility_external, IR_LINKAGE_DEFAULT);
+}
+
+/* int f(int x)
+ * {
+ *     int r;
+ *     if (x < 0)
+ *         r = -x;
+ *     else
+ *         r = x;
+ *     return r + 1;
+ * } */
+static ir_graph *build_graph(char const *name)
+{
+	ir_graph *irg = new_ir_graph(new_function(name), 1);
+	set_current_ir_graph(irg);
+	ir_node *x    = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node *cond = new_Cond(new_Cmp(x, new_Const_long(mode_Is, 0),
+	                                 ir_relation_less));
+
+	ir_node *join = new_immBlock();
+	ir_node *then = new_immBlock();
+	add_immBlock_pred(then, new_Proj(cond, mode_X, pn_Cond_true));
+	mature_immBlock(then);
+	set_cur_block(then);
+	set_value(0, new_Minus(x));
+	add_immBlock_pred(join, new_Jmp());
+
+	ir_node *other = new_immBlock();
+	add_immBlock_pred(other, new_Proj(cond, mode_X, pn_Cond_false));
+	mature_immBlock(other);
+	set_cur_block(other);
+	set_value(0, x);
+	add_immBlock_pred(join, new_Jmp());
+
+	mature_immBlock(join);
+	set_cur_block(join);
+	ir_node *in[] = {
+		new_Add(get_value(0, mode_Is), new_Const_long(mode_Is, 1))
+	};
+	ir_node *ret = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+/* int h(int n)
+ * {
+ *     int s = 0;
+ *     for (int i = 0; i < n; ++i) {
+ *         if (i & 1)
+ *             s += i;
+ *         else
+ *             s -= i;
+ *         s *= 3;
+ *     }
+ *     return s;
+ * } */
+static ir_graph *build_loop_graph(char const *name, ir_node **header)
+{
+	ir_graph *irg = new_ir_graph(new_function(name), 2);
+	set_current_ir_graph(irg);
+	ir_node *n    = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node *zero = new_Const_long(mode_Is, 0);
+	ir_node *one  = new_Const_long(mode_Is, 1);
+	set_value(0, zero);
+	set_value(1, zero);
+
+	*header = new_immBlock();
+	add_immBlock_pred(*header, new_Jmp());
+	set_cur_block(*header);
+	ir_node *loop_cond = new_Cond(new_Cmp(get_value(1, mode_Is), n,
+	                                      ir_relation_less));
+	ir_node *body = new_immBlock();
+	add_immBlock_pred(body, new_Proj(loop_cond, mode_X, pn_Cond_true));
+	mature_immBlock(body);
+	set_cur_block(body);
+	ir_node *i    = get_value(1, mode_Is);
+	ir_node *odd  = new_Cmp(new_And(i, one), zero, ir_relation_less_greater);
+	ir_node *cond = new_Cond(odd);
+
+	ir_node *join = new_immBlock();
+	ir_node *then = new_immBlock();
+	add_immBlock_pred(then, new_Proj(cond, mode_X, pn_Cond_true));
+	mature_immBlock(then);
+	set_cur_block(then);
+	set_value(0, new_Add(get_value(0, mode_Is), i));
+	add_immBlock_pred(join, new_Jmp());
+	ir_node *other = new_immBlock();
+	add_immBlock_pred(other, new_Proj(cond, mode_X, pn_Cond_false));
+	mature_immBlock(other);
+	set_cur_block(other);
+	set_value(0, new_Sub(get_value(0, mode_Is), i));
+	add_immBlock_pred(join, new_Jmp());
+	mature_immBlock(join);
+	set_cur_block(join);
+	set_value(0, new_Mul(get_value(0, mode_Is), new_Const_long(mode_Is, 3)));
+	set_value(1, new_Add(get_value(1, mode_Is), one));
+	add_immBlock_pred(*header, new_Jmp());
+	mature_immBlock(*header);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, new_Proj(loop_cond, mode_X, pn_Cond_false));
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	ir_node *in[] = { get_value(0, mode_Is) };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+	return irg;
+}
+
+static bool is_in_loop(ir_node *block, ir_loop *loop)
+{
+	for (ir_loop *l = get_irn_loop(block); l != NULL;
+	     l = get_loop_outer_loop(l)) {
+		if (l == loop)
+			return true;
+		if (get_loop_depth(l) == 0)
+			break;
+	}
+	return false;
+}
+
+typedef struct entries_t {
+	ir_loop *loop;
+	unsigned n_entries;
+	ir_node *entry;
+} entries_t;
+
+/* counts the blocks of the loop which are entered from outside */
+static void count_entries(ir_node *block, void *env)
+{
+	entries_t *entries = (entries_t*)env;
+	if (!is_in_loop(block, entries->loop))
+		return;
+	for (int i = 0, n = get_Block_n_cfgpreds(block); i < n; ++i) {
+		if (!is_in_loop(get_Block_cfgpred_block(block, i), entries->loop)) {
+			++entries->n_entries;
+			entries->entry = block;
+			return;
+		}
+	}
+}
+
+int main(void)
+{
+	ir_init();
+
+	/* the join block is duplicated for one of the branches */
+	ir_graph *irg  = build_graph("f");
+	ir_estimate_execfreq(irg);
+	ir_node  *join = get_counts(irg).return_blocks[0];
+	double    freq = get_block_execfreq(join);
+	opt_tail_duplication(irg, 100);
+	assert(irg_verify(irg));
+	counts_t counts = get_counts(irg);
+	assert(counts.n_returns == 2);
+
+	/* the copy takes the frequency of its predecessor from the original */
+	ir_node *copy = counts.return_blocks[0] == join ? counts.return_blocks[1]
+	                                                 : counts.return_blocks[0];
+	assert(copy != join && get_Block_n_cfgpreds(copy) == 1);
+	double copy_freq = get_block_execfreq(copy);
+	assert(copy_freq > 0.0);
+	assert(fabs(copy_freq
+	            - get_block_execfreq(get_Block_cfgpred_block(copy, 0))) < 1e-9);
+	assert(get_block_execfreq(join) < freq);
+	assert(fabs(get_block_execfreq(join) + copy_freq - freq) < 1e-9);
+
+	/* nothing is duplicated without a budget */
+	irg = build_graph("g");
+	ir_estimate_execfreq(irg);
+	opt_tail_duplication(irg, 0);
+	assert(get_counts(irg).n_returns == 1);
+
+	/* the join in the loop body is duplicated, but the header is not: the
+	 * trace through the back edge must not continue into it */
+	ir_node *header;
+	irg = build_loop_graph("h", &header);
+	ir_estimate_execfreq(irg);
+	opt_tail_duplication(irg, 100);
+	assert(irg_verify(irg));
+	counts = get_counts(irg);
+	assert(counts.n_muls == 2);
+	assert(counts.n_cmps == 2);
+
+	assure_irg_properties(irg, IR_GRAPH_PROPERTY_CONSISTENT_LOOPINFO);
+	entries_t entries = { get_irn_loop(header), 0, NULL };
+	assert(get_loop_depth(entries.loop) == 1);
+	irg_block_walk_graph(irg, count_entries, NULL, &entries);
+	assert(entries.n_entries == 1 && entries.entry == header);
+
+	ir_finish();
+	return 0;
+}
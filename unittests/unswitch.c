@@ -0,0 +1,169 @@
+#include <assert.h>
+#include "firm.h"
+
+typedef struct counts_t {
+	ir_node *flag;
+	unsigned conds;
+	unsigned flag_conds;
+	unsigned subs;
+} counts_t;
+
+static void count(ir_node *node, void *env)
+{
+	counts_t *counts = (counts_t*)env;
+	if (is_Sub(node))
+		++counts->subs;
+	if (!is_Cond(node))
+		return;
+	++counts->conds;
+	ir_node *sel = get_Cond_selector(node);
+	if (is_Cmp(sel) && get_Cmp_left(sel) == counts->flag)
+		++counts->flag_conds;
+}
+
+int main(void)
+{
+	ir_init();
+	ir_type *int_type = new_type_primitive(mode_Is);
+	ir_type *mtp      = new_type_method(2, 1, 0, cc_cdecl_set,
+	                                    mtp_no_property);
+	set_method_param_type(mtp, 0, int_type);
+	set_method_param_type(mtp, 1, int_type);
+	set_method_res_type(mtp, 0, int_type);
+	ir_entity *entity = new_global_entity(get_glob_type(),
+	                                      new_id_from_str("f"), mtp,
+	                                      ir_visibility_external,
+	                                      IR_LINKAGE_DEFAULT);
+
+	/* int f(int n, int flag)
+	 * {
+	 *     int s = 0;
+	 *     for (int i = 0; i < n; ++i) {
+	 *         if (flag) s += i; else s -= i;
+	 *     }
+	 *     return s;
+	 * } */
+	ir_graph *irg = new_ir_graph(entity, 2);
+	set_current_ir_graph(irg);
+	ir_node *n    = new_Proj(get_irg_args(irg), mode_Is, 0);
+	ir_node *flag = new_Proj(get_irg_args(irg), mode_Is, 1);
+	ir_node *zero = new_Const_long(mode_Is, 0);
+	set_value(0, zero);
+	set_value(1, zero);
+
+	ir_node *header = new_immBlock();
+	add_immBlock_pred(header, new_Jmp());
+	set_cur_block(header);
+	ir_node *cond = new_Cond(new_Cmp(get_value(0, mode_Is), n,
+	                                 ir_relation_less));
+	ir_node *enter = new_Proj(cond, mode_X, pn_Cond_true);
+	ir_node *leave = new_Proj(cond, mode_X, pn_Cond_false);
+
+	ir_node *body = new_immBlock();
+	add_immBlock_pred(body, enter);
+	mature_immBlock(body);
+	set_cur_block(body);
+	ir_node *flag_cond = new_Cond(new_Cmp(flag, zero,
+	                                      ir_relation_less_greater));
+	ir_node *on  = new_Proj(flag_cond, mode_X, pn_Cond_true);
+	ir_node *off = new_Proj(flag_cond, mode_X, pn_Cond_false);
+
+	ir_node *join = new_immBlock();
+	ir_node *then = new_immBlock();
+	add_immBlock_pred(then, on);
+	mature_immBlock(then);
+	set_cur_block(then);
+	set_value(1, new_Add(get_value(1, mode_Is), get_value(0, mode_Is)));
+	add_immBlock_pred(join, new_Jmp());
+	ir_node *other = new_immBlock();
+	add_immBlock_pred(other, off);
+	mature_immBlock(other);
+	set_cur_block(other);
+	set_value(1, new_Sub(get_value(1, mode_Is), get_value(0, mode_Is)));
+	add_immBlock_pred(join, new_Jmp());
+	mature_immBlock(join);
+	set_cur_block(join);
+	set_value(0, new_Add(get_value(0, mode_Is), new_Const_long(mode_Is, 1)));
+	add_immBlock_pred(header, new_Jmp());
+	mature_immBlock(header);
+
+	ir_node *exit = new_immBlock();
+	add_immBlock_pred(exit, leave);
+	mature_immBlock(exit);
+	set_cur_block(exit);
+	ir_node *in[] = { get_value(1, mode_Is) };
+	ir_node *ret  = new_Return(get_store(), 1, in);
+	add_immBlock_pred(get_irg_end_block(irg), ret);
+	mature_immBlock(get_irg_end_block(irg));
+	irg_finalize_cons(irg);
+
+	counts_t before = { flag, 0, 0, 0 };
+	irg_walk_graph(irg, count, NULL, &before);
+	assert(before.conds == 2 && before.flag_conds == 1 && before.subs == 1);
+
+	do_loop_unswitching(irg);
+	assert(irg_verify(irg));
+
+	/* the flag is tested once in front of the loop, which got a copy for
+	 * each outcome */
+	counts_t after = { flag, 0, 0, 0 };
+	irg_walk_graph(irg, count, NULL, &after);
+	assert(after.conds == 3);
+	assert(after.flag_conds == 1);
+	assert(after.subs == 1);
+
+	/* int g(int n, int flag)
+	 * {
+	 *     int s = 0;
+	 *     while (flag)
+	 *         s -= n;
+	 *     return s;
+	 * }
+	 * The only invariant Cond is the exit test, folding it would make one of
+	 * the loops endless. */
+	ir_entity *g_entity = new_global_entity(get_glob_type(),
+	                                        new_id_from_str("g"), mtp,
+	                                        ir_visibility_external,
+	                                        IR_LINKAGE_DEFAULT);
+	ir_graph *g = new_ir_graph(g_entity, 1);
+	set_current_ir_graph(g);
+	ir_node *g_n    = new_Proj(get_irg_args(g), mode_Is, 0);
+	ir_node *g_flag = new_Proj(get_irg_args(g), mode_Is, 1);
+	set_value(0, new_Const_long(mode_Is, 0));
+
+	ir_node *g_header = new_immBlock();
+	add_immBlock_pred(g_header, new_Jmp());
+	set_cur_block(g_header);
+	ir_node *g_cond = new_Cond(new_Cmp(g_flag, new_Const_long(mode_Is, 0),
+	                                   ir_relation_less_greater));
+
+	ir_node *g_body = new_immBlock();
+	add_immBlock_pred(g_body, new_Proj(g_cond, mode_X, pn_Cond_true));
+	mature_immBlock(g_body);
+	set_cur_block(g_body);
+	set_value(0, new_Sub(get_value(0, mode_Is), g_n));
+	add_immBlock_pred(g_header, new_Jmp());
+	mature_immBlock(g_header);
+
+	ir_node *g_exit = new_immBlock();
+	add_immBlock_pred(g_exit, new_Proj(g_cond, mode_X, pn_Cond_false));
+	mature_immBlock(g_exit);
+	set_cur_block(g_exit);
+	ir_node *g_in[] = { get_value(0, mode_Is) };
+	ir_node *g_ret  = new_Return(get_store(), 1, g_in);
+	add_immBlock_pred(get_irg_end_block(g), g_ret);
+	mature_immBlock(get_irg_end_block(g));
+	irg_finalize_cons(g);
+
+	do_loop_unswitching(g);
+	assert(irg_verify(g));
+
+	counts_t exit_test = { g_flag, 0, 0, 0 };
+	irg_walk_graph(g, count, NULL, &exit_test);
+	assert(exit_test.conds == 1);
+	assert(exit_test.flag_conds == 1);
+	assert(exit_test.subs == 1);
+
+	ir_finish();
+	return 0;
+}